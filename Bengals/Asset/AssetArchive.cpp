@@ -0,0 +1,452 @@
+#include "pch.h"
+#include "AssetArchive.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include "Lz4Codec.h"
+
+namespace
+{
+	constexpr UINT64 FnvOffsetBasis = 14695981039346656037ull;
+	constexpr UINT64 FnvPrime = 1099511628211ull;
+
+	// FNV-1a를 8바이트 단위로 적용 (바이트 단위보다 수 배 빠르다). 나머지는 바이트 단위
+	UINT64 HashContinue(UINT64 hash, const void* pData, size_t size)
+	{
+		const BYTE* pBytes = static_cast<const BYTE*>(pData);
+		size_t i = 0;
+		for (; i + sizeof(UINT64) <= size; i += sizeof(UINT64))
+		{
+			UINT64 word = 0;
+			memcpy(&word, pBytes + i, sizeof(word));
+			hash ^= word;
+			hash *= FnvPrime;
+			hash ^= hash >> 32;
+		}
+		for (; i < size; i++)
+		{
+			hash ^= pBytes[i];
+			hash *= FnvPrime;
+		}
+		return hash;
+	}
+
+	void AppendUtf8(std::string& out, UINT codePoint)
+	{
+		if (codePoint < 0x80)
+		{
+			out.push_back(static_cast<char>(codePoint));
+		}
+		else if (codePoint < 0x800)
+		{
+			out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+			out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+		}
+		else if (codePoint < 0x10000)
+		{
+			out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+			out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+			out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+		}
+		else
+		{
+			out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+			out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+			out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+			out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+		}
+	}
+
+	// '\' -> '/', ASCII 소문자, 앞의 "./" 제거 (UTF-8 입력)
+	void NormalizeInPlace(std::string& path)
+	{
+		for (char& c : path)
+		{
+			if (c == '\\')
+			{
+				c = '/';
+			}
+			else if (c >= 'A' && c <= 'Z')
+			{
+				c = static_cast<char>(c - 'A' + 'a');
+			}
+		}
+
+		size_t start = 0;
+		while (path.compare(start, 2, "./") == 0)
+		{
+			start += 2;
+		}
+		path.erase(0, start);
+	}
+
+	UINT64 AlignUp(UINT64 value, UINT64 alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+}
+
+bool CAssetArchive::Open(const std::filesystem::path& fileName)
+{
+	Close();
+
+	if (!m_file.Open(fileName))
+	{
+		return false;
+	}
+
+	const BYTE* pData = m_file.GetData();
+	const UINT64 fileSize = m_file.GetSize();
+
+	FileHeader header = {};
+	if (fileSize < sizeof(header))
+	{
+		Close();
+		return false;
+	}
+	memcpy(&header, pData, sizeof(header));
+
+	if (header.Magic != Magic || header.Version != Version)
+	{
+		Close();
+		return false;
+	}
+
+	const UINT64 entryTableSize = static_cast<UINT64>(header.EntryCount) * sizeof(AssetEntryInfo);
+	const UINT64 nameTableOffset = sizeof(header) + entryTableSize;
+	if (nameTableOffset > fileSize || header.NameTableSize > fileSize - nameTableOffset)
+	{
+		Close();
+		return false;
+	}
+
+	UINT64 tocHash = HashContinue(FnvOffsetBasis, pData + sizeof(header), static_cast<size_t>(entryTableSize));
+	tocHash = HashContinue(tocHash, pData + nameTableOffset, static_cast<size_t>(header.NameTableSize));
+	if (tocHash != header.TocHash)
+	{
+		Close();
+		return false;
+	}
+
+	m_entryList.resize(header.EntryCount);
+	if (header.EntryCount > 0)
+	{
+		memcpy(m_entryList.data(), pData + sizeof(header), static_cast<size_t>(entryTableSize));
+	}
+	m_nameTable.assign(reinterpret_cast<const char*>(pData + nameTableOffset), static_cast<size_t>(header.NameTableSize));
+
+	// 해시가 맞아도 범위는 따로 확인한다 (잘린 파일)
+	for (UINT i = 0; i < header.EntryCount; i++)
+	{
+		const AssetEntryInfo& entry = m_entryList[i];
+		const bool bPayloadInRange = entry.Offset <= fileSize && entry.StoredSize <= fileSize - entry.Offset;
+		const bool bNameInRange = static_cast<UINT64>(entry.NameOffset) + entry.NameLength <= m_nameTable.size();
+		const bool bSorted = (i == 0) || m_entryList[i - 1].PathHash <= entry.PathHash;
+		if (!bPayloadInRange || !bNameInRange || !bSorted)
+		{
+			Close();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void CAssetArchive::Close()
+{
+	m_file.Close();
+	m_entryList.clear();
+	m_nameTable.clear();
+}
+
+const AssetEntryInfo* CAssetArchive::FindEntry(const char* path) const
+{
+	return FindNormalizedEntry(NormalizePath(path));
+}
+
+const AssetEntryInfo* CAssetArchive::FindEntry(const WCHAR* path) const
+{
+	return FindNormalizedEntry(NormalizePath(path));
+}
+
+const AssetEntryInfo* CAssetArchive::FindNormalizedEntry(std::string_view normalizedPath) const
+{
+	const UINT64 pathHash = HashBytes(normalizedPath.data(), normalizedPath.size());
+
+	auto iter = std::lower_bound(m_entryList.begin(), m_entryList.end(), pathHash,
+		[](const AssetEntryInfo& entry, UINT64 hash) { return entry.PathHash < hash; });
+
+	// 해시 충돌은 이름으로 구분
+	for (; iter != m_entryList.end() && iter->PathHash == pathHash; ++iter)
+	{
+		if (GetEntryName(*iter) == normalizedPath)
+		{
+			return &(*iter);
+		}
+	}
+	return nullptr;
+}
+
+std::string_view CAssetArchive::GetEntryName(const AssetEntryInfo& entry) const
+{
+	return std::string_view(m_nameTable).substr(entry.NameOffset, entry.NameLength);
+}
+
+bool CAssetArchive::GetEntryData(const AssetEntryInfo& entry, const BYTE** ppOutData, size_t* pOutSize) const
+{
+	if (!IsOpen() || entry.Compression != EAssetCompression::None)
+	{
+		return false;
+	}
+
+	*ppOutData = m_file.GetData() + entry.Offset;
+	*pOutSize = static_cast<size_t>(entry.Size);
+	return true;
+}
+
+bool CAssetArchive::ReadEntry(const AssetEntryInfo& entry, std::vector<BYTE>* pOutData) const
+{
+	if (!IsOpen())
+	{
+		return false;
+	}
+
+	const BYTE* pStored = m_file.GetData() + entry.Offset;
+	pOutData->resize(static_cast<size_t>(entry.Size));
+
+	switch (entry.Compression)
+	{
+	case EAssetCompression::None:
+		if (entry.StoredSize != entry.Size)
+		{
+			return false;
+		}
+		if (entry.Size > 0)
+		{
+			memcpy(pOutData->data(), pStored, static_cast<size_t>(entry.Size));
+		}
+		break;
+	case EAssetCompression::Lz4:
+		if (!Lz4DecompressBlock(pStored, static_cast<size_t>(entry.StoredSize), pOutData->data(), pOutData->size()))
+		{
+			return false;
+		}
+		break;
+	default:
+		// Zstd 등 지원하지 않는 형식
+		return false;
+	}
+
+	if (HashBytes(pOutData->data(), pOutData->size()) != entry.ContentHash)
+	{
+		__debugbreak();
+		return false;
+	}
+	return true;
+}
+
+std::string CAssetArchive::NormalizePath(const char* path)
+{
+	std::string result = path;
+	NormalizeInPlace(result);
+	return result;
+}
+
+std::string CAssetArchive::NormalizePath(const WCHAR* path)
+{
+	std::string result;
+	for (const WCHAR* p = path; *p != 0; p++)
+	{
+		UINT codePoint = static_cast<UINT>(*p);
+		// UTF-16 (Windows) surrogate pair
+		if (sizeof(WCHAR) == 2 && codePoint >= 0xD800 && codePoint <= 0xDBFF && p[1] >= 0xDC00 && p[1] <= 0xDFFF)
+		{
+			codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (static_cast<UINT>(p[1]) - 0xDC00);
+			p++;
+		}
+		AppendUtf8(result, codePoint);
+	}
+	NormalizeInPlace(result);
+	return result;
+}
+
+UINT64 CAssetArchive::HashBytes(const void* pData, size_t size)
+{
+	return HashContinue(FnvOffsetBasis, pData, size);
+}
+
+bool CAssetArchiveBuilder::AddEntry(const char* path, const void* pData, size_t size, EAssetCompression compression, UINT64* pOutStoredSize)
+{
+	std::string name = CAssetArchive::NormalizePath(path);
+	if (name.empty() || m_entryIndexMap.count(name) != 0)
+	{
+		return false;
+	}
+
+	PendingEntry entry = {};
+	entry.Name = name;
+	entry.Size = size;
+	entry.ContentHash = CAssetArchive::HashBytes(pData, size);
+
+	const BYTE* pBytes = static_cast<const BYTE*>(pData);
+	if (compression == EAssetCompression::Lz4 && size > 0)
+	{
+		// 충분히 줄지 않으면 그대로 저장 (zero-copy로 읽을 수 있도록)
+		const size_t maxStoredSize = size - static_cast<size_t>(static_cast<float>(size) * MinCompressionSaving);
+		entry.StoredData.resize(Lz4CompressBound(size));
+		const size_t storedSize = Lz4CompressBlock(pBytes, size, entry.StoredData.data(), entry.StoredData.size());
+		if (storedSize > 0 && storedSize < maxStoredSize)
+		{
+			entry.StoredData.resize(storedSize);
+			entry.Compression = EAssetCompression::Lz4;
+		}
+	}
+	else if (compression != EAssetCompression::None && compression != EAssetCompression::Lz4)
+	{
+		return false;
+	}
+
+	if (entry.Compression == EAssetCompression::None)
+	{
+		entry.StoredData.assign(pBytes, pBytes + size);
+	}
+
+	if (pOutStoredSize != nullptr)
+	{
+		*pOutStoredSize = entry.StoredData.size();
+	}
+
+	m_entryIndexMap.emplace(std::move(name), static_cast<UINT>(m_entryList.size()));
+	m_entryList.push_back(std::move(entry));
+	return true;
+}
+
+void CAssetArchiveBuilder::Clear()
+{
+	m_entryList.clear();
+	m_entryIndexMap.clear();
+}
+
+void CAssetArchiveBuilder::Serialize(std::vector<BYTE>& outData, UINT payloadAlignment) const
+{
+	payloadAlignment = (std::max)(payloadAlignment, 1u);
+
+	std::vector<UINT> orderList(m_entryList.size());
+	std::vector<UINT64> pathHashList(m_entryList.size());
+	for (UINT i = 0; i < static_cast<UINT>(m_entryList.size()); i++)
+	{
+		orderList[i] = i;
+		pathHashList[i] = CAssetArchive::HashBytes(m_entryList[i].Name.data(), m_entryList[i].Name.size());
+	}
+	// 해시가 같으면 이름 순 (결과가 입력 순서에 의존하지 않도록)
+	std::sort(orderList.begin(), orderList.end(), [&](UINT a, UINT b)
+		{
+			if (pathHashList[a] != pathHashList[b])
+			{
+				return pathHashList[a] < pathHashList[b];
+			}
+			return m_entryList[a].Name < m_entryList[b].Name;
+		});
+
+	std::vector<AssetEntryInfo> entryInfoList(m_entryList.size());
+	std::string nameTable;
+	for (size_t i = 0; i < orderList.size(); i++)
+	{
+		const PendingEntry& pending = m_entryList[orderList[i]];
+		AssetEntryInfo& info = entryInfoList[i];
+		info.PathHash = pathHashList[orderList[i]];
+		info.StoredSize = pending.StoredData.size();
+		info.Size = pending.Size;
+		info.ContentHash = pending.ContentHash;
+		info.NameOffset = static_cast<UINT>(nameTable.size());
+		info.NameLength = static_cast<UINT>(pending.Name.size());
+		info.Compression = pending.Compression;
+		nameTable += pending.Name;
+	}
+
+	const UINT64 tocSize = sizeof(CAssetArchive::FileHeader) + entryInfoList.size() * sizeof(AssetEntryInfo) + nameTable.size();
+	UINT64 payloadOffset = AlignUp(tocSize, payloadAlignment);
+
+	// 내용이 같은 payload는 한 번만 저장 (ContentHash로 후보를 찾고 바이트로 확인)
+	std::unordered_multimap<UINT64, UINT> storedPayloadMap;
+	std::vector<UINT> writeList;
+	for (UINT i = 0; i < static_cast<UINT>(entryInfoList.size()); i++)
+	{
+		AssetEntryInfo& info = entryInfoList[i];
+		const std::vector<BYTE>& stored = m_entryList[orderList[i]].StoredData;
+
+		bool bShared = false;
+		auto range = storedPayloadMap.equal_range(info.ContentHash);
+		for (auto iter = range.first; iter != range.second; ++iter)
+		{
+			const AssetEntryInfo& other = entryInfoList[iter->second];
+			if (other.Compression == info.Compression && m_entryList[orderList[iter->second]].StoredData == stored)
+			{
+				info.Offset = other.Offset;
+				bShared = true;
+				break;
+			}
+		}
+
+		if (!bShared)
+		{
+			info.Offset = payloadOffset;
+			payloadOffset = AlignUp(payloadOffset + stored.size(), payloadAlignment);
+			storedPayloadMap.emplace(info.ContentHash, i);
+			writeList.push_back(i);
+		}
+	}
+
+	CAssetArchive::FileHeader header = {};
+	header.Magic = CAssetArchive::Magic;
+	header.Version = CAssetArchive::Version;
+	header.EntryCount = static_cast<UINT>(entryInfoList.size());
+	header.PayloadAlignment = payloadAlignment;
+	header.NameTableSize = nameTable.size();
+	header.TocHash = HashContinue(FnvOffsetBasis, entryInfoList.data(), entryInfoList.size() * sizeof(AssetEntryInfo));
+	header.TocHash = HashContinue(header.TocHash, nameTable.data(), nameTable.size());
+
+	// 마지막 payload는 정렬 패딩 없이 끝난다
+	UINT64 fileSize = tocSize;
+	for (UINT i : writeList)
+	{
+		fileSize = (std::max)(fileSize, entryInfoList[i].Offset + entryInfoList[i].StoredSize);
+	}
+
+	outData.assign(static_cast<size_t>(fileSize), 0);
+	BYTE* pOut = outData.data();
+	memcpy(pOut, &header, sizeof(header));
+	pOut += sizeof(header);
+	if (!entryInfoList.empty())
+	{
+		memcpy(pOut, entryInfoList.data(), entryInfoList.size() * sizeof(AssetEntryInfo));
+		pOut += entryInfoList.size() * sizeof(AssetEntryInfo);
+	}
+	if (!nameTable.empty())
+	{
+		memcpy(pOut, nameTable.data(), nameTable.size());
+	}
+
+	for (UINT i : writeList)
+	{
+		const std::vector<BYTE>& stored = m_entryList[orderList[i]].StoredData;
+		if (!stored.empty())
+		{
+			memcpy(outData.data() + entryInfoList[i].Offset, stored.data(), stored.size());
+		}
+	}
+}
+
+bool CAssetArchiveBuilder::WriteToFile(const std::filesystem::path& fileName, UINT payloadAlignment) const
+{
+	std::vector<BYTE> data;
+	Serialize(data, payloadAlignment);
+
+	std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+	return static_cast<bool>(file);
+}
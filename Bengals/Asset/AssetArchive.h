@@ -0,0 +1,144 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "MappedFile.h"
+
+/**
+ * Packed asset archive: one file holding every asset payload, memory-mapped at startup
+ * in place of one open per file. Written by BengalsAssetBuild (Windows or Linux).
+ *
+ *   Header    { Magic 'BPAK', Version, EntryCount, PayloadAlignment, NameTableSize, TocHash }
+ *   Entry[]   sorted by PathHash (see AssetEntryInfo)
+ *   NameTable normalized paths, referenced by NameOffset / NameLength
+ *   Payloads  each starting on a PayloadAlignment boundary (a page by default)
+ *
+ * Paths are normalized before hashing: '\' becomes '/', ASCII is lowercased and a
+ * leading "./" is dropped, so L"../Resources/Image/tex_00.dds" and
+ * "..\resources\image\TEX_00.DDS" name the same entry. Lookup is a binary search on the
+ * 64-bit path hash (FNV-1a over 8-byte words, HashBytes) followed by a name compare. TocHash covers the entry table and
+ * names and is checked at Open(); payload pages are only touched when read, and
+ * ReadEntry() checks ContentHash (of the uncompressed bytes). Identical payloads are
+ * stored once. Entries are LZ4 block compressed or stored; stored entries are returned
+ * as a pointer into the mapping without a copy. Zstd has a format id but no codec.
+ */
+
+enum class EAssetCompression : UINT
+{
+	None = 0,
+	Lz4 = 1,
+	Zstd = 2		// 예약 (코덱 없음)
+};
+
+struct AssetEntryInfo
+{
+	UINT64 PathHash = 0;
+	UINT64 Offset = 0;			// 파일 시작 기준
+	UINT64 StoredSize = 0;
+	UINT64 Size = 0;			// 압축 해제 후
+	UINT64 ContentHash = 0;		// 압축 해제 후 바이트의 HashBytes
+	UINT NameOffset = 0;
+	UINT NameLength = 0;
+	EAssetCompression Compression = EAssetCompression::None;
+	UINT Reserved = 0;
+};
+
+class CAssetArchive
+{
+public:
+	static constexpr UINT Magic = 0x4B415042;		// "BPAK"
+	static constexpr UINT Version = 1;
+	static constexpr UINT DefaultPayloadAlignment = 4096;
+
+public:
+	CAssetArchive() = default;
+	~CAssetArchive() = default;
+
+	bool Open(const std::filesystem::path& fileName);
+	void Close();
+
+	bool IsOpen() const
+	{
+		return m_file.IsOpen();
+	}
+
+	const AssetEntryInfo* FindEntry(const char* path) const;
+	const AssetEntryInfo* FindEntry(const WCHAR* path) const;
+	std::string_view GetEntryName(const AssetEntryInfo& entry) const;
+
+	// 압축되지 않은 항목만. 매핑된 메모리를 그대로 돌려준다 (Close 전까지 유효)
+	bool GetEntryData(const AssetEntryInfo& entry, const BYTE** ppOutData, size_t* pOutSize) const;
+	// 압축 여부와 관계없이 복사 / 해제하고 ContentHash를 확인한다
+	bool ReadEntry(const AssetEntryInfo& entry, std::vector<BYTE>* pOutData) const;
+
+	UINT GetEntryCount() const
+	{
+		return static_cast<UINT>(m_entryList.size());
+	}
+
+	const AssetEntryInfo* GetEntry(UINT index) const
+	{
+		return (index < m_entryList.size()) ? &m_entryList[index] : nullptr;
+	}
+
+	static std::string NormalizePath(const char* path);
+	static std::string NormalizePath(const WCHAR* path);
+	static UINT64 HashBytes(const void* pData, size_t size);
+
+private:
+	struct FileHeader
+	{
+		UINT Magic;
+		UINT Version;
+		UINT EntryCount;
+		UINT PayloadAlignment;
+		UINT64 NameTableSize;
+		UINT64 TocHash;
+	};
+
+	friend class CAssetArchiveBuilder;
+
+	const AssetEntryInfo* FindNormalizedEntry(std::string_view normalizedPath) const;
+
+private:
+	CMappedFile m_file;
+	std::vector<AssetEntryInfo> m_entryList;
+	std::string m_nameTable;
+};
+
+class CAssetArchiveBuilder
+{
+public:
+	// 저장 크기가 이 비율 이상이면 압축하지 않고 저장한다
+	static constexpr float MinCompressionSaving = 1.0f / 16.0f;
+
+public:
+	// path는 NormalizePath 후 중복이면 실패. pOutStoredSize는 선택
+	bool AddEntry(const char* path, const void* pData, size_t size, EAssetCompression compression, UINT64* pOutStoredSize = nullptr);
+	void Clear();
+
+	void Serialize(std::vector<BYTE>& outData, UINT payloadAlignment = CAssetArchive::DefaultPayloadAlignment) const;
+	bool WriteToFile(const std::filesystem::path& fileName, UINT payloadAlignment = CAssetArchive::DefaultPayloadAlignment) const;
+
+	UINT GetEntryCount() const
+	{
+		return static_cast<UINT>(m_entryList.size());
+	}
+
+private:
+	struct PendingEntry
+	{
+		std::string Name;
+		std::vector<BYTE> StoredData;
+		UINT64 Size = 0;
+		UINT64 ContentHash = 0;
+		EAssetCompression Compression = EAssetCompression::None;
+	};
+
+private:
+	std::vector<PendingEntry> m_entryList;
+	std::unordered_map<std::string, UINT> m_entryIndexMap;		// 정규화된 경로 -> m_entryList index
+};
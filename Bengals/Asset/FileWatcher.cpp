@@ -0,0 +1,454 @@
+#include "pch.h"
+#include "FileWatcher.h"
+#include <algorithm>
+#include <chrono>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	using WatchClock = std::chrono::steady_clock;
+
+	void AppendUnique(std::vector<std::filesystem::path>* pList, const std::filesystem::path& path)
+	{
+		if (std::find(pList->begin(), pList->end(), path) == pList->end())
+		{
+			pList->push_back(path);
+		}
+	}
+}
+
+CFileWatcher::~CFileWatcher()
+{
+	Stop();
+}
+
+bool CFileWatcher::Start(const std::vector<std::filesystem::path>& rootList, ChangeCallback callback, EFileWatchBackend backend, UINT pollIntervalMs)
+{
+	Stop();
+
+	m_rootList.clear();
+	for (const std::filesystem::path& root : rootList)
+	{
+		std::error_code errorCode;
+		if (std::filesystem::is_directory(root, errorCode))
+		{
+			m_rootList.push_back(root);
+		}
+	}
+	if (m_rootList.empty() || !callback)
+	{
+		return false;
+	}
+
+	m_callback = std::move(callback);
+	m_pollIntervalMs = (std::max)(pollIntervalMs, DebounceMs);
+	m_bStopRequested = false;
+
+	m_backend = backend;
+	if (m_backend == EFileWatchBackend::Native && !StartNative())
+	{
+		CloseNative();
+		m_backend = EFileWatchBackend::Polling;
+	}
+
+	if (m_backend == EFileWatchBackend::Polling)
+	{
+		// 기준 상태. 시작 전에 있던 파일은 변경으로 보지 않는다
+		std::vector<std::filesystem::path> ignoredList;
+		ScanPolling(&ignoredList);
+	}
+
+	m_thread = std::thread(&CFileWatcher::ThreadMain, this);
+	return true;
+}
+
+void CFileWatcher::Stop()
+{
+	if (m_thread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_stopMutex);
+			m_bStopRequested = true;
+		}
+		m_stopCondition.notify_all();
+
+#ifdef _WIN32
+		if (m_stopEvent)
+		{
+			SetEvent(m_stopEvent);
+		}
+#else
+		if (m_wakePipe[1] >= 0)
+		{
+			const char wake = 1;
+			(void)write(m_wakePipe[1], &wake, 1);
+		}
+#endif
+		m_thread.join();
+	}
+
+	CloseNative();
+	m_pollEntryList.clear();
+	m_callback = nullptr;
+}
+
+void CFileWatcher::ThreadMain()
+{
+	std::vector<std::filesystem::path> pendingList;
+	WatchClock::time_point lastChangeTime = {};
+
+	while (!m_bStopRequested)
+	{
+		// 모아 둔 변경이 있으면 debounce가 끝날 때까지만 기다린다
+		UINT timeoutMs = (m_backend == EFileWatchBackend::Polling) ? m_pollIntervalMs : 1000;
+		if (!pendingList.empty())
+		{
+			const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(WatchClock::now() - lastChangeTime).count();
+			timeoutMs = (elapsed >= DebounceMs) ? 0 : (std::min)(timeoutMs, static_cast<UINT>(DebounceMs - elapsed));
+		}
+
+		const size_t prevPendingCount = pendingList.size();
+		const bool bRunning = (m_backend == EFileWatchBackend::Native) ?
+			WaitNative(timeoutMs, &pendingList) :
+			WaitPolling(timeoutMs, &pendingList);
+		if (!bRunning)
+		{
+			break;
+		}
+
+		if (pendingList.size() != prevPendingCount)
+		{
+			lastChangeTime = WatchClock::now();
+			continue;
+		}
+
+		if (!pendingList.empty() && WatchClock::now() - lastChangeTime >= std::chrono::milliseconds(DebounceMs))
+		{
+			m_callback(pendingList);
+			pendingList.clear();
+		}
+	}
+}
+
+bool CFileWatcher::WaitPolling(UINT timeoutMs, std::vector<std::filesystem::path>* pOutChangedList)
+{
+	{
+		std::unique_lock<std::mutex> lock(m_stopMutex);
+		m_stopCondition.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]() { return m_bStopRequested.load(); });
+	}
+	if (m_bStopRequested)
+	{
+		return false;
+	}
+
+	ScanPolling(pOutChangedList);
+	return true;
+}
+
+void CFileWatcher::ScanPolling(std::vector<std::filesystem::path>* pOutChangedList)
+{
+	std::vector<std::pair<std::filesystem::path, PollEntry>> entryList;
+	for (const std::filesystem::path& root : m_rootList)
+	{
+		std::error_code errorCode;
+		for (std::filesystem::recursive_directory_iterator iter(root, errorCode), end; !errorCode && iter != end; iter.increment(errorCode))
+		{
+			std::error_code entryError;
+			if (!iter->is_regular_file(entryError))
+			{
+				continue;
+			}
+
+			PollEntry entry = {};
+			entry.WriteTime = iter->last_write_time(entryError);
+			entry.Size = iter->file_size(entryError);
+			entryList.emplace_back(iter->path(), entry);
+		}
+	}
+	std::sort(entryList.begin(), entryList.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+	// 이전 스캔과 병합 비교 (둘 다 경로 순)
+	auto prevIter = m_pollEntryList.begin();
+	for (const auto& [path, entry] : entryList)
+	{
+		while (prevIter != m_pollEntryList.end() && prevIter->first < path)
+		{
+			++prevIter;
+		}
+
+		const bool bKnown = (prevIter != m_pollEntryList.end() && prevIter->first == path);
+		if (!bKnown || prevIter->second.WriteTime != entry.WriteTime || prevIter->second.Size != entry.Size)
+		{
+			AppendUnique(pOutChangedList, path);
+		}
+	}
+	m_pollEntryList = std::move(entryList);
+}
+
+#ifdef _WIN32
+
+bool CFileWatcher::StartNative()
+{
+	m_stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	if (!m_stopEvent)
+	{
+		return false;
+	}
+
+	m_directoryWatchList.resize(m_rootList.size());
+	for (size_t i = 0; i < m_rootList.size(); i++)
+	{
+		DirectoryWatch& watch = m_directoryWatchList[i];
+		watch.DirectoryHandle = CreateFileW(m_rootList[i].c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+			nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+		if (watch.DirectoryHandle == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		watch.Overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+		watch.Buffer.resize(64 * 1024);
+		if (!watch.Overlapped.hEvent ||
+			!ReadDirectoryChangesW(watch.DirectoryHandle, watch.Buffer.data(), static_cast<DWORD>(watch.Buffer.size()), TRUE,
+				FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE, nullptr, &watch.Overlapped, nullptr))
+		{
+			return false;
+		}
+	}
+
+	// WaitForMultipleObjects 한도 (stop 이벤트 포함)
+	return m_directoryWatchList.size() < MAXIMUM_WAIT_OBJECTS;
+}
+
+void CFileWatcher::CloseNative()
+{
+	for (DirectoryWatch& watch : m_directoryWatchList)
+	{
+		if (watch.DirectoryHandle != INVALID_HANDLE_VALUE)
+		{
+			CancelIoEx(watch.DirectoryHandle, &watch.Overlapped);
+			DWORD transferred = 0;
+			GetOverlappedResult(watch.DirectoryHandle, &watch.Overlapped, &transferred, TRUE);
+			CloseHandle(watch.DirectoryHandle);
+		}
+		if (watch.Overlapped.hEvent)
+		{
+			CloseHandle(watch.Overlapped.hEvent);
+		}
+	}
+	m_directoryWatchList.clear();
+
+	if (m_stopEvent)
+	{
+		CloseHandle(m_stopEvent);
+		m_stopEvent = nullptr;
+	}
+}
+
+bool CFileWatcher::WaitNative(UINT timeoutMs, std::vector<std::filesystem::path>* pOutChangedList)
+{
+	HANDLE waitHandles[MAXIMUM_WAIT_OBJECTS] = {};
+	const DWORD watchCount = static_cast<DWORD>(m_directoryWatchList.size());
+	for (DWORD i = 0; i < watchCount; i++)
+	{
+		waitHandles[i] = m_directoryWatchList[i].Overlapped.hEvent;
+	}
+	waitHandles[watchCount] = m_stopEvent;
+
+	const DWORD waitResult = WaitForMultipleObjects(watchCount + 1, waitHandles, FALSE, timeoutMs);
+	if (waitResult == WAIT_TIMEOUT)
+	{
+		return true;
+	}
+	if (waitResult >= WAIT_OBJECT_0 + watchCount)
+	{
+		return false;		// stop 또는 오류
+	}
+
+	const DWORD watchIndex = waitResult - WAIT_OBJECT_0;
+	DirectoryWatch& watch = m_directoryWatchList[watchIndex];
+	DWORD transferred = 0;
+	const BOOL bCompleted = GetOverlappedResult(watch.DirectoryHandle, &watch.Overlapped, &transferred, FALSE);
+	ResetEvent(watch.Overlapped.hEvent);
+
+	if (bCompleted && transferred == 0)
+	{
+		// 버퍼가 넘쳤다: 이 트리의 모든 파일을 바뀐 것으로 본다
+		std::error_code errorCode;
+		for (std::filesystem::recursive_directory_iterator iter(m_rootList[watchIndex], errorCode), end; !errorCode && iter != end; iter.increment(errorCode))
+		{
+			if (iter->is_regular_file())
+			{
+				AppendUnique(pOutChangedList, iter->path());
+			}
+		}
+	}
+	else if (bCompleted)
+	{
+		const BYTE* pRecord = watch.Buffer.data();
+		for (;;)
+		{
+			const FILE_NOTIFY_INFORMATION* pInfo = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(pRecord);
+			if (pInfo->Action == FILE_ACTION_ADDED || pInfo->Action == FILE_ACTION_MODIFIED || pInfo->Action == FILE_ACTION_RENAMED_NEW_NAME)
+			{
+				const std::wstring relativeName(pInfo->FileName, pInfo->FileNameLength / sizeof(WCHAR));
+				const std::filesystem::path path = m_rootList[watchIndex] / relativeName;
+				std::error_code errorCode;
+				if (std::filesystem::is_regular_file(path, errorCode))
+				{
+					AppendUnique(pOutChangedList, path);
+				}
+			}
+
+			if (pInfo->NextEntryOffset == 0)
+			{
+				break;
+			}
+			pRecord += pInfo->NextEntryOffset;
+		}
+	}
+
+	// 다음 변경을 받도록 다시 건다. 실패하면 (디렉터리 삭제 등) 이 감시를 멈춘다
+	if (!ReadDirectoryChangesW(watch.DirectoryHandle, watch.Buffer.data(), static_cast<DWORD>(watch.Buffer.size()), TRUE,
+		FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE, nullptr, &watch.Overlapped, nullptr))
+	{
+		__debugbreak();
+		return false;
+	}
+	return true;
+}
+
+#else
+
+bool CFileWatcher::StartNative()
+{
+	m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (m_inotifyFd < 0 || pipe(m_wakePipe) != 0)
+	{
+		return false;
+	}
+
+	for (const std::filesystem::path& root : m_rootList)
+	{
+		AddInotifyWatchTree(root);
+	}
+	return !m_inotifyWatchList.empty();
+}
+
+void CFileWatcher::AddInotifyWatchTree(const std::filesystem::path& directory)
+{
+	const int watchDescriptor = inotify_add_watch(m_inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+	if (watchDescriptor < 0)
+	{
+		return;
+	}
+
+	// 같은 디렉터리를 다시 추가하면 기존 descriptor가 돌아온다
+	for (InotifyWatch& watch : m_inotifyWatchList)
+	{
+		if (watch.WatchDescriptor == watchDescriptor)
+		{
+			watch.Directory = directory;
+			return;
+		}
+	}
+	m_inotifyWatchList.push_back({ watchDescriptor, directory });
+
+	std::error_code errorCode;
+	for (std::filesystem::directory_iterator iter(directory, errorCode), end; !errorCode && iter != end; iter.increment(errorCode))
+	{
+		if (iter->is_directory())
+		{
+			AddInotifyWatchTree(iter->path());
+		}
+	}
+}
+
+void CFileWatcher::CloseNative()
+{
+	if (m_inotifyFd >= 0)
+	{
+		close(m_inotifyFd);		// watch들도 함께 제거된다
+		m_inotifyFd = -1;
+	}
+	m_inotifyWatchList.clear();
+
+	for (int& fd : m_wakePipe)
+	{
+		if (fd >= 0)
+		{
+			close(fd);
+			fd = -1;
+		}
+	}
+}
+
+bool CFileWatcher::WaitNative(UINT timeoutMs, std::vector<std::filesystem::path>* pOutChangedList)
+{
+	pollfd pollList[2] = {};
+	pollList[0].fd = m_inotifyFd;
+	pollList[0].events = POLLIN;
+	pollList[1].fd = m_wakePipe[0];
+	pollList[1].events = POLLIN;
+
+	const int readyCount = poll(pollList, 2, static_cast<int>(timeoutMs));
+	if (m_bStopRequested || (pollList[1].revents & POLLIN))
+	{
+		return false;
+	}
+	if (readyCount <= 0 || !(pollList[0].revents & POLLIN))
+	{
+		return true;
+	}
+
+	alignas(inotify_event) char buffer[16 * 1024];
+	for (;;)
+	{
+		const ssize_t readSize = read(m_inotifyFd, buffer, sizeof(buffer));
+		if (readSize <= 0)
+		{
+			break;
+		}
+
+		for (ssize_t offset = 0; offset < readSize;)
+		{
+			const inotify_event* pEvent = reinterpret_cast<const inotify_event*>(buffer + offset);
+			offset += sizeof(inotify_event) + pEvent->len;
+
+			auto watchIter = std::find_if(m_inotifyWatchList.begin(), m_inotifyWatchList.end(),
+				[pEvent](const InotifyWatch& watch) { return watch.WatchDescriptor == pEvent->wd; });
+			if (watchIter == m_inotifyWatchList.end() || pEvent->len == 0)
+			{
+				continue;
+			}
+
+			const std::filesystem::path path = watchIter->Directory / pEvent->name;
+			if (pEvent->mask & IN_ISDIR)
+			{
+				// 새 하위 디렉터리: 감시를 추가하고 이미 들어 있는 파일은 바뀐 것으로 본다
+				AddInotifyWatchTree(path);
+				std::error_code errorCode;
+				for (std::filesystem::recursive_directory_iterator iter(path, errorCode), end; !errorCode && iter != end; iter.increment(errorCode))
+				{
+					if (iter->is_regular_file())
+					{
+						AppendUnique(pOutChangedList, iter->path());
+					}
+				}
+			}
+			else if (pEvent->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+			{
+				AppendUnique(pOutChangedList, path);
+			}
+		}
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Background watch of a few directory trees for changed files.
+ *
+ * The native backend is ReadDirectoryChangesW on Windows and inotify on Linux (one watch
+ * per subdirectory, added as directories appear). If it cannot start, or Polling is asked
+ * for, the trees are rescanned every poll interval and a file counts as changed when its
+ * write time or size differs. Editors save in several steps, so changes are collected
+ * until DebounceMs pass without a new one and then handed to the callback once, on the
+ * watcher thread, as root / relative path (the root exactly as given to Start). Only
+ * writes, creations and renames into a tree are reported; deletions are not.
+ */
+
+enum class EFileWatchBackend : UINT8
+{
+	Native,
+	Polling
+};
+
+class CFileWatcher
+{
+public:
+	using ChangeCallback = std::function<void(const std::vector<std::filesystem::path>& changedFileList)>;
+
+	static constexpr UINT DebounceMs = 100;
+	static constexpr UINT DefaultPollIntervalMs = 500;
+
+public:
+	CFileWatcher() = default;
+	~CFileWatcher();
+
+	CFileWatcher(const CFileWatcher&) = delete;
+	CFileWatcher& operator=(const CFileWatcher&) = delete;
+
+	// 존재하지 않는 디렉터리는 건너뛴다. 하나도 없으면 실패
+	bool Start(const std::vector<std::filesystem::path>& rootList, ChangeCallback callback,
+		EFileWatchBackend backend = EFileWatchBackend::Native, UINT pollIntervalMs = DefaultPollIntervalMs);
+	void Stop();
+
+	bool IsRunning() const
+	{
+		return m_thread.joinable();
+	}
+
+	// Start 후 실제로 사용 중인 backend (Native가 실패하면 Polling)
+	EFileWatchBackend GetBackend() const
+	{
+		return m_backend;
+	}
+
+private:
+	struct PollEntry
+	{
+		std::filesystem::file_time_type WriteTime = {};
+		UINT64 Size = 0;
+	};
+
+	bool StartNative();
+	void CloseNative();
+	// timeoutMs 동안 기다리며 바뀐 파일을 pOutChangedList에 더한다. Stop되면 false
+	bool WaitNative(UINT timeoutMs, std::vector<std::filesystem::path>* pOutChangedList);
+	bool WaitPolling(UINT timeoutMs, std::vector<std::filesystem::path>* pOutChangedList);
+	void ScanPolling(std::vector<std::filesystem::path>* pOutChangedList);
+
+	void ThreadMain();
+
+private:
+	std::vector<std::filesystem::path> m_rootList;
+	ChangeCallback m_callback;
+	EFileWatchBackend m_backend = EFileWatchBackend::Native;
+	UINT m_pollIntervalMs = DefaultPollIntervalMs;
+
+	std::thread m_thread;
+	std::atomic<bool> m_bStopRequested = false;
+	std::mutex m_stopMutex;
+	std::condition_variable m_stopCondition;		// Polling 대기를 깨운다
+
+#ifdef _WIN32
+	struct DirectoryWatch
+	{
+		HANDLE DirectoryHandle = INVALID_HANDLE_VALUE;
+		OVERLAPPED Overlapped = {};
+		std::vector<BYTE> Buffer;
+	};
+	std::vector<DirectoryWatch> m_directoryWatchList;		// m_rootList와 같은 순서
+	HANDLE m_stopEvent = nullptr;
+#else
+	struct InotifyWatch
+	{
+		int WatchDescriptor = -1;
+		std::filesystem::path Directory;		// root 기준으로 이어 붙인 경로
+	};
+	void AddInotifyWatchTree(const std::filesystem::path& directory);
+	std::vector<InotifyWatch> m_inotifyWatchList;
+	int m_inotifyFd = -1;
+	int m_wakePipe[2] = { -1, -1 };
+#endif
+
+	std::vector<std::pair<std::filesystem::path, PollEntry>> m_pollEntryList;		// 경로 순 정렬
+};
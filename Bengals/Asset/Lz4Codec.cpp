@@ -0,0 +1,270 @@
+#include "pch.h"
+#include "Lz4Codec.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	constexpr size_t MinMatch = 4;
+	constexpr size_t LastLiteralCount = 5;		// 블록의 마지막 5바이트는 항상 literal
+	constexpr size_t MatchFindLimit = 12;		// 마지막 match는 블록 끝에서 12바이트 이전에 시작
+	constexpr size_t MaxOffset = 65535;
+	constexpr UINT HashLog = 16;
+
+	UINT Read32(const BYTE* p)
+	{
+		UINT value = 0;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	UINT HashSequence(UINT sequence)
+	{
+		return (sequence * 2654435761u) >> (32 - HashLog);
+	}
+
+	// 255가 이어지는 가변 길이. 반환: 다음 쓰기 위치, 공간이 모자라면 nullptr
+	BYTE* WriteLength(BYTE* pOut, const BYTE* pOutEnd, size_t length)
+	{
+		while (length >= 255)
+		{
+			if (pOut >= pOutEnd)
+			{
+				return nullptr;
+			}
+			*pOut++ = 255;
+			length -= 255;
+		}
+		if (pOut >= pOutEnd)
+		{
+			return nullptr;
+		}
+		*pOut++ = static_cast<BYTE>(length);
+		return pOut;
+	}
+
+	BYTE* WriteSequence(BYTE* pOut, const BYTE* pOutEnd, const BYTE* pLiteral, size_t literalLength, size_t offset, size_t matchLength)
+	{
+		if (pOut >= pOutEnd)
+		{
+			return nullptr;
+		}
+		BYTE* pToken = pOut++;
+		*pToken = static_cast<BYTE>((literalLength >= 15 ? 15 : literalLength) << 4);
+		if (literalLength >= 15 && !(pOut = WriteLength(pOut, pOutEnd, literalLength - 15)))
+		{
+			return nullptr;
+		}
+
+		if (static_cast<size_t>(pOutEnd - pOut) < literalLength)
+		{
+			return nullptr;
+		}
+		memcpy(pOut, pLiteral, literalLength);
+		pOut += literalLength;
+
+		// 마지막 sequence는 literal만
+		if (matchLength == 0)
+		{
+			return pOut;
+		}
+
+		if (pOutEnd - pOut < 2)
+		{
+			return nullptr;
+		}
+		*pOut++ = static_cast<BYTE>(offset & 0xFF);
+		*pOut++ = static_cast<BYTE>(offset >> 8);
+
+		const size_t matchCode = matchLength - MinMatch;
+		*pToken |= static_cast<BYTE>(matchCode >= 15 ? 15 : matchCode);
+		if (matchCode >= 15 && !(pOut = WriteLength(pOut, pOutEnd, matchCode - 15)))
+		{
+			return nullptr;
+		}
+		return pOut;
+	}
+}
+
+size_t Lz4CompressBound(size_t srcSize)
+{
+	return srcSize + srcSize / 255 + 16;
+}
+
+size_t Lz4CompressBlock(const BYTE* pSrc, size_t srcSize, BYTE* pDst, size_t dstCapacity)
+{
+	if ((!pSrc && srcSize > 0) || !pDst)
+	{
+		__debugbreak();
+		return 0;
+	}
+
+	BYTE* pOut = pDst;
+	const BYTE* pOutEnd = pDst + dstCapacity;
+	size_t anchor = 0;
+
+	if (srcSize > MatchFindLimit)
+	{
+		// 위치 + 1을 저장한다 (0 = 비어 있음)
+		std::vector<UINT> hashTable(static_cast<size_t>(1) << HashLog, 0);
+		const size_t matchEndLimit = srcSize - LastLiteralCount;
+		const size_t positionLimit = srcSize - MatchFindLimit;
+
+		size_t position = 0;
+		while (position < positionLimit)
+		{
+			const UINT sequence = Read32(pSrc + position);
+			UINT& slot = hashTable[HashSequence(sequence)];
+			const size_t candidate = static_cast<size_t>(slot) - 1;
+			const bool bHasCandidate = (slot != 0);
+			slot = static_cast<UINT>(position + 1);
+
+			if (!bHasCandidate || position - candidate > MaxOffset || Read32(pSrc + candidate) != sequence)
+			{
+				position++;
+				continue;
+			}
+
+			size_t matchPosition = position;
+			size_t reference = candidate;
+			while (matchPosition > anchor && reference > 0 && pSrc[matchPosition - 1] == pSrc[reference - 1])
+			{
+				matchPosition--;
+				reference--;
+			}
+
+			size_t matchLength = MinMatch + (position - matchPosition);
+			while (matchPosition + matchLength < matchEndLimit && pSrc[reference + matchLength] == pSrc[matchPosition + matchLength])
+			{
+				matchLength++;
+			}
+
+			pOut = WriteSequence(pOut, pOutEnd, pSrc + anchor, matchPosition - anchor, matchPosition - reference, matchLength);
+			if (!pOut)
+			{
+				return 0;
+			}
+
+			position = matchPosition + matchLength;
+			anchor = position;
+
+			// match 끝 부근도 등록해 다음 match를 더 잘 찾는다
+			if (position - 2 < positionLimit)
+			{
+				hashTable[HashSequence(Read32(pSrc + position - 2))] = static_cast<UINT>(position - 2 + 1);
+			}
+		}
+	}
+
+	pOut = WriteSequence(pOut, pOutEnd, pSrc + anchor, srcSize - anchor, 0, 0);
+	if (!pOut)
+	{
+		return 0;
+	}
+	return static_cast<size_t>(pOut - pDst);
+}
+
+bool Lz4DecompressBlock(const BYTE* pSrc, size_t srcSize, BYTE* pDst, size_t dstSize)
+{
+	if ((!pSrc && srcSize > 0) || (!pDst && dstSize > 0))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	size_t in = 0;
+	size_t out = 0;
+
+	auto ReadLength = [&](size_t* pLength)
+		{
+			BYTE value = 0;
+			do
+			{
+				if (in >= srcSize)
+				{
+					return false;
+				}
+				value = pSrc[in++];
+				*pLength += value;
+			} while (value == 255);
+			return true;
+		};
+
+	for (;;)
+	{
+		if (in >= srcSize)
+		{
+			return false;
+		}
+		const BYTE token = pSrc[in++];
+
+		size_t literalLength = token >> 4;
+		if (literalLength == 15 && !ReadLength(&literalLength))
+		{
+			return false;
+		}
+		if (literalLength > srcSize - in || literalLength > dstSize - out)
+		{
+			return false;
+		}
+		// 짧은 literal은 양쪽에 여유가 있으면 16바이트를 한 번에 복사 (넘친 부분은 뒤에서 덮어쓴다)
+		if (literalLength <= 16 && srcSize - in >= 16 && dstSize - out >= 16)
+		{
+			memcpy(pDst + out, pSrc + in, 16);
+		}
+		else
+		{
+			memcpy(pDst + out, pSrc + in, literalLength);
+		}
+		in += literalLength;
+		out += literalLength;
+
+		if (in == srcSize)
+		{
+			return out == dstSize;
+		}
+
+		if (srcSize - in < 2)
+		{
+			return false;
+		}
+		const size_t offset = static_cast<size_t>(pSrc[in]) | (static_cast<size_t>(pSrc[in + 1]) << 8);
+		in += 2;
+		if (offset == 0 || offset > out)
+		{
+			return false;
+		}
+
+		size_t matchLength = token & 15;
+		if (matchLength == 15 && !ReadLength(&matchLength))
+		{
+			return false;
+		}
+		matchLength += MinMatch;
+		if (matchLength > dstSize - out)
+		{
+			return false;
+		}
+
+		// 겹치는 복사 (offset < matchLength)는 바이트 단위로 반복 패턴을 만든다
+		BYTE* pMatchOut = pDst + out;
+		const BYTE* pMatchIn = pMatchOut - offset;
+		size_t copied = 0;
+		if (offset >= 8)
+		{
+			// 8바이트씩: 각 조각은 이미 쓰인 바이트만 읽는다. 뒤에 여유가 있으면 마지막 조각을 넘겨 쓴다
+			const size_t chunkLimit = (dstSize - out >= matchLength + 8) ? matchLength : matchLength - (matchLength % 8);
+			for (; copied < chunkLimit; copied += 8)
+			{
+				memcpy(pMatchOut + copied, pMatchIn + copied, 8);
+			}
+			copied = (std::min)(copied, matchLength);
+		}
+		for (; copied < matchLength; copied++)
+		{
+			pMatchOut[copied] = pMatchIn[copied];
+		}
+		out += matchLength;
+	}
+}
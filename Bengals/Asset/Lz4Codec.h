@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * LZ4 block format (no frame header) encoder and decoder, so archive entries can be
+ * compressed without an external library. The output is readable by any LZ4 block
+ * decoder and vice versa.
+ *
+ * The encoder is greedy with a 64K-entry hash table of 4-byte sequences, close to
+ * LZ4's default level in ratio. The decoder checks every length and offset against
+ * both buffers and fails instead of reading or writing out of range, so a corrupt
+ * payload never overruns. CPU only.
+ */
+
+size_t Lz4CompressBound(size_t srcSize);
+
+// 반환: 압축된 크기. dstCapacity가 모자라면 0
+size_t Lz4CompressBlock(const BYTE* pSrc, size_t srcSize, BYTE* pDst, size_t dstCapacity);
+
+// 출력이 정확히 dstSize를 채워야 성공
+bool Lz4DecompressBlock(const BYTE* pSrc, size_t srcSize, BYTE* pDst, size_t dstSize);
@@ -0,0 +1,91 @@
+#include "pch.h"
+#include "MappedFile.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+CMappedFile::~CMappedFile()
+{
+	Close();
+}
+
+bool CMappedFile::Open(const std::filesystem::path& fileName)
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE hFile = CreateFileW(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize = {};
+	if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart <= 0 || static_cast<UINT64>(fileSize.QuadPart) > SIZE_MAX)
+	{
+		CloseHandle(hFile);
+		return false;
+	}
+
+	HANDLE hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(hFile);
+	if (!hMapping)
+	{
+		return false;
+	}
+
+	void* pView = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(hMapping);
+	if (!pView)
+	{
+		return false;
+	}
+
+	m_pData = static_cast<const BYTE*>(pView);
+	m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+	const int fd = open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStat = {};
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	void* pView = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (pView == MAP_FAILED)
+	{
+		return false;
+	}
+
+	m_pData = static_cast<const BYTE*>(pView);
+	m_size = static_cast<size_t>(fileStat.st_size);
+#endif
+	return true;
+}
+
+void CMappedFile::Close()
+{
+	if (!m_pData)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	UnmapViewOfFile(m_pData);
+#else
+	munmap(const_cast<BYTE*>(m_pData), m_size);
+#endif
+	m_pData = nullptr;
+	m_size = 0;
+}
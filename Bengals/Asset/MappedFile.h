@@ -0,0 +1,42 @@
+#pragma once
+
+#include <filesystem>
+
+/**
+ * Read-only memory mapping of a whole file (MapViewOfFile on Windows, mmap elsewhere).
+ *
+ * Open() maps the file and closes its handles right away; the view keeps the file
+ * alive until Close(). Pages are read on first touch, so opening costs one system
+ * call sequence regardless of the file size. Empty files fail to open.
+ */
+class CMappedFile
+{
+public:
+	CMappedFile() = default;
+	~CMappedFile();
+
+	CMappedFile(const CMappedFile&) = delete;
+	CMappedFile& operator=(const CMappedFile&) = delete;
+
+	bool Open(const std::filesystem::path& fileName);
+	void Close();
+
+	bool IsOpen() const
+	{
+		return m_pData != nullptr;
+	}
+
+	const BYTE* GetData() const
+	{
+		return m_pData;
+	}
+
+	size_t GetSize() const
+	{
+		return m_size;
+	}
+
+private:
+	const BYTE* m_pData = nullptr;
+	size_t m_size = 0;
+};
@@ -1,9 +1,16 @@
 #include "pch.h"
 #include <algorithm>
+#include <map>
 #include <DirectXMath.h>
 #include "Renderer/D3D12Renderer.h"
+#include "Renderer/Manager/TextureManager.h"
 #include "GameObject.h"
 #include "Game.h"
+#include "Scene/DynamicAabbTree.h"
+#include "Scene/OcclusionCuller.h"
+#include "Task/WorkerPool.h"
+#include "Profiler/Profiler.h"
+#include "Profiler/MemoryTracker.h"
 
 CGame::CGame()
 {
@@ -18,15 +25,62 @@ CGame::~CGame()
 bool CGame::Initialize(HWND hWnd, bool bEnableDebugLayer, bool bEnableGBV)
 {
 	m_windowHandle = hWnd;
-	m_renderer = std::make_unique<CD3D12Renderer>(hWnd, bEnableDebugLayer, bEnableGBV);
+	PROFILE_THREAD_NAME("Main");
+
+	// Game update와 렌더 큐 기록이 같은 워커 풀을 사용
+	m_workerPool = std::make_unique<CWorkerPool>();
+	if (!m_workerPool->Initialize(CWorkerPool::GetDefaultWorkerCount()))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	m_renderer = std::make_unique<CD3D12Renderer>(hWnd, bEnableDebugLayer, bEnableGBV, m_workerPool.get());
 	if (!m_renderer)
 	{
 		__debugbreak();
 		return false;
 	}
 
+#ifdef _DEBUG
+	// 리소스 / 셰이더를 편집하면 실행 중에 바로 반영
+	m_renderer->EnableHotReload(L"../Resources");
+#endif
+
+	// budget을 넘거나 다시 돌아오면 디버거 출력 창에 카테고리별 보고서를 남긴다
+	CMemoryTracker::Get().SetBudget(EMemoryCategory::Count, GpuMemoryBudgetBytes);
+	CMemoryTracker::Get().SetBudgetCallback([](const MemoryBudgetEvent& budgetEvent)
+		{
+			char message[128];
+			sprintf_s(message, "GPU memory %s budget: %s %.1f / %.1f MB\n", budgetEvent.bOverBudget ? "over" : "back under",
+				GetMemoryCategoryName(budgetEvent.Category),
+				static_cast<double>(budgetEvent.CurrentBytes) / (1024.0 * 1024.0), static_cast<double>(budgetEvent.BudgetBytes) / (1024.0 * 1024.0));
+			OutputDebugStringA(message);
+
+			std::string report;
+			CMemoryTracker::Get().WriteReport(report);
+			OutputDebugStringA(report.c_str());
+		});
+
 	// 100 box objects at random positions
 	const UINT GameObjCount = 300;
+	m_sceneTree = std::make_unique<CDynamicAabbTree>();
+	if (!m_sceneTree->Initialize(GameObjCount, 0.1f))
+	{
+		__debugbreak();
+		return false;
+	}
+	m_visibleObjectList.reserve(GameObjCount);
+	m_visibleOccludedList.reserve(GameObjCount);
+	m_occluderCandidateList.reserve(GameObjCount);
+
+	m_occlusionCuller = std::make_unique<COcclusionCuller>();
+	if (!m_occlusionCuller->Initialize())
+	{
+		__debugbreak();
+		return false;
+	}
+
 	for (UINT i = 0; i < GameObjCount; i++)
 	{
 		CGameObject* pGameObj = CreateGameObject(EMeshType::Box);
@@ -41,7 +95,16 @@ bool CGame::Initialize(HWND hWnd, bool bEnableDebugLayer, bool bEnableGBV)
 		}
 	}
 
-	m_renderer->SetCameraPos(0.0f, 0.0f, -10.0f);
+	BuildStaticMeshGroups();
+
+	m_cameraPos = { 0.0f, 0.0f, -10.0f };
+	m_renderer->SetCameraPos(m_cameraPos.x, m_cameraPos.y, m_cameraPos.z);
+	for (RenderSnapshot& snapshot : m_renderSnapshots)
+	{
+		snapshot.CameraPos = m_cameraPos;
+		snapshot.MeshDrawList.reserve(GameObjCount);
+		snapshot.StaticMeshGroupDrawList.reserve(m_staticMeshGroupList.size());
+	}
 
 	// Dynamic texture
 	m_dynamicImageWidth = 512;
@@ -56,6 +119,14 @@ bool CGame::Initialize(HWND hWnd, bool bEnableDebugLayer, bool bEnableGBV)
 		}
 	}
 	m_pDynamicTexHandle = m_renderer->CreateDynamicTexture(m_dynamicImageWidth, m_dynamicImageHeight);
+	for (CDirtyRectList& staleRectList : m_dynamicImageStaleRectLists)
+	{
+		staleRectList.Reset(m_dynamicImageWidth, m_dynamicImageHeight);
+	}
+
+	// 첫 업로드는 이미지 전체
+	m_dynamicImageDirtyRectList.push_back({ 0, 0, static_cast<LONG>(m_dynamicImageWidth), static_cast<LONG>(m_dynamicImageHeight) });
+	m_bDynamicImageDirty = true;
 
 	// Sprite objects
 	m_pSpriteObject0 = m_renderer->CreateSpriteObject(
@@ -68,18 +139,65 @@ bool CGame::Initialize(HWND hWnd, bool bEnableDebugLayer, bool bEnableGBV)
 
 void CGame::Run()
 {
+	PROFILE_SCOPE("Frame");
 	m_frameCount++;
 
+	// WM_SIZE에서 모아 둔 크기 변경을 프레임 경계에서 한 번만 적용 (이전 프레임 기록은 이미 끝남)
+	if (m_renderer->ApplyPendingResize() && m_sceneTree)
+	{
+		// 투영 행렬이 바뀌었으므로 다음 Update를 기다리지 않고 이번에 기록할 스냅샷을 다시 컬링
+		CullSceneObjects();
+		BuildRenderSnapshot(m_renderSnapshots[m_renderSnapshotIndex]);
+	}
+
 	ULONGLONG curTick = GetTickCount64();
-	Update(curTick);
-	Render();
+	if (m_bPipelinedFrame)
+	{
+		// 프레임 N의 커맨드 리스트 기록(워커)과 프레임 N+1의 Update(메인 스레드)를 겹친다
+		std::atomic<UINT> recordJobCounter = 0;
+		RenderSnapshot* pRecordSnapshot = &m_renderSnapshots[m_renderSnapshotIndex];
+		m_workerPool->Submit([this, pRecordSnapshot]() { RecordFrame(*pRecordSnapshot); }, &recordJobCounter);
+
+		bool bUpdated = Update(curTick);
+
+		m_workerPool->Wait(recordJobCounter);
+		m_renderer->Present();
+
+		// 새 스냅샷은 다음 프레임에 기록 (Update가 없었으면 같은 스냅샷을 다시 그린다)
+		if (bUpdated)
+		{
+			m_renderSnapshotIndex = (m_renderSnapshotIndex + 1) % RenderSnapshotCount;
+		}
+	}
+	else
+	{
+		if (Update(curTick))
+		{
+			m_renderSnapshotIndex = (m_renderSnapshotIndex + 1) % RenderSnapshotCount;
+		}
+
+		RecordFrame(m_renderSnapshots[m_renderSnapshotIndex]);
+		m_renderer->Present();
+	}
 
 	if (curTick - m_previousFrameCheckTick > 1000)
 	{
 		m_previousFrameCheckTick = curTick;
 
-		WCHAR wchTxt[64];
-		swprintf_s(wchTxt, L"FPS:%u", m_frameCount);
+		FrameTimeStats frameTimeStats = {};
+		m_renderer->GetFrameTimeStats(&frameTimeStats);
+
+		TextureCacheStats textureCacheStats = {};
+		m_renderer->GetTextureCacheStats(&textureCacheStats);
+
+		MemoryStats memoryStats = {};
+		CMemoryTracker::Get().GetStats(&memoryStats);
+
+		WCHAR wchTxt[192];
+		swprintf_s(wchTxt, L"FPS:%u p50:%.2fms p99:%.2fms InFlight:%u TexHit:%.0f%% TexSaved:%lluKB GpuMem:%.1fMB",
+			m_frameCount, frameTimeStats.P50Ms, frameTimeStats.P99Ms, frameTimeStats.PendingFrameCount,
+			textureCacheStats.HitRate * 100.0f, static_cast<unsigned long long>(textureCacheStats.SavedBytes / 1024),
+			static_cast<double>(memoryStats.Total.CurrentBytes) / (1024.0 * 1024.0));
 		SetWindowText(m_windowHandle, wchTxt);
 
 		m_frameCount = 0;
@@ -94,23 +212,43 @@ bool CGame::Update(ULONGLONG curTick)
 	}
 	m_previousUpdateTick = curTick;
 
-	// Camera movement
-	if (m_camOffsetX != 0.0f || m_camOffsetY != 0.0f || m_camOffsetZ != 0.0f)
-	{
-		m_renderer->MoveCamera(m_camOffsetX, m_camOffsetY, m_camOffsetZ);
-	}
+	PROFILE_SCOPE("Update");
 
-	// Update all game objects (dirty flag check)
-	for (auto& pObj : m_gameObjects)
-	{
-		if (pObj)
-		{
-			pObj->Run();
-		}
-	}
+	// Task graph
+	//   Transform (parallel) -> SceneSync -> Culling -> OcclusionRaster -> OcclusionTest (parallel) -> Snapshot
+	//   Camera -----------------------------> Culling
+	//   DynamicTexture -------------------------------------------------------------------------> Snapshot
+	// 렌더러 상태는 건드리지 않는다. 이전 프레임 기록이 워커에서 동시에 진행 중일 수 있음
+	m_updateTaskGraph.Reset();
+
+	RenderSnapshot* pBuildSnapshot = &m_renderSnapshots[(m_renderSnapshotIndex + 1) % RenderSnapshotCount];
 
-	// Dynamic texture tile animation
-	UpdateDynamicTexture();
+	TaskHandle cameraTask = m_updateTaskGraph.AddTask("Camera", [this]()
+		{
+			m_cameraPos.x += m_camOffsetX;
+			m_cameraPos.y += m_camOffsetY;
+			m_cameraPos.z += m_camOffsetZ;
+		});
+	TaskHandle transformTask = m_updateTaskGraph.AddParallelTask("Transform", static_cast<UINT>(m_gameObjects.size()), GameObjectBatchSize,
+		[this](UINT beginIndex, UINT endIndex) { UpdateGameObjects(beginIndex, endIndex); });
+	TaskHandle sceneSyncTask = m_updateTaskGraph.AddTask("SceneSync", [this]() { SyncSceneProxies(); });
+	TaskHandle cullingTask = m_updateTaskGraph.AddTask("Culling", [this]() { CullSceneObjects(); });
+	TaskHandle occlusionRasterTask = m_updateTaskGraph.AddTask("OcclusionRaster", [this]() { RasterizeOccluders(); });
+	// 보이는 오브젝트 수는 Culling 이후에 정해지므로 전체 수로 나누고 범위 밖 batch는 건너뛴다
+	TaskHandle occlusionTestTask = m_updateTaskGraph.AddParallelTask("OcclusionTest", static_cast<UINT>(m_gameObjects.size()), GameObjectBatchSize,
+		[this](UINT beginIndex, UINT endIndex) { TestOcclusion(beginIndex, endIndex); });
+	TaskHandle dynamicTextureTask = m_updateTaskGraph.AddTask("DynamicTexture", [this]() { UpdateDynamicTexture(); });
+	TaskHandle snapshotTask = m_updateTaskGraph.AddTask("Snapshot", [this, pBuildSnapshot]() { BuildRenderSnapshot(*pBuildSnapshot); });
+
+	m_updateTaskGraph.AddDependency(transformTask, sceneSyncTask);
+	m_updateTaskGraph.AddDependency(sceneSyncTask, cullingTask);
+	m_updateTaskGraph.AddDependency(cameraTask, cullingTask);
+	m_updateTaskGraph.AddDependency(cullingTask, occlusionRasterTask);
+	m_updateTaskGraph.AddDependency(occlusionRasterTask, occlusionTestTask);
+	m_updateTaskGraph.AddDependency(occlusionTestTask, snapshotTask);
+	m_updateTaskGraph.AddDependency(dynamicTextureTask, snapshotTask);
+
+	m_updateTaskGraph.Execute(m_workerPool.get());
 
 	return true;
 }
@@ -140,6 +278,10 @@ void CGame::OnKeyDown(UINT nChar, UINT uiScanCode)
 	case 'D':
 		m_camOffsetX = 0.05f;
 		break;
+	case 'P':
+		// chrome://tracing 또는 Perfetto에서 열기
+		CProfiler::Get().ExportChromeTrace("BengalsProfile.json");
+		break;
 	}
 }
 
@@ -167,19 +309,38 @@ bool CGame::UpdateWindowSize(UINT backBufferWidth, UINT backBufferHeight)
 	bool bResult = false;
 	if (m_renderer)
 	{
+		// 요청만 기록된다. 실제 적용은 다음 Run()의 시작
 		bResult = m_renderer->UpdateWindowSize(backBufferWidth, backBufferHeight);
 	}
 	return bResult;
 }
 
-void CGame::Render()
+void CGame::RecordFrame(RenderSnapshot& snapshot)
 {
+	PROFILE_SCOPE("RecordFrame");
+
+	// 스냅샷만 읽는다. 게임 상태는 메인 스레드의 Update가 동시에 수정 중일 수 있음
+	m_renderer->SetCameraPos(snapshot.CameraPos.x, snapshot.CameraPos.y, snapshot.CameraPos.z);
+
+	if (snapshot.bDynamicImageDirty)
+	{
+		//다이나믹 텍스쳐 데이터 업로드 버퍼에 반영
+		m_renderer->UpdateTextureWithImage(m_pDynamicTexHandle, snapshot.DynamicImage.data(), m_dynamicImageWidth, m_dynamicImageHeight,
+			snapshot.DynamicImageDirtyRectList.data(), static_cast<UINT>(snapshot.DynamicImageDirtyRectList.size()));
+		snapshot.DynamicImageDirtyRectList.clear();
+		snapshot.bDynamicImageDirty = false;
+	}
+
 	m_renderer->BeginRender();
 
-	// Render all game objects
-	for (auto& pObj : m_gameObjects)
+	for (void* pStaticMeshGroup : snapshot.StaticMeshGroupDrawList)
 	{
-		pObj->Render();
+		m_renderer->RenderStaticMeshGroup(pStaticMeshGroup);
+	}
+
+	for (const MeshDrawCommand& drawCommand : snapshot.MeshDrawList)
+	{
+		m_renderer->RenderMeshObject(drawCommand.pMeshObj, drawCommand.WorldMatrix);
 	}
 
 	// Sprite
@@ -189,7 +350,223 @@ void CGame::Render()
 	m_renderer->RenderSpriteWithTex(m_pSpriteObjCommon, 0, 0, 100, 100, nullptr, 0.f, m_pDynamicTexHandle);
 
 	m_renderer->EndRender();
-	m_renderer->Present();
+}
+
+void CGame::UpdateGameObjects(UINT beginIndex, UINT endIndex)
+{
+	for (UINT i = beginIndex; i < endIndex; i++)
+	{
+		if (m_gameObjects[i])
+		{
+			m_gameObjects[i]->Run();
+		}
+	}
+}
+
+void CGame::SyncSceneProxies()
+{
+	// CDynamicAabbTree는 쓰기에 대해 thread-safe하지 않으므로 단일 task에서 처리
+	for (auto& pObj : m_gameObjects)
+	{
+		if (pObj)
+		{
+			pObj->SyncSceneProxy();
+		}
+	}
+}
+
+void CGame::CullSceneObjects()
+{
+	// Frustum culling through the scene BVH
+	XMMATRIX viewMatrix = {};
+	XMMATRIX projectionMatrix = {};
+	m_renderer->GetViewProjMatrixAt(m_cameraPos.x, m_cameraPos.y, m_cameraPos.z, &viewMatrix, &projectionMatrix);
+
+	BoundingFrustum frustum = {};
+	BoundingFrustum::CreateFromMatrix(frustum, projectionMatrix);
+	frustum.Transform(frustum, XMMatrixInverse(nullptr, viewMatrix));
+
+	m_visibleObjectList.clear();
+	m_sceneTree->QueryFrustum(frustum, m_visibleObjectList);
+
+	// 오클루전 테스트를 거치지 않은 목록(크기 변경 직후)은 모두 보이는 것으로 둔다
+	m_visibleOccludedList.assign(m_visibleObjectList.size(), 0);
+	XMStoreFloat4x4(&m_cullViewProjMatrix, XMMatrixMultiply(viewMatrix, projectionMatrix));
+}
+
+void CGame::RasterizeOccluders()
+{
+	// 컬링 버퍼에서 가장 크게 보이는 오브젝트 몇 개만 occluder로 그린다
+	m_occlusionCuller->BeginFrame(m_cullViewProjMatrix);
+
+	m_occluderCandidateList.clear();
+	for (void* pVisibleObj : m_visibleObjectList)
+	{
+		const CGameObject* pGameObj = static_cast<const CGameObject*>(pVisibleObj);
+		const float screenArea = m_occlusionCuller->GetScreenArea(pGameObj->GetWorldBounds());
+		if (screenArea >= MinOccluderScreenArea)
+		{
+			m_occluderCandidateList.push_back({ screenArea, pGameObj });
+		}
+	}
+
+	const size_t occluderCount = (std::min)(m_occluderCandidateList.size(), static_cast<size_t>(MaxOccluderCount));
+	std::partial_sort(m_occluderCandidateList.begin(), m_occluderCandidateList.begin() + occluderCount, m_occluderCandidateList.end(),
+		[](const std::pair<float, const CGameObject*>& a, const std::pair<float, const CGameObject*>& b) { return a.first > b.first; });
+
+	for (size_t i = 0; i < occluderCount; i++)
+	{
+		const CGameObject* pGameObj = m_occluderCandidateList[i].second;
+		XMFLOAT4X4 worldMatrix = {};
+		XMStoreFloat4x4(&worldMatrix, pGameObj->GetWorldMatrix());
+		m_occlusionCuller->AddOccluder(pGameObj->GetLocalBounds(), worldMatrix);
+	}
+
+	m_occlusionCuller->EndOccluders();
+}
+
+void CGame::TestOcclusion(UINT beginIndex, UINT endIndex)
+{
+	endIndex = (std::min)(endIndex, static_cast<UINT>(m_visibleObjectList.size()));
+	for (UINT i = beginIndex; i < endIndex; i++)
+	{
+		const CGameObject* pGameObj = static_cast<const CGameObject*>(m_visibleObjectList[i]);
+		m_visibleOccludedList[i] = m_occlusionCuller->IsOccluded(pGameObj->GetWorldBounds()) ? 1 : 0;
+	}
+}
+
+void CGame::BuildRenderSnapshot(RenderSnapshot& snapshot)
+{
+	snapshot.CameraPos = m_cameraPos;
+
+	snapshot.MeshDrawList.clear();
+	snapshot.StaticMeshGroupDrawList.clear();
+	m_staticMeshGroupVisibleList.assign(m_staticMeshGroupList.size(), 0);
+	for (size_t i = 0; i < m_visibleObjectList.size(); i++)
+	{
+		if (m_visibleOccludedList[i])
+		{
+			continue;
+		}
+
+		const CGameObject* pGameObj = static_cast<const CGameObject*>(m_visibleObjectList[i]);
+		const UINT groupIndex = pGameObj->GetStaticMeshGroupIndex();
+		if (groupIndex != UINT_MAX)
+		{
+			m_staticMeshGroupVisibleList[groupIndex] = 1;
+			continue;
+		}
+		pGameObj->AppendDrawCommand(snapshot.MeshDrawList);
+	}
+
+	for (size_t i = 0; i < m_staticMeshGroupList.size(); i++)
+	{
+		if (m_staticMeshGroupVisibleList[i])
+		{
+			snapshot.StaticMeshGroupDrawList.push_back(m_staticMeshGroupList[i]);
+		}
+	}
+
+	// 아직 기록되지 않은 스냅샷을 다시 만드는 경우(크기 변경 직후)에도 업로드 요청은 유지
+	if (m_bDynamicImageDirty)
+	{
+		const size_t snapshotIndex = static_cast<size_t>(&snapshot - m_renderSnapshots.data());
+		CDirtyRectList& staleRectList = m_dynamicImageStaleRectLists[snapshotIndex];
+		const size_t imageSize = static_cast<size_t>(m_dynamicImageWidth) * m_dynamicImageHeight * 4;
+		if (snapshot.DynamicImage.size() != imageSize)
+		{
+			// 이 스냅샷의 첫 이미지: 전체 복사
+			snapshot.DynamicImage.assign(m_pDynamicImage, m_pDynamicImage + imageSize);
+		}
+		else
+		{
+			// 다른 스냅샷에만 복사된 영역과 이번에 바뀐 영역만 복사
+			for (UINT i = 0; i < staleRectList.GetRectCount(); i++)
+			{
+				CopyDynamicImageRect(snapshot.DynamicImage, staleRectList.GetRects()[i]);
+			}
+			for (const RECT& rect : m_dynamicImageDirtyRectList)
+			{
+				CopyDynamicImageRect(snapshot.DynamicImage, rect);
+			}
+		}
+		staleRectList.Clear();
+		for (size_t otherIndex = 0; otherIndex < m_dynamicImageStaleRectLists.size(); otherIndex++)
+		{
+			if (otherIndex == snapshotIndex)
+			{
+				continue;
+			}
+			for (const RECT& rect : m_dynamicImageDirtyRectList)
+			{
+				m_dynamicImageStaleRectLists[otherIndex].AddRect(rect);
+			}
+		}
+
+		// 기록되지 않은 이전 요청의 영역에 이어 붙인다
+		snapshot.DynamicImageDirtyRectList.insert(snapshot.DynamicImageDirtyRectList.end(), m_dynamicImageDirtyRectList.begin(), m_dynamicImageDirtyRectList.end());
+		snapshot.bDynamicImageDirty = true;
+		m_dynamicImageDirtyRectList.clear();
+		m_bDynamicImageDirty = false;
+	}
+}
+
+void CGame::CopyDynamicImageRect(std::vector<BYTE>& dstImage, const RECT& rect) const
+{
+	const size_t rowPitch = static_cast<size_t>(m_dynamicImageWidth) * 4;
+	const size_t rowSize = static_cast<size_t>(rect.right - rect.left) * 4;
+	for (LONG y = rect.top; y < rect.bottom; y++)
+	{
+		const size_t offset = static_cast<size_t>(y) * rowPitch + static_cast<size_t>(rect.left) * 4;
+		memcpy(dstImage.data() + offset, m_pDynamicImage + offset, rowSize);
+	}
+}
+
+void CGame::BuildStaticMeshGroups()
+{
+	// 초기 배치 후 움직이지 않는 오브젝트를 셀마다 하나의 그룹으로 묶는다.
+	// 그룹의 오브젝트 중 하나라도 보이면 그룹 전체를 번들 하나로 그린다
+	std::map<std::pair<int, int>, std::vector<CGameObject*>> cellObjectMap;
+	for (auto& pObj : m_gameObjects)
+	{
+		if (!pObj || !pObj->GetMeshObject())
+		{
+			continue;
+		}
+
+		// 첫 Update 전이므로 월드 행렬 / BVH를 여기서 갱신
+		pObj->Run();
+		pObj->SyncSceneProxy();
+
+		const Aabb& bounds = pObj->GetWorldBounds();
+		const float centerX = (bounds.Min.x + bounds.Max.x) * 0.5f;
+		const float centerZ = (bounds.Min.z + bounds.Max.z) * 0.5f;
+		const int cellX = static_cast<int>(floorf(centerX / StaticMeshGroupCellSize));
+		const int cellZ = static_cast<int>(floorf(centerZ / StaticMeshGroupCellSize));
+		cellObjectMap[{ cellX, cellZ }].push_back(pObj.get());
+	}
+
+	for (auto& cell : cellObjectMap)
+	{
+		const std::vector<CGameObject*>& cellObjectList = cell.second;
+		void* pStaticMeshGroup = m_renderer->CreateStaticMeshGroup(static_cast<UINT>(cellObjectList.size()));
+		if (!pStaticMeshGroup)
+		{
+			continue;
+		}
+
+		const UINT groupIndex = static_cast<UINT>(m_staticMeshGroupList.size());
+		m_staticMeshGroupList.push_back(pStaticMeshGroup);
+		for (CGameObject* pGameObj : cellObjectList)
+		{
+			if (m_renderer->AddStaticMeshInstance(pStaticMeshGroup, pGameObj->GetMeshObject(), pGameObj->GetWorldMatrix()) != UINT_MAX)
+			{
+				pGameObj->SetStaticMeshGroupIndex(groupIndex);
+			}
+		}
+	}
+
+	m_staticMeshGroupVisibleList.assign(m_staticMeshGroupList.size(), 0);
 }
 
 CGameObject* CGame::CreateGameObject(EMeshType meshType)
@@ -261,14 +638,31 @@ void CGame::UpdateDynamicTexture()
 		m_tileColorB = 0;
 	}
 
-	//다이나믹 텍스쳐 데이터 업로드 버퍼에 반영
-	m_renderer->UpdateTextureWithImage(m_pDynamicTexHandle, m_pDynamicImage, m_dynamicImageWidth, m_dynamicImageHeight);
+	// 업로드는 이 이미지를 복사한 스냅샷을 기록하는 프레임에서 처리
+	m_dynamicImageDirtyRectList.push_back({ static_cast<LONG>(startX), static_cast<LONG>(startY), static_cast<LONG>(startX + TileWidth), static_cast<LONG>(startY + TileHeight) });
+	m_bDynamicImageDirty = true;
 }
 
 void CGame::Cleanup()
 {
+	// 그룹의 번들이 메시를 참조하므로 메시(게임 오브젝트)보다 먼저 삭제
+	if (m_renderer)
+	{
+		for (void* pStaticMeshGroup : m_staticMeshGroupList)
+		{
+			m_renderer->DeleteStaticMeshGroup(pStaticMeshGroup);
+		}
+	}
+	m_staticMeshGroupList.clear();
+	m_staticMeshGroupVisibleList.clear();
+
 	// Game objects must be destroyed before the renderer
 	m_gameObjects.clear();
+	m_visibleObjectList.clear();
+	m_visibleOccludedList.clear();
+	m_occluderCandidateList.clear();
+	m_occlusionCuller = nullptr;
+	m_sceneTree = nullptr;
 
 	if (m_pDynamicImage)
 	{
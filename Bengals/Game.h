@@ -1,9 +1,16 @@
 #pragma once
 
+#include <array>
 #include <vector>
+#include "RenderSnapshot.h"
+#include "Renderer/RenderHelper/DirtyRectList.h"
+#include "Task/TaskGraph.h"
 
 class CD3D12Renderer;
+class CWorkerPool;
 class CGameObject;
+class CDynamicAabbTree;
+class COcclusionCuller;
 enum class EMeshType : UINT8;
 
 class CGame
@@ -18,24 +25,65 @@ public:
 	void	OnKeyDown(UINT nChar, UINT uiScanCode);
 	void	OnKeyUp(UINT nChar, UINT uiScanCode);
 	bool	UpdateWindowSize(UINT backBufferWidth, UINT backBufferHeight);
+	void	SetPipelinedFrame(bool bEnable) { m_bPipelinedFrame = bEnable; }
 
 	CD3D12Renderer* GetRenderer() const { return m_renderer.get(); }
+	CDynamicAabbTree* GetSceneTree() const { return m_sceneTree.get(); }
 
 private:
-	void	Render();
+	void	RecordFrame(RenderSnapshot& snapshot);
+	void	UpdateGameObjects(UINT beginIndex, UINT endIndex);
+	void	SyncSceneProxies();
+	void	CullSceneObjects();
+	void	RasterizeOccluders();
+	void	TestOcclusion(UINT beginIndex, UINT endIndex);
+	void	BuildRenderSnapshot(RenderSnapshot& snapshot);
+	void	CopyDynamicImageRect(std::vector<BYTE>& dstImage, const RECT& rect) const;
+	void	BuildStaticMeshGroups();
 	CGameObject* CreateGameObject(EMeshType meshType);
 	void	DeleteGameObject(CGameObject* pGameObj);
 	void	UpdateDynamicTexture();
 	void	Cleanup();
 
 private:
+	static constexpr UINT GameObjectBatchSize = 64;
+	static constexpr UINT RenderSnapshotCount = 2;
+	static constexpr float StaticMeshGroupCellSize = 5.0f;
+	static constexpr UINT MaxOccluderCount = 16;
+	static constexpr float MinOccluderScreenArea = 64.0f;	// 컬링 버퍼 픽셀 단위
+	static constexpr UINT64 GpuMemoryBudgetBytes = 256ull * 1024 * 1024;	// 전체 GPU 할당 (CMemoryTracker)
+
+	// 렌더러가 워커 풀을 공유하므로 m_renderer보다 먼저 선언(나중에 파괴)
+	std::unique_ptr<CWorkerPool> m_workerPool = nullptr;
+	CTaskGraph m_updateTaskGraph;
 	std::unique_ptr<CD3D12Renderer> m_renderer = nullptr;
 	HWND m_windowHandle = nullptr;
 
 	// Game Objects
 	std::vector<std::unique_ptr<CGameObject>> m_gameObjects;
 
+	// Scene BVH (frustum culling ahead of render queue submission)
+	std::unique_ptr<CDynamicAabbTree> m_sceneTree = nullptr;
+	std::vector<void*> m_visibleObjectList;
+
+	// Software occlusion culling (frustum 컬링 결과 중 가려진 오브젝트를 제외)
+	std::unique_ptr<COcclusionCuller> m_occlusionCuller = nullptr;
+	XMFLOAT4X4 m_cullViewProjMatrix = {};
+	std::vector<std::pair<float, const CGameObject*>> m_occluderCandidateList;
+	std::vector<UINT8> m_visibleOccludedList;	// m_visibleObjectList와 같은 순서
+
+	// Static mesh groups (XZ 평면의 셀 단위로 묶어 그룹 단위로 컬링)
+	std::vector<void*> m_staticMeshGroupList;
+	std::vector<UINT8> m_staticMeshGroupVisibleList;
+
+	// Render snapshot (double-buffered)
+	// Update는 m_renderSnapshotIndex가 아닌 쪽에 기록하고, 렌더는 m_renderSnapshotIndex 쪽만 읽는다
+	std::array<RenderSnapshot, RenderSnapshotCount> m_renderSnapshots = {};
+	UINT m_renderSnapshotIndex = 0;
+	bool m_bPipelinedFrame = true;
+
 	// Camera input
+	XMFLOAT3 m_cameraPos = {};
 	bool m_bShiftKeyDown = false;
 	float m_camOffsetX = 0.0f;
 	float m_camOffsetY = 0.0f;
@@ -54,6 +102,10 @@ private:
 	UINT m_tileColorR = 0;
 	UINT m_tileColorG = 0;
 	UINT m_tileColorB = 0;
+	bool m_bDynamicImageDirty = false;
+	std::vector<RECT> m_dynamicImageDirtyRectList;
+	// 스냅샷별로, 다른 스냅샷을 만드는 동안 바뀌어 그 스냅샷의 DynamicImage에 아직 복사하지 않은 영역
+	std::array<CDirtyRectList, RenderSnapshotCount> m_dynamicImageStaleRectLists = {};
 
 	// Timing / FPS
 	ULONGLONG m_previousFrameCheckTick = 0;
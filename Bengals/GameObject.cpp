@@ -28,13 +28,24 @@ bool CGameObject::Initialize(CGame* pGame, EMeshType meshType)
 	{
 	case EMeshType::Box:
 		m_pMeshObj = CreateBoxMesh();
+		m_localBounds.Min = { -0.25f, -0.25f, -0.25f };
+		m_localBounds.Max = { 0.25f, 0.25f, 0.25f };
 		break;
 	case EMeshType::Quad:
 		m_pMeshObj = CreateQuadMesh();
+		m_localBounds.Min = { -0.25f, -0.25f, 0.0f };
+		m_localBounds.Max = { 0.25f, 0.25f, 0.0f };
 		break;
 	}
 
-	return m_pMeshObj != nullptr;
+	if (!m_pMeshObj)
+	{
+		return false;
+	}
+
+	m_worldBounds = CDynamicAabbTree::TransformAabb(m_localBounds, m_worldMatrix);
+	m_proxyId = m_pGame->GetSceneTree()->CreateProxy(m_worldBounds, this);
+	return true;
 }
 
 void CGameObject::SetPosition(float x, float y, float z)
@@ -68,15 +79,31 @@ void CGameObject::Run()
 	if (m_bUpdateTransform)
 	{
 		UpdateTransform();
+		UpdateBounds();
 		m_bUpdateTransform = false;
 	}
 }
 
-void CGameObject::Render()
+// Run()은 워커 스레드에서 병렬로 호출되므로 공유 BVH 갱신은 여기서 따로 처리
+void CGameObject::SyncSceneProxy()
+{
+	if (!m_bBoundsDirty)
+	{
+		return;
+	}
+
+	if (m_proxyId != CDynamicAabbTree::NullNode)
+	{
+		m_pGame->GetSceneTree()->MoveProxy(m_proxyId, m_worldBounds);
+	}
+	m_bBoundsDirty = false;
+}
+
+void CGameObject::AppendDrawCommand(std::vector<MeshDrawCommand>& outDrawList) const
 {
 	if (m_pMeshObj)
 	{
-		m_pRenderer->RenderMeshObject(m_pMeshObj, m_worldMatrix);
+		outDrawList.push_back(MeshDrawCommand{ m_pMeshObj, m_worldMatrix });
 	}
 }
 
@@ -133,6 +160,19 @@ void* CGameObject::CreateBoxMesh()
 		{ 0.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f }
 	};
 
+	// 면마다 꼭짓점 4개의 색을 한 번씩 뽑아 두 삼각형이 공유하는 꼭짓점은 같은 정점이 되게 한다 (weld 대상)
+	static constexpr UINT FaceCornerIndexList[6] = { 0, 1, 2, 0, 2, 3 };
+	std::mt19937 rng(std::random_device{}());
+	std::uniform_real_distribution<float> blueDist(0.0f, 1.0f);
+	float faceCornerBlueList[6][4] = {};
+	for (auto& cornerBlueList : faceCornerBlueList)
+	{
+		for (float& blue : cornerBlueList)
+		{
+			blue = blueDist(rng);
+		}
+	}
+
 	VertexPos3Color4Tex2 vertexList[_countof(worldPosIndexList)] = {};
 	WORD indexList[_countof(worldPosIndexList)] = {};
 	for (UINT i = 0; i < _countof(worldPosIndexList); i++)
@@ -140,10 +180,7 @@ void* CGameObject::CreateBoxMesh()
 		const WORD worldPosIndex = worldPosIndexList[i];
 		vertexList[i].Position = worldPosList[worldPosIndex];
 
-		std::mt19937 rng(std::random_device{}());
-		std::uniform_real_distribution<float> blueDist(0.0f, 1.0f);
-
-		float blue = blueDist(rng);
+		float blue = faceCornerBlueList[i / 6][FaceCornerIndexList[i % 6]];
 
 		vertexList[i].Color = { 1.0f, 1.0f, blue, 1.0f };
 		vertexList[i].TexCoord = texCoordList[i];
@@ -171,7 +208,8 @@ void* CGameObject::CreateBoxMesh()
 		vertexList,
 		_countof(vertexList),
 		sizeof(VertexPos3Color4Tex2),
-		6);
+		6,
+		MeshOptimizeDefault | MeshOptimizeQuantize);
 
 	if (bResult)
 	{
@@ -185,13 +223,17 @@ void* CGameObject::CreateBoxMesh()
 		}
 	}
 
+	if (bResult)
+	{
+		bResult = m_pRenderer->EndCreateMesh(pMeshObject);
+	}
+
 	if (!bResult)
 	{
 		m_pRenderer->DeleteBasicMeshObject(pMeshObject);
 		return nullptr;
 	}
 
-	m_pRenderer->EndCreateMesh(pMeshObject);
 	return pMeshObject;
 }
 
@@ -222,20 +264,25 @@ void* CGameObject::CreateQuadMesh()
 		vertexList,
 		_countof(vertexList),
 		sizeof(VertexPos3Color4Tex2),
-		1);
+		1,
+		MeshOptimizeDefault | MeshOptimizeQuantize);
 
 	if (bResult)
 	{
 		bResult = m_pRenderer->InsertTriGroup(pMeshObject, indexList, 2, L"../Resources/Image/tex_06.dds");
 	}
 
+	if (bResult)
+	{
+		bResult = m_pRenderer->EndCreateMesh(pMeshObject);
+	}
+
 	if (!bResult)
 	{
 		m_pRenderer->DeleteBasicMeshObject(pMeshObject);
 		return nullptr;
 	}
 
-	m_pRenderer->EndCreateMesh(pMeshObject);
 	return pMeshObject;
 }
 
@@ -250,8 +297,20 @@ void CGameObject::UpdateTransform()
 	m_worldMatrix = XMMatrixMultiply(m_worldMatrix, m_translationMatrix);
 }
 
+void CGameObject::UpdateBounds()
+{
+	m_worldBounds = CDynamicAabbTree::TransformAabb(m_localBounds, m_worldMatrix);
+	m_bBoundsDirty = true;
+}
+
 void CGameObject::Cleanup()
 {
+	if (m_proxyId != CDynamicAabbTree::NullNode)
+	{
+		m_pGame->GetSceneTree()->DestroyProxy(m_proxyId);
+		m_proxyId = CDynamicAabbTree::NullNode;
+	}
+
 	if (m_pMeshObj)
 	{
 		m_pRenderer->DeleteBasicMeshObject(m_pMeshObj);
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "Scene/DynamicAabbTree.h"
+#include "RenderSnapshot.h"
+
 class CGame;
 class CD3D12Renderer;
 
@@ -22,13 +25,22 @@ public:
 	void	SetRotationY(float rotY);
 	float	GetRotationX() const { return m_rotX; }
 	float	GetRotationY() const { return m_rotY; }
+	const Aabb& GetLocalBounds() const { return m_localBounds; }
+	const Aabb& GetWorldBounds() const { return m_worldBounds; }
+	const XMMATRIX& GetWorldMatrix() const { return m_worldMatrix; }
+	void*	GetMeshObject() const { return m_pMeshObj; }
+	// 정적 메시 그룹에 들어간 오브젝트는 움직이지 않는다 (그룹 번들로 그려짐)
+	void	SetStaticMeshGroupIndex(UINT groupIndex) { m_staticMeshGroupIndex = groupIndex; }
+	UINT	GetStaticMeshGroupIndex() const { return m_staticMeshGroupIndex; }
 	void	Run();
-	void	Render();
+	void	SyncSceneProxy();
+	void	AppendDrawCommand(std::vector<MeshDrawCommand>& outDrawList) const;
 
 private:
 	void*	CreateBoxMesh();
 	void*	CreateQuadMesh();
 	void	UpdateTransform();
+	void	UpdateBounds();
 	void	Cleanup();
 
 private:
@@ -46,4 +58,11 @@ private:
 	XMMATRIX m_translationMatrix = {};
 	XMMATRIX m_worldMatrix = {};
 	bool m_bUpdateTransform = false;
+	UINT m_staticMeshGroupIndex = UINT_MAX;
+
+	// Scene BVH
+	Aabb m_localBounds = {};
+	Aabb m_worldBounds = {};
+	int m_proxyId = CDynamicAabbTree::NullNode;
+	bool m_bBoundsDirty = false;
 };
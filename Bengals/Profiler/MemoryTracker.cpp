@@ -0,0 +1,219 @@
+#include "pch.h"
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include "MemoryTracker.h"
+
+namespace
+{
+	double ToKB(UINT64 sizeInBytes)
+	{
+		return static_cast<double>(sizeInBytes) / 1024.0;
+	}
+}
+
+const char* GetMemoryCategoryName(EMemoryCategory category)
+{
+	switch (category)
+	{
+	case EMemoryCategory::Texture:
+		return "Texture";
+	case EMemoryCategory::RenderTarget:
+		return "RenderTarget";
+	case EMemoryCategory::Geometry:
+		return "Geometry";
+	case EMemoryCategory::Upload:
+		return "Upload";
+	case EMemoryCategory::Constant:
+		return "Constant";
+	case EMemoryCategory::Descriptor:
+		return "Descriptor";
+	case EMemoryCategory::Readback:
+		return "Readback";
+	default:
+		return "Total";
+	}
+}
+
+CMemoryTracker& CMemoryTracker::Get()
+{
+	static CMemoryTracker s_memoryTracker;
+	return s_memoryTracker;
+}
+
+void CMemoryTracker::RecordAllocation(EMemoryCategory category, UINT64 sizeInBytes)
+{
+	if (category >= EMemoryCategory::Count)
+	{
+		__debugbreak();
+		return;
+	}
+
+	AddAllocation(&m_counterList[static_cast<size_t>(category)], sizeInBytes);
+	AddAllocation(&m_counterList[CategoryCount], sizeInBytes);
+}
+
+void CMemoryTracker::RecordFree(EMemoryCategory category, UINT64 sizeInBytes)
+{
+	if (category >= EMemoryCategory::Count)
+	{
+		__debugbreak();
+		return;
+	}
+
+	AddFree(&m_counterList[static_cast<size_t>(category)], sizeInBytes);
+	AddFree(&m_counterList[CategoryCount], sizeInBytes);
+}
+
+void CMemoryTracker::AddAllocation(CategoryCounter* pCounter, UINT64 sizeInBytes)
+{
+	const UINT64 currentBytes = pCounter->CurrentBytes.fetch_add(sizeInBytes, std::memory_order_relaxed) + sizeInBytes;
+	pCounter->AllocationCount.fetch_add(1, std::memory_order_relaxed);
+	pCounter->PendingAllocatedBytes.fetch_add(sizeInBytes, std::memory_order_relaxed);
+
+	UINT64 peakBytes = pCounter->PeakBytes.load(std::memory_order_relaxed);
+	while (currentBytes > peakBytes && !pCounter->PeakBytes.compare_exchange_weak(peakBytes, currentBytes, std::memory_order_relaxed))
+	{
+	}
+}
+
+void CMemoryTracker::AddFree(CategoryCounter* pCounter, UINT64 sizeInBytes)
+{
+	pCounter->CurrentBytes.fetch_sub(sizeInBytes, std::memory_order_relaxed);
+	pCounter->AllocationCount.fetch_sub(1, std::memory_order_relaxed);
+	pCounter->PendingFreedBytes.fetch_add(sizeInBytes, std::memory_order_relaxed);
+}
+
+void CMemoryTracker::EndFrame()
+{
+	std::vector<MemoryBudgetEvent> eventList;
+	for (UINT i = 0; i <= CategoryCount; i++)
+	{
+		CategoryCounter& counter = m_counterList[i];
+		counter.FrameAllocatedBytes.store(counter.PendingAllocatedBytes.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+		counter.FrameFreedBytes.store(counter.PendingFreedBytes.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+
+		// 경계를 넘을 때만 알린다 (매 프레임 반복하지 않음)
+		const UINT64 budgetBytes = counter.BudgetBytes.load(std::memory_order_relaxed);
+		const UINT64 currentBytes = counter.CurrentBytes.load(std::memory_order_relaxed);
+		const bool bOverBudget = (budgetBytes > 0 && currentBytes > budgetBytes);
+		if (bOverBudget != counter.bOverBudget)
+		{
+			counter.bOverBudget = bOverBudget;
+
+			MemoryBudgetEvent budgetEvent = {};
+			budgetEvent.Category = static_cast<EMemoryCategory>(i);
+			budgetEvent.CurrentBytes = currentBytes;
+			budgetEvent.BudgetBytes = budgetBytes;
+			budgetEvent.bOverBudget = bOverBudget;
+			eventList.push_back(budgetEvent);
+		}
+	}
+	m_frameIndex.fetch_add(1, std::memory_order_relaxed);
+
+	if (eventList.empty())
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_callbackMutex);
+	if (m_budgetCallback)
+	{
+		for (const MemoryBudgetEvent& budgetEvent : eventList)
+		{
+			m_budgetCallback(budgetEvent);
+		}
+	}
+}
+
+void CMemoryTracker::SetBudget(EMemoryCategory category, UINT64 budgetBytes)
+{
+	if (category > EMemoryCategory::Count)
+	{
+		__debugbreak();
+		return;
+	}
+	m_counterList[static_cast<size_t>(category)].BudgetBytes.store(budgetBytes, std::memory_order_relaxed);
+}
+
+void CMemoryTracker::SetBudgetCallback(BudgetCallback callback)
+{
+	std::lock_guard<std::mutex> lock(m_callbackMutex);
+	m_budgetCallback = std::move(callback);
+}
+
+void CMemoryTracker::ResetPeaks()
+{
+	for (CategoryCounter& counter : m_counterList)
+	{
+		counter.PeakBytes.store(counter.CurrentBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+}
+
+void CMemoryTracker::ReadCounter(const CategoryCounter& counter, MemoryCategoryStats* pOutStats)
+{
+	pOutStats->CurrentBytes = counter.CurrentBytes.load(std::memory_order_relaxed);
+	pOutStats->PeakBytes = counter.PeakBytes.load(std::memory_order_relaxed);
+	pOutStats->AllocationCount = counter.AllocationCount.load(std::memory_order_relaxed);
+	pOutStats->FrameAllocatedBytes = counter.FrameAllocatedBytes.load(std::memory_order_relaxed);
+	pOutStats->FrameFreedBytes = counter.FrameFreedBytes.load(std::memory_order_relaxed);
+	pOutStats->BudgetBytes = counter.BudgetBytes.load(std::memory_order_relaxed);
+}
+
+void CMemoryTracker::GetStats(MemoryStats* pOutStats) const
+{
+	for (UINT i = 0; i < CategoryCount; i++)
+	{
+		ReadCounter(m_counterList[i], &pOutStats->CategoryList[i]);
+	}
+	ReadCounter(m_counterList[CategoryCount], &pOutStats->Total);
+	pOutStats->FrameIndex = m_frameIndex.load(std::memory_order_relaxed);
+}
+
+void CMemoryTracker::WriteReport(std::string& outText) const
+{
+	MemoryStats stats = {};
+	GetStats(&stats);
+
+	char line[256];
+	snprintf(line, sizeof(line), "memory report (frame %llu)\n%-14s %12s %12s %8s %12s %12s %12s\n",
+		static_cast<unsigned long long>(stats.FrameIndex), "category", "current KB", "peak KB", "count", "frame +KB", "frame -KB", "budget KB");
+	outText += line;
+
+	for (UINT i = 0; i <= CategoryCount; i++)
+	{
+		const MemoryCategoryStats& categoryStats = (i < CategoryCount) ? stats.CategoryList[i] : stats.Total;
+		const bool bOverBudget = (categoryStats.BudgetBytes > 0 && categoryStats.CurrentBytes > categoryStats.BudgetBytes);
+
+		char budgetText[32] = "-";
+		if (categoryStats.BudgetBytes > 0)
+		{
+			snprintf(budgetText, sizeof(budgetText), "%.1f", ToKB(categoryStats.BudgetBytes));
+		}
+
+		snprintf(line, sizeof(line), "%-14s %12.1f %12.1f %8llu %12.1f %12.1f %12s%s\n",
+			GetMemoryCategoryName(static_cast<EMemoryCategory>(i)),
+			ToKB(categoryStats.CurrentBytes),
+			ToKB(categoryStats.PeakBytes),
+			static_cast<unsigned long long>(categoryStats.AllocationCount),
+			ToKB(categoryStats.FrameAllocatedBytes),
+			ToKB(categoryStats.FrameFreedBytes),
+			budgetText,
+			bOverBudget ? "  OVER" : "");
+		outText += line;
+	}
+}
+
+bool CMemoryTracker::ExportReport(const char* filePath) const
+{
+	std::string text;
+	WriteReport(text);
+
+	std::ofstream file(filePath, std::ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+	file.write(text.data(), static_cast<std::streamsize>(text.size()));
+	return file.good();
+}
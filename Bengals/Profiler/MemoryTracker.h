@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+
+enum class EMemoryCategory : UINT8
+{
+	Texture,
+	RenderTarget,
+	Geometry,		// 정점 / 인덱스 / 인스턴스 버퍼
+	Upload,			// UPLOAD 힙 (일시적인 staging 포함)
+	Constant,
+	Descriptor,
+	Readback,
+	Count			// SetBudget / MemoryBudgetEvent에서는 전체 합계
+};
+
+const char* GetMemoryCategoryName(EMemoryCategory category);
+
+struct MemoryCategoryStats
+{
+	UINT64 CurrentBytes = 0;
+	UINT64 PeakBytes = 0;				// ResetPeaks 이후 최대
+	UINT64 AllocationCount = 0;			// 현재 살아 있는 할당 수
+	UINT64 FrameAllocatedBytes = 0;		// 마지막으로 끝난 프레임에 할당한 크기
+	UINT64 FrameFreedBytes = 0;			// 마지막으로 끝난 프레임에 해제한 크기
+	UINT64 BudgetBytes = 0;				// 0 = 제한 없음
+};
+
+struct MemoryStats
+{
+	std::array<MemoryCategoryStats, static_cast<size_t>(EMemoryCategory::Count)> CategoryList = {};
+	MemoryCategoryStats Total = {};
+	UINT64 FrameIndex = 0;
+};
+
+struct MemoryBudgetEvent
+{
+	EMemoryCategory Category = EMemoryCategory::Count;		// Count = 전체
+	UINT64 CurrentBytes = 0;
+	UINT64 BudgetBytes = 0;
+	bool bOverBudget = false;		// false = 다시 budget 안으로 돌아옴
+};
+
+/**
+ * Byte accounting for GPU-side allocations, tagged by category.
+ *
+ * Record calls are a handful of relaxed atomic adds, so the tracker stays on in release
+ * builds and can be called from any thread (deferred releases, worker-pool uploads).
+ * EndFrame() closes the per-frame churn counters and checks budgets; a category that
+ * crosses its budget in either direction fires the budget callback once, on the thread
+ * calling EndFrame(). The renderer reports into Get(); separate instances are only for
+ * tests. No D3D dependency.
+ */
+class CMemoryTracker
+{
+public:
+	using BudgetCallback = std::function<void(const MemoryBudgetEvent& budgetEvent)>;
+
+	static constexpr UINT CategoryCount = static_cast<UINT>(EMemoryCategory::Count);
+
+public:
+	static CMemoryTracker& Get();
+
+	CMemoryTracker() = default;
+	~CMemoryTracker() = default;
+
+	CMemoryTracker(const CMemoryTracker&) = delete;
+	CMemoryTracker& operator=(const CMemoryTracker&) = delete;
+
+	void RecordAllocation(EMemoryCategory category, UINT64 sizeInBytes);
+	void RecordFree(EMemoryCategory category, UINT64 sizeInBytes);
+
+	// 프레임마다 한 번 (렌더러는 Present에서 호출)
+	void EndFrame();
+
+	void SetBudget(EMemoryCategory category, UINT64 budgetBytes);
+	void SetBudgetCallback(BudgetCallback callback);
+	void ResetPeaks();
+
+	void GetStats(MemoryStats* pOutStats) const;
+	void WriteReport(std::string& outText) const;
+	bool ExportReport(const char* filePath) const;
+
+private:
+	struct CategoryCounter
+	{
+		std::atomic<UINT64> CurrentBytes = 0;
+		std::atomic<UINT64> PeakBytes = 0;
+		std::atomic<UINT64> AllocationCount = 0;
+		std::atomic<UINT64> PendingAllocatedBytes = 0;		// 진행 중인 프레임
+		std::atomic<UINT64> PendingFreedBytes = 0;
+		std::atomic<UINT64> FrameAllocatedBytes = 0;		// 마지막으로 끝난 프레임
+		std::atomic<UINT64> FrameFreedBytes = 0;
+		std::atomic<UINT64> BudgetBytes = 0;
+		bool bOverBudget = false;		// EndFrame에서만 접근
+	};
+
+	static void AddAllocation(CategoryCounter* pCounter, UINT64 sizeInBytes);
+	static void AddFree(CategoryCounter* pCounter, UINT64 sizeInBytes);
+	static void ReadCounter(const CategoryCounter& counter, MemoryCategoryStats* pOutStats);
+
+private:
+	std::array<CategoryCounter, CategoryCount + 1> m_counterList = {};		// 마지막은 전체 합계
+	std::atomic<UINT64> m_frameIndex = 0;
+
+	std::mutex m_callbackMutex;		// EndFrame과 SetBudgetCallback 사이
+	BudgetCallback m_budgetCallback;
+};
@@ -0,0 +1,198 @@
+#include "pch.h"
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <fstream>
+#include "Profiler.h"
+
+thread_local CProfiler::Track* CProfiler::s_pThreadTrack = nullptr;
+
+namespace
+{
+	void AppendJsonString(std::string& outJson, const char* text)
+	{
+		outJson += '"';
+		for (const char* pChar = text ? text : ""; *pChar; pChar++)
+		{
+			switch (*pChar)
+			{
+			case '"':
+				outJson += "\\\"";
+				break;
+			case '\\':
+				outJson += "\\\\";
+				break;
+			case '\n':
+				outJson += "\\n";
+				break;
+			default:
+				if (static_cast<unsigned char>(*pChar) >= 0x20)
+				{
+					outJson += *pChar;
+				}
+				break;
+			}
+		}
+		outJson += '"';
+	}
+}
+
+CProfiler& CProfiler::Get()
+{
+	static CProfiler s_profiler;
+	return s_profiler;
+}
+
+CProfiler::CProfiler()
+{
+	m_baseTimeNs = GetTimeNs();
+}
+
+uint64_t CProfiler::GetTimeNs()
+{
+	using namespace std::chrono;
+	return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+void CProfiler::SetCurrentThreadName(const char* name)
+{
+	Track* pTrack = GetCurrentThreadTrack();
+	std::lock_guard<std::mutex> lock(pTrack->Lock);
+	pTrack->Name = name ? name : "";
+}
+
+UINT CProfiler::RegisterTrack(const char* name)
+{
+	return AddTrack(name)->TrackId;
+}
+
+void CProfiler::RecordScope(const char* name, uint64_t startNs, uint64_t endNs)
+{
+	PushEvent(GetCurrentThreadTrack(), name, startNs, endNs);
+}
+
+void CProfiler::RecordEvent(UINT trackId, const char* name, uint64_t startNs, uint64_t endNs)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	Track* pTrack = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(m_trackListLock);
+		if (trackId >= m_trackList.size())
+		{
+			__debugbreak();
+			return;
+		}
+		pTrack = m_trackList[trackId].get();
+	}
+
+	PushEvent(pTrack, name, startNs, endNs);
+}
+
+void CProfiler::WriteChromeTrace(std::string& outJson) const
+{
+	std::lock_guard<std::mutex> listLock(m_trackListLock);
+
+	outJson.clear();
+	outJson += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+	bool bFirstEvent = true;
+	char buffer[128];
+	for (const std::unique_ptr<Track>& pTrack : m_trackList)
+	{
+		std::lock_guard<std::mutex> trackLock(pTrack->Lock);
+
+		// thread name metadata
+		if (!bFirstEvent)
+		{
+			outJson += ",\n";
+		}
+		bFirstEvent = false;
+		snprintf(buffer, sizeof(buffer), "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":", pTrack->TrackId);
+		outJson += buffer;
+		AppendJsonString(outJson, pTrack->Name.c_str());
+		outJson += "}}";
+
+		// ring buffer에서 오래된 것부터
+		const UINT firstIndex = (pTrack->EventCount < MaxEventCountPerTrack) ? 0 : pTrack->WriteIndex;
+		for (UINT i = 0; i < pTrack->EventCount; i++)
+		{
+			const ProfileEvent& event = pTrack->EventList[(firstIndex + i) % MaxEventCountPerTrack];
+			const uint64_t startNs = (event.StartNs > m_baseTimeNs) ? event.StartNs - m_baseTimeNs : 0;
+			const uint64_t durationNs = (event.EndNs > event.StartNs) ? event.EndNs - event.StartNs : 0;
+
+			outJson += ",\n{\"ph\":\"X\",\"pid\":1,";
+			snprintf(buffer, sizeof(buffer), "\"tid\":%u,\"ts\":%llu.%03llu,\"dur\":%llu.%03llu,\"name\":",
+				pTrack->TrackId,
+				static_cast<unsigned long long>(startNs / 1000), static_cast<unsigned long long>(startNs % 1000),
+				static_cast<unsigned long long>(durationNs / 1000), static_cast<unsigned long long>(durationNs % 1000));
+			outJson += buffer;
+			AppendJsonString(outJson, event.Name);
+			outJson += '}';
+		}
+	}
+
+	outJson += "\n]}\n";
+}
+
+bool CProfiler::ExportChromeTrace(const char* filePath) const
+{
+	std::string json = {};
+	WriteChromeTrace(json);
+
+	std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		return false;
+	}
+
+	file.write(json.data(), static_cast<std::streamsize>(json.size()));
+	return file.good();
+}
+
+void CProfiler::Clear()
+{
+	std::lock_guard<std::mutex> listLock(m_trackListLock);
+	for (std::unique_ptr<Track>& pTrack : m_trackList)
+	{
+		std::lock_guard<std::mutex> trackLock(pTrack->Lock);
+		pTrack->WriteIndex = 0;
+		pTrack->EventCount = 0;
+	}
+	m_baseTimeNs = GetTimeNs();
+}
+
+CProfiler::Track* CProfiler::AddTrack(const char* name)
+{
+	auto pTrack = std::make_unique<Track>();
+	pTrack->EventList.resize(MaxEventCountPerTrack);
+
+	std::lock_guard<std::mutex> lock(m_trackListLock);
+	pTrack->TrackId = static_cast<UINT>(m_trackList.size());
+	pTrack->Name = name ? name : "Thread " + std::to_string(pTrack->TrackId);
+	m_trackList.push_back(std::move(pTrack));
+	return m_trackList.back().get();
+}
+
+CProfiler::Track* CProfiler::GetCurrentThreadTrack()
+{
+	if (!s_pThreadTrack)
+	{
+		s_pThreadTrack = AddTrack(nullptr);
+	}
+	return s_pThreadTrack;
+}
+
+void CProfiler::PushEvent(Track* pTrack, const char* name, uint64_t startNs, uint64_t endNs)
+{
+	std::lock_guard<std::mutex> lock(pTrack->Lock);
+	pTrack->EventList[pTrack->WriteIndex] = ProfileEvent{ name, startNs, endNs };
+	pTrack->WriteIndex = (pTrack->WriteIndex + 1) % MaxEventCountPerTrack;
+	if (pTrack->EventCount < MaxEventCountPerTrack)
+	{
+		pTrack->EventCount++;
+	}
+}
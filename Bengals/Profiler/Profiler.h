@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifndef BENGALS_ENABLE_PROFILER
+#define BENGALS_ENABLE_PROFILER 1
+#endif
+
+struct ProfileEvent
+{
+	const char* Name = nullptr;
+	uint64_t StartNs = 0;
+	uint64_t EndNs = 0;
+};
+
+/**
+ * Scoped CPU timing markers collected into per-thread ring buffers.
+ *
+ * Each thread writes to its own track on first use. Other timelines, such as GPU queue
+ * timestamps, can register a named track and push already-timed events into it. The whole
+ * capture exports as Chrome trace-event JSON (chrome://tracing, Perfetto). Event names must
+ * be string literals or otherwise outlive the profiler. No D3D dependency.
+ */
+class CProfiler
+{
+public:
+	static constexpr UINT MaxEventCountPerTrack = 1 << 16;
+	static constexpr UINT InvalidTrack = UINT_MAX;
+
+public:
+	static CProfiler& Get();
+
+	static uint64_t GetTimeNs();
+
+	void SetEnabled(bool bEnable)
+	{
+		m_bEnabled.store(bEnable, std::memory_order_relaxed);
+	}
+
+	bool IsEnabled() const
+	{
+		return m_bEnabled.load(std::memory_order_relaxed);
+	}
+
+	void SetCurrentThreadName(const char* name);
+	UINT RegisterTrack(const char* name);
+
+	void RecordScope(const char* name, uint64_t startNs, uint64_t endNs);
+	void RecordEvent(UINT trackId, const char* name, uint64_t startNs, uint64_t endNs);
+
+	void WriteChromeTrace(std::string& outJson) const;
+	bool ExportChromeTrace(const char* filePath) const;
+	void Clear();
+
+private:
+	struct Track
+	{
+		std::string Name = {};
+		UINT TrackId = 0;
+		std::vector<ProfileEvent> EventList = {};
+		UINT WriteIndex = 0;
+		UINT EventCount = 0;
+		mutable std::mutex Lock;
+	};
+
+	CProfiler();
+	~CProfiler() = default;
+
+	Track* AddTrack(const char* name);
+	Track* GetCurrentThreadTrack();
+	static void PushEvent(Track* pTrack, const char* name, uint64_t startNs, uint64_t endNs);
+
+private:
+	static thread_local Track* s_pThreadTrack;
+
+	std::vector<std::unique_ptr<Track>> m_trackList = {};
+	mutable std::mutex m_trackListLock;
+	std::atomic<bool> m_bEnabled = true;
+	uint64_t m_baseTimeNs = 0;
+};
+
+class CProfileScope
+{
+public:
+	explicit CProfileScope(const char* name)
+	{
+		if (CProfiler::Get().IsEnabled())
+		{
+			m_name = name;
+			m_startNs = CProfiler::GetTimeNs();
+		}
+	}
+
+	~CProfileScope()
+	{
+		if (m_name)
+		{
+			CProfiler::Get().RecordScope(m_name, m_startNs, CProfiler::GetTimeNs());
+		}
+	}
+
+	CProfileScope(const CProfileScope&) = delete;
+	CProfileScope& operator=(const CProfileScope&) = delete;
+
+private:
+	const char* m_name = nullptr;
+	uint64_t m_startNs = 0;
+};
+
+#if BENGALS_ENABLE_PROFILER
+	#define PROFILE_CONCAT_INNER(a, b) a##b
+	#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+	#define PROFILE_SCOPE(name) CProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+	#define PROFILE_THREAD_NAME(name) CProfiler::Get().SetCurrentThreadName(name)
+#else
+	#define PROFILE_SCOPE(name)
+	#define PROFILE_THREAD_NAME(name)
+#endif
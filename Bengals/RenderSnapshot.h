@@ -0,0 +1,29 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * Everything the render side needs to record one frame, captured at the end of a game update.
+ *
+ * CGame keeps two snapshots: while worker threads record frame N from one, the next update
+ * writes frame N+1 into the other. The render side must not read live game state.
+ */
+
+struct MeshDrawCommand
+{
+	void* pMeshObj = nullptr;
+	XMMATRIX WorldMatrix = {};
+};
+
+struct RenderSnapshot
+{
+	XMFLOAT3 CameraPos = {};
+	std::vector<MeshDrawCommand> MeshDrawList = {};
+	std::vector<void*> StaticMeshGroupDrawList = {};		// 보이는 오브젝트가 하나라도 있는 정적 메시 그룹
+
+	// Dynamic texture image, uploaded once by the frame that consumes it.
+	// Copied in full on the snapshot's first build; after that only changed regions are refreshed
+	std::vector<BYTE> DynamicImage = {};
+	std::vector<RECT> DynamicImageDirtyRectList = {};		// DynamicImage에서 바뀐 영역. 이 영역만 업로드된다
+	bool bDynamicImageDirty = false;
+};
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <d3d12.h>
+#include "../RenderHelper/IndexCluster.h"
+
+/**
+ * 렌더 오브젝트가 커맨드 리스트에 기록하는 호출 순서를 한 곳에 모아둔 헬퍼.
+ * TCommandList는 ID3D12GraphicsCommandList 또는 같은 시그니처의 부분집합을 가진
+ * CNullCommandList이며, 템플릿으로 정적 디스패치하므로 실제 경로에 추가 비용은 없다.
+ */
+
+struct MeshDrawState
+{
+	ID3D12RootSignature* pRootSignature = nullptr;
+	ID3D12PipelineState* pPipelineState = nullptr;
+	ID3D12DescriptorHeap* pDescriptorHeap = nullptr;
+	const D3D12_VERTEX_BUFFER_VIEW* pVertexBufferView = nullptr;
+	D3D12_GPU_DESCRIPTOR_HANDLE GpuBaseDescriptorHandle = {};
+};
+
+struct StaticMeshGroupDrawState
+{
+	ID3D12RootSignature* pRootSignature = nullptr;
+	ID3D12PipelineState* pPipelineState = nullptr;
+	ID3D12DescriptorHeap* pDescriptorHeap = nullptr;
+};
+
+// root param 2 (b1) 값. DefaultShader의 CONSTANT_BUFFER_INSTANCE와 같은 배치 (DWORD 7개)
+struct StaticMeshBatchConstants
+{
+	UINT BaseSlot = 0;
+	XMFLOAT3 PositionScale = { 1.0f, 1.0f, 1.0f };		// QUANTIZED_VERTEX 메시만 사용
+	XMFLOAT3 PositionOffset = {};
+};
+
+struct SpriteDrawState
+{
+	ID3D12RootSignature* pRootSignature = nullptr;
+	ID3D12PipelineState* pPipelineState = nullptr;
+	ID3D12DescriptorHeap* pDescriptorHeap = nullptr;
+	const D3D12_VERTEX_BUFFER_VIEW* pVertexBufferView = nullptr;
+	const D3D12_INDEX_BUFFER_VIEW* pIndexBufferView = nullptr;
+	D3D12_GPU_DESCRIPTOR_HANDLE GpuBaseDescriptorHandle = {};
+};
+
+template <typename TCommandList>
+void RecordRenderTargetSetup(
+	TCommandList* pCommandList,
+	const D3D12_VIEWPORT& viewport,
+	const D3D12_RECT& scissorRect,
+	D3D12_CPU_DESCRIPTOR_HANDLE rtvDescriptorHandle,
+	D3D12_CPU_DESCRIPTOR_HANDLE dsvDescriptorHandle)
+{
+	pCommandList->RSSetViewports(1, &viewport);
+	pCommandList->RSSetScissorRects(1, &scissorRect);
+	pCommandList->OMSetRenderTargets(1, &rtvDescriptorHandle, FALSE, &dsvDescriptorHandle);
+}
+
+// root param 0: CBV table, root param 1: tri group SRV table
+template <typename TCommandList>
+void RecordMeshDrawSetup(TCommandList* pCommandList, const MeshDrawState& state)
+{
+	pCommandList->SetGraphicsRootSignature(state.pRootSignature);
+	pCommandList->SetDescriptorHeaps(1, &state.pDescriptorHeap);
+	pCommandList->SetPipelineState(state.pPipelineState);
+	pCommandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	pCommandList->IASetVertexBuffers(0, 1, state.pVertexBufferView);
+	pCommandList->SetGraphicsRootDescriptorTable(0, state.GpuBaseDescriptorHandle);
+}
+
+// cluster마다 draw 하나 (16비트 인덱스 + BaseVertexLocation)
+template <typename TCommandList>
+void RecordTriGroupDraw(
+	TCommandList* pCommandList,
+	D3D12_GPU_DESCRIPTOR_HANDLE gpuSrvHandle,
+	const D3D12_INDEX_BUFFER_VIEW* pIndexBufferView,
+	const IndexedTriCluster* pClusterList,
+	UINT clusterCount)
+{
+	pCommandList->SetGraphicsRootDescriptorTable(1, gpuSrvHandle);
+	pCommandList->IASetIndexBuffer(pIndexBufferView);
+	for (UINT i = 0; i < clusterCount; i++)
+	{
+		const IndexedTriCluster& cluster = pClusterList[i];
+		pCommandList->DrawIndexedInstanced(cluster.IndexCount, 1, cluster.StartIndex, cluster.BaseVertex, 0);
+	}
+}
+
+// 정적 메시 그룹 번들의 시작. 호출한 커맨드 리스트와 같은 root signature / heap이어야 root argument가 이어진다
+template <typename TBundle>
+void RecordStaticMeshBundleSetup(TBundle* pBundle, const StaticMeshGroupDrawState& state)
+{
+	pBundle->SetGraphicsRootSignature(state.pRootSignature);
+	pBundle->SetDescriptorHeaps(1, &state.pDescriptorHeap);
+	pBundle->SetPipelineState(state.pPipelineState);
+	pBundle->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+}
+
+// root param 2: 메시의 첫 인스턴스 slot + 위치 복원 값. pPipelineState가 nullptr이면 이전 PSO 유지
+template <typename TBundle>
+void RecordStaticMeshBatchSetup(TBundle* pBundle, ID3D12PipelineState* pPipelineState, const D3D12_VERTEX_BUFFER_VIEW* pVertexBufferView, const StaticMeshBatchConstants& constants)
+{
+	if (pPipelineState)
+	{
+		pBundle->SetPipelineState(pPipelineState);
+	}
+	pBundle->IASetVertexBuffers(0, 1, pVertexBufferView);
+	pBundle->SetGraphicsRoot32BitConstants(2, sizeof(StaticMeshBatchConstants) / sizeof(UINT), &constants, 0);
+}
+
+// root param 3: tri group SRV table
+template <typename TBundle>
+void RecordStaticMeshTriGroupDraw(
+	TBundle* pBundle,
+	D3D12_GPU_DESCRIPTOR_HANDLE gpuSrvHandle,
+	const D3D12_INDEX_BUFFER_VIEW* pIndexBufferView,
+	const IndexedTriCluster* pClusterList,
+	UINT clusterCount,
+	UINT instanceCount)
+{
+	pBundle->SetGraphicsRootDescriptorTable(3, gpuSrvHandle);
+	pBundle->IASetIndexBuffer(pIndexBufferView);
+	for (UINT i = 0; i < clusterCount; i++)
+	{
+		const IndexedTriCluster& cluster = pClusterList[i];
+		pBundle->DrawIndexedInstanced(cluster.IndexCount, instanceCount, cluster.StartIndex, cluster.BaseVertex, 0);
+	}
+}
+
+// root param 0: camera CBV, root param 1: instance buffer SRV. 나머지는 번들이 기록
+template <typename TCommandList, typename TBundle>
+void RecordStaticMeshGroupDraw(
+	TCommandList* pCommandList,
+	const StaticMeshGroupDrawState& state,
+	D3D12_GPU_VIRTUAL_ADDRESS constantBufferAddress,
+	D3D12_GPU_VIRTUAL_ADDRESS instanceBufferAddress,
+	TBundle* pBundle)
+{
+	pCommandList->SetGraphicsRootSignature(state.pRootSignature);
+	pCommandList->SetDescriptorHeaps(1, &state.pDescriptorHeap);
+	pCommandList->SetGraphicsRootConstantBufferView(0, constantBufferAddress);
+	pCommandList->SetGraphicsRootShaderResourceView(1, instanceBufferAddress);
+	pCommandList->ExecuteBundle(pBundle);
+}
+
+// root param 0: CBV + SRV table, quad 1개
+template <typename TCommandList>
+void RecordSpriteDraw(TCommandList* pCommandList, const SpriteDrawState& state)
+{
+	pCommandList->SetGraphicsRootSignature(state.pRootSignature);
+	pCommandList->SetDescriptorHeaps(1, &state.pDescriptorHeap);
+	pCommandList->SetPipelineState(state.pPipelineState);
+	pCommandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	pCommandList->IASetVertexBuffers(0, 1, state.pVertexBufferView);
+	pCommandList->IASetIndexBuffer(state.pIndexBufferView);
+	pCommandList->SetGraphicsRootDescriptorTable(0, state.GpuBaseDescriptorHandle);
+	pCommandList->DrawIndexedInstanced(6, 1, 0, 0, 0);
+}
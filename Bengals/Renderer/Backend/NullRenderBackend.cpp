@@ -0,0 +1,511 @@
+#include "pch.h"
+#include "NullRenderBackend.h"
+
+void NullBackendStats::Accumulate(const NullBackendStats& other)
+{
+	CallCount += other.CallCount;
+	DrawCount += other.DrawCount;
+	IndexCount += other.IndexCount;
+	StateChangeCount += other.StateChangeCount;
+	RedundantStateCount += other.RedundantStateCount;
+	DescriptorTableCount += other.DescriptorTableCount;
+	DescriptorCopyCount += other.DescriptorCopyCount;
+	BarrierCount += other.BarrierCount;
+	BarrierCallCount += other.BarrierCallCount;
+	ErrorCount += other.ErrorCount;
+}
+
+// ---------------------------------------------------------------------------
+// CNullRenderDevice
+// ---------------------------------------------------------------------------
+
+void CNullRenderDevice::CopyDescriptorsSimple(
+	UINT numDescriptors,
+	D3D12_CPU_DESCRIPTOR_HANDLE destDescriptorRangeStart,
+	D3D12_CPU_DESCRIPTOR_HANDLE srcDescriptorRangeStart,
+	D3D12_DESCRIPTOR_HEAP_TYPE descriptorHeapsType)
+{
+	m_stats.CallCount++;
+
+	if (numDescriptors == 0)
+	{
+		ReportError("CopyDescriptorsSimple: numDescriptors is 0");
+		return;
+	}
+	if (destDescriptorRangeStart.ptr == 0 || srcDescriptorRangeStart.ptr == 0)
+	{
+		ReportError("CopyDescriptorsSimple: null descriptor handle");
+		return;
+	}
+	if (descriptorHeapsType != D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV && descriptorHeapsType != D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER)
+	{
+		ReportError("CopyDescriptorsSimple: heap type is not shader visible");
+		return;
+	}
+
+	m_stats.DescriptorCopyCount += numDescriptors;
+}
+
+void CNullRenderDevice::ResetStats()
+{
+	m_stats = {};
+	m_pLastError = nullptr;
+}
+
+void CNullRenderDevice::ReportError(const char* pMessage)
+{
+	m_stats.ErrorCount++;
+	m_pLastError = pMessage;
+}
+
+// ---------------------------------------------------------------------------
+// CNullCommandList
+// ---------------------------------------------------------------------------
+
+void CNullCommandList::Reset()
+{
+	m_pRootSignature = nullptr;
+	m_pPipelineState = nullptr;
+	m_pDescriptorHeap = nullptr;
+	m_primitiveTopology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+	m_vertexBufferView = {};
+	m_indexBufferView = {};
+	m_boundRootTableMask = 0;
+	m_bViewportSet = false;
+	m_bScissorRectSet = false;
+	m_bRenderTargetSet = false;
+	m_bClosed = false;
+	m_recordedBarrierList.clear();
+}
+
+void CNullCommandList::Close()
+{
+	if (BeginCall())
+	{
+		m_bClosed = true;
+	}
+}
+
+void CNullCommandList::RSSetViewports(UINT numViewports, const D3D12_VIEWPORT* pViewports)
+{
+	if (!BeginCall())
+	{
+		return;
+	}
+	if (numViewports == 0 || !pViewports)
+	{
+		ReportError("RSSetViewports: no viewport");
+		return;
+	}
+	for (UINT i = 0; i < numViewports; i++)
+	{
+		if (pViewports[i].Width <= 0.0f || pViewports[i].Height <= 0.0f)
+		{
+			ReportError("RSSetViewports: empty viewport");
+			return;
+		}
+	}
+	m_bViewportSet = true;
+}
+
+void CNullCommandList::RSSetScissorRects(UINT numRects, const D3D12_RECT* pRects)
+{
+	if (!BeginCall())
+	{
+		return;
+	}
+	if (numRects == 0 || !pRects)
+	{
+		ReportError("RSSetScissorRects: no rect");
+		return;
+	}
+	m_bScissorRectSet = true;
+}
+
+void CNullCommandList::OMSetRenderTargets(
+	UINT numRenderTargetDescriptors,
+	const D3D12_CPU_DESCRIPTOR_HANDLE* pRenderTargetDescriptors,
+	BOOL bRTsSingleHandleToDescriptorRange,
+	const D3D12_CPU_DESCRIPTOR_HANDLE* pDepthStencilDescriptor)
+{
+	if (!BeginCall())
+	{
+		return;
+	}
+	if (numRenderTargetDescriptors > D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT)
+	{
+		ReportError("OMSetRenderTargets: too many render targets");
+		return;
+	}
+	if (numRenderTargetDescriptors > 0 && (!pRenderTargetDescriptors || pRenderTargetDescriptors[0].ptr == 0))
+	{
+		ReportError("OMSetRenderTargets: null RTV handle");
+		return;
+	}
+	if (pDepthStencilDescriptor && pDepthStencilDescriptor->ptr == 0)
+	{
+		ReportError("OMSetRenderTargets: null DSV handle");
+		return;
+	}
+	m_bRenderTargetSet = (numRenderTargetDescriptors > 0 || pDepthStencilDescriptor);
+}
+
+void CNullCommandList::SetGraphicsRootSignature(ID3D12RootSignature* pRootSignature)
+{
+	if (!BeginCall())
+	{
+		return;
+	}
+	if (!pRootSignature)
+	{
+		ReportError("SetGraphicsRootSignature: null root signature");
+		return;
+	}
+
+	// 루트 시그니처를 바꾸면 기존 루트 인자 바인딩은 무효가 된다
+	const bool bChanged = (m_pRootSignature != pRootSignature);
+	CountStateChange(bChanged);
+	if (bChanged)
+	{
+		m_pRootSignature = pRootSignature;
+		m_boundRootTableMask = 0;
+	}
+}
+
+void CNullCommandList::SetDescriptorHeaps(UINT numDescriptorHeaps, ID3D12DescriptorHeap* const* ppDescriptorHeaps)
+{
+	if (!BeginCall())
+	{
+		return;
+	}
+	if (numDescriptorHeaps == 0 || !ppDescriptorHeaps || !ppDescriptorHeaps[0])
+	{
+		ReportError("SetDescriptorHeaps: null descriptor heap");
+		return;
+	}
+
+	CountStateChange(m_pDescriptorHeap != ppDescriptorHeaps[0]);
+	m_pDescriptorHeap = ppDescriptorHeaps[0];
+}
+
+void CNullCommandList::SetPipelineState(ID3D12PipelineState* pPipelineState)
+{
+	if (!BeginCall())
+	{
+		return;
+	}
+	if (!pPipelineState)
+	{
+		ReportError("SetPipelineState: null PSO");
+		return;
+	}
+
+	CountStateChange(m_pPipelineState != pPipelineState);
+	m_pPipelineState = pPipelineState;
+}
+
+void CNullCommandList::IASetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY primitiveTopology)
+{
+	if (!BeginCall())
+	{
+		return;
+	}
+	if (primitiveTopology == D3D_PRIMITIVE_TOPOLOGY_UNDEFINED)
+	{
+		ReportError("IASetPrimitiveTopology: undefined topology");
+		return;
+	}
+
+	CountStateChange(m_primitiveTopology != primitiveTopology);
+	m_primitiveTopology = primitiveTopology;
+}
+
+void CNullCommandList::IASetVertexBuffers(UINT startSlot, UINT numViews, const D3D12_VERTEX_BUFFER_VIEW* pViews)
+{
+	if (!BeginCall())
+	{
+		return;
+	}
+	if (startSlot != 0 || numViews != 1 || !pViews)
+	{
+		// 드로우 경로는 slot 0에 vertex buffer 1개만 사용
+		ReportError("IASetVertexBuffers: expected a single view at slot 0");
+		return;
+	}
+	if (pViews->BufferLocation == 0 || pViews->SizeInBytes == 0 || pViews->StrideInBytes == 0)
+	{
+		ReportError("IASetVertexBuffers: empty vertex buffer view");
+		return;
+	}
+	m_vertexBufferView = *pViews;
+}
+
+void CNullCommandList::IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW* pView)
+{
+	if (!BeginCall())
+	{
+		return;
+	}
+	if (!pView || pView->BufferLocation == 0 || pView->SizeInBytes == 0)
+	{
+		ReportError("IASetIndexBuffer: empty index buffer view");
+		return;
+	}
+	if (pView->Format != DXGI_FORMAT_R16_UINT && pView->Format != DXGI_FORMAT_R32_UINT)
+	{
+		ReportError("IASetIndexBuffer: invalid index format");
+		return;
+	}
+	m_indexBufferView = *pView;
+}
+
+void CNullCommandList::SetGraphicsRootDescriptorTable(UINT rootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE baseDescriptor)
+{
+	if (!BeginCall())
+	{
+		return;
+	}
+	if (!m_pRootSignature)
+	{
+		ReportError("SetGraphicsRootDescriptorTable: no root signature");
+		return;
+	}
+	if (!m_pDescriptorHeap)
+	{
+		ReportError("SetGraphicsRootDescriptorTable: no descriptor heap");
+		return;
+	}
+	if (rootParameterIndex >= MaxRootParameterCount || baseDescriptor.ptr == 0)
+	{
+		ReportError("SetGraphicsRootDescriptorTable: invalid parameter");
+		return;
+	}
+
+	m_stats.DescriptorTableCount++;
+	m_boundRootTableMask |= (1u << rootParameterIndex);
+}
+
+void CNullCommandList::DrawIndexedInstanced(
+	UINT indexCountPerInstance,
+	UINT instanceCount,
+	UINT startIndexLocation,
+	INT baseVertexLocation,
+	UINT startInstanceLocation)
+{
+	if (!BeginCall())
+	{
+		return;
+	}
+	if (!m_bViewportSet || !m_bScissorRectSet || !m_bRenderTargetSet)
+	{
+		ReportError("DrawIndexedInstanced: viewport, scissor rect or render target not set");
+		return;
+	}
+	if (!m_pRootSignature || !m_pPipelineState || m_primitiveTopology == D3D_PRIMITIVE_TOPOLOGY_UNDEFINED)
+	{
+		ReportError("DrawIndexedInstanced: pipeline state not bound");
+		return;
+	}
+	if (m_boundRootTableMask == 0)
+	{
+		ReportError("DrawIndexedInstanced: no root descriptor table bound");
+		return;
+	}
+	if (m_vertexBufferView.SizeInBytes == 0 || m_indexBufferView.SizeInBytes == 0)
+	{
+		ReportError("DrawIndexedInstanced: vertex or index buffer not bound");
+		return;
+	}
+	if (indexCountPerInstance == 0 || instanceCount == 0)
+	{
+		ReportError("DrawIndexedInstanced: empty draw");
+		return;
+	}
+
+	const UINT64 indexSize = (m_indexBufferView.Format == DXGI_FORMAT_R32_UINT) ? 4 : 2;
+	const UINT64 lastIndexByte = (static_cast<UINT64>(startIndexLocation) + indexCountPerInstance) * indexSize;
+	if (lastIndexByte > m_indexBufferView.SizeInBytes)
+	{
+		ReportError("DrawIndexedInstanced: index range exceeds index buffer");
+		return;
+	}
+
+	m_stats.DrawCount++;
+	m_stats.IndexCount += static_cast<UINT64>(indexCountPerInstance) * instanceCount;
+}
+
+void CNullCommandList::ResourceBarrier(UINT numBarriers, const D3D12_RESOURCE_BARRIER* pBarriers)
+{
+	if (!BeginCall())
+	{
+		return;
+	}
+	if (numBarriers == 0 || !pBarriers)
+	{
+		ReportError("ResourceBarrier: no barrier");
+		return;
+	}
+	for (UINT i = 0; i < numBarriers; i++)
+	{
+		const D3D12_RESOURCE_BARRIER& barrier = pBarriers[i];
+		if (barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION &&
+			barrier.Transition.StateBefore == barrier.Transition.StateAfter)
+		{
+			ReportError("ResourceBarrier: StateBefore == StateAfter");
+			return;
+		}
+	}
+	m_stats.BarrierCount += numBarriers;
+	m_stats.BarrierCallCount++;
+	m_recordedBarrierList.insert(m_recordedBarrierList.end(), pBarriers, pBarriers + numBarriers);
+}
+
+void CNullCommandList::ResetStats()
+{
+	m_stats = {};
+	m_pLastError = nullptr;
+}
+
+bool CNullCommandList::BeginCall()
+{
+	m_stats.CallCount++;
+	if (m_bClosed)
+	{
+		ReportError("command list is closed");
+		return false;
+	}
+	return true;
+}
+
+void CNullCommandList::ReportError(const char* pMessage)
+{
+	m_stats.ErrorCount++;
+	m_pLastError = pMessage;
+}
+
+void CNullCommandList::CountStateChange(bool bChanged)
+{
+	if (bChanged)
+	{
+		m_stats.StateChangeCount++;
+	}
+	else
+	{
+		m_stats.RedundantStateCount++;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// CNullCommandQueue
+// ---------------------------------------------------------------------------
+
+void CNullCommandQueue::Signal(CNullFence* pFence, UINT64 value)
+{
+	m_stats.CallCount++;
+	if (!pFence)
+	{
+		ReportError("Signal: null fence");
+		return;
+	}
+	m_commandList.push_back({ ECommandType::Signal, pFence, value });
+}
+
+void CNullCommandQueue::Wait(CNullFence* pFence, UINT64 value)
+{
+	m_stats.CallCount++;
+	if (!pFence)
+	{
+		ReportError("Wait: null fence");
+		return;
+	}
+	m_commandList.push_back({ ECommandType::Wait, pFence, value });
+}
+
+void CNullCommandQueue::ExecuteCommandLists(UINT numCommandLists, CNullCommandList* const* ppCommandLists)
+{
+	m_stats.CallCount++;
+	if (numCommandLists == 0 || !ppCommandLists)
+	{
+		ReportError("ExecuteCommandLists: no command list");
+		return;
+	}
+	for (UINT i = 0; i < numCommandLists; i++)
+	{
+		if (!ppCommandLists[i] || !ppCommandLists[i]->IsClosed())
+		{
+			ReportError("ExecuteCommandLists: command list is not closed");
+			return;
+		}
+	}
+	m_commandList.push_back({ ECommandType::Execute, nullptr, numCommandLists });
+}
+
+bool CNullCommandQueue::ExecuteNext()
+{
+	if (m_commandList.empty())
+	{
+		return false;
+	}
+
+	const QueuedCommand& command = m_commandList.front();
+	switch (command.Type)
+	{
+		case ECommandType::Signal:
+			if (command.Value < command.pFence->GetCompletedValue())
+			{
+				ReportError("Signal: fence value decreased");
+			}
+			command.pFence->SetCompletedValue(command.Value);
+			break;
+		case ECommandType::Wait:
+			if (command.pFence->GetCompletedValue() < command.Value)
+			{
+				return false;
+			}
+			break;
+		case ECommandType::Execute:
+			m_stats.DrawCount += command.Value;
+			break;
+	}
+	m_commandList.pop_front();
+	return true;
+}
+
+void CNullCommandQueue::ResetStats()
+{
+	m_stats = {};
+	m_pLastError = nullptr;
+}
+
+void CNullCommandQueue::ReportError(const char* pMessage)
+{
+	m_stats.ErrorCount++;
+	m_pLastError = pMessage;
+}
+
+bool DrainNullCommandQueues(CNullCommandQueue* const* ppQueueList, UINT queueCount)
+{
+	for (;;)
+	{
+		bool bProgress = false;
+		bool bIdle = true;
+		for (UINT i = 0; i < queueCount; i++)
+		{
+			// 막힐 때까지 실행해 다른 큐가 기다리는 signal을 내보낸다
+			while (ppQueueList[i]->ExecuteNext())
+			{
+				bProgress = true;
+			}
+			bIdle &= ppQueueList[i]->IsIdle();
+		}
+
+		if (bIdle)
+		{
+			return true;
+		}
+		if (!bProgress)
+		{
+			return false;
+		}
+	}
+}
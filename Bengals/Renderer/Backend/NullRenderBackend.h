@@ -0,0 +1,171 @@
+#pragma once
+
+#include <d3d12.h>
+#include <deque>
+#include <vector>
+
+/**
+ * GPU 없이 렌더 제출 경로를 실행하기 위한 null 백엔드.
+ * ID3D12Device / ID3D12GraphicsCommandList에서 드로우 경로가 쓰는 메서드만 같은 시그니처로 제공하고,
+ * 호출을 세고 D3D12 디버그 레이어가 잡을 만한 상태 오류(바인딩 누락, 범위 밖 인덱스 등)를 검증한다.
+ * DrawCommandRecorder.h의 템플릿 함수에 그대로 넘길 수 있다.
+ * 카운터는 동기화하지 않으므로 렌더 스레드마다 별도 인스턴스를 사용한다.
+ */
+
+struct NullBackendStats
+{
+	UINT64 CallCount = 0;
+	UINT64 DrawCount = 0;
+	UINT64 IndexCount = 0;
+	UINT64 StateChangeCount = 0;		// root signature / PSO / heap / topology 변경
+	UINT64 RedundantStateCount = 0;		// 이미 바인딩된 값을 다시 설정
+	UINT64 DescriptorTableCount = 0;
+	UINT64 DescriptorCopyCount = 0;
+	UINT64 BarrierCount = 0;
+	UINT64 BarrierCallCount = 0;		// ResourceBarrier 호출 수 (배치 크기 = BarrierCount / BarrierCallCount)
+	UINT64 ErrorCount = 0;
+
+	void Accumulate(const NullBackendStats& other);
+};
+
+class CNullRenderDevice
+{
+public:
+	void CopyDescriptorsSimple(
+		UINT numDescriptors,
+		D3D12_CPU_DESCRIPTOR_HANDLE destDescriptorRangeStart,
+		D3D12_CPU_DESCRIPTOR_HANDLE srcDescriptorRangeStart,
+		D3D12_DESCRIPTOR_HEAP_TYPE descriptorHeapsType);
+
+	const NullBackendStats& GetStats() const { return m_stats; }
+	const char* GetLastError() const { return m_pLastError; }
+	void ResetStats();
+
+private:
+	void ReportError(const char* pMessage);
+
+private:
+	NullBackendStats m_stats = {};
+	const char* m_pLastError = nullptr;
+};
+
+class CNullCommandList
+{
+public:
+	// ID3D12GraphicsCommandList::Reset / Close에 대응. 바인딩 상태만 초기화하고 통계는 유지
+	void Reset();
+	void Close();
+
+	void RSSetViewports(UINT numViewports, const D3D12_VIEWPORT* pViewports);
+	void RSSetScissorRects(UINT numRects, const D3D12_RECT* pRects);
+	void OMSetRenderTargets(
+		UINT numRenderTargetDescriptors,
+		const D3D12_CPU_DESCRIPTOR_HANDLE* pRenderTargetDescriptors,
+		BOOL bRTsSingleHandleToDescriptorRange,
+		const D3D12_CPU_DESCRIPTOR_HANDLE* pDepthStencilDescriptor);
+	void SetGraphicsRootSignature(ID3D12RootSignature* pRootSignature);
+	void SetDescriptorHeaps(UINT numDescriptorHeaps, ID3D12DescriptorHeap* const* ppDescriptorHeaps);
+	void SetPipelineState(ID3D12PipelineState* pPipelineState);
+	void IASetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY primitiveTopology);
+	void IASetVertexBuffers(UINT startSlot, UINT numViews, const D3D12_VERTEX_BUFFER_VIEW* pViews);
+	void IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW* pView);
+	void SetGraphicsRootDescriptorTable(UINT rootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE baseDescriptor);
+	void DrawIndexedInstanced(
+		UINT indexCountPerInstance,
+		UINT instanceCount,
+		UINT startIndexLocation,
+		INT baseVertexLocation,
+		UINT startInstanceLocation);
+	void ResourceBarrier(UINT numBarriers, const D3D12_RESOURCE_BARRIER* pBarriers);
+
+	bool IsClosed() const { return m_bClosed; }
+	const NullBackendStats& GetStats() const { return m_stats; }
+	const char* GetLastError() const { return m_pLastError; }
+	void ResetStats();
+	// 마지막 Reset 이후 기록된 barrier (barrier 순서 검증용)
+	const std::vector<D3D12_RESOURCE_BARRIER>& GetRecordedBarriers() const { return m_recordedBarrierList; }
+
+private:
+	bool BeginCall();
+	void ReportError(const char* pMessage);
+	void CountStateChange(bool bChanged);
+
+private:
+	static constexpr UINT MaxRootParameterCount = 16;
+
+	NullBackendStats m_stats = {};
+	const char* m_pLastError = nullptr;
+
+	// Binding state
+	ID3D12RootSignature* m_pRootSignature = nullptr;
+	ID3D12PipelineState* m_pPipelineState = nullptr;
+	ID3D12DescriptorHeap* m_pDescriptorHeap = nullptr;
+	D3D12_PRIMITIVE_TOPOLOGY m_primitiveTopology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+	D3D12_VERTEX_BUFFER_VIEW m_vertexBufferView = {};
+	D3D12_INDEX_BUFFER_VIEW m_indexBufferView = {};
+	UINT m_boundRootTableMask = 0;
+	bool m_bViewportSet = false;
+	bool m_bScissorRectSet = false;
+	bool m_bRenderTargetSet = false;
+	bool m_bClosed = false;
+
+	std::vector<D3D12_RESOURCE_BARRIER> m_recordedBarrierList = {};
+};
+
+// ID3D12Fence 대신. 값은 CNullCommandQueue가 Signal을 실행할 때 바뀐다
+class CNullFence
+{
+public:
+	UINT64 GetCompletedValue() const { return m_completedValue; }
+	void SetCompletedValue(UINT64 value) { m_completedValue = value; }
+
+private:
+	UINT64 m_completedValue = 0;
+};
+
+/**
+ * ID3D12CommandQueue의 Signal / Wait / ExecuteCommandLists를 순서대로 쌓아두고,
+ * ExecuteNext()가 GPU처럼 맨 앞 명령을 하나씩 실행한다. Wait는 fence가 그 값에 도달할 때까지
+ * 큐를 막으므로 여러 큐를 번갈아 실행하면 큐 사이 동기화와 교착을 GPU 없이 확인할 수 있다.
+ */
+class CNullCommandQueue
+{
+public:
+	void Signal(CNullFence* pFence, UINT64 value);
+	void Wait(CNullFence* pFence, UINT64 value);
+	void ExecuteCommandLists(UINT numCommandLists, CNullCommandList* const* ppCommandLists);
+
+	// 맨 앞 명령을 실행. 비어 있거나 Wait에 막혀 있으면 false
+	bool ExecuteNext();
+	bool IsIdle() const { return m_commandList.empty(); }
+	UINT GetPendingCommandCount() const { return static_cast<UINT>(m_commandList.size()); }
+
+	const NullBackendStats& GetStats() const { return m_stats; }
+	const char* GetLastError() const { return m_pLastError; }
+	void ResetStats();
+
+private:
+	enum class ECommandType : UINT8
+	{
+		Signal,
+		Wait,
+		Execute
+	};
+
+	struct QueuedCommand
+	{
+		ECommandType Type = ECommandType::Execute;
+		CNullFence* pFence = nullptr;
+		UINT64 Value = 0;		// Execute: 커맨드 리스트 수
+	};
+
+	void ReportError(const char* pMessage);
+
+private:
+	std::deque<QueuedCommand> m_commandList = {};
+	NullBackendStats m_stats = {};		// DrawCount 자리에 실행한 커맨드 리스트 수
+	const char* m_pLastError = nullptr;
+};
+
+// 모든 큐를 번갈아 끝까지 실행. 남은 명령이 서로를 기다려 더 진행할 수 없으면 false (GPU 교착)
+bool DrainNullCommandQueues(CNullCommandQueue* const* ppQueueList, UINT queueCount);
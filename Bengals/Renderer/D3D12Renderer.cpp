@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "D3D12Renderer.h"
+#include <algorithm>
 #include <cassert>
 #include "../../Util/D3DUtil.h"
 #include <dxgi.h>
@@ -16,14 +17,45 @@
 
 #include "RenderObject/BasicMeshObject.h"
 #include "RenderObject/SpriteObject.h"
+#include "RenderObject/StaticMeshGroup.h"
 #include "Manager/TextureManager.h"
 #include "RenderHelper/RenderQueue.h"
 #include "RenderHelper/RenderThread.h"
+#include "RenderHelper/FrameClock.h"
+#include "RenderHelper/GpuMemoryTag.h"
+#include "RenderHelper/GpuProfiler.h"
+#include "RenderHelper/HotReloader.h"
+#include "RenderHelper/PipelineStateCache.h"
+#include "RenderHelper/ShaderArchive.h"
+#include "Asset/AssetArchive.h"
+#include "Profiler/Profiler.h"
+#include "Profiler/MemoryTracker.h"
+#include "Task/WorkerPool.h"
 #include "Types/typedef.h"
+#include "../../Util/ProcessorInfo.h"
+
+namespace
+{
+	// 창이 놓인 모니터 크기 이상으로 잡는다 (모니터를 못 얻으면 요청 크기 그대로)
+	void GetFramebufferCapacity(HWND hWindow, UINT width, UINT height, UINT* pOutWidth, UINT* pOutHeight)
+	{
+		*pOutWidth = width;
+		*pOutHeight = height;
+
+		MONITORINFO monitorInfo = {};
+		monitorInfo.cbSize = sizeof(monitorInfo);
+		if (GetMonitorInfo(MonitorFromWindow(hWindow, MONITOR_DEFAULTTONEAREST), &monitorInfo))
+		{
+			*pOutWidth = (std::max)(width, static_cast<UINT>(monitorInfo.rcMonitor.right - monitorInfo.rcMonitor.left));
+			*pOutHeight = (std::max)(height, static_cast<UINT>(monitorInfo.rcMonitor.bottom - monitorInfo.rcMonitor.top));
+		}
+	}
+}
 
 RenderThreadContext::~RenderThreadContext() = default;
 
-CD3D12Renderer::CD3D12Renderer(HWND hWindow, bool bEnableDebugLayer, bool bEnableGbv)
+CD3D12Renderer::CD3D12Renderer(HWND hWindow, bool bEnableDebugLayer, bool bEnableGbv, CWorkerPool* pWorkerPool)
+	: m_pWorkerPool(pWorkerPool)
 {
 	if (Initialize(hWindow, bEnableDebugLayer, bEnableGbv) == false)
 	{
@@ -39,6 +71,11 @@ CD3D12Renderer::~CD3D12Renderer()
 
 void CD3D12Renderer::BeginRender()
 {
+	PROFILE_SCOPE("BeginRender");
+
+	// 이번 프레임의 기록이 시작되기 전에 교체 (이전 프레임은 이미 제출됨)
+	ApplyHotReloads();
+
 	FrameContext& ctx = m_frameContexts[m_currentContextIndex];
 	m_currentRenderThreadIndex = 0;
 	CCommandListPool* pCommandListPool = ctx.CommandListPool.get();
@@ -55,19 +92,31 @@ void CD3D12Renderer::BeginRender()
 		return;
 	}
 
+	UINT gpuQuery = m_gpuProfiler->BeginQuery(pCommandList, m_currentContextIndex, "Clear");
+
 	CD3DX12_CPU_DESCRIPTOR_HANDLE RTVDescriptorHandle(m_pRtvDescriptorHeap->GetCPUDescriptorHandleForHeapStart(), m_currentRenderTargetIndex, m_rtvDescriptorSize);
-	CD3DX12_RESOURCE_BARRIER RenderTargetBarrier = CD3DX12_RESOURCE_BARRIER::Transition(m_pRenderTargets[m_currentRenderTargetIndex], D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RENDER_TARGET);
-	pCommandList->ResourceBarrier(1, &RenderTargetBarrier);
+	// 렌더 타깃 전환과 동적 텍스처의 COPY_DEST 전환이 한 번의 ResourceBarrier로 기록된다
+	m_resourceStateTracker.TransitionResource(m_pRenderTargets[m_currentRenderTargetIndex], D3D12_RESOURCE_STATE_RENDER_TARGET);
+	m_textureManager->RecordPendingUploads(pCommandList, &m_resourceStateTracker);
+	for (CStaticMeshGroup* pStaticMeshGroup : m_staticMeshGroupList)
+	{
+		pStaticMeshGroup->PrepareFrame(pCommandList, m_currentContextIndex, &m_resourceStateTracker);
+	}
+	m_resourceStateTracker.FlushBarriers(pCommandList);
 
 	const float BackColor[] = { 1.0f, 0.9f, 1.0f, 1.0f };
 	D3D12_CPU_DESCRIPTOR_HANDLE DsvDescriptorHandle{ m_pDsvDescriptorHeap->GetCPUDescriptorHandleForHeapStart() };
 	pCommandList->ClearRenderTargetView(RTVDescriptorHandle, BackColor, 0, nullptr);
 	pCommandList->ClearDepthStencilView(DsvDescriptorHandle, D3D12_CLEAR_FLAG_DEPTH, 1.f, 0, 0, nullptr);
 
+	m_gpuProfiler->EndQuery(pCommandList, m_currentContextIndex, gpuQuery);
 	pCommandListPool->CloseAndExecute(m_pCommandQueue);
+	m_resourceStateTracker.OnCommandListsExecuted();
 }
 void CD3D12Renderer::EndRender()
 {
+	PROFILE_SCOPE("EndRender");
+
 	FrameContext& ctx = m_frameContexts[m_currentContextIndex];
 	CCommandListPool* pCommandListPool = ctx.CommandListPool.get();
 	if (!pCommandListPool)
@@ -77,13 +126,11 @@ void CD3D12Renderer::EndRender()
 	}
 
 	std::vector<DWORD> activeThreadIndexList = {};
-	std::vector<HANDLE> completeEventList = {};
 	activeThreadIndexList.reserve(m_renderThreadCount);
-	completeEventList.reserve(m_renderThreadCount);
 
 	for (DWORD threadIndex = 0; threadIndex < m_renderThreadCount; threadIndex++)
 	{
-		if (threadIndex >= ctx.RenderThreadContextList.size() || threadIndex >= m_renderThreadDescList.size())
+		if (threadIndex >= ctx.RenderThreadContextList.size())
 		{
 			__debugbreak();
 			continue;
@@ -96,26 +143,10 @@ void CD3D12Renderer::EndRender()
 			continue;
 		}
 
-		RenderThreadDesc& renderThreadDesc = m_renderThreadDescList[threadIndex];
-		if (!renderThreadDesc.ThreadHandle || !renderThreadDesc.EventList[RenderThreadEventTypeProcess] || !renderThreadDesc.CompleteEvent)
-		{
-			__debugbreak();
-			continue;
-		}
-
 		activeThreadIndexList.push_back(threadIndex);
-		completeEventList.push_back(renderThreadDesc.CompleteEvent);
-		SetEvent(renderThreadDesc.EventList[RenderThreadEventTypeProcess]);
 	}
 
-	if (!completeEventList.empty())
-	{
-		DWORD waitResult = WaitForMultipleObjects(static_cast<DWORD>(completeEventList.size()), completeEventList.data(), TRUE, INFINITE);
-		if (waitResult == WAIT_FAILED)
-		{
-			__debugbreak();
-		}
-	}
+	ProcessRenderQueues(activeThreadIndexList);
 
 	UINT totalRecordedCommandListCount = 0;
 	for (DWORD threadIndex : activeThreadIndexList)
@@ -135,6 +166,7 @@ void CD3D12Renderer::EndRender()
 	if (!commandListArray.empty())
 	{
 		m_pCommandQueue->ExecuteCommandLists(static_cast<UINT>(commandListArray.size()), commandListArray.data());
+		m_resourceStateTracker.OnCommandListsExecuted();
 	}
 
 	ID3D12GraphicsCommandList* pTransitionCommandList = pCommandListPool->GetCurrentCommandList();
@@ -144,21 +176,26 @@ void CD3D12Renderer::EndRender()
 		return;
 	}
 
-	CD3DX12_RESOURCE_BARRIER renderTargetBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
-		m_pRenderTargets[m_currentRenderTargetIndex],
-		D3D12_RESOURCE_STATE_RENDER_TARGET,
-		D3D12_RESOURCE_STATE_PRESENT);
-	pTransitionCommandList->ResourceBarrier(1, &renderTargetBarrier);
+	UINT gpuQuery = m_gpuProfiler->BeginQuery(pTransitionCommandList, m_currentContextIndex, "PresentTransition");
+	m_resourceStateTracker.TransitionResource(m_pRenderTargets[m_currentRenderTargetIndex], D3D12_RESOURCE_STATE_PRESENT);
+	m_resourceStateTracker.FlushBarriers(pTransitionCommandList);
+	m_gpuProfiler->EndQuery(pTransitionCommandList, m_currentContextIndex, gpuQuery);
+
+	// 이 프레임의 timestamp를 readback 버퍼로 (마지막으로 실행되는 커맨드 리스트)
+	m_gpuProfiler->ResolveFrame(pTransitionCommandList, m_currentContextIndex);
 	pCommandListPool->CloseAndExecute(m_pCommandQueue);
+	m_resourceStateTracker.OnCommandListsExecuted();
 }
 
 void CD3D12Renderer::Present()
 {
-	//UINT m_SyncInterval = 1;	// VSync On
-	UINT syncInterval = 0;	// VSync Off
+	PROFILE_SCOPE("Present");
+
+	const FramePacingDesc& pacingDesc = m_framePacer.GetDesc();
+	UINT syncInterval = pacingDesc.SyncInterval;
 	UINT presentFlags = 0;
 
-	if (!syncInterval)
+	if (!syncInterval && pacingDesc.bAllowTearing)
 	{
 		presentFlags = DXGI_PRESENT_ALLOW_TEARING;
 	}
@@ -166,6 +203,12 @@ void CD3D12Renderer::Present()
 	// Fence를 Present 앞에 호출: 렌더링 커맨드 완료 시점만 정확히 추적
 	SetFence();
 
+	// 이번 프레임에 미룬 해제는 프레임의 모든 커맨드가 제출된 이 값에 묶는다
+	if (!m_deferredReleaseQueue.AssignFence(m_fenceValue))
+	{
+		__debugbreak();
+	}
+
 	HRESULT hr = m_pSwapChain->Present(syncInterval, presentFlags);
 
 	if (DXGI_ERROR_DEVICE_REMOVED == hr)
@@ -176,9 +219,27 @@ void CD3D12Renderer::Present()
     m_currentRenderTargetIndex = m_pSwapChain->GetCurrentBackBufferIndex();
 
 	// 다음 컨텍스트의 이전 GPU 작업 완료 대기
+	// pacer가 1프레임만 허용하면 방금 제출한 프레임까지 기다려 지연을 줄인다
 	DWORD nextContextIndex = (m_currentContextIndex + 1) % MaxPendingFrameCount;
 	FrameContext& nextCtx = m_frameContexts[nextContextIndex];
-	WaitForFenceValue(nextCtx.LastFenceValue);
+	uint64_t waitFenceValue = nextCtx.LastFenceValue;
+	if (m_framePacer.GetPendingFrameCount() < MaxPendingFrameCount)
+	{
+		waitFenceValue = m_fenceValue;
+	}
+
+	{
+		PROFILE_SCOPE("WaitForFence");
+		WaitForFenceValue(waitFenceValue);
+	}
+
+	// 완료된 컨텍스트의 GPU timestamp 수집 (리셋 전에)
+	m_gpuProfiler->CollectFrame(nextContextIndex);
+
+	// GPU가 끝낸 프레임이 참조하던 객체 해제
+	const uint64_t completedFenceValue = m_pFence->GetCompletedValue();
+	m_queueSyncTracker.OnCompleted(EQueueType::Graphics, completedFenceValue);
+	m_deferredReleaseQueue.ProcessCompleted(completedFenceValue);
 
 	// 다음 컨텍스트의 풀 리셋
 	if (nextCtx.CommandListPool)
@@ -186,6 +247,13 @@ void CD3D12Renderer::Present()
 		nextCtx.CommandListPool->Reset();
 	}
 
+	// compute 리스트는 graphics가 그 결과를 기다렸다면 이미 끝났다. 아니면 compute fence를 기다린다
+	if (nextCtx.ComputeCommandListPool)
+	{
+		WaitForComputeFenceValue(nextCtx.LastComputeFenceValue);
+		nextCtx.ComputeCommandListPool->Reset();
+	}
+
 	for (RenderThreadContext& renderThreadContext : nextCtx.RenderThreadContextList)
 	{
 		if (renderThreadContext.ConstantBufferManager)
@@ -213,61 +281,248 @@ void CD3D12Renderer::Present()
 
 	// 컨텍스트 전환
 	m_currentContextIndex = nextContextIndex;
+
+	// Frame pacing: 스왑체인이 다음 프레임을 받을 수 있을 때까지 대기 후 목표 FPS에 맞춰 대기
+	if (m_frameLatencyWaitableObject)
+	{
+		WaitForSingleObjectEx(m_frameLatencyWaitableObject, 1000, TRUE);
+	}
+	m_framePacer.WaitForFrameSlot();
+	m_framePacer.EndFrame(m_gpuProfiler->GetLastFrameGpuBusyMs() / 1000.0);
+
+	// 프레임 단위 할당 / 해제 집계를 닫고 budget을 검사 (콜백은 이 스레드에서)
+	CMemoryTracker::Get().EndFrame();
 }
 
-bool CD3D12Renderer::UpdateWindowSize(UINT backBufferWidth, UINT backBufferHeight)
+void CD3D12Renderer::SetFramePacing(const FramePacingDesc& desc)
 {
-	bool bResult = false;
+	m_framePacer.SetDesc(desc);
+	if (m_pSwapChain && desc.MaxFrameLatency > 0)
+	{
+		m_pSwapChain->SetMaximumFrameLatency(desc.MaxFrameLatency);
+	}
+}
+
+const FramePacingDesc& CD3D12Renderer::GetFramePacing() const
+{
+	return m_framePacer.GetDesc();
+}
+
+void CD3D12Renderer::GetFrameTimeStats(FrameTimeStats* pOutStats) const
+{
+	m_framePacer.GetFrameTimeStats(pOutStats);
+}
+
+void CD3D12Renderer::GetTextureCacheStats(TextureCacheStats* pOutStats) const
+{
+	m_textureManager->GetCacheStats(pOutStats);
+}
+
+bool CD3D12Renderer::EnableHotReload(const WCHAR* wchTextureRoot)
+{
+	DisableHotReload();
+
+	m_hotReloader = std::make_unique<CHotReloader>();
+	if (!m_hotReloader->Initialize(wchTextureRoot, L"Renderer/Shaders", L"ShaderArchive.bsa"))
+	{
+		m_hotReloader = nullptr;
+		return false;
+	}
+	return true;
+}
+
+void CD3D12Renderer::DisableHotReload()
+{
+	m_hotReloader = nullptr;
+}
 
-	if (backBufferWidth <= 0 || backBufferHeight <= 0 )
+void CD3D12Renderer::ApplyHotReloads()
+{
+	if (!m_hotReloader)
 	{
-		return bResult;
+		return;
 	}
 
-	if (m_viewportWidth == backBufferWidth && m_viewportHeight == backBufferHeight)
+	std::vector<HotReloadTexture> textureList;
+	std::unique_ptr<CShaderArchive> shaderArchive = nullptr;
+	m_hotReloader->TakePendingReloads(&textureList, &shaderArchive);
+
+	bool bInvalidateBundles = false;
+	for (const HotReloadTexture& texture : textureList)
 	{
-		return bResult;
+		// 제출된 프레임이 이전 리소스를 읽고 있을 수 있으므로 GPU가 끝낸 뒤 해제
+		ID3D12Resource* pOldResource = nullptr;
+		if (m_textureManager->ReloadTexture(texture.FilePath.c_str(), texture.Data.data(), texture.Data.size(), texture.ContentHash, &pOldResource))
+		{
+			DeferRelease([pOldResource]() { pOldResource->Release(); });
+			bInvalidateBundles = true;
+		}
 	}
 
-	// 모든 컨텍스트의 GPU 작업 완료 대기
-	SetFence();
-	for (DWORD i = 0; i < MaxPendingFrameCount; i++)
+	if (shaderArchive)
 	{
-		WaitForFenceValue(m_frameContexts[i].LastFenceValue);
+		// PSO는 캐시가 계속 소유하므로 이전 PSO를 쓰는 제출된 프레임은 영향이 없다
+		std::unique_ptr<CShaderArchive> prevShaderArchive = std::move(m_shaderArchive);
+		m_shaderArchive = std::move(shaderArchive);
+		if (!CBasicMeshObject::ReloadPipelineState(this) || !CSpriteObject::ReloadPipelineState(this) || !CStaticMeshGroup::ReloadPipelineState(this))
+		{
+			// 일부만 바뀌지 않도록 이전 아카이브로 모두 되돌린다 (캐시 적중)
+			m_shaderArchive = std::move(prevShaderArchive);
+			CBasicMeshObject::ReloadPipelineState(this);
+			CSpriteObject::ReloadPipelineState(this);
+			CStaticMeshGroup::ReloadPipelineState(this);
+		}
+		bInvalidateBundles = true;
 	}
 
-	DXGI_SWAP_CHAIN_DESC1	desc;
-	HRESULT	hr = m_pSwapChain->GetDesc1(&desc);
-	if (FAILED(hr))
+	// 번들은 텍스처 SRV 복사본과 PSO를 담고 있다
+	if (bInvalidateBundles)
+	{
+		for (CStaticMeshGroup* pStaticMeshGroup : m_staticMeshGroupList)
+		{
+			pStaticMeshGroup->InvalidateBundles();
+		}
+	}
+}
+
+bool CD3D12Renderer::EnableAsyncCompute()
+{
+	if (m_pComputeQueue)
+	{
+		return true;
+	}
+
+	D3D12_COMMAND_QUEUE_DESC computeQueueDesc = {};
+	computeQueueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+	computeQueueDesc.Type = D3D12_COMMAND_LIST_TYPE_COMPUTE;
+	if (FAILED(m_pD3DDevice->CreateCommandQueue(&computeQueueDesc, IID_PPV_ARGS(&m_pComputeQueue))))
+	{
 		__debugbreak();
+		return false;
+	}
 
-	CleanupFramebufferResources();
+	if (FAILED(m_pD3DDevice->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_pComputeFence))))
+	{
+		__debugbreak();
+		CleanupAsyncCompute();
+		return false;
+	}
+	m_computeFenceValue = 0;
+
+	for (FrameContext& ctx : m_frameContexts)
+	{
+		ctx.ComputeCommandListPool = std::make_unique<CCommandListPool>();
+		if (!ctx.ComputeCommandListPool->Initialize(m_pD3DDevice, D3D12_COMMAND_LIST_TYPE_COMPUTE, MaxComputeCommandListCountPerFrame))
+		{
+			__debugbreak();
+			CleanupAsyncCompute();
+			return false;
+		}
+		ctx.LastComputeFenceValue = 0;
+	}
+	return true;
+}
 
-	if (FAILED(m_pSwapChain->ResizeBuffers(SwapChainFrameCount, backBufferWidth, backBufferHeight, DXGI_FORMAT_R8G8B8A8_UNORM, m_swapChainFlags)))
+ID3D12GraphicsCommandList* CD3D12Renderer::BeginComputeCommandList()
+{
+	FrameContext& ctx = m_frameContexts[m_currentContextIndex];
+	if (!ctx.ComputeCommandListPool)
+	{
+		return nullptr;
+	}
+	return ctx.ComputeCommandListPool->GetCurrentCommandList();
+}
+
+QueueSyncPoint CD3D12Renderer::ExecuteComputeCommandList(const QueueSyncPoint* pWaitPoint)
+{
+	FrameContext& ctx = m_frameContexts[m_currentContextIndex];
+	if (!ctx.ComputeCommandListPool)
 	{
 		__debugbreak();
+		return {};
 	}
-	m_currentRenderTargetIndex = m_pSwapChain->GetCurrentBackBufferIndex();
 
-	if (!InitializeFramebufferResources(backBufferWidth, backBufferHeight))
+	// 대기는 같은 큐의 이후 제출에만 걸리므로 실행보다 먼저 기록한다
+	if (pWaitPoint)
+	{
+		ID3D12Fence* pSourceFence = (pWaitPoint->Queue == EQueueType::Compute) ? m_pComputeFence : m_pFence;
+		if (WaitQueue(&m_queueSyncTracker, EQueueType::Compute, m_pComputeQueue, pSourceFence, *pWaitPoint) == EQueueWaitResult::Invalid)
+		{
+			__debugbreak();
+		}
+	}
+
+	ctx.ComputeCommandListPool->CloseAndExecute(m_pComputeQueue);
+
+	m_computeFenceValue++;
+	ctx.LastComputeFenceValue = m_computeFenceValue;
+	return SignalQueue(&m_queueSyncTracker, EQueueType::Compute, m_pComputeQueue, m_pComputeFence, m_computeFenceValue);
+}
+
+QueueSyncPoint CD3D12Renderer::SignalGraphicsQueue()
+{
+	return { EQueueType::Graphics, SetFence() };
+}
+
+void CD3D12Renderer::WaitOnGraphicsQueue(const QueueSyncPoint& syncPoint)
+{
+	ID3D12Fence* pSourceFence = (syncPoint.Queue == EQueueType::Compute) ? m_pComputeFence : m_pFence;
+	if (WaitQueue(&m_queueSyncTracker, EQueueType::Graphics, m_pCommandQueue, pSourceFence, syncPoint) == EQueueWaitResult::Invalid)
 	{
 		__debugbreak();
+	}
+}
+
+bool CD3D12Renderer::UpdateWindowSize(UINT backBufferWidth, UINT backBufferHeight)
+{
+	// 최소화(0 x 0)는 무시하고 이전 크기를 유지한다
+	if (backBufferWidth == 0 || backBufferHeight == 0)
+	{
 		return false;
 	}
 
-	m_viewportWidth = backBufferWidth;
-	m_viewportHeight = backBufferHeight;
-	m_viewport.Width = static_cast<FLOAT>(m_viewportWidth);
-	m_viewport.Height = static_cast<FLOAT>(m_viewportHeight);
+	m_pendingWindowSize.store((static_cast<UINT64>(backBufferWidth) << 32) | backBufferHeight);
+	return true;
+}
 
-	m_scissorRect.left = 0;
-	m_scissorRect.top = 0;
-	m_scissorRect.right = static_cast<LONG>(m_viewportWidth);
-	m_scissorRect.bottom = static_cast<LONG>(m_viewportHeight);
+bool CD3D12Renderer::ApplyPendingResize()
+{
+	const UINT64 pendingWindowSize = m_pendingWindowSize.exchange(0);
+	if (pendingWindowSize == 0)
+	{
+		return false;
+	}
 
-	InitializeCamera();
+	const UINT width = static_cast<UINT>(pendingWindowSize >> 32);
+	const UINT height = static_cast<UINT>(pendingWindowSize & 0xFFFFFFFF);
+	if (width == m_viewportWidth && height == m_viewportHeight)
+	{
+		return false;
+	}
 
-	return bResult = true;
+	if (width > m_framebufferWidth || height > m_framebufferHeight)
+	{
+		// 한 번 키울 때 모니터 크기까지 잡아 두어 이후 드래그는 다시 할당하지 않는다
+		UINT capacityWidth = 0;
+		UINT capacityHeight = 0;
+		GetFramebufferCapacity(m_windowHandle, width, height, &capacityWidth, &capacityHeight);
+		if (!ResizeFramebuffers(capacityWidth, capacityHeight))
+		{
+			__debugbreak();
+			return false;
+		}
+	}
+
+	// 버퍼의 왼쪽 위 영역만 창에 표시된다 (DXGI_SCALING_NONE이므로 1:1)
+	if (FAILED(m_pSwapChain->SetSourceSize(width, height)))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	SetViewportSize(width, height);
+	InitializeCamera();
+	return true;
 }
 
 void* CD3D12Renderer::CreateBasicMeshObject()
@@ -276,10 +531,10 @@ void* CD3D12Renderer::CreateBasicMeshObject()
 	return pMeshObject;
 }
 
-bool CD3D12Renderer::BeginCreateMesh(void* pMeshObjectHandle, const void* pVertexList, UINT vertexCount, UINT vertexSize, UINT triGroupCount)
+bool CD3D12Renderer::BeginCreateMesh(void* pMeshObjectHandle, const void* pVertexList, UINT vertexCount, UINT vertexSize, UINT triGroupCount, UINT optimizeFlags, UINT maxLodCount)
 {
 	CBasicMeshObject* pMeshObj = (CBasicMeshObject*)pMeshObjectHandle;
-	return pMeshObj->BeginCreateMesh(pVertexList, vertexCount, vertexSize, triGroupCount);
+	return pMeshObj->BeginCreateMesh(pVertexList, vertexCount, vertexSize, triGroupCount, optimizeFlags, maxLodCount);
 }
 
 bool CD3D12Renderer::InsertTriGroup(void* pMeshObjectHandle, const WORD* pIndexList, UINT triCount, const WCHAR* wchTexFileName)
@@ -288,10 +543,27 @@ bool CD3D12Renderer::InsertTriGroup(void* pMeshObjectHandle, const WORD* pIndexL
 	return pMeshObj->InsertIndexedTriList(pIndexList, triCount, wchTexFileName);
 }
 
-void CD3D12Renderer::EndCreateMesh(void* pMeshObjectHandle)
+bool CD3D12Renderer::InsertTriGroup(void* pMeshObjectHandle, const UINT* pIndexList, UINT triCount, const WCHAR* wchTexFileName)
 {
 	CBasicMeshObject* pMeshObj = (CBasicMeshObject*)pMeshObjectHandle;
-	pMeshObj->EndCreateMesh();
+	return pMeshObj->InsertIndexedTriList(pIndexList, triCount, wchTexFileName);
+}
+
+bool CD3D12Renderer::EndCreateMesh(void* pMeshObjectHandle)
+{
+	CBasicMeshObject* pMeshObj = (CBasicMeshObject*)pMeshObjectHandle;
+	return pMeshObj->EndCreateMesh();
+}
+
+bool CD3D12Renderer::GetMeshOptimizeStats(void* pMeshObjectHandle, MeshOptimizeStats* pOutStats) const
+{
+	const CBasicMeshObject* pMeshObj = (const CBasicMeshObject*)pMeshObjectHandle;
+	if (!pMeshObj || !pOutStats)
+	{
+		return false;
+	}
+	*pOutStats = pMeshObj->m_optimizeStats;
+	return true;
 }
 
 void CD3D12Renderer::RenderMeshObject(void* pMeshObjectHandle, const XMMATRIX& worldMatrix)
@@ -307,6 +579,7 @@ void CD3D12Renderer::RenderMeshObject(void* pMeshObjectHandle, const XMMATRIX& w
 	renderItem.Type = ERenderItemType::MeshObject;
 	renderItem.MeshItem.pMeshObject = pMeshObj;
 	renderItem.MeshItem.WorldMatrix = worldMatrix;
+	renderItem.MeshItem.LodIndex = pMeshObj->SelectLod(worldMatrix, m_viewMatrix, m_projectionMatrix, static_cast<float>(m_viewportHeight), m_meshLodPixelError);
 
 	if (!pRenderQueue->Add(renderItem))
 	{
@@ -319,14 +592,64 @@ void CD3D12Renderer::RenderMeshObject(void* pMeshObjectHandle, const XMMATRIX& w
 
 void CD3D12Renderer::DeleteBasicMeshObject(void* pMeshObjectHandle)
 {
-	// wait for all commands
-	for (DWORD i = 0; i < MaxPendingFrameCount; i++)
+	// 이번 프레임까지 기록된 커맨드가 끝난 뒤 해제 (GPU 전체 대기 없음)
+	CBasicMeshObject* pMeshObject = (CBasicMeshObject*)pMeshObjectHandle;
+	DeferRelease([pMeshObject]() { delete pMeshObject; });
+}
+
+void* CD3D12Renderer::CreateStaticMeshGroup(UINT maxInstanceCount)
+{
+	CStaticMeshGroup* pStaticMeshGroup = new CStaticMeshGroup(this, maxInstanceCount);
+	m_staticMeshGroupList.push_back(pStaticMeshGroup);
+	return pStaticMeshGroup;
+}
+
+UINT CD3D12Renderer::AddStaticMeshInstance(void* pStaticMeshGroupHandle, void* pMeshObjectHandle, const XMMATRIX& worldMatrix)
+{
+	CStaticMeshGroup* pStaticMeshGroup = (CStaticMeshGroup*)pStaticMeshGroupHandle;
+	CBasicMeshObject* pMeshObj = (CBasicMeshObject*)pMeshObjectHandle;
+	return pStaticMeshGroup->AddInstance(pMeshObj, worldMatrix);
+}
+
+void CD3D12Renderer::SetStaticMeshInstanceTransform(void* pStaticMeshGroupHandle, UINT instanceIndex, const XMMATRIX& worldMatrix)
+{
+	CStaticMeshGroup* pStaticMeshGroup = (CStaticMeshGroup*)pStaticMeshGroupHandle;
+	pStaticMeshGroup->SetInstanceTransform(instanceIndex, worldMatrix);
+}
+
+void CD3D12Renderer::RenderStaticMeshGroup(void* pStaticMeshGroupHandle)
+{
+	CStaticMeshGroup* pStaticMeshGroup = (CStaticMeshGroup*)pStaticMeshGroupHandle;
+	CRenderQueue* pRenderQueue = GetCurrentRenderQueue();
+	if (!pStaticMeshGroup || !pRenderQueue)
 	{
-		WaitForFenceValue(m_frameContexts[i].LastFenceValue);
+		return;
 	}
 
-	CBasicMeshObject* pMeshObject = (CBasicMeshObject*)pMeshObjectHandle;
-	delete pMeshObject;
+	RenderItem renderItem = {};
+	renderItem.Type = ERenderItemType::StaticMeshGroup;
+	renderItem.StaticMeshGroupItem.pStaticMeshGroup = pStaticMeshGroup;
+
+	if (!pRenderQueue->Add(renderItem))
+	{
+		__debugbreak();
+		return;
+	}
+
+	AdvanceRenderThreadIndex();
+}
+
+void CD3D12Renderer::DeleteStaticMeshGroup(void* pStaticMeshGroupHandle)
+{
+	CStaticMeshGroup* pStaticMeshGroup = (CStaticMeshGroup*)pStaticMeshGroupHandle;
+	auto it = std::find(m_staticMeshGroupList.begin(), m_staticMeshGroupList.end(), pStaticMeshGroup);
+	if (it != m_staticMeshGroupList.end())
+	{
+		m_staticMeshGroupList.erase(it);
+	}
+
+	// 목록에서는 바로 빼고, 번들/인스턴스 버퍼는 GPU가 끝난 뒤 해제
+	DeferRelease([pStaticMeshGroup]() { delete pStaticMeshGroup; });
 }
 
 void* CD3D12Renderer::CreateSpriteObject()
@@ -355,14 +678,8 @@ void* CD3D12Renderer::CreateSpriteObject(const WCHAR* wchTexFileName, int posX,
 
 void CD3D12Renderer::DeleteSpriteObject(void* pSpriteObjectHandle)
 {
-	// wait for all commands
-	for (DWORD i = 0; i < MaxPendingFrameCount; i++)
-	{
-		WaitForFenceValue(m_frameContexts[i].LastFenceValue);
-	}
-
 	CSpriteObject* pSpriteObject = (CSpriteObject*)pSpriteObjectHandle;
-	delete pSpriteObject;
+	DeferRelease([pSpriteObject]() { delete pSpriteObject; });
 }
 
 void CD3D12Renderer::RenderSpriteWithTex(void* pSpriteObjectHandle, int posX, int posY, int width, int height, const RECT* pRect, float z, void* pTexHandle)
@@ -422,9 +739,9 @@ void CD3D12Renderer::RenderSprite(void* pSpriteObjectHandle, int posX, int posY,
 	AdvanceRenderThreadIndex();
 }
 
-void CD3D12Renderer::UpdateTextureWithImage(void* pTexHandle, const BYTE* pSrcBits, UINT SrcWidth, UINT SrcHeight)
+void CD3D12Renderer::UpdateTextureWithImage(void* pTexHandle, const BYTE* pSrcBits, UINT SrcWidth, UINT SrcHeight, const RECT* pDirtyRects, UINT dirtyRectCount)
 {
-	m_textureManager->UpdateTextureWithImage((TextureHandle*)pTexHandle, pSrcBits, SrcWidth, SrcHeight);
+	m_textureManager->UpdateTextureWithImage((TextureHandle*)pTexHandle, pSrcBits, SrcWidth, SrcHeight, pDirtyRects, dirtyRectCount);
 }
 
 void* CD3D12Renderer::CreateTiledTexture(UINT texWidth, UINT texHeight, BYTE r, BYTE g, BYTE b)
@@ -480,13 +797,9 @@ void* CD3D12Renderer::CreateTextureFromFile(const WCHAR* filePath)
 
 void CD3D12Renderer::DeleteTexture(void* pTextureHandle)
 {
-	// GPU 작업 완료 대기 (fence는 renderer 소유)
-	for (DWORD i = 0; i < MaxPendingFrameCount; i++)
-	{
-		WaitForFenceValue(m_frameContexts[i].LastFenceValue);
-	}
-
-	m_textureManager->DeleteTexture((TextureHandle*)pTextureHandle);
+	// 참조 카운트가 0이 되는 시점도 GPU 완료 뒤로 미룬다 (fence는 renderer 소유)
+	TextureHandle* pTexHandle = (TextureHandle*)pTextureHandle;
+	DeferRelease([this, pTexHandle]() { m_textureManager->DeleteTexture(pTexHandle); });
 }
 
 void CD3D12Renderer::GetViewProjMatrix(XMMATRIX* pOutViewMatrix, XMMATRIX* pOutProjMatrix)
@@ -495,6 +808,15 @@ void CD3D12Renderer::GetViewProjMatrix(XMMATRIX* pOutViewMatrix, XMMATRIX* pOutP
 	*pOutProjMatrix = m_projectionMatrix;
 }
 
+// 카메라 상태를 바꾸지 않고 주어진 위치 기준의 view/proj를 계산 (렌더 기록과 동시에 호출 가능)
+void CD3D12Renderer::GetViewProjMatrixAt(float cameraX, float cameraY, float cameraZ, XMMATRIX* pOutViewMatrix, XMMATRIX* pOutProjMatrix) const
+{
+	XMVECTOR cameraPos = XMVectorSet(cameraX, cameraY, cameraZ, 1.0f);
+	XMVECTOR upDir = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+	*pOutViewMatrix = XMMatrixLookToLH(cameraPos, m_cameraDir, upDir);
+	*pOutProjMatrix = m_projectionMatrix;
+}
+
 void CD3D12Renderer::SetCameraPos(float x, float y, float z)
 {
 	m_cameraPos = XMVectorSet(x, y, z, 1.0f);
@@ -613,8 +935,13 @@ bool CD3D12Renderer::Initialize(HWND hWindow, bool bEnableDebugLayer, bool bEnab
 	::GetClientRect(hWindow, &ClientRect);
 	DWORD	wndWidth = ClientRect.right - ClientRect.left;
 	DWORD	wndHeight = ClientRect.bottom - ClientRect.top;
-	UINT	backBufferWidth = ClientRect.right - ClientRect.left;
-	UINT	backBufferHeight = ClientRect.bottom - ClientRect.top;
+	UINT	viewportWidth = (std::max)(1u, static_cast<UINT>(wndWidth));		// 최소화 상태로 시작해도 0 크기를 만들지 않는다
+	UINT	viewportHeight = (std::max)(1u, static_cast<UINT>(wndHeight));
+
+	// 스왑체인 / 깊이 버퍼는 처음부터 모니터 크기로 만들고 창 크기만큼만 그린다 (ApplyPendingResize)
+	UINT	backBufferWidth = 0;
+	UINT	backBufferHeight = 0;
+	GetFramebufferCapacity(hWindow, viewportWidth, viewportHeight, &backBufferWidth, &backBufferHeight);
 
 	//Make swap chain
 
@@ -632,6 +959,7 @@ bool CD3D12Renderer::Initialize(HWND hWindow, bool bEnableDebugLayer, bool bEnab
 	SwapChainDesc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
 	SwapChainDesc.AlphaMode = DXGI_ALPHA_MODE_IGNORE;
 	SwapChainDesc.Flags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+	SwapChainDesc.Flags |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
 	m_swapChainFlags = SwapChainDesc.Flags;
 
 	DXGI_SWAP_CHAIN_FULLSCREEN_DESC swapChainFullscreenDesc = {};
@@ -647,24 +975,30 @@ bool CD3D12Renderer::Initialize(HWND hWindow, bool bEnableDebugLayer, bool bEnab
 
 	assert(m_pSwapChain != nullptr && "CD3D12Renderer::Initialize , Swap chain 3 is not valid ");
 	m_currentRenderTargetIndex = m_pSwapChain->GetCurrentBackBufferIndex();
+	m_framebufferWidth = backBufferWidth;
+	m_framebufferHeight = backBufferHeight;
+	m_pSwapChain->SetSourceSize(viewportWidth, viewportHeight);
+
+	// Frame pacing
+	m_frameClock = std::make_unique<CHighResolutionFrameClock>();
+	FramePacingDesc framePacingDesc = {};
+	if (!m_framePacer.Initialize(m_frameClock.get(), MaxPendingFrameCount, framePacingDesc))
+	{
+		__debugbreak();
+		return false;
+	}
+	m_pSwapChain->SetMaximumFrameLatency(framePacingDesc.MaxFrameLatency);
+	m_frameLatencyWaitableObject = m_pSwapChain->GetFrameLatencyWaitableObject();
 	//~ Make swap chain
 
 	// set viewport and scissor rect
-	m_viewport.Width = static_cast<float>(wndWidth);
-	m_viewport.Height = static_cast<float>(wndHeight);
 	m_viewport.MaxDepth = 1.f;
 	m_viewport.MinDepth = 0.f;
-
-	m_scissorRect.left = 0;
-	m_scissorRect.right = static_cast<LONG>(wndWidth);
-	m_scissorRect.top = 0;
-	m_scissorRect.bottom = static_cast<LONG>(wndHeight);
-
-	m_viewportWidth = wndWidth;
-	m_viewportHeight = wndHeight;
+	SetViewportSize(viewportWidth, viewportHeight);
 	// ~set viewport and scissor rect
 
-	UINT renderThreadCount = std::thread::hardware_concurrency();
+	// 커맨드 리스트 기록은 코어 하나를 꽉 채우는 작업이라 SMT 형제 스레드로는 거의 빨라지지 않는다
+	UINT renderThreadCount = GetProcessorTopology().GetPhysicalCoreCount();
 	if (renderThreadCount == 0)
 	{
 		renderThreadCount = 1;
@@ -677,7 +1011,7 @@ bool CD3D12Renderer::Initialize(HWND hWindow, bool bEnableDebugLayer, bool bEnab
 	m_renderThreadCount = renderThreadCount;
 	m_currentRenderThreadIndex = 0;
 
-	if (!InitializeFramebufferResources(wndWidth, wndHeight))
+	if (!InitializeFramebufferResources(m_framebufferWidth, m_framebufferHeight))
 	{
 		__debugbreak();
 		return false;
@@ -689,6 +1023,36 @@ bool CD3D12Renderer::Initialize(HWND hWindow, bool bEnableDebugLayer, bool bEnab
 	}
 	CreateFence();
 
+	m_gpuProfiler = std::make_unique<CGpuProfiler>();
+	if (!m_gpuProfiler->Initialize(m_pD3DDevice, m_pCommandQueue, MaxPendingFrameCount))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	// 렌더 오브젝트가 InitPipelineState에서 사용하므로 오브젝트 생성 전에 준비
+	// 셰이더는 BengalsShaderBuild가 빌드 전에 컴파일해 둔 아카이브에서만 읽는다
+	m_shaderArchive = std::make_unique<CShaderArchive>();
+	if (!m_shaderArchive->ReadFromFile(L"ShaderArchive.bsa"))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	// 선택: BengalsAssetBuild가 만든 리소스 아카이브. 한 번 매핑하고 텍스처 등은 여기서 먼저 찾는다
+	m_assetArchive = std::make_unique<CAssetArchive>();
+	if (!m_assetArchive->Open(L"Assets.bpk"))
+	{
+		m_assetArchive = nullptr;
+	}
+
+	m_pipelineStateCache = std::make_unique<CPipelineStateCache>();
+	if (!m_pipelineStateCache->Initialize(m_pD3DDevice, L"BengalsPipelineCache"))
+	{
+		__debugbreak();
+		return false;
+	}
+
 	InitializeCamera();
 
 	m_persistentCpuDescriptorAllocator = std::make_unique<CPersistentCpuDescriptorAllocator>();
@@ -706,7 +1070,8 @@ bool CD3D12Renderer::Initialize(HWND hWindow, bool bEnableDebugLayer, bool bEnab
 		__debugbreak();
 		return false;
 	}
-	if (!InitializeRenderThreadPool())
+	// 공유 워커 풀을 받은 경우 전용 렌더 스레드를 만들지 않는다
+	if (!m_pWorkerPool && !InitializeRenderThreadPool())
 	{
 		__debugbreak();
 		return false;
@@ -718,11 +1083,19 @@ bool CD3D12Renderer::Initialize(HWND hWindow, bool bEnableDebugLayer, bool bEnab
 UINT64 CD3D12Renderer::SetFence()
 {
 	m_fenceValue++;
-	m_pCommandQueue->Signal(m_pFence, m_fenceValue);
+	SignalQueue(&m_queueSyncTracker, EQueueType::Graphics, m_pCommandQueue, m_pFence, m_fenceValue);
 	m_frameContexts[m_currentContextIndex].LastFenceValue = m_fenceValue;
 	return m_fenceValue;
 }
 
+void CD3D12Renderer::DeferRelease(CDeferredReleaseQueue::ReleaseFunc func)
+{
+	if (!m_deferredReleaseQueue.EnqueueForNextFence(std::move(func)))
+	{
+		__debugbreak();
+	}
+}
+
 void CD3D12Renderer::WaitForFenceValue(uint64_t expectedFenceValue) const
 {
 	if (m_pFence->GetCompletedValue() < expectedFenceValue)
@@ -732,6 +1105,21 @@ void CD3D12Renderer::WaitForFenceValue(uint64_t expectedFenceValue) const
 	}
 }
 
+void CD3D12Renderer::WaitForComputeFenceValue(uint64_t expectedFenceValue)
+{
+	if (!m_pComputeFence || m_queueSyncTracker.IsCompleted({ EQueueType::Compute, expectedFenceValue }))
+	{
+		return;
+	}
+
+	if (m_pComputeFence->GetCompletedValue() < expectedFenceValue)
+	{
+		m_pComputeFence->SetEventOnCompletion(expectedFenceValue, m_fenceEvent);
+		WaitForSingleObject(m_fenceEvent, INFINITE);
+	}
+	m_queueSyncTracker.OnCompleted(EQueueType::Compute, m_pComputeFence->GetCompletedValue());
+}
+
 void CD3D12Renderer::CreateFence()
 {
 	if (FAILED(m_pD3DDevice->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_pFence))))
@@ -825,6 +1213,14 @@ bool CD3D12Renderer::InitializeRenderThreadPool()
 		return true;
 	}
 
+	// 코어가 충분하면 메인 스레드 코어를 피해 렌더 스레드마다 물리 코어 하나씩
+	std::vector<uint32_t> affinityList;
+	const ProcessorTopology& topology = GetProcessorTopology();
+	if (m_renderThreadCount < topology.GetPhysicalCoreCount())
+	{
+		GetWorkerAffinityList(topology, 1, &affinityList);
+	}
+
 	m_renderThreadDescList.clear();
 	m_renderThreadDescList.resize(m_renderThreadCount);
 	for (DWORD threadIndex = 0; threadIndex < m_renderThreadCount; threadIndex++)
@@ -832,6 +1228,7 @@ bool CD3D12Renderer::InitializeRenderThreadPool()
 		RenderThreadDesc& renderThreadDesc = m_renderThreadDescList[threadIndex];
 		renderThreadDesc.Renderer = this;
 		renderThreadDesc.ThreadIndex = threadIndex;
+		renderThreadDesc.LogicalProcessorIndex = (threadIndex < affinityList.size()) ? affinityList[threadIndex] : UINT_MAX;
 		renderThreadDesc.CompleteEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
 		if (!renderThreadDesc.CompleteEvent)
 		{
@@ -914,6 +1311,7 @@ bool CD3D12Renderer::CreateFramebufferDescriptorHeaps()
 		return false;
 	}
 
+	TagGpuMemory(m_pD3DDevice, m_pRtvDescriptorHeap);
 	m_rtvDescriptorSize = m_pD3DDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
 
 	D3D12_DESCRIPTOR_HEAP_DESC dsvDescriptorHeapDesc = {};
@@ -926,6 +1324,7 @@ bool CD3D12Renderer::CreateFramebufferDescriptorHeaps()
 		return false;
 	}
 
+	TagGpuMemory(m_pD3DDevice, m_pDsvDescriptorHeap);
 	m_dsvDescriptorSize = m_pD3DDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV);
 
 	return true;
@@ -948,7 +1347,10 @@ bool CD3D12Renderer::CreateRenderTargetViews()
 			return false;
 		}
 
+		// 스왑체인이 소유하는 버퍼도 태그한다 (ResizeBuffers에서 해제되면 기록이 빠진다)
+		TagGpuMemory(m_pD3DDevice, m_pRenderTargets[n], EMemoryCategory::RenderTarget);
 		m_pD3DDevice->CreateRenderTargetView(m_pRenderTargets[n], nullptr, rtvDescriptorHandle);
+		m_resourceStateTracker.RegisterResource(m_pRenderTargets[n], D3D12_RESOURCE_STATE_PRESENT);
 		rtvDescriptorHandle.Offset(1, m_rtvDescriptorSize);
 	}
 
@@ -995,6 +1397,7 @@ bool CD3D12Renderer::CreateDepthStencilBufferAndView(UINT width, UINT height)
 	}
 
 	m_pDepthStencilBuffer->SetName(L"CD3D12Renderer::DepthStencilBuffer");
+	TagGpuMemory(m_pD3DDevice, m_pDepthStencilBuffer, EMemoryCategory::RenderTarget);
 
 	D3D12_DEPTH_STENCIL_VIEW_DESC depthStencilViewDesc = {};
 	depthStencilViewDesc.Format = DXGI_FORMAT_D32_FLOAT;
@@ -1007,6 +1410,48 @@ bool CD3D12Renderer::CreateDepthStencilBufferAndView(UINT width, UINT height)
 	return true;
 }
 
+bool CD3D12Renderer::ResizeFramebuffers(UINT width, UINT height)
+{
+	// back buffer 참조가 남아 있으면 ResizeBuffers가 실패하므로 모든 컨텍스트의 GPU 작업 완료 대기
+	SetFence();
+	for (DWORD i = 0; i < MaxPendingFrameCount; i++)
+	{
+		WaitForFenceValue(m_frameContexts[i].LastFenceValue);
+	}
+
+	CleanupFramebufferResources();
+
+	if (FAILED(m_pSwapChain->ResizeBuffers(SwapChainFrameCount, width, height, DXGI_FORMAT_R8G8B8A8_UNORM, m_swapChainFlags)))
+	{
+		__debugbreak();
+		return false;
+	}
+	m_currentRenderTargetIndex = m_pSwapChain->GetCurrentBackBufferIndex();
+
+	if (!InitializeFramebufferResources(width, height))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	m_framebufferWidth = width;
+	m_framebufferHeight = height;
+	return true;
+}
+
+void CD3D12Renderer::SetViewportSize(UINT width, UINT height)
+{
+	m_viewportWidth = width;
+	m_viewportHeight = height;
+	m_viewport.Width = static_cast<FLOAT>(width);
+	m_viewport.Height = static_cast<FLOAT>(height);
+
+	m_scissorRect.left = 0;
+	m_scissorRect.top = 0;
+	m_scissorRect.right = static_cast<LONG>(width);
+	m_scissorRect.bottom = static_cast<LONG>(height);
+}
+
 void CD3D12Renderer::InitializeCamera()
 {
 	m_cameraPos = XMVectorSet(0.0f, 0.0f, -1.0f, 1.0f);
@@ -1049,8 +1494,61 @@ void CD3D12Renderer::AdvanceRenderThreadIndex()
 	m_currentRenderThreadIndex %= m_renderThreadCount;
 }
 
+void CD3D12Renderer::ProcessRenderQueues(const std::vector<DWORD>& activeThreadIndexList)
+{
+	PROFILE_SCOPE("ProcessRenderQueues");
+
+	if (activeThreadIndexList.empty())
+	{
+		return;
+	}
+
+	if (m_pWorkerPool)
+	{
+		std::atomic<UINT> pendingJobCounter = 0;
+		for (DWORD threadIndex : activeThreadIndexList)
+		{
+			m_pWorkerPool->Submit([this, threadIndex]() { ProcessByThread(threadIndex); }, &pendingJobCounter);
+		}
+		m_pWorkerPool->Wait(pendingJobCounter);
+		return;
+	}
+
+	std::vector<HANDLE> completeEventList = {};
+	completeEventList.reserve(activeThreadIndexList.size());
+	for (DWORD threadIndex : activeThreadIndexList)
+	{
+		if (threadIndex >= m_renderThreadDescList.size())
+		{
+			__debugbreak();
+			continue;
+		}
+
+		RenderThreadDesc& renderThreadDesc = m_renderThreadDescList[threadIndex];
+		if (!renderThreadDesc.ThreadHandle || !renderThreadDesc.EventList[RenderThreadEventTypeProcess] || !renderThreadDesc.CompleteEvent)
+		{
+			__debugbreak();
+			continue;
+		}
+
+		completeEventList.push_back(renderThreadDesc.CompleteEvent);
+		SetEvent(renderThreadDesc.EventList[RenderThreadEventTypeProcess]);
+	}
+
+	if (!completeEventList.empty())
+	{
+		DWORD waitResult = WaitForMultipleObjects(static_cast<DWORD>(completeEventList.size()), completeEventList.data(), TRUE, INFINITE);
+		if (waitResult == WAIT_FAILED)
+		{
+			__debugbreak();
+		}
+	}
+}
+
 void CD3D12Renderer::ProcessByThread(DWORD renderThreadIndex)
 {
+	PROFILE_SCOPE("ProcessByThread");
+
 	FrameContext& ctx = m_frameContexts[m_currentContextIndex];
 	if (renderThreadIndex >= ctx.RenderThreadContextList.size())
 	{
@@ -1091,17 +1589,32 @@ void CD3D12Renderer::ProcessByThread(DWORD renderThreadIndex)
 
 void CD3D12Renderer::Cleanup()
 {
+	// 감시 스레드를 먼저 멈춘다
+	m_hotReloader = nullptr;
+
 	// 모든 컨텍스트의 GPU 작업 완료 보장
 	SetFence();
 	for (DWORD i = 0; i < MaxPendingFrameCount; i++)
 	{
 		WaitForFenceValue(m_frameContexts[i].LastFenceValue);
+		WaitForComputeFenceValue(m_frameContexts[i].LastComputeFenceValue);
 	}
+	CleanupAsyncCompute();
 
+	// 대기 중인 해제 처리 (texture manager보다 먼저; 메시 해제가 텍스처 해제를 추가할 수 있다)
+	m_deferredReleaseQueue.Flush();
 
 	CleanupRenderThreadPool();
 
+	m_gpuProfiler = nullptr;
+	if (m_pipelineStateCache)
+	{
+		m_pipelineStateCache->Save();
+		m_pipelineStateCache = nullptr;
+	}
+	m_shaderArchive = nullptr;
 	m_textureManager = nullptr;
+	m_assetArchive = nullptr;
 	m_resourceManager = nullptr;
 	m_persistentCpuDescriptorAllocator = nullptr;
 	m_renderThreadCount = 1;
@@ -1110,6 +1623,12 @@ void CD3D12Renderer::Cleanup()
 	CleanupFramebufferResources();
 	CleanupFramebufferDescriptorHeaps();
 
+	if (m_frameLatencyWaitableObject)
+	{
+		CloseHandle(m_frameLatencyWaitableObject);
+		m_frameLatencyWaitableObject = nullptr;
+	}
+
 	if (m_pSwapChain)
 	{
 		m_pSwapChain->Release();
@@ -1161,6 +1680,29 @@ void CD3D12Renderer::CleanupFence()
 	m_fenceValue = 0;
 }
 
+void CD3D12Renderer::CleanupAsyncCompute()
+{
+	for (FrameContext& ctx : m_frameContexts)
+	{
+		ctx.ComputeCommandListPool = nullptr;
+		ctx.LastComputeFenceValue = 0;
+	}
+
+	if (m_pComputeFence)
+	{
+		m_pComputeFence->Release();
+		m_pComputeFence = nullptr;
+	}
+
+	if (m_pComputeQueue)
+	{
+		m_pComputeQueue->Release();
+		m_pComputeQueue = nullptr;
+	}
+
+	m_computeFenceValue = 0;
+}
+
 void CD3D12Renderer::CleanupFrameContexts()
 {
 	for (FrameContext& ctx : m_frameContexts)
@@ -1233,6 +1775,7 @@ void CD3D12Renderer::CleanupFramebufferResources()
 	{
 		if (pRenderTarget)
 		{
+			m_resourceStateTracker.UnregisterResource(pRenderTarget);
 			pRenderTarget->Release();
 			pRenderTarget = nullptr;
 		}
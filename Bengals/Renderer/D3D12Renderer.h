@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -14,11 +15,25 @@ class CD3D12ResourceManager;
 class CPersistentCpuDescriptorAllocator;
 class CConstantBufferManager;
 class CTextureManager;
+struct TextureCacheStats;
+class CWorkerPool;
+class CHighResolutionFrameClock;
+class CGpuProfiler;
+class CPipelineStateCache;
+class CShaderArchive;
+class CAssetArchive;
+class CHotReloader;
+class CStaticMeshGroup;
 
 #include "RenderHelper/FrameGpuDescriptorAllocator.h"
 #include "RenderHelper/CommandListPool.h"
 #include "RenderHelper/ConstantBufferManager.h"
 #include "RenderHelper/RenderThread.h"
+#include "RenderHelper/FramePacer.h"
+#include "RenderHelper/ResourceStateTracker.h"
+#include "RenderHelper/MeshOptimizer.h"
+#include "RenderHelper/DeferredReleaseQueue.h"
+#include "RenderHelper/QueueSyncTracker.h"
 
 struct RenderThreadContext
 {
@@ -39,21 +54,48 @@ struct RenderThreadContext
 struct FrameContext
 {
 	std::unique_ptr<CCommandListPool> CommandListPool = nullptr;
+	std::unique_ptr<CCommandListPool> ComputeCommandListPool = nullptr;		// EnableAsyncCompute 전에는 nullptr
 	std::vector<RenderThreadContext> RenderThreadContextList = {};
 	uint64_t LastFenceValue = 0;
+	uint64_t LastComputeFenceValue = 0;
 };
 
 class CD3D12Renderer
 {
 public:/*function*/
 	CD3D12Renderer() = delete;
-	CD3D12Renderer(HWND hWindow, bool bEnableDebugLayer = true, bool bEnableGbv = true);
+	CD3D12Renderer(HWND hWindow, bool bEnableDebugLayer = true, bool bEnableGbv = true, CWorkerPool* pWorkerPool = nullptr);
 	virtual ~CD3D12Renderer();
 
 	void BeginRender();
 	void EndRender();
 	void Present();
 
+	void SetFramePacing(const FramePacingDesc& desc);
+	const FramePacingDesc& GetFramePacing() const;
+	void GetFrameTimeStats(FrameTimeStats* pOutStats) const;
+	// 파일 텍스처 캐시 (경로 / 내용 중복 제거) 적중률과 절약한 메모리
+	void GetTextureCacheStats(TextureCacheStats* pOutStats) const;
+
+	// 개발용: wchTextureRoot 아래의 DDS와 셰이더 소스를 감시해 바뀌면 다음 BeginRender에서 교체한다
+	bool EnableHotReload(const WCHAR* wchTextureRoot);
+	void DisableHotReload();
+
+	// 비동기 compute 큐 (GPU 컬링, 파티클 등). BeginRender와 같은 스레드에서 프레임 기록 중에 사용
+	bool EnableAsyncCompute();
+	bool IsAsyncComputeEnabled() const
+	{
+		return m_pComputeQueue != nullptr;
+	}
+	// 현재 프레임 컨텍스트의 compute 리스트. 켜지 않았으면 nullptr
+	ID3D12GraphicsCommandList* BeginComputeCommandList();
+	// 기록한 compute 리스트를 제출하고 완료 지점을 반환. pWaitPoint가 있으면 compute 큐가 먼저 기다린다
+	QueueSyncPoint ExecuteComputeCommandList(const QueueSyncPoint* pWaitPoint = nullptr);
+	// 지금까지 graphics 큐에 제출한 작업의 완료 지점 (compute가 그 결과를 읽을 때)
+	QueueSyncPoint SignalGraphicsQueue();
+	// 이후 graphics 큐에 제출하는 작업이 syncPoint를 GPU에서 기다린다
+	void WaitOnGraphicsQueue(const QueueSyncPoint& syncPoint);
+
 	/* Getter function*/
 
 	ID3D12Device5* GetD3DDevice() const
@@ -98,6 +140,43 @@ public:/*function*/
 		return ctx.RenderThreadContextList[renderThreadIndex].ConstantBufferManager->GetConstantBufferPool(type);
 	}
 
+	// 렌더러 스레드 전용. 동적 텍스처 / 인스턴스 버퍼처럼 프레임마다 복사되는 리소스를 수명 동안 등록한다
+	CResourceStateTracker* GetResourceStateTracker()
+	{
+		return &m_resourceStateTracker;
+	}
+
+	CGpuProfiler* GetGpuProfiler() const
+	{
+		return m_gpuProfiler.get();
+	}
+
+	CPipelineStateCache* GetPipelineStateCache() const
+	{
+		return m_pipelineStateCache.get();
+	}
+
+	const CShaderArchive* GetShaderArchive() const
+	{
+		return m_shaderArchive.get();
+	}
+
+	// Assets.bpk가 없으면 nullptr (파일에서 직접 읽는다)
+	const CAssetArchive* GetAssetArchive() const
+	{
+		return m_assetArchive.get();
+	}
+
+	DWORD GetCurrentContextIndex() const
+	{
+		return m_currentContextIndex;
+	}
+
+	UINT GetFrameContextCount() const
+	{
+		return MaxPendingFrameCount;
+	}
+
 	UINT GetScreenWidth() const
 	{
 		return m_viewportWidth;
@@ -108,21 +187,43 @@ public:/*function*/
 		return m_viewportHeight;
 	}
 
+	// 크기만 기록하고 바로 반환한다 (드래그 중 연속된 WM_SIZE는 마지막 값으로 합쳐짐)
 	bool UpdateWindowSize(UINT backBufferWidth, UINT backBufferHeight);
+	// 프레임 경계(기록 / 제출 중이 아닐 때)에서 호출. viewport 크기가 바뀌었으면 true
+	// 스왑체인 / 깊이 버퍼보다 작으면 viewport만 줄이고, 더 커질 때만 GPU를 비우고 다시 만든다
+	bool ApplyPendingResize();
 
 	void* CreateBasicMeshObject();
-	bool BeginCreateMesh(void* pMeshObjectHandle, const void* pVertexList, UINT vertexCount, UINT vertexSize, UINT triGroupCount);
+	// optimizeFlags: EMeshOptimizeFlag 조합. EndCreateMesh에서 최적화 후 업로드
+	// maxLodCount > 1이면 quadric 단순화로 LOD 인덱스를 만들고, 그릴 때 화면 오차로 LOD를 고른다
+	// MeshOptimizeQuantize는 VertexPos3Color4Tex2 정점만 받는다 (16 bytes로 압축해 업로드)
+	bool BeginCreateMesh(void* pMeshObjectHandle, const void* pVertexList, UINT vertexCount, UINT vertexSize, UINT triGroupCount, UINT optimizeFlags = MeshOptimizeNone, UINT maxLodCount = 1);
+	// 16 / 32비트 인덱스 모두 받는다. 업로드할 인덱스 폭은 EndCreateMesh가 tri group마다 고른다
 	bool InsertTriGroup(void* pMeshObjectHandle, const WORD* pIndexList, UINT triCount, const WCHAR* wchTexFileName);
-	void EndCreateMesh(void* pMeshObjectHandle);
+	bool InsertTriGroup(void* pMeshObjectHandle, const UINT* pIndexList, UINT triCount, const WCHAR* wchTexFileName);
+	bool EndCreateMesh(void* pMeshObjectHandle);
+	bool GetMeshOptimizeStats(void* pMeshObjectHandle, MeshOptimizeStats* pOutStats) const;
 	void RenderMeshObject(void* pMeshObjectHandle, const XMMATRIX& worldMatrix);
+	// LOD 단순화 오차가 화면에서 이 픽셀 수를 넘지 않는 가장 낮은 LOD를 쓴다
+	void SetMeshLodPixelError(float maxPixelError)
+	{
+		m_meshLodPixelError = maxPixelError;
+	}
 	void DeleteBasicMeshObject(void* pMeshObjectHandle);
 
+	// 정적 메시 그룹: 인스턴스를 미리 기록된 번들로 그린다. 그룹을 메시보다 먼저 삭제해야 한다
+	void* CreateStaticMeshGroup(UINT maxInstanceCount);
+	UINT AddStaticMeshInstance(void* pStaticMeshGroupHandle, void* pMeshObjectHandle, const XMMATRIX& worldMatrix);
+	void SetStaticMeshInstanceTransform(void* pStaticMeshGroupHandle, UINT instanceIndex, const XMMATRIX& worldMatrix);
+	void RenderStaticMeshGroup(void* pStaticMeshGroupHandle);
+	void DeleteStaticMeshGroup(void* pStaticMeshGroupHandle);
+
 	void* CreateSpriteObject();
 	void* CreateSpriteObject(const WCHAR* wchTexFileName, int posX, int posY, int width, int height);
 	void DeleteSpriteObject(void* pSpriteObjectHandle);
 	void RenderSpriteWithTex(void* pSpriteObjectHandle, int posX, int posY, int width, int height, const RECT* pRect, float z, void* pTexHandle);
 	void RenderSprite(void* pSpriteObjectHandle, int posX, int posY, int width, int height, float z);
-	void UpdateTextureWithImage(void* pTexHandle, const BYTE* pSrcBits, UINT SrcWidth, UINT SrcHeight);
+	void UpdateTextureWithImage(void* pTexHandle, const BYTE* pSrcBits, UINT SrcWidth, UINT SrcHeight, const RECT* pDirtyRects = nullptr, UINT dirtyRectCount = 0);
 
 	void* CreateTiledTexture(UINT texWidth, UINT texHeight, BYTE r, BYTE g, BYTE b);
 	void* CreateDynamicTexture(UINT texWidth, UINT texHeight);
@@ -130,6 +231,7 @@ public:/*function*/
 	void DeleteTexture(void* pTextureHandle);
 
 	void GetViewProjMatrix(XMMATRIX* pOutViewMatrix, XMMATRIX* pOutProjMatrix);
+	void GetViewProjMatrixAt(float cameraX, float cameraY, float cameraZ, XMMATRIX* pOutViewMatrix, XMMATRIX* pOutProjMatrix) const;
 
 	void SetCameraPos(float x, float y, float z);
 	void MoveCamera(float dx, float dy, float dz);
@@ -140,6 +242,11 @@ private:
 
 	UINT64 SetFence();
 	void WaitForFenceValue(uint64_t expectedFenceValue) const;
+	// graphics 완료로 이미 보장되면 fence를 확인하지 않는다
+	void WaitForComputeFenceValue(uint64_t expectedFenceValue);
+	// 이번 프레임의 끝(Present 앞 SetFence)이 완료되면 func 실행.
+	// 프레임 중간의 SignalGraphicsQueue 값은 그 뒤에 제출될 커맨드를 포함하지 않으므로 쓰지 않는다
+	void DeferRelease(CDeferredReleaseQueue::ReleaseFunc func);
 
 	void	CreateFence();
 	bool	InitializeFrameContexts();
@@ -151,14 +258,22 @@ private:
 	bool	CreateFramebufferDescriptorHeaps();
 	bool	CreateRenderTargetViews();
 	bool	CreateDepthStencilBufferAndView(UINT width, UINT height);
+	bool	ResizeFramebuffers(UINT width, UINT height);
+	void	SetViewportSize(UINT width, UINT height);
 
 	void	InitializeCamera();
 
+	// BeginRender 시작에서 호출. 감시 스레드가 준비한 텍스처 / 셰이더 아카이브를 적용
+	void	ApplyHotReloads();
+
+	void	ProcessRenderQueues(const std::vector<DWORD>& activeThreadIndexList);
+
 	CRenderQueue* GetCurrentRenderQueue() const;
 	void	AdvanceRenderThreadIndex();
 
 	void	Cleanup();
 	void	CleanupFence();
+	void	CleanupAsyncCompute();
 	void	CleanupFrameContexts();
 	void	CleanupCommandListPool(FrameContext& ctx);
 	void	CleanupRenderThreadContext(RenderThreadContext& renderThreadContext);
@@ -171,19 +286,30 @@ private:
 	static constexpr uint32_t SwapChainFrameCount = 3;
 	static constexpr uint32_t MaxPendingFrameCount = SwapChainFrameCount - 1;
 	static constexpr uint32_t MaxCommandListCountPerFrame = 256;
+	static constexpr uint32_t MaxComputeCommandListCountPerFrame = 16;
 	static constexpr uint32_t MaxDrawCountPerFrame = 4096;
 	static constexpr uint32_t MaxRenderThreadCount = 8;
 	static constexpr uint32_t MaxDescriptorCount = 4096;
+	static constexpr float DefaultMeshLodPixelError = 1.0f;
 
 	HWND m_windowHandle = nullptr;
 
 	ID3D12Device5* m_pD3DDevice = nullptr;
 	ID3D12CommandQueue* m_pCommandQueue = nullptr;
+	ID3D12CommandQueue* m_pComputeQueue = nullptr;
+	ID3D12Fence* m_pComputeFence = nullptr;
+	uint64_t m_computeFenceValue = 0;
+	CQueueSyncTracker m_queueSyncTracker;		// graphics / compute fence 기록과 큐 사이 대기
 
 	IDXGISwapChain3* m_pSwapChain = nullptr;
 	UINT m_swapChainFlags = 0;
+	HANDLE m_frameLatencyWaitableObject = nullptr;
+
+	std::unique_ptr<CHighResolutionFrameClock> m_frameClock = nullptr;
+	CFramePacer m_framePacer;
 
 	std::array<ID3D12Resource*, SwapChainFrameCount> m_pRenderTargets = {};
+	CResourceStateTracker m_resourceStateTracker;		// back buffer (PRESENT <-> RENDER_TARGET), 동적 텍스처, 인스턴스 버퍼
 	ID3D12Resource* m_pDepthStencilBuffer = nullptr;
 
 	ID3D12DescriptorHeap* m_pRtvDescriptorHeap = nullptr;
@@ -199,16 +325,27 @@ private:
 	uint64_t m_fenceValue = 0;
 	HANDLE m_fenceEvent = nullptr;
 	ID3D12Fence* m_pFence = nullptr;
+	CDeferredReleaseQueue m_deferredReleaseQueue;		// Delete*: 다음 SetFence 값이 완료되면 해제
 
 	D3D12_VIEWPORT m_viewport = {};
 	D3D12_RECT m_scissorRect = {};
 	UINT m_viewportWidth = 0;
 	UINT m_viewportHeight = 0;
+	UINT m_framebufferWidth = 0;		// 스왑체인 / 깊이 버퍼 크기 (>= viewport, 처음엔 모니터 크기)
+	UINT m_framebufferHeight = 0;
+	std::atomic<UINT64> m_pendingWindowSize = 0;		// (width << 32) | height, 0 = 요청 없음
 
 	std::unique_ptr<CD3D12ResourceManager> m_resourceManager = nullptr;
 	std::unique_ptr<CPersistentCpuDescriptorAllocator> m_persistentCpuDescriptorAllocator = nullptr;
 	std::unique_ptr<CTextureManager> m_textureManager = nullptr;
+	std::unique_ptr<CGpuProfiler> m_gpuProfiler = nullptr;
+	std::unique_ptr<CPipelineStateCache> m_pipelineStateCache = nullptr;
+	std::unique_ptr<CShaderArchive> m_shaderArchive = nullptr;
+	std::unique_ptr<CAssetArchive> m_assetArchive = nullptr;
+	std::unique_ptr<CHotReloader> m_hotReloader = nullptr;
+	std::vector<CStaticMeshGroup*> m_staticMeshGroupList = {};		// BeginRender에서 인스턴스 업로드 / 번들 갱신
 	std::vector<RenderThreadDesc> m_renderThreadDescList = {};
+	CWorkerPool* m_pWorkerPool = nullptr;	// 설정되면 전용 렌더 스레드 대신 공유 워커 풀에서 ProcessByThread 실행
 	DWORD m_renderThreadCount = 1;
 	DWORD m_currentRenderThreadIndex = 0;
 
@@ -216,6 +353,7 @@ private:
 	XMVECTOR m_cameraDir = {};
 	XMMATRIX m_viewMatrix = {};
 	XMMATRIX m_projectionMatrix = {};
+	float m_meshLodPixelError = DefaultMeshLodPixelError;
 };
 
 
@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "CD3D12ResourceManager.h"
+#include "../RenderHelper/GpuMemoryTag.h"
 #include <DDSTextureLoader.h>
 
 
@@ -106,6 +107,9 @@ HRESULT CD3D12ResourceManager::CreateVertexBuffer(const UINT sizePerVertex, cons
 		return hr;
 	}
 	
+	TagGpuMemory(m_pD3DDevice, vertexBuffer.Get(), EMemoryCategory::Geometry);
+	TagGpuMemory(m_pD3DDevice, uploadBuffer.Get(), EMemoryCategory::Upload);
+
 	UINT8* pVertexDataBegin = nullptr;
 	CD3DX12_RANGE readRange(0, 0);
 	hr = uploadBuffer->Map(0, &readRange, reinterpret_cast<void**>(&pVertexDataBegin));
@@ -133,9 +137,12 @@ HRESULT CD3D12ResourceManager::CreateVertexBuffer(const UINT sizePerVertex, cons
 		return hr;
 	}
 
-	m_commandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(vertexBuffer.Get(), D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_DEST));
+	// COMMON 버퍼는 COPY_DEST로 암시적 승격되므로 barrier가 없다.
+	// 실행이 끝나면 다시 COMMON으로 decay되고, draw에서 읽기 상태로 다시 암시적 승격된다
+	m_resourceStateTracker.RegisterResource(vertexBuffer.Get(), D3D12_RESOURCE_STATE_COMMON, EResourcePromotionType::Buffer);
+	m_resourceStateTracker.TransitionResource(vertexBuffer.Get(), D3D12_RESOURCE_STATE_COPY_DEST);
+	m_resourceStateTracker.FlushBarriers(m_commandList.Get());
 	m_commandList->CopyBufferRegion(vertexBuffer.Get(), 0, uploadBuffer.Get(), 0, bufferSize);
-	m_commandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(vertexBuffer.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER));
 	m_commandList->Close();
 
 	ID3D12CommandList* ppCommandLists[] = { m_commandList.Get() };
@@ -143,6 +150,7 @@ HRESULT CD3D12ResourceManager::CreateVertexBuffer(const UINT sizePerVertex, cons
 
 	Fence();
 	WaitForFenceValue();
+	m_resourceStateTracker.UnregisterResource(vertexBuffer.Get());
 	
 	vertexBufferView.BufferLocation = vertexBuffer->GetGPUVirtualAddress();
 	vertexBufferView.SizeInBytes = bufferSize;
@@ -154,9 +162,10 @@ HRESULT CD3D12ResourceManager::CreateVertexBuffer(const UINT sizePerVertex, cons
 	return hr;
 }
 
-HRESULT CD3D12ResourceManager::CreateIndexBuffer(const UINT indexCount, D3D12_INDEX_BUFFER_VIEW* pOutIndexBufferView, ID3D12Resource** ppOutBuffer, const void* pInitData)
+HRESULT CD3D12ResourceManager::CreateIndexBuffer(const UINT indexCount, D3D12_INDEX_BUFFER_VIEW* pOutIndexBufferView, ID3D12Resource** ppOutBuffer, const void* pInitData, DXGI_FORMAT indexFormat)
 {
-	if (!pOutIndexBufferView || !ppOutBuffer || !m_pD3DDevice || !pInitData)
+	if (!pOutIndexBufferView || !ppOutBuffer || !m_pD3DDevice || !pInitData ||
+		(indexFormat != DXGI_FORMAT_R16_UINT && indexFormat != DXGI_FORMAT_R32_UINT))
 	{
 		__debugbreak();
 		return E_FAIL;
@@ -171,7 +180,8 @@ HRESULT CD3D12ResourceManager::CreateIndexBuffer(const UINT indexCount, D3D12_IN
 
 	ComPtr<ID3D12Resource> indexBuffer;
 	ComPtr<ID3D12Resource> uploadBuffer;
-	UINT bufferSize = indexCount * sizeof(WORD);
+	const UINT indexSize = (indexFormat == DXGI_FORMAT_R32_UINT) ? sizeof(UINT) : sizeof(WORD);
+	UINT bufferSize = indexCount * indexSize;
 
 	hr = m_pD3DDevice->CreateCommittedResource(&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT), D3D12_HEAP_FLAG_NONE, &CD3DX12_RESOURCE_DESC::Buffer(bufferSize),
 		D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(indexBuffer.ReleaseAndGetAddressOf()));
@@ -192,6 +202,9 @@ HRESULT CD3D12ResourceManager::CreateIndexBuffer(const UINT indexCount, D3D12_IN
 		return hr;
 	}
 
+	TagGpuMemory(m_pD3DDevice, indexBuffer.Get(), EMemoryCategory::Geometry);
+	TagGpuMemory(m_pD3DDevice, uploadBuffer.Get(), EMemoryCategory::Upload);
+
 	UINT8* pIndexDataBegin = nullptr;
 	CD3DX12_RANGE readRange(0, 0);
 	hr = uploadBuffer->Map(0, &readRange, reinterpret_cast<void**>(&pIndexDataBegin));
@@ -219,9 +232,12 @@ HRESULT CD3D12ResourceManager::CreateIndexBuffer(const UINT indexCount, D3D12_IN
 		return hr;
 	}
 
-	m_commandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(indexBuffer.Get(), D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_DEST));
+	// COMMON 버퍼는 COPY_DEST로 암시적 승격되므로 barrier가 없다.
+	// 실행이 끝나면 다시 COMMON으로 decay되고, draw에서 읽기 상태로 다시 암시적 승격된다
+	m_resourceStateTracker.RegisterResource(indexBuffer.Get(), D3D12_RESOURCE_STATE_COMMON, EResourcePromotionType::Buffer);
+	m_resourceStateTracker.TransitionResource(indexBuffer.Get(), D3D12_RESOURCE_STATE_COPY_DEST);
+	m_resourceStateTracker.FlushBarriers(m_commandList.Get());
 	m_commandList->CopyBufferRegion(indexBuffer.Get(), 0, uploadBuffer.Get(), 0, bufferSize);
-	m_commandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(indexBuffer.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_INDEX_BUFFER));
 	m_commandList->Close();
 
 	ID3D12CommandList* ppCommandLists[] = { m_commandList.Get() };
@@ -229,9 +245,10 @@ HRESULT CD3D12ResourceManager::CreateIndexBuffer(const UINT indexCount, D3D12_IN
 
 	Fence();
 	WaitForFenceValue();
+	m_resourceStateTracker.UnregisterResource(indexBuffer.Get());
 
 	indexBufferView.BufferLocation = indexBuffer->GetGPUVirtualAddress();
-	indexBufferView.Format = DXGI_FORMAT_R16_UINT;
+	indexBufferView.Format = indexFormat;
 	indexBufferView.SizeInBytes = bufferSize;
 
 	*pOutIndexBufferView = indexBufferView;
@@ -260,7 +277,9 @@ void CD3D12ResourceManager::UpdateTextureForWrite(ID3D12Resource* pDestTexResour
 	if (FAILED(m_commandList->Reset(m_commandAllocator.Get(), nullptr)))
 		__debugbreak();
 
-	m_commandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(pDestTexResource, D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_COPY_DEST));
+	m_resourceStateTracker.RegisterResource(pDestTexResource, D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE, EResourcePromotionType::Texture);
+	m_resourceStateTracker.TransitionResource(pDestTexResource, D3D12_RESOURCE_STATE_COPY_DEST);
+	m_resourceStateTracker.FlushBarriers(m_commandList.Get());
 	for (DWORD i = 0; i < desc.MipLevels; i++)
 	{
 		D3D12_TEXTURE_COPY_LOCATION	destLocation = {};
@@ -276,7 +295,8 @@ void CD3D12ResourceManager::UpdateTextureForWrite(ID3D12Resource* pDestTexResour
 
 		m_commandList->CopyTextureRegion(&destLocation, 0, 0, 0, &srcLocation, nullptr);
 	}
-	m_commandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(pDestTexResource, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE));
+	m_resourceStateTracker.TransitionResource(pDestTexResource, D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE);
+	m_resourceStateTracker.FlushBarriers(m_commandList.Get());
 	m_commandList->Close();
 
 	ID3D12CommandList* ppCommandLists[] = { m_commandList.Get() };
@@ -284,6 +304,7 @@ void CD3D12ResourceManager::UpdateTextureForWrite(ID3D12Resource* pDestTexResour
 
 	Fence();
 	WaitForFenceValue();
+	m_resourceStateTracker.UnregisterResource(pDestTexResource);
 }
 
 bool CD3D12ResourceManager::CreateTexture(ID3D12Resource** ppOutResource, UINT width, UINT height, DXGI_FORMAT format, const BYTE* pInitImage)
@@ -320,6 +341,8 @@ bool CD3D12ResourceManager::CreateTexture(ID3D12Resource** ppOutResource, UINT w
 		return false;
 	}
 
+	TagGpuMemory(m_pD3DDevice, texResource.Get(), EMemoryCategory::Texture);
+
 	if (pInitImage)
 	{
 		D3D12_RESOURCE_DESC Desc = texResource->GetDesc();
@@ -347,6 +370,8 @@ bool CD3D12ResourceManager::CreateTexture(ID3D12Resource** ppOutResource, UINT w
 			return false;
 		}
 
+		TagGpuMemory(m_pD3DDevice, uploadBuffer.Get(), EMemoryCategory::Upload);
+
 		HRESULT hr = uploadBuffer->Map(0, &writeRange, reinterpret_cast<void**>(&pMappedPtr));
 		if (FAILED(hr))
 		{
@@ -398,11 +423,48 @@ bool CD3D12ResourceManager::CreateTextureFromFile(ID3D12Resource** ppOutResource
 		return false;
 	}
 
+	return UploadDdsTexture(ppOutResource, pOutDesc, texResource.Get(), subresources);
+}
+
+bool CD3D12ResourceManager::CreateTextureFromMemory(ID3D12Resource** ppOutResource, D3D12_RESOURCE_DESC* pOutDesc, const BYTE* pDdsData, size_t ddsDataSize)
+{
+	if (!ppOutResource || !pOutDesc || !pDdsData)
+	{
+		__debugbreak();
+		return false;
+	}
+
+	*ppOutResource = nullptr;
+	*pOutDesc = {};
+
+	// subresources는 pDdsData를 가리킨다. 업로드가 끝날 때까지 호출자가 유지
+	ComPtr<ID3D12Resource> texResource;
+	std::vector<D3D12_SUBRESOURCE_DATA> subresources;
+
+	HRESULT hr = DirectX::LoadDDSTextureFromMemory(
+		m_pD3DDevice,
+		pDdsData,
+		ddsDataSize,
+		texResource.ReleaseAndGetAddressOf(),
+		subresources);
+	if (FAILED(hr))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	return UploadDdsTexture(ppOutResource, pOutDesc, texResource.Get(), subresources);
+}
+
+bool CD3D12ResourceManager::UploadDdsTexture(ID3D12Resource** ppOutResource, D3D12_RESOURCE_DESC* pOutDesc, ID3D12Resource* pTexResource, const std::vector<D3D12_SUBRESOURCE_DATA>& subresources)
+{
+	ComPtr<ID3D12Resource> texResource = pTexResource;
+
 	UINT subresourceCount = static_cast<UINT>(subresources.size());
 	UINT64 uploadBufferSize = GetRequiredIntermediateSize(texResource.Get(), 0, subresourceCount);
 
 	ComPtr<ID3D12Resource> uploadBuffer;
-	hr = m_pD3DDevice->CreateCommittedResource(
+	HRESULT hr = m_pD3DDevice->CreateCommittedResource(
 		&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
 		D3D12_HEAP_FLAG_NONE,
 		&CD3DX12_RESOURCE_DESC::Buffer(uploadBufferSize),
@@ -415,6 +477,10 @@ bool CD3D12ResourceManager::CreateTextureFromFile(ID3D12Resource** ppOutResource
 		return false;
 	}
 
+	// DDS 로더가 만든 텍스처와 임시 업로드 버퍼
+	TagGpuMemory(m_pD3DDevice, texResource.Get(), EMemoryCategory::Texture);
+	TagGpuMemory(m_pD3DDevice, uploadBuffer.Get(), EMemoryCategory::Upload);
+
 	if (FAILED(m_commandAllocator->Reset()))
 	{
 		__debugbreak();
@@ -426,11 +492,10 @@ bool CD3D12ResourceManager::CreateTextureFromFile(ID3D12Resource** ppOutResource
 		return false;
 	}
 
-	m_commandList->ResourceBarrier(1,
-		&CD3DX12_RESOURCE_BARRIER::Transition(
-			texResource.Get(),
-			D3D12_RESOURCE_STATE_COMMON,
-			D3D12_RESOURCE_STATE_COPY_DEST));
+	// LoadDDSTextureFromFile은 COMMON으로 만든다 (c_initialCopyTargetState). COPY_DEST는 암시적 승격
+	m_resourceStateTracker.RegisterResource(texResource.Get(), D3D12_RESOURCE_STATE_COMMON, EResourcePromotionType::Texture);
+	m_resourceStateTracker.TransitionResource(texResource.Get(), D3D12_RESOURCE_STATE_COPY_DEST);
+	m_resourceStateTracker.FlushBarriers(m_commandList.Get());
 
 	UpdateSubresources(
 		m_commandList.Get(),
@@ -440,11 +505,8 @@ bool CD3D12ResourceManager::CreateTextureFromFile(ID3D12Resource** ppOutResource
 		subresourceCount,
 		subresources.data());
 
-	m_commandList->ResourceBarrier(1,
-		&CD3DX12_RESOURCE_BARRIER::Transition(
-			texResource.Get(),
-			D3D12_RESOURCE_STATE_COPY_DEST,
-			D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE));
+	m_resourceStateTracker.TransitionResource(texResource.Get(), D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE);
+	m_resourceStateTracker.FlushBarriers(m_commandList.Get());
 
 	m_commandList->Close();
 
@@ -453,15 +515,16 @@ bool CD3D12ResourceManager::CreateTextureFromFile(ID3D12Resource** ppOutResource
 
 	Fence();
 	WaitForFenceValue();
+	m_resourceStateTracker.UnregisterResource(texResource.Get());
 
 	*pOutDesc = texResource->GetDesc();
 	*ppOutResource = texResource.Detach();
 	return true;
 }
 
-bool CD3D12ResourceManager::CreateTexturePair(ID3D12Resource** ppOutResource, ID3D12Resource** ppOutUploadBuffer, UINT Width, UINT Height, DXGI_FORMAT format)
+bool CD3D12ResourceManager::CreateTexturePair(ID3D12Resource** ppOutResource, ID3D12Resource** ppOutUploadBuffer, UINT64* pOutUploadSliceSize, UINT Width, UINT Height, DXGI_FORMAT format, UINT uploadSliceCount)
 {
-	if (!ppOutResource || !ppOutUploadBuffer)
+	if (!ppOutResource || !ppOutUploadBuffer || !pOutUploadSliceSize || uploadSliceCount == 0)
 	{
 		__debugbreak();
 		return false;
@@ -493,7 +556,12 @@ bool CD3D12ResourceManager::CreateTexturePair(ID3D12Resource** ppOutResource, ID
 		return false;
 	}
 
-	UINT64 uploadBufferSize = GetRequiredIntermediateSize(texResource.Get(), 0, 1);
+	TagGpuMemory(m_pD3DDevice, texResource.Get(), EMemoryCategory::Texture);
+
+	// placed footprint의 Offset은 D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT 배수여야 한다
+	const UINT64 uploadSliceSize = (GetRequiredIntermediateSize(texResource.Get(), 0, 1) + D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1) &
+		~static_cast<UINT64>(D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1);
+	const UINT64 uploadBufferSize = uploadSliceSize * uploadSliceCount;
 
 	if (FAILED(m_pD3DDevice->CreateCommittedResource(
 		&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
@@ -506,8 +574,11 @@ bool CD3D12ResourceManager::CreateTexturePair(ID3D12Resource** ppOutResource, ID
 		__debugbreak();
 		return false;
 	}
+	TagGpuMemory(m_pD3DDevice, uploadBuffer.Get(), EMemoryCategory::Upload);
+
 	*ppOutResource = texResource.Detach();
 	*ppOutUploadBuffer = uploadBuffer.Detach();
+	*pOutUploadSliceSize = uploadSliceSize;
 
 	return true;
 }
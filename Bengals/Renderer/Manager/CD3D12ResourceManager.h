@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../RenderHelper/ResourceStateTracker.h"
+
 /**
  * Dedicated manager for GPU resource uploads.
  *
@@ -17,13 +19,18 @@ public:
 	bool Initialize(ID3D12Device5* pD3DDevice);
 
 	HRESULT CreateVertexBuffer(const UINT sizePerVertex, const UINT vertexCount, D3D12_VERTEX_BUFFER_VIEW* pOutVertexBufferView, ID3D12Resource** ppOutBuffer, const void* pInInitData);
-	HRESULT CreateIndexBuffer(const UINT indexCount, D3D12_INDEX_BUFFER_VIEW* pOutIndexBufferView, ID3D12Resource** ppOutBuffer, const void* pInitData);
+	// indexFormat: DXGI_FORMAT_R16_UINT (pInitData는 WORD) 또는 DXGI_FORMAT_R32_UINT (UINT)
+	HRESULT CreateIndexBuffer(const UINT indexCount, D3D12_INDEX_BUFFER_VIEW* pOutIndexBufferView, ID3D12Resource** ppOutBuffer, const void* pInitData, DXGI_FORMAT indexFormat = DXGI_FORMAT_R16_UINT);
 
 	void UpdateTextureForWrite(ID3D12Resource* pDestTexResource, ID3D12Resource* pSrcTexResource);
 	bool CreateTexture(ID3D12Resource** ppOutResource, UINT width, UINT height, DXGI_FORMAT format, const BYTE* pInitImage);
 	bool CreateTextureFromFile(ID3D12Resource** ppOutResource, D3D12_RESOURCE_DESC* pOutDesc, const WCHAR* inFileName);
-	bool CreateTexturePair(ID3D12Resource** ppOutResource, ID3D12Resource** ppOutUploadBuffer, UINT Width, UINT Height, DXGI_FORMAT format);
+	// pDdsData는 DDS 파일 전체 (아카이브 매핑 등). 반환 후에는 필요 없다
+	bool CreateTextureFromMemory(ID3D12Resource** ppOutResource, D3D12_RESOURCE_DESC* pOutDesc, const BYTE* pDdsData, size_t ddsDataSize);
+	// 업로드 버퍼는 uploadSliceCount개의 slice로 이루어지며 각 slice가 텍스처 전체를 담는다
+	bool CreateTexturePair(ID3D12Resource** ppOutResource, ID3D12Resource** ppOutUploadBuffer, UINT64* pOutUploadSliceSize, UINT Width, UINT Height, DXGI_FORMAT format, UINT uploadSliceCount = 1);
 private:
+	bool UploadDdsTexture(ID3D12Resource** ppOutResource, D3D12_RESOURCE_DESC* pOutDesc, ID3D12Resource* pTexResource, const std::vector<D3D12_SUBRESOURCE_DATA>& subresources);
 	UINT64 Fence();
 	void WaitForFenceValue() const;
 
@@ -37,6 +44,8 @@ private:
 	HANDLE m_fenceEvent = nullptr;
 	ComPtr<ID3D12Fence> m_fence = nullptr;
 	UINT64 m_fenceValue = 0;
+
+	CResourceStateTracker m_resourceStateTracker;
 };
 
 
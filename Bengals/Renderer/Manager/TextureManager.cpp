@@ -1,10 +1,59 @@
 #include "pch.h"
 #include <d3d12.h>
+#include <algorithm>
 #include "TextureManager.h"
 #include "Types/typedef.h"
 #include "../D3D12Renderer.h"
 #include "CD3D12ResourceManager.h"
 #include "../RenderHelper/PersistentCpuDescriptorAllocator.h"
+#include "../RenderHelper/ResourceStateTracker.h"
+#include "Asset/AssetArchive.h"
+#include "Asset/MappedFile.h"
+#include "../../../Util/D3DUtil.h"
+
+namespace
+{
+	WCHAR NormalizePathChar(WCHAR c)
+	{
+		if (c == L'\\')
+		{
+			return L'/';
+		}
+		if (c >= L'A' && c <= L'Z')
+		{
+			return static_cast<WCHAR>(c - L'A' + L'a');
+		}
+		return c;
+	}
+
+	// murmur3 finalizer
+	UINT64 MixContentCheckHash(UINT64 value)
+	{
+		value ^= value >> 33;
+		value *= 0xff51afd7ed558ccdull;
+		value ^= value >> 33;
+		value *= 0xc4ceb9fe1a85ec53ull;
+		value ^= value >> 33;
+		return value;
+	}
+
+	// CAssetArchive::HashBytes(FNV-1a, 바이트 단위)와 독립인 해시. 8바이트 단위로 섞는다
+	UINT64 HashContentCheck(const BYTE* pData, size_t dataSize)
+	{
+		UINT64 hash = MixContentCheckHash(0x9e3779b97f4a7c15ull ^ dataSize);
+		size_t offset = 0;
+		for (; offset + sizeof(UINT64) <= dataSize; offset += sizeof(UINT64))
+		{
+			UINT64 word = 0;
+			memcpy(&word, pData + offset, sizeof(word));
+			hash = MixContentCheckHash(hash ^ word);
+		}
+
+		UINT64 tail = 0;
+		memcpy(&tail, pData + offset, dataSize - offset);
+		return MixContentCheckHash(hash ^ tail);
+	}
+}
 
 CTextureManager::~CTextureManager()
 {
@@ -23,47 +72,235 @@ bool CTextureManager::Initialize(CD3D12Renderer* pRenderer)
 
 TextureHandle* CTextureManager::CreateTextureFromFile(const WCHAR* filePath)
 {
-	// dedup: 동일 파일이 이미 로드되어 있으면 참조 카운트 증가 후 반환
-	std::wstring key(filePath);
-	auto it = m_fileTextureMap.find(key);
-	if (it != m_fileTextureMap.end())
+	m_cacheStats.RequestCount++;
+
+	// 경로로 먼저 찾는다: 정규화 해시만 계산하고 문자열은 만들지 않는다
+	const UINT64 pathId = GetTexturePathId(filePath);
+	auto pathIter = FindTexturePath(pathId, filePath);
+	if (pathIter != m_pathTextureMap.end())
 	{
-		it->second->RefCount++;
-		return it->second;
+		pathIter->second.pTexHandle->RefCount++;
+		m_cacheStats.PathHitCount++;
+		return pathIter->second.pTexHandle;
 	}
 
-	ID3D12Resource* pTexResource = nullptr;
-	D3D12_RESOURCE_DESC texDesc = {};
+	CMappedFile mappedFile;
+	std::vector<BYTE> readBuffer;
+	const BYTE* pData = nullptr;
+	size_t dataSize = 0;
+	UINT64 contentHash = 0;
+	if (!ReadTextureFile(filePath, &mappedFile, &readBuffer, &pData, &dataSize, &contentHash))
+	{
+		return nullptr;
+	}
 
-	if (!m_pResourceManager->CreateTextureFromFile(&pTexResource, &texDesc, filePath))
+	// 다른 경로로 같은 내용이 이미 올라가 있으면 리소스만 공유하고, 핸들과 SRV는 이 경로 것을 만든다
+	bool bCreated = false;
+	TextureContentEntry* pContent = AcquireTextureContent(pData, dataSize, contentHash, &bCreated);
+	if (!pContent)
 	{
 		return nullptr;
 	}
 
 	TextureHandle* pTexHandle = AllocTextureHandle();
 	pTexHandle->bFromFile = true;
-	pTexHandle->FilePath = key;
+	pTexHandle->ContentHash = contentHash;
+	pTexHandle->ContentSize = dataSize;
+	pTexHandle->ResourceSize = pContent->ResourceSize;
 
-	if (!CreateSrvForTexture(pTexHandle, pTexResource, texDesc.Format, texDesc.MipLevels))
+	if (!CreateSrvForTexture(pTexHandle, pContent->pTexResource, pContent->Format, pContent->MipLevels))
 	{
+		ID3D12Resource* pTexResource = pContent->pTexResource;
+		pTexHandle->TextureResource = pTexResource;
+		ReleaseTextureContent(pTexHandle);
 		pTexResource->Release();
 		delete pTexHandle;
 		return nullptr;
 	}
 
-	m_fileTextureMap[key] = pTexHandle;
+	RegisterTexturePath(pTexHandle, pathId, filePath);
+
+	if (bCreated)
+	{
+		m_cacheStats.LoadCount++;
+	}
+	else
+	{
+		m_cacheStats.ContentHitCount++;
+		m_cacheStats.SavedBytes += pContent->ResourceSize;
+	}
 	return pTexHandle;
 }
 
+std::unordered_multimap<UINT64, CTextureManager::TexturePathEntry>::iterator CTextureManager::FindTexturePath(UINT64 pathId, const WCHAR* filePath)
+{
+	// id가 같은 다른 경로(충돌)는 저장된 경로로 구분한다
+	auto range = m_pathTextureMap.equal_range(pathId);
+	for (auto pathIter = range.first; pathIter != range.second; ++pathIter)
+	{
+		if (IsSameTexturePath(pathIter->second.FilePath.c_str(), filePath))
+		{
+			return pathIter;
+		}
+	}
+	return m_pathTextureMap.end();
+}
+
+CTextureManager::TextureContentEntry* CTextureManager::AcquireTextureContent(const BYTE* pData, size_t dataSize, UINT64 contentHash, bool* pOutCreated)
+{
+	*pOutCreated = false;
+
+	// 해시가 같아도 크기나 두 번째 해시가 다르면 다른 내용(충돌)이다. 같은 키의 다음 항목을 본다
+	const UINT64 contentCheckHash = HashContentCheck(pData, dataSize);
+	auto range = m_contentTextureMap.equal_range(contentHash);
+	for (auto contentIter = range.first; contentIter != range.second; ++contentIter)
+	{
+		TextureContentEntry& content = contentIter->second;
+		if (content.ContentSize == dataSize && content.ContentCheckHash == contentCheckHash)
+		{
+			content.pTexResource->AddRef();
+			content.HandleCount++;
+			return &content;
+		}
+	}
+
+	ID3D12Resource* pTexResource = nullptr;
+	D3D12_RESOURCE_DESC texDesc = {};
+	if (!m_pResourceManager->CreateTextureFromMemory(&pTexResource, &texDesc, pData, dataSize))
+	{
+		return nullptr;
+	}
+
+	// 생성 참조는 첫 핸들의 것
+	TextureContentEntry& content = m_contentTextureMap.emplace(contentHash, TextureContentEntry{})->second;
+	content.pTexResource = pTexResource;
+	content.Format = texDesc.Format;
+	content.MipLevels = texDesc.MipLevels;
+	content.ContentSize = dataSize;
+	content.ContentCheckHash = contentCheckHash;
+	content.ResourceSize = m_pD3DDevice->GetResourceAllocationInfo(0, 1, &texDesc).SizeInBytes;
+	content.HandleCount = 1;
+	*pOutCreated = true;
+	return &content;
+}
+
+void CTextureManager::ReleaseTextureContent(TextureHandle* pTexHandle)
+{
+	// 핸들의 COM 참조는 건드리지 않는다 (FreeTextureHandle / 리로드 호출자가 Release)
+	auto range = m_contentTextureMap.equal_range(pTexHandle->ContentHash);
+	for (auto contentIter = range.first; contentIter != range.second; ++contentIter)
+	{
+		if (contentIter->second.pTexResource != pTexHandle->TextureResource)
+		{
+			continue;
+		}
+
+		if (--contentIter->second.HandleCount == 0)
+		{
+			m_contentTextureMap.erase(contentIter);
+		}
+		return;
+	}
+	__debugbreak();
+}
+
+bool CTextureManager::ReadTextureFile(const WCHAR* filePath, CMappedFile* pMappedFile, std::vector<BYTE>* pReadBuffer, const BYTE** ppOutData, size_t* pOutSize, UINT64* pOutContentHash) const
+{
+	// 아카이브에 있으면 파일을 열지 않는다. 압축되지 않은 항목은 매핑된 메모리를 그대로 쓰고 해시도 아카이브 것을 쓴다
+	const CAssetArchive* pAssetArchive = m_pRenderer->GetAssetArchive();
+	const AssetEntryInfo* pEntry = pAssetArchive ? pAssetArchive->FindEntry(filePath) : nullptr;
+	if (pEntry)
+	{
+		if (pAssetArchive->GetEntryData(*pEntry, ppOutData, pOutSize))
+		{
+			*pOutContentHash = pEntry->ContentHash;
+			return true;
+		}
+
+		if (pAssetArchive->ReadEntry(*pEntry, pReadBuffer))
+		{
+			*ppOutData = pReadBuffer->data();
+			*pOutSize = pReadBuffer->size();
+			*pOutContentHash = pEntry->ContentHash;
+			return true;
+		}
+	}
+
+	if (!pMappedFile->Open(filePath))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	*ppOutData = pMappedFile->GetData();
+	*pOutSize = pMappedFile->GetSize();
+	*pOutContentHash = CAssetArchive::HashBytes(*ppOutData, *pOutSize);
+	return true;
+}
+
+void CTextureManager::RegisterTexturePath(TextureHandle* pTexHandle, UINT64 pathId, const WCHAR* filePath)
+{
+	TexturePathEntry& pathEntry = m_pathTextureMap.emplace(pathId, TexturePathEntry{})->second;
+	pathEntry.pTexHandle = pTexHandle;
+	pathEntry.FilePath = filePath;
+	pTexHandle->PathId = pathId;
+}
+
+void CTextureManager::GetCacheStats(TextureCacheStats* pOutStats) const
+{
+	*pOutStats = m_cacheStats;
+	pOutStats->TextureCount = static_cast<UINT>(m_contentTextureMap.size());
+	pOutStats->PathCount = static_cast<UINT>(m_pathTextureMap.size());
+	pOutStats->HitRate = (m_cacheStats.RequestCount > 0) ?
+		static_cast<float>(m_cacheStats.PathHitCount + m_cacheStats.ContentHitCount) / static_cast<float>(m_cacheStats.RequestCount) : 0.0f;
+}
+
+UINT64 CTextureManager::GetTexturePathId(const WCHAR* filePath)
+{
+	// FNV-1a (UTF-16 code unit 단위)
+	UINT64 hash = 14695981039346656037ull;
+	for (const WCHAR* p = filePath; *p != 0; p++)
+	{
+		hash ^= static_cast<UINT64>(NormalizePathChar(*p));
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+bool CTextureManager::IsSameTexturePath(const WCHAR* pathA, const WCHAR* pathB)
+{
+	for (; *pathA != 0 && *pathB != 0; pathA++, pathB++)
+	{
+		if (NormalizePathChar(*pathA) != NormalizePathChar(*pathB))
+		{
+			return false;
+		}
+	}
+	return *pathA == *pathB;
+}
+
 TextureHandle* CTextureManager::CreateDynamicTexture(UINT texWidth, UINT texHeight)
 {
 	ID3D12Resource* pTexResource = nullptr;
 	ID3D12Resource* pUploadBuffer = nullptr;
+	UINT64 uploadSliceSize = 0;
 
 	DXGI_FORMAT texFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
 
-	if (!m_pResourceManager->CreateTexturePair(&pTexResource, &pUploadBuffer, texWidth, texHeight, texFormat))
+	// 프레임 컨텍스트마다 slice 하나: 프레임 N의 쓰기가 GPU에서 진행 중인 N-1의 복사와 겹치지 않는다
+	const UINT uploadSliceCount = m_pRenderer->GetFrameContextCount();
+	if (!m_pResourceManager->CreateTexturePair(&pTexResource, &pUploadBuffer, &uploadSliceSize, texWidth, texHeight, texFormat, uploadSliceCount))
+	{
+		return nullptr;
+	}
+
+	BYTE* pMappedUploadBuffer = nullptr;
+	CD3DX12_RANGE readRange(0, 0);
+	if (FAILED(pUploadBuffer->Map(0, &readRange, reinterpret_cast<void**>(&pMappedUploadBuffer))))
 	{
+		__debugbreak();
+		pTexResource->Release();
+		pUploadBuffer->Release();
 		return nullptr;
 	}
 
@@ -77,8 +314,19 @@ TextureHandle* CTextureManager::CreateDynamicTexture(UINT texWidth, UINT texHeig
 		return nullptr;
 	}
 
+	// 업로드마다 COPY_DEST <-> ALL_SHADER_RESOURCE를 오가므로 수명 동안 상태를 추적한다
+	m_pRenderer->GetResourceStateTracker()->RegisterResource(pTexResource, D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE, EResourcePromotionType::Texture);
+
 	pTexHandle->pUploadBuffer = pUploadBuffer;
+	pTexHandle->pMappedUploadBuffer = pMappedUploadBuffer;
+	pTexHandle->UploadSliceSize = uploadSliceSize;
 	pTexHandle->bUpdated = false;
+	pTexHandle->DirtyRectList.Reset(texWidth, texHeight);
+	pTexHandle->StaleRectLists.resize(uploadSliceCount);
+	for (CDirtyRectList& staleRectList : pTexHandle->StaleRectLists)
+	{
+		staleRectList.Reset(texWidth, texHeight);
+	}
 	return pTexHandle;
 }
 
@@ -101,10 +349,15 @@ TextureHandle* CTextureManager::CreateStaticTexture(UINT texWidth, UINT texHeigh
 	return pTexHandle;
 }
 
-void CTextureManager::UpdateTextureWithImage(TextureHandle* pTexHandle, const BYTE* pSrcBits, UINT srcWidth, UINT srcHeight)
+void CTextureManager::UpdateTextureWithImage(TextureHandle* pTexHandle, const BYTE* pSrcBits, UINT srcWidth, UINT srcHeight, const RECT* pDirtyRects, UINT dirtyRectCount)
 {
+	if (!pTexHandle || !pTexHandle->pMappedUploadBuffer)
+	{
+		__debugbreak();
+		return;
+	}
+
 	ID3D12Resource* pDestTexResource = pTexHandle->TextureResource;
-	ID3D12Resource* pUploadBuffer = pTexHandle->pUploadBuffer;
 
 	D3D12_RESOURCE_DESC desc = pDestTexResource->GetDesc();
 	if (srcWidth > desc.Width)
@@ -116,32 +369,102 @@ void CTextureManager::UpdateTextureWithImage(TextureHandle* pTexHandle, const BY
 		__debugbreak();
 	}
 
+	// 현재 프레임 컨텍스트의 slice. 이 컨텍스트의 이전 프레임은 Present에서 GPU 완료를 기다렸으므로 대기 없이 쓴다
+	const UINT sliceIndex = m_pRenderer->GetCurrentContextIndex();
+	if (pTexHandle->bUpdated && pTexHandle->UploadSliceIndex != sliceIndex)
+	{
+		// BeginRender 이후에 호출되어 이전 프레임의 업로드가 기록되지 않았다
+		__debugbreak();
+	}
+
 	D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint;
 	UINT rows = 0;
 	UINT64 rowSize = 0;
 	UINT64 totalBytes = 0;
 
-	m_pD3DDevice->GetCopyableFootprints(&desc, 0, 1, 0, &footprint, &rows, &rowSize, &totalBytes);
+	m_pD3DDevice->GetCopyableFootprints(&desc, 0, 1, pTexHandle->UploadSliceSize * sliceIndex, &footprint, &rows, &rowSize, &totalBytes);
+
+	CDirtyRectList newRectList;
+	newRectList.Reset(srcWidth, srcHeight);
+	if (pDirtyRects && dirtyRectCount > 0)
+	{
+		for (UINT i = 0; i < dirtyRectCount; i++)
+		{
+			newRectList.AddRect(pDirtyRects[i]);
+		}
+	}
+	else
+	{
+		newRectList.AddFullRect();
+	}
 
-	BYTE* pMappedPtr = nullptr;
-	CD3DX12_RANGE writeRange(0, 0);
+	if (newRectList.IsEmpty())
+	{
+		return;
+	}
 
-	HRESULT hr = pUploadBuffer->Map(0, &writeRange, reinterpret_cast<void**>(&pMappedPtr));
-	if (FAILED(hr))
-		__debugbreak();
+	// 이 slice에는 이번 영역과, 다른 slice에만 쓰였던 영역을 함께 쓴다. 나머지는 이전에 쓴 내용이 최신이다
+	CDirtyRectList& writeRectList = pTexHandle->StaleRectLists[sliceIndex];
+	for (UINT i = 0; i < newRectList.GetRectCount(); i++)
+	{
+		const RECT& dirtyRect = newRectList.GetRects()[i];
+		for (UINT staleSliceIndex = 0; staleSliceIndex < static_cast<UINT>(pTexHandle->StaleRectLists.size()); staleSliceIndex++)
+		{
+			pTexHandle->StaleRectLists[staleSliceIndex].AddRect(dirtyRect);
+		}
+		pTexHandle->DirtyRectList.AddRect(dirtyRect);
+	}
+
+	const UINT rowPitch = footprint.Footprint.RowPitch;
+	for (UINT i = 0; i < writeRectList.GetRectCount(); i++)
+	{
+		const RECT& writeRect = writeRectList.GetRects()[i];
+		const UINT rowBytes = static_cast<UINT>(writeRect.right - writeRect.left) * 4;
+
+		const BYTE* pSrc = pSrcBits + (static_cast<SIZE_T>(writeRect.top) * srcWidth + writeRect.left) * 4;
+		BYTE* pDest = pTexHandle->pMappedUploadBuffer + footprint.Offset + static_cast<SIZE_T>(writeRect.top) * rowPitch + static_cast<SIZE_T>(writeRect.left) * 4;
+		for (LONG y = writeRect.top; y < writeRect.bottom; y++)
+		{
+			memcpy(pDest, pSrc, rowBytes);
+			pSrc += (srcWidth * 4);
+			pDest += rowPitch;
+		}
+	}
+	writeRectList.Clear();
+
+	pTexHandle->UploadSliceIndex = sliceIndex;
+	if (!pTexHandle->bUpdated)
+	{
+		pTexHandle->bUpdated = true;
+		m_pendingUploadList.push_back(pTexHandle);
+	}
+}
 
-	const BYTE* pSrc = pSrcBits;
-	BYTE* pDest = pMappedPtr;
-	for (UINT y = 0; y < srcHeight; y++)
+void CTextureManager::RecordPendingUploads(ID3D12GraphicsCommandList* pCommandList, CResourceStateTracker* pStateTracker)
+{
+	if (m_pendingUploadList.empty())
 	{
-		memcpy(pDest, pSrc, srcWidth * 4);
-		pSrc += (srcWidth * 4);
-		pDest += footprint.Footprint.RowPitch;
+		return;
 	}
 
-	pUploadBuffer->Unmap(0, nullptr);
+	for (TextureHandle* pTexHandle : m_pendingUploadList)
+	{
+		pStateTracker->TransitionResource(pTexHandle->TextureResource, D3D12_RESOURCE_STATE_COPY_DEST);
+	}
+	pStateTracker->FlushBarriers(pCommandList);
 
-	pTexHandle->bUpdated = TRUE;
+	for (TextureHandle* pTexHandle : m_pendingUploadList)
+	{
+		CDirtyRectList& dirtyRectList = pTexHandle->DirtyRectList;
+		UpdateTextureRegions(m_pD3DDevice, pCommandList, pTexHandle->TextureResource, pTexHandle->pUploadBuffer,
+			pTexHandle->UploadSliceSize * pTexHandle->UploadSliceIndex, dirtyRectList.GetRects(), dirtyRectList.GetRectCount());
+		dirtyRectList.Clear();
+		pTexHandle->bUpdated = false;
+
+		// ALL_SHADER_RESOURCE로 되돌리는 barrier는 호출한 쪽의 다음 FlushBarriers에서 기록된다
+		pStateTracker->TransitionResource(pTexHandle->TextureResource, D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE);
+	}
+	m_pendingUploadList.clear();
 }
 
 void CTextureManager::DeleteTexture(TextureHandle* pTexHandle)
@@ -151,15 +474,63 @@ void CTextureManager::DeleteTexture(TextureHandle* pTexHandle)
 		return;
 	}
 
-	// 파일 텍스처이고 마지막 참조이면 맵에서 제거
+	// 파일 텍스처이고 마지막 참조이면 경로 이름과 공유 리소스의 몫을 제거 (리소스 참조는 FreeTextureHandle에서 Release)
 	if (pTexHandle->bFromFile && pTexHandle->RefCount == 1)
 	{
-		m_fileTextureMap.erase(pTexHandle->FilePath);
+		auto range = m_pathTextureMap.equal_range(pTexHandle->PathId);
+		for (auto pathIter = range.first; pathIter != range.second; ++pathIter)
+		{
+			if (pathIter->second.pTexHandle == pTexHandle)
+			{
+				m_pathTextureMap.erase(pathIter);
+				break;
+			}
+		}
+		ReleaseTextureContent(pTexHandle);
 	}
 
 	FreeTextureHandle(pTexHandle);
 }
 
+bool CTextureManager::ReloadTexture(const WCHAR* filePath, const BYTE* pData, size_t dataSize, UINT64 contentHash, ID3D12Resource** ppOutOldResource)
+{
+	*ppOutOldResource = nullptr;
+
+	auto pathIter = FindTexturePath(GetTexturePathId(filePath), filePath);
+	if (pathIter == m_pathTextureMap.end())
+	{
+		return false;
+	}
+
+	// 새 내용도 이미 다른 경로로 올라가 있으면 그 리소스를 공유한다. 내용이 같으면 이 핸들의 리소스가 나온다
+	TextureHandle* pTexHandle = pathIter->second.pTexHandle;
+	bool bCreated = false;
+	TextureContentEntry* pContent = AcquireTextureContent(pData, dataSize, contentHash, &bCreated);
+	if (!pContent)
+	{
+		// 저장 중인 파일 등 읽을 수 없는 내용: 이전 텍스처를 유지
+		return false;
+	}
+	if (pContent->pTexResource == pTexHandle->TextureResource)
+	{
+		pContent->HandleCount--;
+		pContent->pTexResource->Release();
+		return false;
+	}
+
+	// 이 경로의 몫만 이전 리소스에서 뺀다. 같은 내용을 쓰던 다른 경로의 핸들은 그대로
+	ReleaseTextureContent(pTexHandle);
+
+	// CPU descriptor만 다시 쓴다. 이미 기록된 프레임은 GPU heap에 복사된 이전 SRV로 이전 리소스를 읽는다
+	WriteTextureSrv(pTexHandle->SrvDescriptorHandle, pContent->pTexResource, pContent->Format, pContent->MipLevels);
+	*ppOutOldResource = pTexHandle->TextureResource;
+	pTexHandle->TextureResource = pContent->pTexResource;
+	pTexHandle->ContentHash = contentHash;
+	pTexHandle->ContentSize = dataSize;
+	pTexHandle->ResourceSize = pContent->ResourceSize;
+	return true;
+}
+
 TextureHandle* CTextureManager::AllocTextureHandle()
 {
 	TextureHandle* pTexHandle = new TextureHandle{};
@@ -182,14 +553,27 @@ DWORD CTextureManager::FreeTextureHandle(TextureHandle* pTexHandle)
 	DWORD refCount = --pTexHandle->RefCount;
 	if (refCount == 0)
 	{
+		// 동적 텍스처는 생성할 때 등록했다. 보류 중인 barrier도 함께 버린다
+		if (pTexHandle->pUploadBuffer)
+		{
+			m_pRenderer->GetResourceStateTracker()->UnregisterResource(pTexHandle->TextureResource);
+		}
+
 		if (pTexHandle->TextureResource)
 		{
 			pTexHandle->TextureResource->Release();
 			pTexHandle->TextureResource = nullptr;
 		}
 
+		if (pTexHandle->bUpdated)
+		{
+			m_pendingUploadList.erase(std::find(m_pendingUploadList.begin(), m_pendingUploadList.end(), pTexHandle));
+		}
+
 		if (pTexHandle->pUploadBuffer)
 		{
+			pTexHandle->pMappedUploadBuffer = nullptr;
+			pTexHandle->pUploadBuffer->Unmap(0, nullptr);
 			pTexHandle->pUploadBuffer->Release();
 			pTexHandle->pUploadBuffer = nullptr;
 		}
@@ -214,6 +598,15 @@ bool CTextureManager::CreateSrvForTexture(TextureHandle* pTexHandle, ID3D12Resou
 		return false;
 	}
 
+	WriteTextureSrv(srv, pTexResource, format, mipLevels);
+
+	pTexHandle->TextureResource = pTexResource;
+	pTexHandle->SrvDescriptorHandle = srv;
+	return true;
+}
+
+void CTextureManager::WriteTextureSrv(D3D12_CPU_DESCRIPTOR_HANDLE srv, ID3D12Resource* pTexResource, DXGI_FORMAT format, UINT mipLevels)
+{
 	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
 	srvDesc.Format = format;
 	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
@@ -221,15 +614,11 @@ bool CTextureManager::CreateSrvForTexture(TextureHandle* pTexHandle, ID3D12Resou
 	srvDesc.Texture2D.MipLevels = mipLevels;
 
 	m_pD3DDevice->CreateShaderResourceView(pTexResource, &srvDesc, srv);
-
-	pTexHandle->TextureResource = pTexResource;
-	pTexHandle->SrvDescriptorHandle = srv;
-	return true;
 }
 
 void CTextureManager::Cleanup()
 {
-	if (!m_fileTextureMap.empty())
+	if (!m_pathTextureMap.empty() || !m_contentTextureMap.empty())
 	{
 		// texture resource leak
 		__debugbreak();
@@ -2,12 +2,42 @@
 
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 class CD3D12Renderer;
 class CD3D12ResourceManager;
 class CPersistentCpuDescriptorAllocator;
+class CResourceStateTracker;
+class CMappedFile;
 struct TextureHandle;
 
+struct TextureCacheStats
+{
+	UINT64 RequestCount = 0;		// CreateTextureFromFile 호출 수
+	UINT64 PathHitCount = 0;		// 같은 경로가 이미 로드되어 있음
+	UINT64 ContentHitCount = 0;		// 다른 경로지만 내용이 같은 텍스처가 로드되어 있음
+	UINT64 LoadCount = 0;			// GPU 텍스처를 새로 만든 수
+	UINT64 SavedBytes = 0;			// 내용 중복으로 만들지 않은 GPU 할당 크기 합 (누적)
+	UINT TextureCount = 0;			// 현재 살아 있는 파일 텍스처 리소스 (내용 기준)
+	UINT PathCount = 0;				// 현재 등록된 경로
+	float HitRate = 0.0f;			// (PathHitCount + ContentHitCount) / RequestCount
+};
+
+/**
+ * Texture creation and lifetime. File textures are cached twice:
+ *   by path     the path is normalized ('\' -> '/', ASCII lowercase) and hashed to a 64-bit
+ *               id while scanning, so a repeated request costs one hash-map probe and no
+ *               string allocation; paths whose ids collide are chained under the same id and
+ *               told apart by the stored path
+ *   by content  on a path miss the DDS bytes are hashed (the asset archive's ContentHash is
+ *               reused when the file comes from Assets.bpk); if a texture with the same bytes is
+ *               alive, the new path shares its ID3D12Resource instead of a second upload. A hit
+ *               also needs the same size and an independent second hash of the bytes, so two
+ *               images colliding on ContentHash are chained rather than merged
+ * Every path still gets its own TextureHandle and SRV; only the resource is shared, with one
+ * COM reference per handle. A handle's RefCount counts the requests for its path, and a hot
+ * reload re-points just that path's handle, leaving other paths with the old bytes intact.
+ */
 class CTextureManager
 {
 public:
@@ -20,13 +50,56 @@ public:
 	TextureHandle* CreateDynamicTexture(UINT texWidth, UINT texHeight);
 	TextureHandle* CreateStaticTexture(UINT texWidth, UINT texHeight, DXGI_FORMAT format, const BYTE* pInitImage);
 
-	void UpdateTextureWithImage(TextureHandle* pTexHandle, const BYTE* pSrcBits, UINT srcWidth, UINT srcHeight);
+	// pDirtyRects가 nullptr이면 이미지 전체를 업로드한다. 그 프레임의 BeginRender 전에 호출해야 한다
+	void UpdateTextureWithImage(TextureHandle* pTexHandle, const BYTE* pSrcBits, UINT srcWidth, UINT srcHeight, const RECT* pDirtyRects = nullptr, UINT dirtyRectCount = 0);
 	void DeleteTexture(TextureHandle* pTexHandle);
 
+	// 핫 리로드: filePath의 핸들만 새 DDS 내용을 가리키게 하고 SRV를 같은 descriptor에 다시 쓴다.
+	// 이전 내용을 공유하던 다른 경로는 바뀌지 않는다. 교체했으면 *ppOutOldResource에 이 핸들의 이전 참조를 넘긴다
+	// (GPU가 끝낼 때까지 호출자가 보관 후 Release). 로드된 적 없는 경로이거나 내용이 같으면 false
+	bool ReloadTexture(const WCHAR* filePath, const BYTE* pData, size_t dataSize, UINT64 contentHash, ID3D12Resource** ppOutOldResource);
+
+	// 이번 프레임에 갱신된 동적 텍스처의 복사를 기록한다. 되돌리는 barrier는 pStateTracker에 보류된다
+	void RecordPendingUploads(ID3D12GraphicsCommandList* pCommandList, CResourceStateTracker* pStateTracker);
+
+	void GetCacheStats(TextureCacheStats* pOutStats) const;
+
+	// 정규화한 경로의 64비트 id. 대소문자와 구분자만 다른 경로는 같은 id
+	static UINT64 GetTexturePathId(const WCHAR* filePath);
+	static bool IsSameTexturePath(const WCHAR* pathA, const WCHAR* pathB);
+
+private:
+	struct TexturePathEntry
+	{
+		TextureHandle* pTexHandle = nullptr;
+		std::wstring FilePath;
+	};
+
+	// 같은 내용의 파일 텍스처들이 공유하는 리소스. 참조는 핸들마다 하나씩 가지고 있다
+	struct TextureContentEntry
+	{
+		ID3D12Resource* pTexResource = nullptr;
+		DXGI_FORMAT Format = DXGI_FORMAT_UNKNOWN;
+		UINT MipLevels = 1;
+		UINT64 ContentSize = 0;
+		UINT64 ContentCheckHash = 0;		// ContentHash와 독립인 두 번째 해시. 크기와 함께 같아야 같은 내용
+		UINT64 ResourceSize = 0;
+		UINT HandleCount = 0;
+	};
+
 private:
 	TextureHandle* AllocTextureHandle();
 	DWORD FreeTextureHandle(TextureHandle* pTexHandle);
+	// 렌더러의 에셋 아카이브에 있으면 거기서, 없으면 파일을 매핑해 읽는다. *ppOutData는 pMappedFile / pReadBuffer가 살아 있는 동안 유효
+	bool ReadTextureFile(const WCHAR* filePath, CMappedFile* pMappedFile, std::vector<BYTE>* pReadBuffer, const BYTE** ppOutData, size_t* pOutSize, UINT64* pOutContentHash) const;
+	void RegisterTexturePath(TextureHandle* pTexHandle, UINT64 pathId, const WCHAR* filePath);
+	// 같은 경로의 항목. 없으면 m_pathTextureMap.end()
+	std::unordered_multimap<UINT64, TexturePathEntry>::iterator FindTexturePath(UINT64 pathId, const WCHAR* filePath);
+	// 같은 내용의 리소스를 찾아 AddRef하거나 새로 만든다 (SRV는 호출자가 쓴다)
+	TextureContentEntry* AcquireTextureContent(const BYTE* pData, size_t dataSize, UINT64 contentHash, bool* pOutCreated);
+	void ReleaseTextureContent(TextureHandle* pTexHandle);
 	bool CreateSrvForTexture(TextureHandle* pTexHandle, ID3D12Resource* pTexResource, DXGI_FORMAT format, UINT mipLevels);
+	void WriteTextureSrv(D3D12_CPU_DESCRIPTOR_HANDLE srv, ID3D12Resource* pTexResource, DXGI_FORMAT format, UINT mipLevels);
 	void Cleanup();
 
 private:
@@ -35,5 +108,8 @@ private:
 	CD3D12ResourceManager* m_pResourceManager = nullptr;
 	CPersistentCpuDescriptorAllocator* m_pPersistentCpuDescriptorAllocator = nullptr;
 
-	std::unordered_map<std::wstring, TextureHandle*> m_fileTextureMap;
+	std::unordered_multimap<UINT64, TexturePathEntry> m_pathTextureMap;		// 경로 id -> 텍스처 (id 충돌은 같은 키에 여러 항목)
+	std::unordered_multimap<UINT64, TextureContentEntry> m_contentTextureMap;	// ContentHash -> 공유 리소스 (해시 충돌은 같은 키에 여러 항목)
+	TextureCacheStats m_cacheStats = {};
+	std::vector<TextureHandle*> m_pendingUploadList;
 };
@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "ConstantBufferPool.h"
+#include "GpuMemoryTag.h"
 
 bool CConstantBufferPool::Initialize(ID3D12Device5* pD3DDevice, UINT sizePerConstantBuffer, UINT maxCbvCount)
 {
@@ -36,6 +37,9 @@ bool CConstantBufferPool::Initialize(ID3D12Device5* pD3DDevice, UINT sizePerCons
 		return false;
 	}
 
+	TagGpuMemory(pD3DDevice, m_constantBufferChunk.Get(), EMemoryCategory::Constant);
+	TagGpuMemory(pD3DDevice, m_cbvDescriptorHeap.Get());
+
 	CD3DX12_RANGE writeRange(0, 0);
 	m_constantBufferChunk->Map(0, &writeRange, reinterpret_cast<void**>(&m_pSystemAddressForStart));
 
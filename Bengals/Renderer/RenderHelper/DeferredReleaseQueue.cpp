@@ -0,0 +1,89 @@
+#include "pch.h"
+#include "DeferredReleaseQueue.h"
+
+bool CDeferredReleaseQueue::Enqueue(UINT64 fenceValue, ReleaseFunc func)
+{
+	if (!func)
+	{
+		ReportError("Enqueue: empty release function");
+		return false;
+	}
+
+	// fence 값이 작아지는 경우는 없어야 한다. 정렬을 유지하도록 마지막 값으로 올린다 (더 늦게 해제될 뿐 안전)
+	bool bResult = true;
+	if (!m_entryList.empty() && fenceValue < m_entryList.back().FenceValue)
+	{
+		ReportError("Enqueue: fence value decreased");
+		fenceValue = m_entryList.back().FenceValue;
+		bResult = false;
+	}
+
+	m_entryList.push_back({ fenceValue, std::move(func) });
+	return bResult;
+}
+
+bool CDeferredReleaseQueue::EnqueueForNextFence(ReleaseFunc func)
+{
+	if (!func)
+	{
+		ReportError("EnqueueForNextFence: empty release function");
+		return false;
+	}
+
+	m_untaggedList.push_back(std::move(func));
+	return true;
+}
+
+bool CDeferredReleaseQueue::AssignFence(UINT64 fenceValue)
+{
+	bool bResult = true;
+	for (ReleaseFunc& func : m_untaggedList)
+	{
+		bResult &= Enqueue(fenceValue, std::move(func));
+	}
+	m_untaggedList.clear();
+	return bResult;
+}
+
+UINT CDeferredReleaseQueue::ProcessCompleted(UINT64 completedFenceValue)
+{
+	UINT releasedCount = 0;
+	while (!m_entryList.empty() && m_entryList.front().FenceValue <= completedFenceValue)
+	{
+		// release 안에서 Enqueue할 수 있으므로 꺼낸 뒤 실행
+		ReleaseFunc func = std::move(m_entryList.front().Func);
+		m_entryList.pop_front();
+		func();
+		releasedCount++;
+	}
+	return releasedCount;
+}
+
+UINT CDeferredReleaseQueue::Flush()
+{
+	// fence가 붙은 것부터 넣은 순서대로. 아직 fence를 받지 못한 release도 실행한다
+	UINT releasedCount = 0;
+	while (!m_entryList.empty() || !m_untaggedList.empty())
+	{
+		ReleaseFunc func = nullptr;
+		if (!m_entryList.empty())
+		{
+			func = std::move(m_entryList.front().Func);
+			m_entryList.pop_front();
+		}
+		else
+		{
+			func = std::move(m_untaggedList.front());
+			m_untaggedList.pop_front();
+		}
+		func();
+		releasedCount++;
+	}
+	return releasedCount;
+}
+
+void CDeferredReleaseQueue::ReportError(const char* pMessage)
+{
+	m_errorCount++;
+	m_pLastError = pMessage;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <deque>
+#include <functional>
+
+/**
+ * Frees objects once the GPU has finished every frame that could still reference them.
+ *
+ * Enqueue() tags a release with the fence value that will be signaled after all work
+ * recorded so far; ProcessCompleted() runs, in enqueue order, every release whose fence
+ * value the GPU has reached. Fence values only grow, so the queue stays sorted and
+ * processing stops at the first pending entry. A release may enqueue further releases
+ * (a mesh dropping its textures); Flush() keeps going until the queue is empty.
+ * When the fence value that will cover the current frame is not known yet (the queue may
+ * be signaled mid-frame for cross-queue sync), EnqueueForNextFence() holds the release
+ * untagged until AssignFence() is called with the frame-end value.
+ * A fence value smaller than the last one is raised to it and reported through
+ * GetErrorCount() / GetLastError(); Enqueue() returns false and the caller decides
+ * whether to break.
+ * Not thread-safe. No device access: the caller passes the completed fence value.
+ */
+
+class CDeferredReleaseQueue
+{
+public:
+	using ReleaseFunc = std::function<void()>;
+
+public:
+	CDeferredReleaseQueue() = default;
+	~CDeferredReleaseQueue() = default;
+
+	// false: func가 비었거나(무시) fence 값이 작아졌다(마지막 값으로 올려 추가)
+	bool Enqueue(UINT64 fenceValue, ReleaseFunc func);
+	// 다음 AssignFence의 값이 완료되면 실행. false: func가 비었다
+	bool EnqueueForNextFence(ReleaseFunc func);
+	// EnqueueForNextFence로 넣은 release들에 fenceValue를 붙인다. false: fence 값이 작아졌다 (Enqueue와 같이 보정)
+	bool AssignFence(UINT64 fenceValue);
+
+	// 실행한 release 수
+	UINT ProcessCompleted(UINT64 completedFenceValue);
+	// GPU가 모두 끝난 뒤(종료 시)에만 호출
+	UINT Flush();
+
+	UINT GetPendingCount() const
+	{
+		return static_cast<UINT>(m_entryList.size() + m_untaggedList.size());
+	}
+
+	UINT64 GetErrorCount() const { return m_errorCount; }
+	const char* GetLastError() const { return m_pLastError; }
+
+private:
+	struct ReleaseEntry
+	{
+		UINT64 FenceValue = 0;
+		ReleaseFunc Func = nullptr;
+	};
+
+	void ReportError(const char* pMessage);
+
+private:
+	std::deque<ReleaseEntry> m_entryList = {};
+	std::deque<ReleaseFunc> m_untaggedList = {};		// fence 값을 기다리는 release (넣은 순서)
+	UINT64 m_errorCount = 0;
+	const char* m_pLastError = nullptr;
+};
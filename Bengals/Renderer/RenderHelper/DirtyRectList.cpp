@@ -0,0 +1,93 @@
+#include "pch.h"
+#include "DirtyRectList.h"
+
+void CDirtyRectList::Reset(UINT width, UINT height)
+{
+	m_width = width;
+	m_height = height;
+	m_rectList.clear();
+}
+
+void CDirtyRectList::AddRect(const RECT& rect)
+{
+	RECT mergedRect = {};
+	mergedRect.left = (std::max<LONG>)(rect.left, 0);
+	mergedRect.top = (std::max<LONG>)(rect.top, 0);
+	mergedRect.right = (std::min)(rect.right, static_cast<LONG>(m_width));
+	mergedRect.bottom = (std::min)(rect.bottom, static_cast<LONG>(m_height));
+	if (mergedRect.left >= mergedRect.right || mergedRect.top >= mergedRect.bottom)
+	{
+		return;
+	}
+
+	// 합쳐진 사각형이 다른 사각형과 다시 합쳐질 수 있으므로 더 이상 합칠 것이 없을 때까지 반복
+	bool bMerged = true;
+	while (bMerged)
+	{
+		bMerged = false;
+		for (size_t i = 0; i < m_rectList.size(); i++)
+		{
+			const RECT boundingRect = GetBoundingRect(mergedRect, m_rectList[i]);
+			if (GetRectArea(boundingRect) <= GetRectArea(mergedRect) + GetRectArea(m_rectList[i]))
+			{
+				mergedRect = boundingRect;
+				m_rectList[i] = m_rectList.back();
+				m_rectList.pop_back();
+				bMerged = true;
+				break;
+			}
+		}
+	}
+
+	m_rectList.push_back(mergedRect);
+
+	if (m_rectList.size() > MaxRectCount)
+	{
+		RECT boundingRect = m_rectList[0];
+		for (const RECT& dirtyRect : m_rectList)
+		{
+			boundingRect = GetBoundingRect(boundingRect, dirtyRect);
+		}
+		m_rectList.clear();
+		m_rectList.push_back(boundingRect);
+	}
+}
+
+void CDirtyRectList::AddFullRect()
+{
+	m_rectList.clear();
+	if (m_width > 0 && m_height > 0)
+	{
+		m_rectList.push_back({ 0, 0, static_cast<LONG>(m_width), static_cast<LONG>(m_height) });
+	}
+}
+
+void CDirtyRectList::Clear()
+{
+	m_rectList.clear();
+}
+
+UINT64 CDirtyRectList::GetArea() const
+{
+	UINT64 area = 0;
+	for (const RECT& dirtyRect : m_rectList)
+	{
+		area += GetRectArea(dirtyRect);
+	}
+	return area;
+}
+
+UINT64 CDirtyRectList::GetRectArea(const RECT& rect)
+{
+	return static_cast<UINT64>(rect.right - rect.left) * static_cast<UINT64>(rect.bottom - rect.top);
+}
+
+RECT CDirtyRectList::GetBoundingRect(const RECT& a, const RECT& b)
+{
+	RECT boundingRect = {};
+	boundingRect.left = (std::min)(a.left, b.left);
+	boundingRect.top = (std::min)(a.top, b.top);
+	boundingRect.right = (std::max)(a.right, b.right);
+	boundingRect.bottom = (std::max)(a.bottom, b.bottom);
+	return boundingRect;
+}
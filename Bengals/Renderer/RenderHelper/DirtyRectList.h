@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * Set of texel rectangles that changed since the last upload.
+ *
+ * AddRect() merges a rectangle with an existing one when their bounding box is no
+ * larger than the two copied separately (touching tiles on a row or column), and keeps
+ * merging until nothing else fits. When more than MaxRectCount rectangles remain, they
+ * collapse into their bounding box so one upload never turns into hundreds of tiny copies.
+ * Rectangles are clipped to the bounds given at Reset(); empty ones are ignored.
+ */
+class CDirtyRectList
+{
+public:
+	static constexpr UINT MaxRectCount = 16;
+
+public:
+	void Reset(UINT width, UINT height);
+	void AddRect(const RECT& rect);
+	void AddFullRect();
+	void Clear();
+
+	bool IsEmpty() const
+	{
+		return m_rectList.empty();
+	}
+
+	UINT GetRectCount() const
+	{
+		return static_cast<UINT>(m_rectList.size());
+	}
+
+	const RECT* GetRects() const
+	{
+		return m_rectList.data();
+	}
+
+	UINT64 GetArea() const;
+
+private:
+	static UINT64 GetRectArea(const RECT& rect);
+	static RECT GetBoundingRect(const RECT& a, const RECT& b);
+
+private:
+	std::vector<RECT> m_rectList;
+	UINT m_width = 0;
+	UINT m_height = 0;
+};
@@ -0,0 +1,59 @@
+#include "pch.h"
+#include "FrameClock.h"
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+CHighResolutionFrameClock::CHighResolutionFrameClock()
+{
+	LARGE_INTEGER frequency = {};
+	QueryPerformanceFrequency(&frequency);
+	m_frequency = frequency.QuadPart;
+
+	// Windows 10 1803 이전에는 high resolution 타이머 생성이 실패하므로 일반 타이머로 대체
+	m_timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+	m_bHighResolutionTimer = (m_timer != nullptr);
+	if (!m_timer)
+	{
+		m_timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+	}
+}
+
+CHighResolutionFrameClock::~CHighResolutionFrameClock()
+{
+	if (m_timer)
+	{
+		CloseHandle(m_timer);
+		m_timer = nullptr;
+	}
+}
+
+double CHighResolutionFrameClock::GetTimeInSeconds() const
+{
+	LARGE_INTEGER counter = {};
+	QueryPerformanceCounter(&counter);
+	return static_cast<double>(counter.QuadPart) / static_cast<double>(m_frequency);
+}
+
+void CHighResolutionFrameClock::SleepUntil(double targetTimeInSeconds)
+{
+	// 타이머 해상도만큼은 남겨두고 잠든 뒤 나머지는 spin
+	const double spinThreshold = m_bHighResolutionTimer ? 0.0005 : 0.002;
+
+	double remaining = targetTimeInSeconds - GetTimeInSeconds();
+	if (remaining > spinThreshold && m_timer)
+	{
+		LARGE_INTEGER dueTime = {};
+		dueTime.QuadPart = -static_cast<LONGLONG>((remaining - spinThreshold) * 10000000.0);	// relative, 100ns
+		if (SetWaitableTimer(m_timer, &dueTime, 0, nullptr, nullptr, FALSE))
+		{
+			WaitForSingleObject(m_timer, INFINITE);
+		}
+	}
+
+	while (GetTimeInSeconds() < targetTimeInSeconds)
+	{
+		YieldProcessor();
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+/**
+ * Time source used by CFramePacer.
+ *
+ * CHighResolutionFrameClock is the real clock (QueryPerformanceCounter plus a high-resolution
+ * waitable timer). CSimulatedFrameClock only moves when told to, so pacing logic can be
+ * driven deterministically without a device or a window.
+ */
+class IFrameClock
+{
+public:
+	virtual ~IFrameClock() = default;
+
+	virtual double GetTimeInSeconds() const = 0;
+	virtual void SleepUntil(double targetTimeInSeconds) = 0;
+};
+
+class CHighResolutionFrameClock : public IFrameClock
+{
+public:
+	CHighResolutionFrameClock();
+	virtual ~CHighResolutionFrameClock();
+
+	double GetTimeInSeconds() const override;
+	void SleepUntil(double targetTimeInSeconds) override;
+
+private:
+	LONGLONG m_frequency = 1;
+	HANDLE m_timer = nullptr;
+	bool m_bHighResolutionTimer = false;
+};
+
+class CSimulatedFrameClock : public IFrameClock
+{
+public:
+	double GetTimeInSeconds() const override
+	{
+		return m_currentTime;
+	}
+
+	void SleepUntil(double targetTimeInSeconds) override
+	{
+		if (targetTimeInSeconds > m_currentTime)
+		{
+			m_currentTime = targetTimeInSeconds;
+		}
+	}
+
+	void Advance(double seconds)
+	{
+		m_currentTime += seconds;
+	}
+
+private:
+	double m_currentTime = 0.0;
+};
@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "FrameGpuDescriptorAllocator.h"
+#include "GpuMemoryTag.h"
 
 bool CFrameGpuDescriptorAllocator::Initialize(ID3D12Device5* pD3DDevice, UINT maxDescriptorCount)
 {
@@ -24,6 +25,8 @@ bool CFrameGpuDescriptorAllocator::Initialize(ID3D12Device5* pD3DDevice, UINT ma
 		return false;
 	}
 
+	TagGpuMemory(pD3DDevice, m_descriptorHeap.Get());
+
 	m_cpuDescriptorHandleForHeapStart = m_descriptorHeap->GetCPUDescriptorHandleForHeapStart();
 	m_gpuDescriptorHandleForHeapStart = m_descriptorHeap->GetGPUDescriptorHandleForHeapStart();
 
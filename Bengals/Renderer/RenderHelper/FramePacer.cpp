@@ -0,0 +1,164 @@
+#include "pch.h"
+#include <algorithm>
+#include "FrameClock.h"
+#include "FramePacer.h"
+
+bool CFramePacer::Initialize(IFrameClock* pClock, UINT maxPendingFrameCount, const FramePacingDesc& desc)
+{
+	if (!pClock || maxPendingFrameCount == 0)
+	{
+		__debugbreak();
+		return false;
+	}
+
+	m_pClock = pClock;
+	m_maxPendingFrameCount = maxPendingFrameCount;
+	m_frameTimeHistory.assign(FrameTimeHistoryCount, 0.0);
+	SetDesc(desc);
+	ResetStats();
+	return true;
+}
+
+void CFramePacer::SetDesc(const FramePacingDesc& desc)
+{
+	m_desc = desc;
+
+	// 적응 모드는 1프레임부터 시작해서 GPU 병목일 때만 늘린다
+	m_pendingFrameCount = m_desc.bAdaptivePendingFrames ? 1 : m_maxPendingFrameCount;
+	m_windowGpuBusySeconds = 0.0;
+	m_windowFrameSeconds = 0.0;
+	m_windowFrameCount = 0;
+	m_lowWindowCount = 0;
+	m_bFirstFrame = true;
+}
+
+double CFramePacer::GetTimeInSeconds() const
+{
+	return m_pClock->GetTimeInSeconds();
+}
+
+void CFramePacer::WaitForFrameSlot()
+{
+	if (m_desc.TargetFps <= 0.0f)
+	{
+		return;
+	}
+
+	const double frameInterval = 1.0 / static_cast<double>(m_desc.TargetFps);
+	double now = m_pClock->GetTimeInSeconds();
+	if (m_bFirstFrame)
+	{
+		m_nextFrameTime = now + frameInterval;
+		return;
+	}
+
+	if (now < m_nextFrameTime)
+	{
+		m_pClock->SleepUntil(m_nextFrameTime);
+		m_nextFrameTime += frameInterval;
+	}
+	else if (now - m_nextFrameTime > frameInterval)
+	{
+		// 한 프레임 이상 밀렸으면 따라잡으려 하지 말고 기준을 다시 잡는다
+		m_nextFrameTime = now + frameInterval;
+	}
+	else
+	{
+		m_nextFrameTime += frameInterval;
+	}
+}
+
+void CFramePacer::EndFrame(double gpuBusySeconds)
+{
+	double now = m_pClock->GetTimeInSeconds();
+	if (m_bFirstFrame)
+	{
+		m_lastFrameEndTime = now;
+		m_bFirstFrame = false;
+		return;
+	}
+
+	double frameSeconds = now - m_lastFrameEndTime;
+	m_lastFrameEndTime = now;
+
+	m_frameTimeHistory[m_frameTimeWriteIndex] = frameSeconds;
+	m_frameTimeWriteIndex = (m_frameTimeWriteIndex + 1) % FrameTimeHistoryCount;
+	if (m_frameTimeCount < FrameTimeHistoryCount)
+	{
+		m_frameTimeCount++;
+	}
+
+	if (m_desc.bAdaptivePendingFrames)
+	{
+		UpdatePendingFrameCount(gpuBusySeconds, frameSeconds);
+	}
+}
+
+void CFramePacer::GetFrameTimeStats(FrameTimeStats* pOutStats) const
+{
+	*pOutStats = {};
+	pOutStats->PendingFrameCount = m_pendingFrameCount;
+	pOutStats->SampleCount = m_frameTimeCount;
+	if (m_frameTimeCount == 0)
+	{
+		return;
+	}
+
+	std::vector<double> sortedList(m_frameTimeHistory.begin(), m_frameTimeHistory.begin() + m_frameTimeCount);
+	std::sort(sortedList.begin(), sortedList.end());
+
+	double total = 0.0;
+	for (double frameSeconds : sortedList)
+	{
+		total += frameSeconds;
+	}
+
+	// nearest-rank percentile
+	auto percentile = [&sortedList](double p) -> double
+		{
+			size_t rank = static_cast<size_t>(p * static_cast<double>(sortedList.size()) + 0.999999);
+			rank = (std::max)(rank, static_cast<size_t>(1));
+			rank = (std::min)(rank, sortedList.size());
+			return sortedList[rank - 1];
+		};
+
+	pOutStats->AverageMs = total / static_cast<double>(sortedList.size()) * 1000.0;
+	pOutStats->P50Ms = percentile(0.50) * 1000.0;
+	pOutStats->P99Ms = percentile(0.99) * 1000.0;
+	pOutStats->MaxMs = sortedList.back() * 1000.0;
+}
+
+void CFramePacer::ResetStats()
+{
+	m_frameTimeWriteIndex = 0;
+	m_frameTimeCount = 0;
+}
+
+void CFramePacer::UpdatePendingFrameCount(double gpuBusySeconds, double frameSeconds)
+{
+	m_windowGpuBusySeconds += gpuBusySeconds;
+	m_windowFrameSeconds += frameSeconds;
+	m_windowFrameCount++;
+
+	if (m_windowFrameCount < AdaptWindowFrameCount)
+	{
+		return;
+	}
+
+	// GPU 작업량은 pending 수와 무관하고, 겹치면 프레임이 짧아져 비율은 더 커진다. 올린 뒤 바로 내려가지 않는다
+	double busyRatio = (m_windowFrameSeconds > 0.0) ? m_windowGpuBusySeconds / m_windowFrameSeconds : 0.0;
+	m_lowWindowCount = (busyRatio < LowerPendingGpuBusyRatio) ? m_lowWindowCount + 1 : 0;
+	if (busyRatio > RaisePendingGpuBusyRatio && m_pendingFrameCount < m_maxPendingFrameCount)
+	{
+		m_pendingFrameCount++;
+	}
+	else if (m_lowWindowCount >= LowerPendingWindowCount && m_pendingFrameCount > 1)
+	{
+		m_pendingFrameCount--;
+		m_lowWindowCount = 0;
+	}
+
+	m_windowGpuBusySeconds = 0.0;
+	m_windowFrameSeconds = 0.0;
+	m_windowFrameCount = 0;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <vector>
+
+class IFrameClock;
+
+struct FramePacingDesc
+{
+	UINT SyncInterval = 0;				// 0 = VSync off
+	bool bAllowTearing = true;			// SyncInterval == 0 일 때만 적용
+	float TargetFps = 0.0f;				// 0 = unlimited
+	UINT MaxFrameLatency = 2;			// IDXGISwapChain2::SetMaximumFrameLatency
+	bool bAdaptivePendingFrames = true;
+};
+
+struct FrameTimeStats
+{
+	UINT SampleCount = 0;
+	double AverageMs = 0.0;
+	double P50Ms = 0.0;
+	double P99Ms = 0.0;
+	double MaxMs = 0.0;
+	UINT PendingFrameCount = 0;
+};
+
+/**
+ * CPU-side frame pacing: target-FPS limiter, adaptive number of frames in flight and
+ * frame-time statistics.
+ *
+ * Call EndFrame() once per Present with the GPU busy time of the last completed frame
+ * (timestamp queries). When the GPU is busy for only a small share of the frame, one frame
+ * in flight is enough and keeps latency low. When it is busy for a large share, running
+ * the CPU and GPU serially costs that share, so the pacer allows up to maxPendingFrameCount
+ * frames to overlap them. The fence wait is not used: it depends on the pending count
+ * itself (large at 1, near zero at 2) and would flip the count every window. Lowering also
+ * needs LowerPendingWindowCount windows in a row below the threshold.
+ * CD3D12Renderer passes MaxPendingFrameCount = SwapChainFrameCount - 1 = 2, so in the
+ * renderer the adaptation is a toggle between 1 and 2 frames in flight.
+ * All timing goes through IFrameClock.
+ */
+class CFramePacer
+{
+public:
+	static constexpr UINT FrameTimeHistoryCount = 240;
+	static constexpr UINT AdaptWindowFrameCount = 60;
+	static constexpr double RaisePendingGpuBusyRatio = 0.2;
+	static constexpr double LowerPendingGpuBusyRatio = 0.1;
+	static constexpr UINT LowerPendingWindowCount = 3;
+
+public:
+	CFramePacer() = default;
+	~CFramePacer() = default;
+
+	bool Initialize(IFrameClock* pClock, UINT maxPendingFrameCount, const FramePacingDesc& desc);
+	void SetDesc(const FramePacingDesc& desc);
+	const FramePacingDesc& GetDesc() const
+	{
+		return m_desc;
+	}
+
+	UINT GetPendingFrameCount() const
+	{
+		return m_pendingFrameCount;
+	}
+
+	double GetTimeInSeconds() const;
+	void WaitForFrameSlot();
+	void EndFrame(double gpuBusySeconds);
+
+	void GetFrameTimeStats(FrameTimeStats* pOutStats) const;
+	void ResetStats();
+
+private:
+	void UpdatePendingFrameCount(double gpuBusySeconds, double frameSeconds);
+
+private:
+	IFrameClock* m_pClock = nullptr;
+	FramePacingDesc m_desc = {};
+	UINT m_maxPendingFrameCount = 1;
+	UINT m_pendingFrameCount = 1;
+
+	// limiter
+	double m_nextFrameTime = 0.0;
+	double m_lastFrameEndTime = 0.0;
+	bool m_bFirstFrame = true;
+
+	// frame time ring buffer (seconds)
+	std::vector<double> m_frameTimeHistory = {};
+	UINT m_frameTimeWriteIndex = 0;
+	UINT m_frameTimeCount = 0;
+
+	// adaptive pending frame window
+	double m_windowGpuBusySeconds = 0.0;
+	double m_windowFrameSeconds = 0.0;
+	UINT m_windowFrameCount = 0;
+	UINT m_lowWindowCount = 0;			// 연속으로 LowerPendingGpuBusyRatio 아래였던 창 수
+};
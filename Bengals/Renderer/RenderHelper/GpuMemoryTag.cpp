@@ -0,0 +1,98 @@
+#include "pch.h"
+#include "GpuMemoryTag.h"
+#include <atomic>
+
+namespace
+{
+	// {8E0A4B31-6C52-4D7F-9A13-2B5E7C9D0F46}
+	constexpr GUID MemoryTagGuid = { 0x8e0a4b31, 0x6c52, 0x4d7f, { 0x9a, 0x13, 0x2b, 0x5e, 0x7c, 0x9d, 0x0f, 0x46 } };
+
+	class CGpuMemoryTag final : public IUnknown
+	{
+	public:
+		CGpuMemoryTag(EMemoryCategory category, UINT64 sizeInBytes)
+			: m_category(category), m_sizeInBytes(sizeInBytes)
+		{
+			CMemoryTracker::Get().RecordAllocation(m_category, m_sizeInBytes);
+		}
+
+		HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override
+		{
+			if (!ppvObject)
+			{
+				return E_POINTER;
+			}
+			if (riid != __uuidof(IUnknown))
+			{
+				*ppvObject = nullptr;
+				return E_NOINTERFACE;
+			}
+			AddRef();
+			*ppvObject = static_cast<IUnknown*>(this);
+			return S_OK;
+		}
+
+		ULONG STDMETHODCALLTYPE AddRef() override
+		{
+			return m_refCount.fetch_add(1, std::memory_order_relaxed) + 1;
+		}
+
+		ULONG STDMETHODCALLTYPE Release() override
+		{
+			const ULONG refCount = m_refCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+			if (refCount == 0)
+			{
+				delete this;
+			}
+			return refCount;
+		}
+
+	private:
+		~CGpuMemoryTag()
+		{
+			CMemoryTracker::Get().RecordFree(m_category, m_sizeInBytes);
+		}
+
+	private:
+		std::atomic<ULONG> m_refCount = 1;
+		EMemoryCategory m_category = EMemoryCategory::Count;
+		UINT64 m_sizeInBytes = 0;
+	};
+
+	void AttachMemoryTag(ID3D12Object* pObject, EMemoryCategory category, UINT64 sizeInBytes)
+	{
+		// private data가 참조를 하나 갖는다. 객체가 소멸하면 Release되어 해제가 기록된다
+		CGpuMemoryTag* pTag = new CGpuMemoryTag(category, sizeInBytes);
+		if (FAILED(pObject->SetPrivateDataInterface(MemoryTagGuid, pTag)))
+		{
+			__debugbreak();
+		}
+		pTag->Release();
+	}
+}
+
+void TagGpuMemory(ID3D12Device* pD3DDevice, ID3D12Resource* pResource, EMemoryCategory category)
+{
+	if (!pD3DDevice || !pResource)
+	{
+		__debugbreak();
+		return;
+	}
+
+	const D3D12_RESOURCE_DESC desc = pResource->GetDesc();
+	const UINT64 sizeInBytes = pD3DDevice->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+	AttachMemoryTag(pResource, category, sizeInBytes);
+}
+
+void TagGpuMemory(ID3D12Device* pD3DDevice, ID3D12DescriptorHeap* pDescriptorHeap)
+{
+	if (!pD3DDevice || !pDescriptorHeap)
+	{
+		__debugbreak();
+		return;
+	}
+
+	const D3D12_DESCRIPTOR_HEAP_DESC desc = pDescriptorHeap->GetDesc();
+	const UINT64 sizeInBytes = static_cast<UINT64>(desc.NumDescriptors) * pD3DDevice->GetDescriptorHandleIncrementSize(desc.Type);
+	AttachMemoryTag(pDescriptorHeap, EMemoryCategory::Descriptor, sizeInBytes);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <d3d12.h>
+#include "Profiler/MemoryTracker.h"
+
+/**
+ * Reports a D3D12 object's memory to CMemoryTracker::Get() for as long as the object lives.
+ *
+ * The size is recorded right away and a small IUnknown is attached as private data; D3D
+ * releases it when the object is destroyed, whichever ComPtr, Release() or deferred release
+ * drops the last reference, and that records the free. Tagging the same object again
+ * replaces the earlier tag, so re-tagging (e.g. back buffers after a resize) never double
+ * counts. Resources are measured with GetResourceAllocationInfo, descriptor heaps as
+ * NumDescriptors * handle increment size.
+ */
+
+void TagGpuMemory(ID3D12Device* pD3DDevice, ID3D12Resource* pResource, EMemoryCategory category);
+void TagGpuMemory(ID3D12Device* pD3DDevice, ID3D12DescriptorHeap* pDescriptorHeap);
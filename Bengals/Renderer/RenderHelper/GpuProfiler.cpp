@@ -0,0 +1,255 @@
+#include "pch.h"
+#include <algorithm>
+#include "GpuProfiler.h"
+#include "GpuMemoryTag.h"
+#include "Profiler/Profiler.h"
+
+CGpuProfiler::~CGpuProfiler()
+{
+	Cleanup();
+}
+
+bool CGpuProfiler::Initialize(ID3D12Device5* pD3DDevice, ID3D12CommandQueue* pCommandQueue, UINT frameContextCount)
+{
+	if (!pD3DDevice || !pCommandQueue || frameContextCount == 0)
+	{
+		__debugbreak();
+		return false;
+	}
+
+	m_pCommandQueue = pCommandQueue;
+	m_frameContextCount = frameContextCount;
+
+	const UINT totalQueryCount = frameContextCount * MaxQueryPairCountPerFrame * 2;
+
+	D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
+	queryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+	queryHeapDesc.Count = totalQueryCount;
+	if (FAILED(pD3DDevice->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&m_pQueryHeap))))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	CD3DX12_HEAP_PROPERTIES readbackHeapProperties(D3D12_HEAP_TYPE_READBACK);
+	CD3DX12_RESOURCE_DESC readbackBufferDesc = CD3DX12_RESOURCE_DESC::Buffer(sizeof(UINT64) * totalQueryCount);
+	if (FAILED(pD3DDevice->CreateCommittedResource(
+		&readbackHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&readbackBufferDesc,
+		D3D12_RESOURCE_STATE_COPY_DEST,
+		nullptr,
+		IID_PPV_ARGS(&m_pReadbackBuffer))))
+	{
+		__debugbreak();
+		Cleanup();
+		return false;
+	}
+
+	TagGpuMemory(pD3DDevice, m_pReadbackBuffer, EMemoryCategory::Readback);
+
+	m_frameQueryStateList = std::make_unique<FrameQueryState[]>(frameContextCount);
+	for (UINT i = 0; i < frameContextCount; i++)
+	{
+		m_frameQueryStateList[i].NameList.resize(MaxQueryPairCountPerFrame, nullptr);
+	}
+
+	if (FAILED(m_pCommandQueue->GetTimestampFrequency(&m_timestampFrequency)) || m_timestampFrequency == 0)
+	{
+		__debugbreak();
+		Cleanup();
+		return false;
+	}
+
+	m_trackId = CProfiler::Get().RegisterTrack("GPU Direct Queue");
+	Calibrate();
+	return true;
+}
+
+UINT CGpuProfiler::BeginQuery(ID3D12GraphicsCommandList* pCommandList, DWORD contextIndex, const char* name)
+{
+	// 프로파일러가 꺼져 있어도 기록한다: frame pacer가 GPU busy 시간을 쓴다
+	if (!m_pQueryHeap || !pCommandList || contextIndex >= m_frameContextCount)
+	{
+		return InvalidQuery;
+	}
+
+	FrameQueryState& frameState = m_frameQueryStateList[contextIndex];
+	UINT queryPairIndex = frameState.QueryPairCount.fetch_add(1, std::memory_order_relaxed);
+	if (queryPairIndex >= MaxQueryPairCountPerFrame)
+	{
+		// 이번 프레임 슬롯 소진: 측정 생략
+		return InvalidQuery;
+	}
+
+	frameState.NameList[queryPairIndex] = name;
+	pCommandList->EndQuery(m_pQueryHeap, D3D12_QUERY_TYPE_TIMESTAMP, GetHeapIndex(contextIndex, queryPairIndex));
+	return queryPairIndex;
+}
+
+void CGpuProfiler::EndQuery(ID3D12GraphicsCommandList* pCommandList, DWORD contextIndex, UINT queryPairIndex)
+{
+	if (queryPairIndex == InvalidQuery || !pCommandList || contextIndex >= m_frameContextCount)
+	{
+		return;
+	}
+
+	pCommandList->EndQuery(m_pQueryHeap, D3D12_QUERY_TYPE_TIMESTAMP, GetHeapIndex(contextIndex, queryPairIndex) + 1);
+}
+
+void CGpuProfiler::ResolveFrame(ID3D12GraphicsCommandList* pCommandList, DWORD contextIndex)
+{
+	if (!m_pQueryHeap || !pCommandList || contextIndex >= m_frameContextCount)
+	{
+		return;
+	}
+
+	FrameQueryState& frameState = m_frameQueryStateList[contextIndex];
+	UINT pairCount = frameState.QueryPairCount.load(std::memory_order_acquire);
+	if (pairCount > MaxQueryPairCountPerFrame)
+	{
+		pairCount = MaxQueryPairCountPerFrame;
+	}
+
+	frameState.ResolvedPairCount = pairCount;
+	if (pairCount == 0)
+	{
+		return;
+	}
+
+	const UINT startIndex = GetHeapIndex(contextIndex, 0);
+	pCommandList->ResolveQueryData(
+		m_pQueryHeap,
+		D3D12_QUERY_TYPE_TIMESTAMP,
+		startIndex,
+		pairCount * 2,
+		m_pReadbackBuffer,
+		sizeof(UINT64) * startIndex);
+}
+
+void CGpuProfiler::CollectFrame(DWORD contextIndex)
+{
+	if (!m_pReadbackBuffer || contextIndex >= m_frameContextCount)
+	{
+		return;
+	}
+
+	FrameQueryState& frameState = m_frameQueryStateList[contextIndex];
+	const UINT pairCount = frameState.ResolvedPairCount;
+	frameState.ResolvedPairCount = 0;
+	frameState.QueryPairCount.store(0, std::memory_order_relaxed);
+
+	// 측정이 없는 프레임이 이전 값을 남기지 않도록 먼저 비운다
+	m_lastFrameGpuTimeMs = 0.0;
+	m_lastFrameGpuBusyMs = 0.0;
+	if (pairCount == 0)
+	{
+		return;
+	}
+
+	const UINT startIndex = GetHeapIndex(contextIndex, 0);
+	D3D12_RANGE readRange = { sizeof(UINT64) * startIndex, sizeof(UINT64) * (startIndex + pairCount * 2) };
+	UINT64* pTimestampList = nullptr;
+	if (FAILED(m_pReadbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&pTimestampList))))
+	{
+		__debugbreak();
+		return;
+	}
+
+	CProfiler& profiler = CProfiler::Get();
+	const bool bRecordEvents = profiler.IsEnabled();
+	if (bRecordEvents)
+	{
+		Calibrate();
+	}
+
+	auto toCpuTimeNs = [this](UINT64 gpuTimestamp) -> uint64_t
+		{
+			double deltaSeconds = (static_cast<double>(gpuTimestamp) - static_cast<double>(m_calibrationGpuTimestamp)) / static_cast<double>(m_timestampFrequency);
+			return static_cast<uint64_t>(static_cast<double>(m_calibrationCpuTimeNs) + deltaSeconds * 1e9);
+		};
+
+	UINT64 frameBeginTimestamp = UINT64_MAX;
+	UINT64 frameEndTimestamp = 0;
+	m_busyIntervalList.clear();
+	for (UINT queryPairIndex = 0; queryPairIndex < pairCount; queryPairIndex++)
+	{
+		UINT64 beginTimestamp = pTimestampList[startIndex + queryPairIndex * 2];
+		UINT64 endTimestamp = pTimestampList[startIndex + queryPairIndex * 2 + 1];
+		if (endTimestamp < beginTimestamp)
+		{
+			continue;
+		}
+
+		frameBeginTimestamp = (std::min)(frameBeginTimestamp, beginTimestamp);
+		frameEndTimestamp = (std::max)(frameEndTimestamp, endTimestamp);
+		m_busyIntervalList.emplace_back(beginTimestamp, endTimestamp);
+		if (bRecordEvents)
+		{
+			profiler.RecordEvent(m_trackId, frameState.NameList[queryPairIndex], toCpuTimeNs(beginTimestamp), toCpuTimeNs(endTimestamp));
+		}
+	}
+
+	D3D12_RANGE writeRange = { 0, 0 };
+	m_pReadbackBuffer->Unmap(0, &writeRange);
+
+	if (frameEndTimestamp > frameBeginTimestamp)
+	{
+		m_lastFrameGpuTimeMs = static_cast<double>(frameEndTimestamp - frameBeginTimestamp) * 1000.0 / static_cast<double>(m_timestampFrequency);
+	}
+
+	// 겹치는 구간을 합쳐 GPU가 실제로 일한 시간만 센다
+	std::sort(m_busyIntervalList.begin(), m_busyIntervalList.end());
+	UINT64 busyTicks = 0;
+	UINT64 coveredEnd = 0;
+	for (const std::pair<UINT64, UINT64>& interval : m_busyIntervalList)
+	{
+		const UINT64 begin = (std::max)(interval.first, coveredEnd);
+		if (interval.second > begin)
+		{
+			busyTicks += interval.second - begin;
+			coveredEnd = interval.second;
+		}
+	}
+	m_lastFrameGpuBusyMs = static_cast<double>(busyTicks) * 1000.0 / static_cast<double>(m_timestampFrequency);
+}
+
+void CGpuProfiler::Calibrate()
+{
+	// GPU timestamp <-> QPC 기준점을 얻고, QPC를 CPU profiler 시간(steady_clock ns)으로 옮긴다
+	UINT64 gpuTimestamp = 0;
+	UINT64 cpuTimestamp = 0;
+	if (FAILED(m_pCommandQueue->GetClockCalibration(&gpuTimestamp, &cpuTimestamp)))
+	{
+		return;
+	}
+
+	LARGE_INTEGER qpcFrequency = {};
+	LARGE_INTEGER qpcNow = {};
+	QueryPerformanceFrequency(&qpcFrequency);
+	QueryPerformanceCounter(&qpcNow);
+	uint64_t profilerNowNs = CProfiler::GetTimeNs();
+
+	double calibrationAgeSeconds = static_cast<double>(qpcNow.QuadPart - static_cast<LONGLONG>(cpuTimestamp)) / static_cast<double>(qpcFrequency.QuadPart);
+	m_calibrationGpuTimestamp = gpuTimestamp;
+	m_calibrationCpuTimeNs = profilerNowNs - static_cast<uint64_t>(calibrationAgeSeconds * 1e9);
+}
+
+void CGpuProfiler::Cleanup()
+{
+	if (m_pReadbackBuffer)
+	{
+		m_pReadbackBuffer->Release();
+		m_pReadbackBuffer = nullptr;
+	}
+
+	if (m_pQueryHeap)
+	{
+		m_pQueryHeap->Release();
+		m_pQueryHeap = nullptr;
+	}
+
+	m_frameQueryStateList = nullptr;
+	m_frameContextCount = 0;
+	m_pCommandQueue = nullptr;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <climits>
+#include <d3d12.h>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * GPU timestamp queries around command lists.
+ *
+ * Each frame context owns a range of a timestamp query heap and of a readback buffer.
+ * Query pairs are handed out atomically, so render threads can open them concurrently.
+ * ResolveFrame() copies the range into the readback buffer at the end of the frame.
+ * CollectFrame() runs after that context's fence has passed, converts the ticks to the
+ * CPU profiler timebase and pushes them into the profiler's GPU track, which acts as
+ * the history ring buffer. It also keeps the frame's span (first begin to last end) and
+ * its busy time (union of the query intervals, without the gaps where the GPU waited for
+ * the CPU to submit), which the frame pacer uses. Queries are therefore recorded even when
+ * CProfiler is disabled; only the push into the GPU track is skipped. A frame without
+ * resolved queries reports 0 for both.
+ */
+class CGpuProfiler
+{
+public:
+	static constexpr UINT MaxQueryPairCountPerFrame = 512;
+	static constexpr UINT InvalidQuery = UINT_MAX;
+
+public:
+	CGpuProfiler() = default;
+	~CGpuProfiler();
+
+	bool Initialize(ID3D12Device5* pD3DDevice, ID3D12CommandQueue* pCommandQueue, UINT frameContextCount);
+
+	UINT BeginQuery(ID3D12GraphicsCommandList* pCommandList, DWORD contextIndex, const char* name);
+	void EndQuery(ID3D12GraphicsCommandList* pCommandList, DWORD contextIndex, UINT queryPairIndex);
+
+	void ResolveFrame(ID3D12GraphicsCommandList* pCommandList, DWORD contextIndex);
+	void CollectFrame(DWORD contextIndex);
+
+	double GetLastFrameGpuTimeMs() const
+	{
+		return m_lastFrameGpuTimeMs;
+	}
+
+	double GetLastFrameGpuBusyMs() const
+	{
+		return m_lastFrameGpuBusyMs;
+	}
+
+private:
+	struct FrameQueryState
+	{
+		std::atomic<UINT> QueryPairCount = 0;
+		std::vector<const char*> NameList = {};
+		UINT ResolvedPairCount = 0;
+	};
+
+	UINT GetHeapIndex(DWORD contextIndex, UINT queryPairIndex) const
+	{
+		return (contextIndex * MaxQueryPairCountPerFrame + queryPairIndex) * 2;
+	}
+
+	void Calibrate();
+	void Cleanup();
+
+private:
+	ID3D12CommandQueue* m_pCommandQueue = nullptr;
+	ID3D12QueryHeap* m_pQueryHeap = nullptr;
+	ID3D12Resource* m_pReadbackBuffer = nullptr;
+	std::unique_ptr<FrameQueryState[]> m_frameQueryStateList = nullptr;
+	UINT m_frameContextCount = 0;
+
+	UINT64 m_timestampFrequency = 1;
+	UINT64 m_calibrationGpuTimestamp = 0;
+	uint64_t m_calibrationCpuTimeNs = 0;
+
+	UINT m_trackId = UINT_MAX;
+	double m_lastFrameGpuTimeMs = 0.0;
+	double m_lastFrameGpuBusyMs = 0.0;
+	std::vector<std::pair<UINT64, UINT64>> m_busyIntervalList = {};
+};
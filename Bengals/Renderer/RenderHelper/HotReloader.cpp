@@ -0,0 +1,200 @@
+#include "pch.h"
+#include "HotReloader.h"
+#include <algorithm>
+#include "ShaderArchive.h"
+#include "Asset/AssetArchive.h"
+#include "Asset/MappedFile.h"
+#include "../Manager/TextureManager.h"
+
+namespace
+{
+	enum class EHotReloadFileType : UINT8
+	{
+		None,
+		Texture,
+		Shader
+	};
+
+	EHotReloadFileType GetHotReloadFileType(const std::filesystem::path& filePath)
+	{
+		std::wstring extension = filePath.extension().wstring();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](WCHAR c) { return static_cast<WCHAR>(towlower(c)); });
+
+		if (extension == L".dds")
+		{
+			return EHotReloadFileType::Texture;
+		}
+		if (extension == L".hlsl" || extension == L".hlsli")
+		{
+			return EHotReloadFileType::Shader;
+		}
+		return EHotReloadFileType::None;
+	}
+
+	// 빌드 설정과 같은 BengalsShaderBuild (Bengals.vcxproj의 PreBuildEvent 참고)
+#if defined(_WIN64) && defined(_DEBUG)
+	const WCHAR* ShaderBuildCommandLine = L"\"..\\BengalsShaderBuild\\BengalsShaderBuild_x64_debug.exe\" --root . --out ShaderArchive.bsa --debug";
+#elif defined(_WIN64)
+	const WCHAR* ShaderBuildCommandLine = L"\"..\\BengalsShaderBuild\\BengalsShaderBuild_x64_release.exe\" --root . --out ShaderArchive.bsa";
+#elif defined(_DEBUG)
+	const WCHAR* ShaderBuildCommandLine = L"\"..\\BengalsShaderBuild\\BengalsShaderBuild_x86_debug.exe\" --root . --out ShaderArchive.bsa --debug";
+#else
+	const WCHAR* ShaderBuildCommandLine = L"\"..\\BengalsShaderBuild\\BengalsShaderBuild_x86_release.exe\" --root . --out ShaderArchive.bsa";
+#endif
+}
+
+CHotReloader::~CHotReloader()
+{
+	Cleanup();
+}
+
+bool CHotReloader::Initialize(const WCHAR* wchTextureRoot, const WCHAR* wchShaderRoot, const WCHAR* wchShaderArchiveFileName)
+{
+	if (!wchTextureRoot || !wchShaderRoot || !wchShaderArchiveFileName)
+	{
+		__debugbreak();
+		return false;
+	}
+
+	m_shaderArchivePath = wchShaderArchiveFileName;
+	return m_fileWatcher.Start({ wchTextureRoot, wchShaderRoot },
+		[this](const std::vector<std::filesystem::path>& changedFileList) { OnFilesChanged(changedFileList); });
+}
+
+void CHotReloader::Cleanup()
+{
+	// 감시 스레드가 끝난 뒤에 대기 중인 결과를 버린다
+	m_fileWatcher.Stop();
+
+	std::lock_guard<std::mutex> lock(m_pendingMutex);
+	m_pendingTextureList.clear();
+	m_pendingShaderArchive = nullptr;
+}
+
+void CHotReloader::TakePendingReloads(std::vector<HotReloadTexture>* pOutTextureList, std::unique_ptr<CShaderArchive>* pOutShaderArchive)
+{
+	std::lock_guard<std::mutex> lock(m_pendingMutex);
+	pOutTextureList->swap(m_pendingTextureList);
+	m_pendingTextureList.clear();
+	*pOutShaderArchive = std::move(m_pendingShaderArchive);
+}
+
+void CHotReloader::OnFilesChanged(const std::vector<std::filesystem::path>& changedFileList)
+{
+	// 감시 스레드: 파일 읽기와 셰이더 빌드는 렌더 스레드 밖에서 끝낸다
+	bool bShaderChanged = false;
+	for (const std::filesystem::path& filePath : changedFileList)
+	{
+		const EHotReloadFileType fileType = GetHotReloadFileType(filePath);
+		if (fileType == EHotReloadFileType::Shader)
+		{
+			bShaderChanged = true;
+			continue;
+		}
+		if (fileType != EHotReloadFileType::Texture)
+		{
+			continue;
+		}
+
+		HotReloadTexture texture = {};
+		if (!ReadTexture(filePath, &texture))
+		{
+			continue;
+		}
+
+		std::lock_guard<std::mutex> lock(m_pendingMutex);
+		auto textureIter = std::find_if(m_pendingTextureList.begin(), m_pendingTextureList.end(),
+			[&texture](const HotReloadTexture& pending) { return CTextureManager::IsSameTexturePath(pending.FilePath.c_str(), texture.FilePath.c_str()); });
+		if (textureIter != m_pendingTextureList.end())
+		{
+			*textureIter = std::move(texture);
+		}
+		else
+		{
+			m_pendingTextureList.push_back(std::move(texture));
+		}
+	}
+
+	if (!bShaderChanged)
+	{
+		return;
+	}
+
+	std::unique_ptr<CShaderArchive> shaderArchive = std::make_unique<CShaderArchive>();
+	const bool bBuilt = RunShaderBuild() && shaderArchive->ReadFromFile(m_shaderArchivePath.c_str());
+
+	if (!bBuilt)
+	{
+		// 컴파일 오류: 도구가 아카이브를 건드리지 않으므로 실행 중인 셰이더를 유지
+		OutputDebugStringA("hot reload: shader build failed, keeping the current shaders\n");
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_pendingMutex);
+	m_pendingShaderArchive = std::move(shaderArchive);
+}
+
+bool CHotReloader::ReadTexture(const std::filesystem::path& filePath, HotReloadTexture* pOutTexture) const
+{
+	// 편집기가 아직 쓰는 중이면 열리지 않는다. 저장이 끝나면 다시 알림이 온다
+	CMappedFile mappedFile;
+	if (!mappedFile.Open(filePath))
+	{
+		return false;
+	}
+
+	pOutTexture->FilePath = filePath.wstring();
+	pOutTexture->Data.assign(mappedFile.GetData(), mappedFile.GetData() + mappedFile.GetSize());
+	pOutTexture->ContentHash = CAssetArchive::HashBytes(pOutTexture->Data.data(), pOutTexture->Data.size());
+	return true;
+}
+
+bool CHotReloader::RunShaderBuild() const
+{
+	SECURITY_ATTRIBUTES securityAttributes = {};
+	securityAttributes.nLength = sizeof(securityAttributes);
+	securityAttributes.bInheritHandle = TRUE;
+
+	HANDLE readPipe = nullptr;
+	HANDLE writePipe = nullptr;
+	if (!CreatePipe(&readPipe, &writePipe, &securityAttributes, 0))
+	{
+		return false;
+	}
+	SetHandleInformation(readPipe, HANDLE_FLAG_INHERIT, 0);
+
+	STARTUPINFOW startupInfo = {};
+	startupInfo.cb = sizeof(startupInfo);
+	startupInfo.dwFlags = STARTF_USESTDHANDLES;
+	startupInfo.hStdOutput = writePipe;
+	startupInfo.hStdError = writePipe;
+
+	// CreateProcessW는 명령줄 버퍼를 수정할 수 있다
+	std::wstring commandLine = ShaderBuildCommandLine;
+	PROCESS_INFORMATION processInfo = {};
+	const BOOL bCreated = CreateProcessW(nullptr, commandLine.data(), nullptr, nullptr, TRUE, CREATE_NO_WINDOW, nullptr, nullptr, &startupInfo, &processInfo);
+	CloseHandle(writePipe);
+	if (!bCreated)
+	{
+		CloseHandle(readPipe);
+		OutputDebugStringA("hot reload: cannot run BengalsShaderBuild\n");
+		return false;
+	}
+
+	// 도구 출력 (컴파일 오류 포함)을 디버거 출력 창으로
+	char buffer[1024];
+	DWORD readSize = 0;
+	while (ReadFile(readPipe, buffer, sizeof(buffer) - 1, &readSize, nullptr) && readSize > 0)
+	{
+		buffer[readSize] = '\0';
+		OutputDebugStringA(buffer);
+	}
+	CloseHandle(readPipe);
+
+	WaitForSingleObject(processInfo.hProcess, INFINITE);
+	DWORD exitCode = 1;
+	GetExitCodeProcess(processInfo.hProcess, &exitCode);
+	CloseHandle(processInfo.hThread);
+	CloseHandle(processInfo.hProcess);
+	return exitCode == 0;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Asset/FileWatcher.h"
+
+class CShaderArchive;
+
+struct HotReloadTexture
+{
+	std::wstring FilePath;		// 감시 root 기준 경로 (CreateTextureFromFile에 넘긴 경로와 같은 형태)
+	std::vector<BYTE> Data;
+	UINT64 ContentHash = 0;		// CAssetArchive::HashBytes
+};
+
+/**
+ * Development-time reload of changed DDS textures and HLSL sources.
+ *
+ * A CFileWatcher reports changed files on its own thread, which also does the slow part:
+ * texture files are read and hashed there, and a shader change runs BengalsShaderBuild
+ * out of process (the same tool and arguments as the pre-build step, so nothing is
+ * compiled inside the renderer) and loads the rewritten ShaderArchive.bsa. Results wait
+ * behind a mutex until the renderer takes them at the next frame boundary and swaps the
+ * texture resources and pipeline states there. A failed shader build leaves the pending
+ * archive empty, so the running shaders stay in use.
+ */
+class CHotReloader
+{
+public:
+	CHotReloader() = default;
+	~CHotReloader();
+
+	CHotReloader(const CHotReloader&) = delete;
+	CHotReloader& operator=(const CHotReloader&) = delete;
+
+	// wchShaderRoot: 셰이더 소스 디렉터리. 빌드 도구는 작업 디렉터리 (Bengals/)에서 실행한다
+	bool Initialize(const WCHAR* wchTextureRoot, const WCHAR* wchShaderRoot, const WCHAR* wchShaderArchiveFileName);
+	void Cleanup();
+
+	// 렌더러가 프레임 시작에서 호출. 마지막 호출 이후 준비된 결과를 넘기고 비운다
+	void TakePendingReloads(std::vector<HotReloadTexture>* pOutTextureList, std::unique_ptr<CShaderArchive>* pOutShaderArchive);
+
+private:
+	void OnFilesChanged(const std::vector<std::filesystem::path>& changedFileList);
+	bool ReadTexture(const std::filesystem::path& filePath, HotReloadTexture* pOutTexture) const;
+	bool RunShaderBuild() const;
+
+private:
+	CFileWatcher m_fileWatcher;
+	std::filesystem::path m_shaderArchivePath;
+
+	std::mutex m_pendingMutex;
+	std::vector<HotReloadTexture> m_pendingTextureList;		// 같은 경로는 마지막 내용만 남긴다
+	std::unique_ptr<CShaderArchive> m_pendingShaderArchive = nullptr;
+};
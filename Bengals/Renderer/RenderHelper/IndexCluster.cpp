@@ -0,0 +1,70 @@
+#include "pch.h"
+#include "IndexCluster.h"
+#include <algorithm>
+
+bool BuildIndexClusters16(const UINT* pIndexList, UINT indexCount, UINT maxClusterCount,
+	std::vector<WORD>* pOutIndexList, std::vector<IndexedTriCluster>* pOutClusterList)
+{
+	if ((!pIndexList && indexCount > 0) || indexCount % 3 != 0 || !pOutIndexList || !pOutClusterList)
+	{
+		__debugbreak();
+		return false;
+	}
+
+	pOutIndexList->clear();
+	pOutClusterList->clear();
+	pOutIndexList->reserve(indexCount);
+
+	// [clusterBegin, i) 삼각형들의 정점 범위가 [clusterMin, clusterMax]
+	UINT clusterBegin = 0;
+	UINT clusterMin = UINT_MAX;
+	UINT clusterMax = 0;
+
+	auto EmitCluster = [&](UINT clusterEnd)
+		{
+			IndexedTriCluster cluster = {};
+			cluster.StartIndex = clusterBegin;
+			cluster.IndexCount = clusterEnd - clusterBegin;
+			cluster.BaseVertex = static_cast<INT>(clusterMin);
+			for (UINT i = clusterBegin; i < clusterEnd; i++)
+			{
+				pOutIndexList->push_back(static_cast<WORD>(pIndexList[i] - clusterMin));
+			}
+			pOutClusterList->push_back(cluster);
+		};
+
+	for (UINT i = 0; i < indexCount; i += 3)
+	{
+		const UINT triMin = (std::min)({ pIndexList[i], pIndexList[i + 1], pIndexList[i + 2] });
+		const UINT triMax = (std::max)({ pIndexList[i], pIndexList[i + 1], pIndexList[i + 2] });
+		if (triMax - triMin >= IndexClusterVertexWindow || triMin > static_cast<UINT>(INT_MAX))
+		{
+			return false;
+		}
+
+		const UINT mergedMin = (std::min)(clusterMin, triMin);
+		const UINT mergedMax = (std::max)(clusterMax, triMax);
+		if (i > clusterBegin && mergedMax - mergedMin >= IndexClusterVertexWindow)
+		{
+			if (pOutClusterList->size() + 1 >= maxClusterCount)
+			{
+				return false;
+			}
+
+			EmitCluster(i);
+			clusterBegin = i;
+			clusterMin = triMin;
+			clusterMax = triMax;
+			continue;
+		}
+
+		clusterMin = mergedMin;
+		clusterMax = mergedMax;
+	}
+
+	if (indexCount > 0)
+	{
+		EmitCluster(indexCount);
+	}
+	return true;
+}
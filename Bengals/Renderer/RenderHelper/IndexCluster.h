@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * Index width selection for mesh tri groups.
+ *
+ * BuildIndexClusters16() walks a triangle list in order and cuts it into clusters whose
+ * vertex indices fit a 65,536-vertex window; each cluster stores its indices minus its
+ * smallest vertex as 16-bit values and is drawn with that vertex as BaseVertexLocation,
+ * so a mesh of any size keeps 16-bit indices without duplicating vertices. Triangle
+ * order is preserved, and after MeshOptimizeVertexFetch (vertices numbered in first-use
+ * order) a window covers about 65k consecutive vertices. A triangle spanning more than
+ * the window, or a list needing more than maxClusterCount clusters, is left to 32-bit
+ * indices drawn as one cluster. No device access.
+ */
+
+constexpr UINT IndexClusterVertexWindow = 65536;
+// cluster마다 draw가 하나 늘어나므로 이보다 잘게 나뉘면 32비트 인덱스 한 번으로 그린다
+constexpr UINT MaxIndexClusterCount = 64;
+
+struct IndexedTriCluster
+{
+	UINT StartIndex = 0;		// 인덱스 view 기준
+	UINT IndexCount = 0;
+	INT BaseVertex = 0;
+};
+
+// 반환: 16비트로 나눌 수 있으면 true. StartIndex는 pIndexList 기준, 출력은 덮어쓴다
+bool BuildIndexClusters16(const UINT* pIndexList, UINT indexCount, UINT maxClusterCount,
+	std::vector<WORD>* pOutIndexList, std::vector<IndexedTriCluster>* pOutClusterList);
@@ -0,0 +1,635 @@
+#include "pch.h"
+#include "MeshLod.h"
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+	// 경계 edge에 수직인 평면의 가중치 (경계가 안쪽으로 말려 들어가지 않게)
+	constexpr double BorderQuadricWeight = 10.0;
+
+	enum class EVertexKind : UINT8
+	{
+		Manifold = 0,
+		Border,		// 열린 경계. 경계 edge를 따라서만 collapse
+		Locked		// seam / non-manifold 경계. 움직이지 않는다
+	};
+
+	// 대칭 4x4 행렬 (A b; b^T c)과 누적 가중치. 평가값을 W로 나누면 평균 제곱 거리
+	struct Quadric
+	{
+		double A00 = 0.0, A11 = 0.0, A22 = 0.0;
+		double A01 = 0.0, A02 = 0.0, A12 = 0.0;
+		double B0 = 0.0, B1 = 0.0, B2 = 0.0;
+		double C = 0.0;
+		double W = 0.0;
+	};
+
+	struct EdgeCollapse
+	{
+		UINT From = 0;
+		UINT To = 0;
+		double Cost = 0.0;
+	};
+
+	void AddPlane(Quadric* pQuadric, const XMFLOAT3& normal, double d, double weight)
+	{
+		const double x = normal.x;
+		const double y = normal.y;
+		const double z = normal.z;
+		pQuadric->A00 += weight * x * x;
+		pQuadric->A11 += weight * y * y;
+		pQuadric->A22 += weight * z * z;
+		pQuadric->A01 += weight * x * y;
+		pQuadric->A02 += weight * x * z;
+		pQuadric->A12 += weight * y * z;
+		pQuadric->B0 += weight * x * d;
+		pQuadric->B1 += weight * y * d;
+		pQuadric->B2 += weight * z * d;
+		pQuadric->C += weight * d * d;
+		pQuadric->W += weight;
+	}
+
+	void AddQuadric(Quadric* pDest, const Quadric& src)
+	{
+		pDest->A00 += src.A00;
+		pDest->A11 += src.A11;
+		pDest->A22 += src.A22;
+		pDest->A01 += src.A01;
+		pDest->A02 += src.A02;
+		pDest->A12 += src.A12;
+		pDest->B0 += src.B0;
+		pDest->B1 += src.B1;
+		pDest->B2 += src.B2;
+		pDest->C += src.C;
+		pDest->W += src.W;
+	}
+
+	double EvaluateQuadric(const Quadric& quadric, const XMFLOAT3& position)
+	{
+		const double x = position.x;
+		const double y = position.y;
+		const double z = position.z;
+		const double error =
+			quadric.A00 * x * x + quadric.A11 * y * y + quadric.A22 * z * z +
+			2.0 * (quadric.A01 * x * y + quadric.A02 * x * z + quadric.A12 * y * z) +
+			2.0 * (quadric.B0 * x + quadric.B1 * y + quadric.B2 * z) +
+			quadric.C;
+		return (quadric.W > 0.0) ? fabs(error) / quadric.W : 0.0;
+	}
+
+	XMFLOAT3 Subtract(const XMFLOAT3& a, const XMFLOAT3& b)
+	{
+		return { a.x - b.x, a.y - b.y, a.z - b.z };
+	}
+
+	XMFLOAT3 Cross(const XMFLOAT3& a, const XMFLOAT3& b)
+	{
+		return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+	}
+
+	float Dot(const XMFLOAT3& a, const XMFLOAT3& b)
+	{
+		return a.x * b.x + a.y * b.y + a.z * b.z;
+	}
+
+	XMFLOAT3 TriangleNormal(const XMFLOAT3& p0, const XMFLOAT3& p1, const XMFLOAT3& p2)
+	{
+		return Cross(Subtract(p1, p0), Subtract(p2, p0));
+	}
+
+	UINT64 MakeEdgeKey(UINT from, UINT to)
+	{
+		return (static_cast<UINT64>(from) << 32) | to;
+	}
+
+	// directed edge 집합 (open addressing). 정점 인덱스는 UINT_MAX 미만이므로 UINT64_MAX를 빈 슬롯으로 쓴다
+	class CEdgeSet
+	{
+	public:
+		void Reset(UINT edgeCount)
+		{
+			UINT64 tableSize = 16;
+			while (tableSize < static_cast<UINT64>(edgeCount) * 2)
+			{
+				tableSize *= 2;
+			}
+			m_slotList.assign(tableSize, UINT64_MAX);
+			m_mask = tableSize - 1;
+		}
+
+		void Insert(UINT64 key)
+		{
+			UINT64 slot = Hash(key) & m_mask;
+			while (m_slotList[slot] != UINT64_MAX && m_slotList[slot] != key)
+			{
+				slot = (slot + 1) & m_mask;
+			}
+			m_slotList[slot] = key;
+		}
+
+		bool Contains(UINT64 key) const
+		{
+			UINT64 slot = Hash(key) & m_mask;
+			while (m_slotList[slot] != UINT64_MAX)
+			{
+				if (m_slotList[slot] == key)
+				{
+					return true;
+				}
+				slot = (slot + 1) & m_mask;
+			}
+			return false;
+		}
+
+	private:
+		static UINT64 Hash(UINT64 key)
+		{
+			key ^= key >> 29;
+			key *= 0xbf58476d1ce4e5b9ull;
+			key ^= key >> 32;
+			return key;
+		}
+
+	private:
+		std::vector<UINT64> m_slotList = {};
+		UINT64 m_mask = 0;
+	};
+
+	// 같은 위치의 정점 중 첫 정점으로 매핑. 다른 정점과 위치를 공유하면 seam으로 잠근다
+	void BuildPositionRemap(const std::vector<XMFLOAT3>& positionList, std::vector<UINT>* pOutRemapList, std::vector<EVertexKind>* pKindList)
+	{
+		const UINT vertexCount = static_cast<UINT>(positionList.size());
+		pOutRemapList->resize(vertexCount);
+
+		UINT tableSize = 16;
+		while (tableSize < vertexCount * 2)
+		{
+			tableSize *= 2;
+		}
+		const UINT tableMask = tableSize - 1;
+		std::vector<UINT> tableList(tableSize, UINT_MAX);
+
+		for (UINT i = 0; i < vertexCount; i++)
+		{
+			UINT bits[3] = {};
+			memcpy(bits, &positionList[i], sizeof(bits));
+			UINT slot = ((bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u)) & tableMask;
+			while (true)
+			{
+				const UINT representative = tableList[slot];
+				if (representative == UINT_MAX)
+				{
+					tableList[slot] = i;
+					(*pOutRemapList)[i] = i;
+					break;
+				}
+				if (memcmp(&positionList[representative], &positionList[i], sizeof(XMFLOAT3)) == 0)
+				{
+					(*pOutRemapList)[i] = representative;
+					(*pKindList)[i] = EVertexKind::Locked;
+					(*pKindList)[representative] = EVertexKind::Locked;
+					break;
+				}
+				slot = (slot + 1) & tableMask;
+			}
+		}
+	}
+
+	void BuildEdgeSet(const std::vector<UINT>& indexList, const std::vector<UINT>& positionRemapList, CEdgeSet* pOutEdgeSet)
+	{
+		pOutEdgeSet->Reset(static_cast<UINT>(indexList.size()));
+		for (size_t i = 0; i < indexList.size(); i += 3)
+		{
+			for (UINT e = 0; e < 3; e++)
+			{
+				const UINT from = positionRemapList[indexList[i + e]];
+				const UINT to = positionRemapList[indexList[i + (e + 1) % 3]];
+				pOutEdgeSet->Insert(MakeEdgeKey(from, to));
+			}
+		}
+	}
+
+	// 반대 방향 edge가 없으면 열린 경계
+	bool IsBorderEdge(const CEdgeSet& edgeSet, const std::vector<UINT>& positionRemapList, UINT a, UINT b)
+	{
+		const UINT64 forwardKey = MakeEdgeKey(positionRemapList[a], positionRemapList[b]);
+		const UINT64 backwardKey = MakeEdgeKey(positionRemapList[b], positionRemapList[a]);
+		return edgeSet.Contains(forwardKey) != edgeSet.Contains(backwardKey);
+	}
+
+	// 정점 -> 삼각형 목록 (CSR)
+	void BuildTriangleAdjacency(const std::vector<UINT>& indexList, UINT vertexCount, std::vector<UINT>* pOffsetList, std::vector<UINT>* pTriangleList)
+	{
+		pOffsetList->assign(vertexCount + 1, 0);
+		for (UINT vertexIndex : indexList)
+		{
+			(*pOffsetList)[vertexIndex + 1]++;
+		}
+		for (UINT i = 0; i < vertexCount; i++)
+		{
+			(*pOffsetList)[i + 1] += (*pOffsetList)[i];
+		}
+
+		pTriangleList->resize(indexList.size());
+		std::vector<UINT> writeOffsetList(pOffsetList->begin(), pOffsetList->end() - 1);
+		for (size_t i = 0; i < indexList.size(); i++)
+		{
+			(*pTriangleList)[writeOffsetList[indexList[i]]++] = static_cast<UINT>(i / 3);
+		}
+	}
+}
+
+UINT SimplifyMesh(const BYTE* pVertexData, UINT vertexCount, UINT vertexSize, const UINT* pIndexList, UINT indexCount,
+	UINT targetIndexCount, float maxError, std::vector<UINT>* pOutIndexList, float* pOutError)
+{
+	if (pOutError)
+	{
+		*pOutError = 0.0f;
+	}
+
+	if (!pVertexData || !pIndexList || !pOutIndexList || vertexSize < sizeof(XMFLOAT3) || (indexCount % 3) != 0)
+	{
+		__debugbreak();
+		return 0;
+	}
+
+	std::vector<UINT>& indexList = *pOutIndexList;
+	indexList.assign(pIndexList, pIndexList + indexCount);
+	for (UINT vertexIndex : indexList)
+	{
+		if (vertexIndex >= vertexCount)
+		{
+			__debugbreak();
+			indexList.clear();
+			return 0;
+		}
+	}
+
+	if (indexCount <= targetIndexCount)
+	{
+		return indexCount;
+	}
+
+	std::vector<XMFLOAT3> positionList(vertexCount);
+	for (UINT i = 0; i < vertexCount; i++)
+	{
+		memcpy(&positionList[i], pVertexData + static_cast<size_t>(i) * vertexSize, sizeof(XMFLOAT3));
+	}
+
+	// 1. seam 잠금, 경계 분류 (경계 edge가 정확히 2개인 정점만 경계를 따라 움직인다)
+	std::vector<EVertexKind> kindList(vertexCount, EVertexKind::Manifold);
+	std::vector<UINT> positionRemapList;
+	BuildPositionRemap(positionList, &positionRemapList, &kindList);
+
+	CEdgeSet edgeSet;
+	BuildEdgeSet(indexList, positionRemapList, &edgeSet);
+
+	std::vector<UINT> borderEdgeCountList(vertexCount, 0);
+	for (UINT i = 0; i < indexCount; i += 3)
+	{
+		for (UINT e = 0; e < 3; e++)
+		{
+			const UINT a = indexList[i + e];
+			const UINT b = indexList[i + (e + 1) % 3];
+			if (!edgeSet.Contains(MakeEdgeKey(positionRemapList[b], positionRemapList[a])))
+			{
+				borderEdgeCountList[positionRemapList[a]]++;
+				borderEdgeCountList[positionRemapList[b]]++;
+			}
+		}
+	}
+	for (UINT i = 0; i < vertexCount; i++)
+	{
+		if (kindList[i] == EVertexKind::Locked)
+		{
+			continue;
+		}
+		const UINT borderEdgeCount = borderEdgeCountList[i];
+		if (borderEdgeCount == 2)
+		{
+			kindList[i] = EVertexKind::Border;
+		}
+		else if (borderEdgeCount > 0)
+		{
+			kindList[i] = EVertexKind::Locked;
+		}
+	}
+
+	// 2. 면적 가중 평면 quadric + 경계 quadric
+	std::vector<Quadric> quadricList(vertexCount);
+	for (UINT i = 0; i < indexCount; i += 3)
+	{
+		const UINT triVertexList[3] = { indexList[i], indexList[i + 1], indexList[i + 2] };
+		XMFLOAT3 normal = TriangleNormal(positionList[triVertexList[0]], positionList[triVertexList[1]], positionList[triVertexList[2]]);
+		const float normalLength = sqrtf(Dot(normal, normal));
+		if (normalLength <= 0.0f)
+		{
+			continue;
+		}
+		normal = { normal.x / normalLength, normal.y / normalLength, normal.z / normalLength };
+
+		const double d = -Dot(normal, positionList[triVertexList[0]]);
+		for (UINT vertexIndex : triVertexList)
+		{
+			AddPlane(&quadricList[vertexIndex], normal, d, normalLength * 0.5);
+		}
+
+		for (UINT e = 0; e < 3; e++)
+		{
+			const UINT a = triVertexList[e];
+			const UINT b = triVertexList[(e + 1) % 3];
+			if (edgeSet.Contains(MakeEdgeKey(positionRemapList[b], positionRemapList[a])))
+			{
+				continue;
+			}
+
+			const XMFLOAT3 edge = Subtract(positionList[b], positionList[a]);
+			const float edgeLengthSq = Dot(edge, edge);
+			XMFLOAT3 borderNormal = Cross(edge, normal);
+			const float borderNormalLength = sqrtf(Dot(borderNormal, borderNormal));
+			if (borderNormalLength <= 0.0f)
+			{
+				continue;
+			}
+			borderNormal = { borderNormal.x / borderNormalLength, borderNormal.y / borderNormalLength, borderNormal.z / borderNormalLength };
+
+			const double borderD = -Dot(borderNormal, positionList[a]);
+			AddPlane(&quadricList[a], borderNormal, borderD, BorderQuadricWeight * edgeLengthSq);
+			AddPlane(&quadricList[b], borderNormal, borderD, BorderQuadricWeight * edgeLengthSq);
+		}
+	}
+
+	// 3. pass마다 비용 순으로 서로 겹치지 않는 collapse를 적용하고 인덱스를 다시 쓴다
+	const double maxCost = static_cast<double>(maxError) * maxError;
+	double resultCost = 0.0;
+
+	std::vector<UINT> adjacencyOffsetList;
+	std::vector<UINT> adjacencyList;
+	std::vector<EdgeCollapse> candidateList;
+	std::vector<EdgeCollapse> bestCollapseList(vertexCount);
+	std::vector<UINT> collapseList(vertexCount);
+	std::vector<UINT8> touchedList(vertexCount);
+
+	UINT triCount = indexCount / 3;
+	while (triCount * 3 > targetIndexCount)
+	{
+		BuildTriangleAdjacency(indexList, vertexCount, &adjacencyOffsetList, &adjacencyList);
+
+		// 정점마다 가장 싼 collapse 하나만 후보로 둔다 (정렬 크기를 정점 수로 제한)
+		for (UINT i = 0; i < vertexCount; i++)
+		{
+			bestCollapseList[i] = { i, i, DBL_MAX };
+		}
+		auto AddCandidate = [&](UINT from, UINT to)
+			{
+				if (from == to || kindList[from] == EVertexKind::Locked)
+				{
+					return;
+				}
+				if (kindList[from] == EVertexKind::Border && !IsBorderEdge(edgeSet, positionRemapList, from, to))
+				{
+					return;
+				}
+
+				const double cost = EvaluateQuadric(quadricList[from], positionList[to]);
+				if (cost < bestCollapseList[from].Cost)
+				{
+					bestCollapseList[from] = { from, to, cost };
+				}
+			};
+
+		for (size_t i = 0; i < indexList.size(); i += 3)
+		{
+			for (UINT e = 0; e < 3; e++)
+			{
+				const UINT a = indexList[i + e];
+				const UINT b = indexList[i + (e + 1) % 3];
+				AddCandidate(a, b);
+				AddCandidate(b, a);
+			}
+		}
+
+		candidateList.clear();
+		for (const EdgeCollapse& collapse : bestCollapseList)
+		{
+			if (collapse.From != collapse.To && collapse.Cost <= maxCost)
+			{
+				candidateList.push_back(collapse);
+			}
+		}
+		std::sort(candidateList.begin(), candidateList.end(),
+			[](const EdgeCollapse& lhs, const EdgeCollapse& rhs) { return lhs.Cost < rhs.Cost; });
+
+		for (UINT i = 0; i < vertexCount; i++)
+		{
+			collapseList[i] = i;
+		}
+		std::fill(touchedList.begin(), touchedList.end(), 0);
+
+		UINT collapseCount = 0;
+		for (const EdgeCollapse& collapse : candidateList)
+		{
+			if (triCount * 3 <= targetIndexCount)
+			{
+				break;
+			}
+			if (touchedList[collapse.From] || touchedList[collapse.To])
+			{
+				continue;
+			}
+
+			// From 주변 삼각형 중 To를 포함하지 않는 것이 뒤집히면 거부
+			const XMFLOAT3& targetPosition = positionList[collapse.To];
+			bool bFlipped = false;
+			UINT removedTriCount = 0;
+			for (UINT j = adjacencyOffsetList[collapse.From]; j < adjacencyOffsetList[collapse.From + 1]; j++)
+			{
+				const UINT* pTri = indexList.data() + static_cast<size_t>(adjacencyList[j]) * 3;
+				if (pTri[0] == collapse.To || pTri[1] == collapse.To || pTri[2] == collapse.To)
+				{
+					removedTriCount++;
+					continue;
+				}
+
+				XMFLOAT3 triPositionList[3] = { positionList[pTri[0]], positionList[pTri[1]], positionList[pTri[2]] };
+				const XMFLOAT3 oldNormal = TriangleNormal(triPositionList[0], triPositionList[1], triPositionList[2]);
+				for (UINT k = 0; k < 3; k++)
+				{
+					if (pTri[k] == collapse.From)
+					{
+						triPositionList[k] = targetPosition;
+					}
+				}
+				const XMFLOAT3 newNormal = TriangleNormal(triPositionList[0], triPositionList[1], triPositionList[2]);
+				const float oldLengthSq = Dot(oldNormal, oldNormal);
+				if (oldLengthSq > 0.0f && Dot(oldNormal, newNormal) <= 1e-2f * sqrtf(oldLengthSq * Dot(newNormal, newNormal)))
+				{
+					bFlipped = true;
+					break;
+				}
+			}
+			if (bFlipped)
+			{
+				continue;
+			}
+
+			// flip 검사가 이번 pass의 인덱스 기준이므로 From의 1-ring은 더 이상 움직이지 않게 한다
+			for (UINT j = adjacencyOffsetList[collapse.From]; j < adjacencyOffsetList[collapse.From + 1]; j++)
+			{
+				const UINT* pTri = indexList.data() + static_cast<size_t>(adjacencyList[j]) * 3;
+				touchedList[pTri[0]] = 1;
+				touchedList[pTri[1]] = 1;
+				touchedList[pTri[2]] = 1;
+			}
+			touchedList[collapse.From] = 1;
+			touchedList[collapse.To] = 1;
+
+			collapseList[collapse.From] = collapse.To;
+			AddQuadric(&quadricList[collapse.To], quadricList[collapse.From]);
+			resultCost = (std::max)(resultCost, collapse.Cost);
+			triCount -= removedTriCount;
+			collapseCount++;
+		}
+
+		if (collapseCount == 0)
+		{
+			break;
+		}
+
+		// collapse 적용, 퇴화 삼각형 제거
+		size_t writeIndex = 0;
+		for (size_t i = 0; i < indexList.size(); i += 3)
+		{
+			const UINT a = collapseList[indexList[i]];
+			const UINT b = collapseList[indexList[i + 1]];
+			const UINT c = collapseList[indexList[i + 2]];
+			if (a == b || b == c || a == c)
+			{
+				continue;
+			}
+			indexList[writeIndex++] = a;
+			indexList[writeIndex++] = b;
+			indexList[writeIndex++] = c;
+		}
+		indexList.resize(writeIndex);
+		triCount = static_cast<UINT>(writeIndex / 3);
+
+		BuildEdgeSet(indexList, positionRemapList, &edgeSet);
+	}
+
+	if (pOutError)
+	{
+		*pOutError = static_cast<float>(sqrt(resultCost));
+	}
+	return static_cast<UINT>(indexList.size());
+}
+
+bool BuildMeshLodChain(const BYTE* pVertexData, UINT vertexCount, UINT vertexSize, const std::vector<UINT>& indexList,
+	const std::vector<UINT>& groupIndexCountList, UINT maxLodCount, UINT optimizeFlags, std::vector<MeshLodLevel>* pOutLodList)
+{
+	if (!pVertexData || !pOutLodList || vertexSize < sizeof(XMFLOAT3) || maxLodCount == 0 || maxLodCount > MaxMeshLodCount)
+	{
+		__debugbreak();
+		return false;
+	}
+
+	UINT totalIndexCount = 0;
+	for (UINT groupIndexCount : groupIndexCountList)
+	{
+		if ((groupIndexCount % 3) != 0)
+		{
+			__debugbreak();
+			return false;
+		}
+		totalIndexCount += groupIndexCount;
+	}
+	if (totalIndexCount != indexList.size())
+	{
+		__debugbreak();
+		return false;
+	}
+
+	pOutLodList->clear();
+	pOutLodList->reserve(maxLodCount);
+	pOutLodList->push_back({ indexList, groupIndexCountList, 0.0f });
+
+	std::vector<UINT> groupIndexList;
+	for (UINT lod = 1; lod < maxLodCount; lod++)
+	{
+		const MeshLodLevel& prevLevel = pOutLodList->back();
+
+		MeshLodLevel level = {};
+		float levelError = 0.0f;
+		UINT indexOffset = 0;
+		for (UINT groupIndexCount : prevLevel.GroupIndexCountList)
+		{
+			const UINT* pGroupIndexList = prevLevel.IndexList.data() + indexOffset;
+			const UINT targetIndexCount = static_cast<UINT>(groupIndexCount / 3 * MeshLodReduction) * 3;
+
+			float groupError = 0.0f;
+			SimplifyMesh(pVertexData, vertexCount, vertexSize, pGroupIndexList, groupIndexCount, targetIndexCount, FLT_MAX, &groupIndexList, &groupError);
+
+			// 그룹이 통째로 사라지면 이전 LOD를 유지 (빈 인덱스 버퍼는 만들지 않는다)
+			if (groupIndexList.empty())
+			{
+				groupIndexList.assign(pGroupIndexList, pGroupIndexList + groupIndexCount);
+				groupError = 0.0f;
+			}
+			else if (optimizeFlags & MeshOptimizeVertexCache)
+			{
+				OptimizeVertexCache(groupIndexList.data(), static_cast<UINT>(groupIndexList.size()), vertexCount);
+			}
+
+			level.IndexList.insert(level.IndexList.end(), groupIndexList.begin(), groupIndexList.end());
+			level.GroupIndexCountList.push_back(static_cast<UINT>(groupIndexList.size()));
+			levelError = (std::max)(levelError, groupError);
+			indexOffset += groupIndexCount;
+		}
+
+		if (level.IndexList.size() > prevLevel.IndexList.size() * MinMeshLodReduction)
+		{
+			break;
+		}
+
+		level.Error = prevLevel.Error + levelError;
+		pOutLodList->push_back(std::move(level));
+	}
+	return true;
+}
+
+float ComputeMeshLodPixelsPerUnit(const XMMATRIX& worldMatrix, const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix,
+	float viewportHeight, const XMFLOAT3& boundsCenter, float boundsRadius)
+{
+	const XMVECTOR viewCenter = XMVector3Transform(XMLoadFloat3(&boundsCenter), XMMatrixMultiply(worldMatrix, viewMatrix));
+	const float scale = (std::max)({
+		XMVectorGetX(XMVector3Length(worldMatrix.r[0])),
+		XMVectorGetX(XMVector3Length(worldMatrix.r[1])),
+		XMVectorGetX(XMVector3Length(worldMatrix.r[2])) });
+
+	const float nearestDepth = XMVectorGetZ(viewCenter) - boundsRadius * scale;
+	if (nearestDepth <= 1e-4f)
+	{
+		return FLT_MAX;
+	}
+
+	// projMatrix._22 = cot(fovY / 2): view 공간 깊이 1에서 높이 1이 NDC에서 차지하는 비율
+	return scale * XMVectorGetY(projMatrix.r[1]) * 0.5f * viewportHeight / nearestDepth;
+}
+
+UINT SelectMeshLod(const float* pLodErrorList, UINT lodCount, float pixelsPerUnit, float maxPixelError)
+{
+	UINT selectedLod = 0;
+	for (UINT lod = 1; lod < lodCount; lod++)
+	{
+		if (pLodErrorList[lod] * pixelsPerUnit > maxPixelError)
+		{
+			break;
+		}
+		selectedLod = lod;
+	}
+	return selectedLod;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * Level-of-detail index sets for a mesh, built on the CPU and chosen per draw.
+ *
+ * SimplifyMesh() reduces one tri group with quadric error metrics (Garland & Heckbert
+ * 1997) by collapsing edges onto their existing endpoints, so every LOD keeps indexing
+ * the mesh's one vertex buffer and only the index lists differ. Open borders collapse
+ * only along themselves; vertices that share a position with another vertex (UV or
+ * color seams) and non-manifold border vertices never move. Positions are a float3 at
+ * byte offset 0. Each LOD records an object-space error: LOD i is simplified from
+ * LOD i-1 and its error is the running sum, an upper bound on the distance to LOD 0.
+ * Only position error is measured; attributes follow the surviving vertices.
+ * SelectMeshLod() picks the coarsest LOD whose error projects under the pixel limit.
+ * No device access.
+ */
+
+constexpr UINT MaxMeshLodCount = 4;
+// LOD마다 목표 삼각형 수 비율. 이보다 덜 줄면(MinMeshLodReduction) 체인을 끝낸다
+constexpr float MeshLodReduction = 0.5f;
+constexpr float MinMeshLodReduction = 0.85f;
+
+struct MeshLodLevel
+{
+	std::vector<UINT> IndexList = {};
+	std::vector<UINT> GroupIndexCountList = {};
+	float Error = 0.0f;		// object-space 거리
+};
+
+// 반환: 결과 인덱스 수. maxError를 넘는 collapse는 하지 않는다. pOutError는 적용된 최대 오차
+UINT SimplifyMesh(const BYTE* pVertexData, UINT vertexCount, UINT vertexSize, const UINT* pIndexList, UINT indexCount,
+	UINT targetIndexCount, float maxError, std::vector<UINT>* pOutIndexList, float* pOutError);
+
+// pOutLodList[0]은 입력 그대로. 충분히 줄지 않으면 maxLodCount보다 적게 만든다
+// optimizeFlags에 MeshOptimizeVertexCache가 있으면 LOD마다 삼각형 순서를 다시 최적화
+bool BuildMeshLodChain(const BYTE* pVertexData, UINT vertexCount, UINT vertexSize, const std::vector<UINT>& indexList,
+	const std::vector<UINT>& groupIndexCountList, UINT maxLodCount, UINT optimizeFlags, std::vector<MeshLodLevel>* pOutLodList);
+
+// object-space 1 단위가 화면에서 차지하는 픽셀 수 (bounds의 가장 가까운 지점 기준). near plane 안쪽이면 FLT_MAX
+float ComputeMeshLodPixelsPerUnit(const XMMATRIX& worldMatrix, const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix,
+	float viewportHeight, const XMFLOAT3& boundsCenter, float boundsRadius);
+
+// pLodErrorList는 LOD 순으로 증가 (LOD 0 = 0)
+UINT SelectMeshLod(const float* pLodErrorList, UINT lodCount, float pixelsPerUnit, float maxPixelError);
@@ -0,0 +1,468 @@
+#include "pch.h"
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+	UINT64 HashVertex(const BYTE* pVertex, UINT vertexSize)
+	{
+		// FNV-1a
+		UINT64 hash = 14695981039346656037ull;
+		for (UINT i = 0; i < vertexSize; i++)
+		{
+			hash ^= pVertex[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	XMFLOAT3 LoadPosition(const BYTE* pVertexData, UINT vertexSize, UINT vertexIndex)
+	{
+		XMFLOAT3 position = {};
+		memcpy(&position, pVertexData + static_cast<size_t>(vertexIndex) * vertexSize, sizeof(position));
+		return position;
+	}
+
+	// FIFO 캐시를 비운 상태에서 시작해 miss 수를 센다
+	UINT CountCacheMisses(const UINT* pIndexList, UINT indexCount, std::vector<UINT>& insertTimeList)
+	{
+		std::fill(insertTimeList.begin(), insertTimeList.end(), UINT_MAX);
+
+		UINT missCount = 0;
+		for (UINT i = 0; i < indexCount; i++)
+		{
+			const UINT vertexIndex = pIndexList[i];
+			const UINT insertTime = insertTimeList[vertexIndex];
+			if (insertTime == UINT_MAX || missCount - insertTime >= MeshVertexCacheSize)
+			{
+				insertTimeList[vertexIndex] = missCount;
+				missCount++;
+			}
+		}
+		return missCount;
+	}
+
+	VertexCacheStats ComputeMeshCacheStats(const UINT* pIndexList, const std::vector<UINT>& groupIndexCountList, UINT vertexCount)
+	{
+		std::vector<UINT> insertTimeList(vertexCount);
+		std::vector<UINT8> referencedList(vertexCount, 0);
+
+		VertexCacheStats stats = {};
+		UINT indexOffset = 0;
+		UINT referencedVertexCount = 0;
+		for (UINT groupIndexCount : groupIndexCountList)
+		{
+			stats.CacheMissCount += CountCacheMisses(pIndexList + indexOffset, groupIndexCount, insertTimeList);
+			for (UINT i = indexOffset; i < indexOffset + groupIndexCount; i++)
+			{
+				if (!referencedList[pIndexList[i]])
+				{
+					referencedList[pIndexList[i]] = 1;
+					referencedVertexCount++;
+				}
+			}
+			indexOffset += groupIndexCount;
+		}
+
+		const UINT triCount = indexOffset / 3;
+		stats.Acmr = (triCount > 0) ? static_cast<float>(stats.CacheMissCount) / triCount : 0.0f;
+		stats.Atvr = (referencedVertexCount > 0) ? static_cast<float>(stats.CacheMissCount) / referencedVertexCount : 0.0f;
+		return stats;
+	}
+}
+
+bool OptimizeMesh(std::vector<BYTE>* pVertexData, UINT vertexSize, std::vector<UINT>* pIndexList,
+	const std::vector<UINT>& groupIndexCountList, UINT optimizeFlags, MeshOptimizeStats* pOutStats)
+{
+	if (!pVertexData || !pIndexList || vertexSize == 0 || (pVertexData->size() % vertexSize) != 0)
+	{
+		__debugbreak();
+		return false;
+	}
+
+	// overdraw 정렬은 위치(float3)를 읽는다
+	if ((optimizeFlags & MeshOptimizeOverdraw) && vertexSize < sizeof(XMFLOAT3))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	UINT vertexCount = static_cast<UINT>(pVertexData->size() / vertexSize);
+	UINT totalIndexCount = 0;
+	for (UINT groupIndexCount : groupIndexCountList)
+	{
+		if ((groupIndexCount % 3) != 0)
+		{
+			__debugbreak();
+			return false;
+		}
+		totalIndexCount += groupIndexCount;
+	}
+	if (totalIndexCount != pIndexList->size())
+	{
+		__debugbreak();
+		return false;
+	}
+	for (UINT vertexIndex : *pIndexList)
+	{
+		if (vertexIndex >= vertexCount)
+		{
+			__debugbreak();
+			return false;
+		}
+	}
+
+	MeshOptimizeStats stats = {};
+	stats.VertexCountBefore = vertexCount;
+	stats.CacheBefore = ComputeMeshCacheStats(pIndexList->data(), groupIndexCountList, vertexCount);
+
+	if (optimizeFlags & MeshOptimizeWeld)
+	{
+		std::vector<UINT> remapList;
+		const UINT uniqueVertexCount = WeldVertices(pVertexData->data(), vertexCount, vertexSize, &remapList);
+		if (uniqueVertexCount < vertexCount)
+		{
+			// remap은 첫 등장 순서이므로 앞으로만 복사된다
+			BYTE* pData = pVertexData->data();
+			for (UINT i = 0; i < vertexCount; i++)
+			{
+				if (remapList[i] != i)
+				{
+					memmove(pData + static_cast<size_t>(remapList[i]) * vertexSize, pData + static_cast<size_t>(i) * vertexSize, vertexSize);
+				}
+			}
+			pVertexData->resize(static_cast<size_t>(uniqueVertexCount) * vertexSize);
+
+			for (UINT& vertexIndex : *pIndexList)
+			{
+				vertexIndex = remapList[vertexIndex];
+			}
+			vertexCount = uniqueVertexCount;
+		}
+	}
+
+	if (optimizeFlags & (MeshOptimizeVertexCache | MeshOptimizeOverdraw))
+	{
+		std::vector<UINT> clusterList;
+		UINT indexOffset = 0;
+		for (UINT groupIndexCount : groupIndexCountList)
+		{
+			UINT* pGroupIndexList = pIndexList->data() + indexOffset;
+			if (optimizeFlags & MeshOptimizeOverdraw)
+			{
+				OptimizeVertexCache(pGroupIndexList, groupIndexCount, vertexCount, &clusterList);
+				OptimizeOverdraw(pGroupIndexList, groupIndexCount, pVertexData->data(), vertexSize, clusterList);
+			}
+			else
+			{
+				OptimizeVertexCache(pGroupIndexList, groupIndexCount, vertexCount);
+			}
+			indexOffset += groupIndexCount;
+		}
+	}
+
+	if (optimizeFlags & MeshOptimizeVertexFetch)
+	{
+		vertexCount = OptimizeVertexFetch(pVertexData->data(), vertexCount, vertexSize, pIndexList->data(), totalIndexCount);
+		pVertexData->resize(static_cast<size_t>(vertexCount) * vertexSize);
+	}
+
+	stats.VertexCountAfter = vertexCount;
+	stats.CacheAfter = ComputeMeshCacheStats(pIndexList->data(), groupIndexCountList, vertexCount);
+	if (pOutStats)
+	{
+		*pOutStats = stats;
+	}
+	return true;
+}
+
+UINT WeldVertices(const BYTE* pVertexData, UINT vertexCount, UINT vertexSize, std::vector<UINT>* pOutRemapList)
+{
+	pOutRemapList->assign(vertexCount, 0);
+
+	// open addressing. 슬롯에는 대표 정점의 원래 인덱스를 저장
+	UINT tableSize = 16;
+	while (tableSize < vertexCount * 2)
+	{
+		tableSize *= 2;
+	}
+	const UINT tableMask = tableSize - 1;
+	std::vector<UINT> tableList(tableSize, UINT_MAX);
+
+	UINT uniqueVertexCount = 0;
+	for (UINT i = 0; i < vertexCount; i++)
+	{
+		const BYTE* pVertex = pVertexData + static_cast<size_t>(i) * vertexSize;
+		UINT slot = static_cast<UINT>(HashVertex(pVertex, vertexSize)) & tableMask;
+		while (true)
+		{
+			const UINT representative = tableList[slot];
+			if (representative == UINT_MAX)
+			{
+				tableList[slot] = i;
+				(*pOutRemapList)[i] = uniqueVertexCount++;
+				break;
+			}
+			if (memcmp(pVertexData + static_cast<size_t>(representative) * vertexSize, pVertex, vertexSize) == 0)
+			{
+				(*pOutRemapList)[i] = (*pOutRemapList)[representative];
+				break;
+			}
+			slot = (slot + 1) & tableMask;
+		}
+	}
+	return uniqueVertexCount;
+}
+
+void OptimizeVertexCache(UINT* pIndexList, UINT indexCount, UINT vertexCount, std::vector<UINT>* pOutClusterList)
+{
+	if (pOutClusterList)
+	{
+		pOutClusterList->clear();
+	}
+
+	const UINT triCount = indexCount / 3;
+	if (triCount == 0)
+	{
+		return;
+	}
+
+	// vertex -> triangle 인접 목록 (CSR)
+	std::vector<UINT> liveTriCountList(vertexCount, 0);
+	for (UINT i = 0; i < indexCount; i++)
+	{
+		liveTriCountList[pIndexList[i]]++;
+	}
+
+	std::vector<UINT> adjacencyOffsetList(vertexCount + 1, 0);
+	for (UINT i = 0; i < vertexCount; i++)
+	{
+		adjacencyOffsetList[i + 1] = adjacencyOffsetList[i] + liveTriCountList[i];
+	}
+
+	std::vector<UINT> adjacencyList(indexCount);
+	{
+		std::vector<UINT> writeOffsetList(adjacencyOffsetList.begin(), adjacencyOffsetList.end() - 1);
+		for (UINT i = 0; i < indexCount; i++)
+		{
+			adjacencyList[writeOffsetList[pIndexList[i]]++] = i / 3;
+		}
+	}
+
+	std::vector<UINT> cacheTimeList(vertexCount, 0);
+	std::vector<UINT8> emittedList(triCount, 0);
+	std::vector<UINT> deadEndStack;
+	std::vector<UINT> candidateList;
+	std::vector<UINT> outIndexList;
+	deadEndStack.reserve(indexCount);
+	outIndexList.reserve(indexCount);
+
+	UINT timeStamp = MeshVertexCacheSize + 1;
+	UINT cursor = 0;
+
+	// 후보가 없으면 최근에 쓴 정점부터, 그 다음에는 입력 순서대로 남은 삼각형이 있는 정점을 찾는다
+	auto SkipDeadEnd = [&]() -> UINT
+		{
+			while (!deadEndStack.empty())
+			{
+				const UINT vertexIndex = deadEndStack.back();
+				deadEndStack.pop_back();
+				if (liveTriCountList[vertexIndex] > 0)
+				{
+					return vertexIndex;
+				}
+			}
+			while (cursor < vertexCount)
+			{
+				if (liveTriCountList[cursor] > 0)
+				{
+					return cursor;
+				}
+				cursor++;
+			}
+			return UINT_MAX;
+		};
+
+	UINT fanningVertex = SkipDeadEnd();
+	while (fanningVertex != UINT_MAX)
+	{
+		// 캐시 밖의 정점에서 다시 시작하는 지점이 overdraw 정렬 단위(cluster)의 경계
+		if (pOutClusterList && timeStamp - cacheTimeList[fanningVertex] > MeshVertexCacheSize)
+		{
+			pOutClusterList->push_back(static_cast<UINT>(outIndexList.size() / 3));
+		}
+
+		candidateList.clear();
+		for (UINT i = adjacencyOffsetList[fanningVertex]; i < adjacencyOffsetList[fanningVertex + 1]; i++)
+		{
+			const UINT triIndex = adjacencyList[i];
+			if (emittedList[triIndex])
+			{
+				continue;
+			}
+
+			for (UINT corner = 0; corner < 3; corner++)
+			{
+				const UINT vertexIndex = pIndexList[triIndex * 3 + corner];
+				outIndexList.push_back(vertexIndex);
+				deadEndStack.push_back(vertexIndex);
+				candidateList.push_back(vertexIndex);
+				liveTriCountList[vertexIndex]--;
+				if (timeStamp - cacheTimeList[vertexIndex] > MeshVertexCacheSize)
+				{
+					cacheTimeList[vertexIndex] = timeStamp;
+					timeStamp++;
+				}
+			}
+			emittedList[triIndex] = 1;
+		}
+
+		// 남은 삼각형을 모두 내보내는 동안 캐시에 머물 수 있는 정점 중 가장 오래된 것
+		UINT nextVertex = UINT_MAX;
+		int bestPriority = -1;
+		for (UINT vertexIndex : candidateList)
+		{
+			if (liveTriCountList[vertexIndex] == 0)
+			{
+				continue;
+			}
+
+			int priority = 0;
+			const UINT age = timeStamp - cacheTimeList[vertexIndex];
+			if (age + 2 * liveTriCountList[vertexIndex] <= MeshVertexCacheSize)
+			{
+				priority = static_cast<int>(age);
+			}
+			if (priority > bestPriority)
+			{
+				bestPriority = priority;
+				nextVertex = vertexIndex;
+			}
+		}
+
+		fanningVertex = (nextVertex != UINT_MAX) ? nextVertex : SkipDeadEnd();
+	}
+
+	memcpy(pIndexList, outIndexList.data(), sizeof(UINT) * outIndexList.size());
+}
+
+void OptimizeOverdraw(UINT* pIndexList, UINT indexCount, const BYTE* pVertexData, UINT vertexSize, const std::vector<UINT>& clusterList)
+{
+	const UINT triCount = indexCount / 3;
+	if (triCount == 0 || clusterList.size() < 2)
+	{
+		return;
+	}
+
+	struct ClusterSortKey
+	{
+		UINT BeginTri = 0;
+		UINT EndTri = 0;
+		float Score = 0.0f;
+	};
+
+	// 면적 가중 법선 / 중심. 시계 방향 winding에서 cross(b - a, c - a)가 바깥쪽 법선
+	std::vector<ClusterSortKey> keyList(clusterList.size());
+	std::vector<XMFLOAT3> clusterNormalList(clusterList.size());
+	std::vector<XMFLOAT3> clusterCenterList(clusterList.size());
+	XMFLOAT3 meshCenter = {};
+	float meshArea = 0.0f;
+	for (size_t clusterIndex = 0; clusterIndex < clusterList.size(); clusterIndex++)
+	{
+		ClusterSortKey& key = keyList[clusterIndex];
+		key.BeginTri = clusterList[clusterIndex];
+		key.EndTri = (clusterIndex + 1 < clusterList.size()) ? clusterList[clusterIndex + 1] : triCount;
+
+		XMFLOAT3 normal = {};
+		XMFLOAT3 center = {};
+		float clusterArea = 0.0f;
+		for (UINT triIndex = key.BeginTri; triIndex < key.EndTri; triIndex++)
+		{
+			const XMFLOAT3 a = LoadPosition(pVertexData, vertexSize, pIndexList[triIndex * 3 + 0]);
+			const XMFLOAT3 b = LoadPosition(pVertexData, vertexSize, pIndexList[triIndex * 3 + 1]);
+			const XMFLOAT3 c = LoadPosition(pVertexData, vertexSize, pIndexList[triIndex * 3 + 2]);
+			const XMFLOAT3 ab = { b.x - a.x, b.y - a.y, b.z - a.z };
+			const XMFLOAT3 ac = { c.x - a.x, c.y - a.y, c.z - a.z };
+			const XMFLOAT3 cross = { ab.y * ac.z - ab.z * ac.y, ab.z * ac.x - ab.x * ac.z, ab.x * ac.y - ab.y * ac.x };
+			const float area = sqrtf(cross.x * cross.x + cross.y * cross.y + cross.z * cross.z) * 0.5f;
+
+			normal = { normal.x + cross.x, normal.y + cross.y, normal.z + cross.z };
+			center.x += (a.x + b.x + c.x) * (area / 3.0f);
+			center.y += (a.y + b.y + c.y) * (area / 3.0f);
+			center.z += (a.z + b.z + c.z) * (area / 3.0f);
+			clusterArea += area;
+		}
+
+		meshCenter = { meshCenter.x + center.x, meshCenter.y + center.y, meshCenter.z + center.z };
+		meshArea += clusterArea;
+
+		if (clusterArea > 0.0f)
+		{
+			center = { center.x / clusterArea, center.y / clusterArea, center.z / clusterArea };
+		}
+		clusterNormalList[clusterIndex] = normal;
+		clusterCenterList[clusterIndex] = center;
+	}
+
+	if (meshArea <= 0.0f)
+	{
+		return;
+	}
+	meshCenter = { meshCenter.x / meshArea, meshCenter.y / meshArea, meshCenter.z / meshArea };
+
+	// 메시 중심에서 바깥을 향하는 cluster일수록 다른 cluster를 가릴 가능성이 크므로 먼저 그린다
+	for (size_t clusterIndex = 0; clusterIndex < clusterList.size(); clusterIndex++)
+	{
+		const XMFLOAT3& normal = clusterNormalList[clusterIndex];
+		const XMFLOAT3& center = clusterCenterList[clusterIndex];
+		const float normalLength = sqrtf(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+		if (normalLength > 0.0f)
+		{
+			keyList[clusterIndex].Score = ((center.x - meshCenter.x) * normal.x + (center.y - meshCenter.y) * normal.y + (center.z - meshCenter.z) * normal.z) / normalLength;
+		}
+	}
+
+	std::stable_sort(keyList.begin(), keyList.end(), [](const ClusterSortKey& a, const ClusterSortKey& b) { return a.Score > b.Score; });
+
+	std::vector<UINT> sortedIndexList;
+	sortedIndexList.reserve(indexCount);
+	for (const ClusterSortKey& key : keyList)
+	{
+		sortedIndexList.insert(sortedIndexList.end(), pIndexList + key.BeginTri * 3, pIndexList + key.EndTri * 3);
+	}
+	memcpy(pIndexList, sortedIndexList.data(), sizeof(UINT) * sortedIndexList.size());
+}
+
+UINT OptimizeVertexFetch(BYTE* pVertexData, UINT vertexCount, UINT vertexSize, UINT* pIndexList, UINT indexCount)
+{
+	std::vector<UINT> remapList(vertexCount, UINT_MAX);
+	UINT usedVertexCount = 0;
+	for (UINT i = 0; i < indexCount; i++)
+	{
+		UINT& remappedIndex = remapList[pIndexList[i]];
+		if (remappedIndex == UINT_MAX)
+		{
+			remappedIndex = usedVertexCount++;
+		}
+		pIndexList[i] = remappedIndex;
+	}
+
+	std::vector<BYTE> reorderedVertexData(static_cast<size_t>(usedVertexCount) * vertexSize);
+	for (UINT i = 0; i < vertexCount; i++)
+	{
+		if (remapList[i] != UINT_MAX)
+		{
+			memcpy(reorderedVertexData.data() + static_cast<size_t>(remapList[i]) * vertexSize, pVertexData + static_cast<size_t>(i) * vertexSize, vertexSize);
+		}
+	}
+	memcpy(pVertexData, reorderedVertexData.data(), reorderedVertexData.size());
+	return usedVertexCount;
+}
+
+VertexCacheStats ComputeVertexCacheStats(const UINT* pIndexList, UINT indexCount, UINT vertexCount)
+{
+	const std::vector<UINT> groupIndexCountList = { indexCount };
+	return ComputeMeshCacheStats(pIndexList, groupIndexCountList, vertexCount);
+}
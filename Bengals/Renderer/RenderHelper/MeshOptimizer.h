@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * Offline-style mesh optimization run on the CPU before a mesh is uploaded.
+ *
+ * Indices are kept as UINT while optimizing; a mesh's tri groups are consecutive
+ * ranges of one index list and share one vertex buffer. The passes, in the order
+ * OptimizeMesh() applies them:
+ *   Weld         merge byte-identical vertices
+ *   VertexCache  Tipsify (Sander et al. 2007) triangle order per tri group
+ *   Overdraw     sort Tipsify's clusters so outward-facing ones draw first; implies
+ *                VertexCache and needs a float3 position at byte offset 0
+ *   VertexFetch  renumber vertices in first-use order and drop unused ones
+ *   Quantize     not a pass here: CBasicMeshObject packs VertexPos3Color4Tex2 into
+ *                VertexPackedPos3Color4Tex2 after the passes and LODs (VertexQuantizer.h)
+ * ACMR is cache misses per triangle and ATVR misses per referenced vertex, both
+ * measured with a FIFO post-transform cache of MeshVertexCacheSize entries that starts
+ * empty at every tri group. No device access.
+ */
+
+enum EMeshOptimizeFlag : UINT
+{
+	MeshOptimizeNone = 0,
+	MeshOptimizeWeld = 1 << 0,
+	MeshOptimizeVertexCache = 1 << 1,
+	MeshOptimizeOverdraw = 1 << 2,
+	MeshOptimizeVertexFetch = 1 << 3,
+	MeshOptimizeQuantize = 1 << 4,
+	MeshOptimizeDefault = MeshOptimizeWeld | MeshOptimizeVertexCache | MeshOptimizeVertexFetch
+};
+
+struct VertexCacheStats
+{
+	UINT CacheMissCount = 0;
+	float Acmr = 0.0f;
+	float Atvr = 0.0f;
+};
+
+struct MeshOptimizeStats
+{
+	UINT VertexCountBefore = 0;
+	UINT VertexCountAfter = 0;
+	VertexCacheStats CacheBefore = {};
+	VertexCacheStats CacheAfter = {};
+};
+
+// ACMR / ATVR 측정과 Tipsify가 가정하는 post-transform 캐시 크기
+constexpr UINT MeshVertexCacheSize = 16;
+
+// groupIndexCountList[i]는 i번째 tri group의 인덱스 수. 합은 pIndexList 크기와 같아야 한다
+bool OptimizeMesh(std::vector<BYTE>* pVertexData, UINT vertexSize, std::vector<UINT>* pIndexList,
+	const std::vector<UINT>& groupIndexCountList, UINT optimizeFlags, MeshOptimizeStats* pOutStats);
+
+// 개별 pass (벤치마크 / 도구용)
+UINT WeldVertices(const BYTE* pVertexData, UINT vertexCount, UINT vertexSize, std::vector<UINT>* pOutRemapList);
+void OptimizeVertexCache(UINT* pIndexList, UINT indexCount, UINT vertexCount, std::vector<UINT>* pOutClusterList = nullptr);
+void OptimizeOverdraw(UINT* pIndexList, UINT indexCount, const BYTE* pVertexData, UINT vertexSize, const std::vector<UINT>& clusterList);
+UINT OptimizeVertexFetch(BYTE* pVertexData, UINT vertexCount, UINT vertexSize, UINT* pIndexList, UINT indexCount);
+
+VertexCacheStats ComputeVertexCacheStats(const UINT* pIndexList, UINT indexCount, UINT vertexCount);
@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "PersistentCpuDescriptorAllocator.h"
+#include "GpuMemoryTag.h"
 
 bool CPersistentCpuDescriptorAllocator::Initialize(ID3D12Device* pD3DDevice, const UINT maxDescriptorCount)
 {
@@ -20,6 +21,8 @@ bool CPersistentCpuDescriptorAllocator::Initialize(ID3D12Device* pD3DDevice, con
 		return false;
 	}
 
+	TagGpuMemory(pD3DDevice, m_pDescriptorHeap.Get());
+
 	m_indexCreator.Initialize(maxDescriptorCount);
 	m_descriptorSize = pD3DDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
@@ -0,0 +1,164 @@
+#include "pch.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include "PipelineCacheFile.h"
+#include "PipelineStateKey.h"
+
+namespace
+{
+	size_t AlignUp8(size_t size)
+	{
+		return (size + 7) & ~static_cast<size_t>(7);
+	}
+}
+
+bool CPipelineCacheFile::Deserialize(const BYTE* pData, size_t size)
+{
+	Clear();
+
+	if (!pData || size < sizeof(FileHeader))
+	{
+		return false;
+	}
+
+	FileHeader header = {};
+	memcpy(&header, pData, sizeof(header));
+	if (header.Magic != Magic || header.Version != Version)
+	{
+		return false;
+	}
+
+	const BYTE* pPayload = pData + sizeof(FileHeader);
+	const size_t payloadSize = size - sizeof(FileHeader);
+	if (CPipelineStateHasher::HashBytes(pPayload, payloadSize) != header.PayloadHash)
+	{
+		return false;
+	}
+
+	size_t offset = 0;
+	for (UINT i = 0; i < header.EntryCount; i++)
+	{
+		if (payloadSize - offset < sizeof(EntryHeader))
+		{
+			Clear();
+			return false;
+		}
+
+		EntryHeader entry = {};
+		memcpy(&entry, pPayload + offset, sizeof(entry));
+		offset += sizeof(EntryHeader);
+
+		if (entry.BlobSize > payloadSize - offset)
+		{
+			Clear();
+			return false;
+		}
+
+		const BYTE* pBlob = pPayload + offset;
+		m_entryMap[entry.Key].assign(pBlob, pBlob + entry.BlobSize);
+		offset += (std::min)(AlignUp8(static_cast<size_t>(entry.BlobSize)), payloadSize - offset);
+	}
+
+	return true;
+}
+
+void CPipelineCacheFile::Serialize(std::vector<BYTE>& outData) const
+{
+	std::vector<UINT64> keyList;
+	keyList.reserve(m_entryMap.size());
+	size_t payloadSize = 0;
+	for (const auto& entry : m_entryMap)
+	{
+		keyList.push_back(entry.first);
+		payloadSize += sizeof(EntryHeader) + AlignUp8(entry.second.size());
+	}
+	std::sort(keyList.begin(), keyList.end());
+
+	outData.assign(sizeof(FileHeader) + payloadSize, 0);
+
+	size_t offset = sizeof(FileHeader);
+	for (UINT64 key : keyList)
+	{
+		const std::vector<BYTE>& blob = m_entryMap.at(key);
+		EntryHeader entry = { key, static_cast<UINT64>(blob.size()) };
+		memcpy(outData.data() + offset, &entry, sizeof(entry));
+		offset += sizeof(EntryHeader);
+
+		if (!blob.empty())
+		{
+			memcpy(outData.data() + offset, blob.data(), blob.size());
+		}
+		offset += AlignUp8(blob.size());
+	}
+
+	FileHeader header = {};
+	header.Magic = Magic;
+	header.Version = Version;
+	header.EntryCount = static_cast<UINT>(keyList.size());
+	header.PayloadHash = CPipelineStateHasher::HashBytes(outData.data() + sizeof(FileHeader), payloadSize);
+	memcpy(outData.data(), &header, sizeof(header));
+}
+
+bool CPipelineCacheFile::ReadFromFile(const WCHAR* wchFileName)
+{
+	Clear();
+
+	std::ifstream file(std::filesystem::path(wchFileName), std::ios::binary | std::ios::ate);
+	if (!file)
+	{
+		return false;
+	}
+
+	const std::streamsize fileSize = file.tellg();
+	if (fileSize <= 0)
+	{
+		return false;
+	}
+
+	std::vector<BYTE> fileData(static_cast<size_t>(fileSize));
+	file.seekg(0, std::ios::beg);
+	if (!file.read(reinterpret_cast<char*>(fileData.data()), fileSize))
+	{
+		return false;
+	}
+
+	return Deserialize(fileData.data(), fileData.size());
+}
+
+bool CPipelineCacheFile::WriteToFile(const WCHAR* wchFileName) const
+{
+	std::vector<BYTE> fileData;
+	Serialize(fileData);
+
+	std::ofstream file(std::filesystem::path(wchFileName), std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		return false;
+	}
+
+	file.write(reinterpret_cast<const char*>(fileData.data()), static_cast<std::streamsize>(fileData.size()));
+	return file.good();
+}
+
+const std::vector<BYTE>* CPipelineCacheFile::Find(UINT64 key) const
+{
+	auto it = m_entryMap.find(key);
+	return (it != m_entryMap.end()) ? &it->second : nullptr;
+}
+
+void CPipelineCacheFile::Store(UINT64 key, const void* pBlob, size_t blobSize)
+{
+	const BYTE* pBytes = static_cast<const BYTE*>(pBlob);
+	m_entryMap[key].assign(pBytes, pBytes + blobSize);
+}
+
+void CPipelineCacheFile::Remove(UINT64 key)
+{
+	m_entryMap.erase(key);
+}
+
+void CPipelineCacheFile::Clear()
+{
+	m_entryMap.clear();
+}
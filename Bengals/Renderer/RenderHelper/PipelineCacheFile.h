@@ -0,0 +1,58 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Fallback on-disk format for cached PSO blobs (ID3D12PipelineState::GetCachedBlob),
+ * used when the device does not support ID3D12PipelineLibrary.
+ *
+ *   Header  { Magic 'BPSC', Version, EntryCount, Reserved, PayloadHash }
+ *   Entry[] { Key (UINT64), BlobSize (UINT64), Blob bytes padded to 8 }
+ *
+ * PayloadHash covers everything after the header; a truncated or stale file is
+ * rejected as a whole and the cache simply starts empty. Entries are written in key
+ * order so the same contents always produce the same file.
+ * No device access.
+ */
+class CPipelineCacheFile
+{
+public:
+	static constexpr UINT Magic = 0x43535042;		// "BPSC"
+	static constexpr UINT Version = 1;
+
+public:
+	bool Deserialize(const BYTE* pData, size_t size);
+	void Serialize(std::vector<BYTE>& outData) const;
+
+	bool ReadFromFile(const WCHAR* wchFileName);
+	bool WriteToFile(const WCHAR* wchFileName) const;
+
+	const std::vector<BYTE>* Find(UINT64 key) const;
+	void Store(UINT64 key, const void* pBlob, size_t blobSize);
+	void Remove(UINT64 key);
+	void Clear();
+
+	UINT GetEntryCount() const
+	{
+		return static_cast<UINT>(m_entryMap.size());
+	}
+
+private:
+	struct FileHeader
+	{
+		UINT Magic;
+		UINT Version;
+		UINT EntryCount;
+		UINT Reserved;
+		UINT64 PayloadHash;
+	};
+
+	struct EntryHeader
+	{
+		UINT64 Key;
+		UINT64 BlobSize;
+	};
+
+	std::unordered_map<UINT64, std::vector<BYTE>> m_entryMap;
+};
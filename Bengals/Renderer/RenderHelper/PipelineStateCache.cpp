@@ -0,0 +1,251 @@
+#include "pch.h"
+#include <filesystem>
+#include <fstream>
+#include "PipelineStateCache.h"
+#include "PipelineStateKey.h"
+
+namespace
+{
+	bool ReadBinaryFile(const std::wstring& fileName, std::vector<BYTE>& outData)
+	{
+		outData.clear();
+
+		std::ifstream file(std::filesystem::path(fileName), std::ios::binary | std::ios::ate);
+		if (!file)
+		{
+			return false;
+		}
+
+		const std::streamsize fileSize = file.tellg();
+		if (fileSize <= 0)
+		{
+			return false;
+		}
+
+		outData.resize(static_cast<size_t>(fileSize));
+		file.seekg(0, std::ios::beg);
+		if (!file.read(reinterpret_cast<char*>(outData.data()), fileSize))
+		{
+			outData.clear();
+			return false;
+		}
+		return true;
+	}
+
+	bool WriteBinaryFile(const std::wstring& fileName, const void* pData, size_t size)
+	{
+		std::ofstream file(std::filesystem::path(fileName), std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			return false;
+		}
+
+		file.write(static_cast<const char*>(pData), static_cast<std::streamsize>(size));
+		return file.good();
+	}
+}
+
+CPipelineStateCache::~CPipelineStateCache()
+{
+	Cleanup();
+}
+
+bool CPipelineStateCache::Initialize(ID3D12Device5* pD3DDevice, const WCHAR* wchCacheFileName)
+{
+	if (!pD3DDevice || !wchCacheFileName)
+	{
+		return false;
+	}
+
+	m_pD3DDevice = pD3DDevice;
+	m_libraryFileName = std::wstring(wchCacheFileName) + L".lib";
+	m_cacheFileName = std::wstring(wchCacheFileName) + L".bin";
+
+	D3D12_FEATURE_DATA_SHADER_CACHE shaderCacheSupport = {};
+	const bool bLibrarySupported =
+		SUCCEEDED(m_pD3DDevice->CheckFeatureSupport(D3D12_FEATURE_SHADER_CACHE, &shaderCacheSupport, sizeof(shaderCacheSupport))) &&
+		(shaderCacheSupport.SupportFlags & D3D12_SHADER_CACHE_SUPPORT_LIBRARY);
+
+	if (bLibrarySupported && InitializePipelineLibrary())
+	{
+		return true;
+	}
+
+	// Fallback: PSO별 cached blob. 파일이 없거나 깨졌으면 빈 캐시로 시작
+	m_cacheFile.ReadFromFile(m_cacheFileName.c_str());
+	return true;
+}
+
+ID3D12PipelineState* CPipelineStateCache::GetGraphicsPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, UINT64 rootSignatureHash)
+{
+	if (!m_pD3DDevice)
+	{
+		__debugbreak();
+		return nullptr;
+	}
+
+	const UINT64 key = HashGraphicsPipelineDesc(desc, rootSignatureHash);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto it = m_pipelineStateMap.find(key);
+	if (it != m_pipelineStateMap.end())
+	{
+		return it->second;
+	}
+
+	WCHAR wchName[32] = {};
+	swprintf_s(wchName, L"%016llx", static_cast<unsigned long long>(key));
+
+	ID3D12PipelineState* pPipelineState = m_pPipelineLibrary ? LoadFromLibrary(desc, wchName) : LoadFromCacheFile(desc, key);
+	if (pPipelineState)
+	{
+		m_loadedFromDiskCount++;
+	}
+	else
+	{
+		D3D12_GRAPHICS_PIPELINE_STATE_DESC createDesc = desc;
+		createDesc.CachedPSO = {};
+		if (FAILED(m_pD3DDevice->CreateGraphicsPipelineState(&createDesc, IID_PPV_ARGS(&pPipelineState))))
+		{
+			__debugbreak();
+			return nullptr;
+		}
+
+		if (m_pPipelineLibrary)
+		{
+			// 같은 이름이 이미 있으면(해시 충돌) 실패하지만 PSO 자체는 그대로 사용
+			if (SUCCEEDED(m_pPipelineLibrary->StorePipeline(wchName, pPipelineState)))
+			{
+				m_bDirty = true;
+			}
+		}
+		else
+		{
+			ComPtr<ID3DBlob> cachedBlob = nullptr;
+			if (SUCCEEDED(pPipelineState->GetCachedBlob(&cachedBlob)))
+			{
+				m_cacheFile.Store(key, cachedBlob->GetBufferPointer(), cachedBlob->GetBufferSize());
+				m_bDirty = true;
+			}
+		}
+	}
+
+	m_pipelineStateMap.emplace(key, pPipelineState);
+	return pPipelineState;
+}
+
+bool CPipelineStateCache::Save()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (!m_bDirty)
+	{
+		return true;
+	}
+
+	bool bResult = false;
+	if (m_pPipelineLibrary)
+	{
+		std::vector<BYTE> serializedData(m_pPipelineLibrary->GetSerializedSize());
+		if (SUCCEEDED(m_pPipelineLibrary->Serialize(serializedData.data(), serializedData.size())))
+		{
+			bResult = WriteBinaryFile(m_libraryFileName, serializedData.data(), serializedData.size());
+		}
+	}
+	else
+	{
+		bResult = m_cacheFile.WriteToFile(m_cacheFileName.c_str());
+	}
+
+	if (bResult)
+	{
+		m_bDirty = false;
+	}
+	return bResult;
+}
+
+UINT CPipelineStateCache::GetPipelineStateCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return static_cast<UINT>(m_pipelineStateMap.size());
+}
+
+ID3D12PipelineState* CPipelineStateCache::LoadFromLibrary(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, const WCHAR* wchName)
+{
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC loadDesc = desc;
+	loadDesc.CachedPSO = {};
+
+	// 이름이 없거나 desc가 저장 당시와 다르면 E_INVALIDARG
+	ID3D12PipelineState* pPipelineState = nullptr;
+	if (FAILED(m_pPipelineLibrary->LoadGraphicsPipeline(wchName, &loadDesc, IID_PPV_ARGS(&pPipelineState))))
+	{
+		return nullptr;
+	}
+	return pPipelineState;
+}
+
+ID3D12PipelineState* CPipelineStateCache::LoadFromCacheFile(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, UINT64 key)
+{
+	const std::vector<BYTE>* pCachedBlob = m_cacheFile.Find(key);
+	if (!pCachedBlob || pCachedBlob->empty())
+	{
+		return nullptr;
+	}
+
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC loadDesc = desc;
+	loadDesc.CachedPSO.pCachedBlob = pCachedBlob->data();
+	loadDesc.CachedPSO.CachedBlobSizeInBytes = pCachedBlob->size();
+
+	ID3D12PipelineState* pPipelineState = nullptr;
+	if (FAILED(m_pD3DDevice->CreateGraphicsPipelineState(&loadDesc, IID_PPV_ARGS(&pPipelineState))))
+	{
+		// D3D12_ERROR_DRIVER_VERSION_MISMATCH / ADAPTER_NOT_FOUND: 오래된 blob은 버리고 새로 만든다
+		m_cacheFile.Remove(key);
+		m_bDirty = true;
+		return nullptr;
+	}
+	return pPipelineState;
+}
+
+bool CPipelineStateCache::InitializePipelineLibrary()
+{
+	if (ReadBinaryFile(m_libraryFileName, m_libraryFileData))
+	{
+		if (SUCCEEDED(m_pD3DDevice->CreatePipelineLibrary(m_libraryFileData.data(), m_libraryFileData.size(), IID_PPV_ARGS(&m_pPipelineLibrary))))
+		{
+			return true;
+		}
+
+		// 드라이버/어댑터가 바뀌었거나 파일이 깨졌으면 빈 라이브러리로 다시 시작
+		m_libraryFileData.clear();
+	}
+
+	if (FAILED(m_pD3DDevice->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&m_pPipelineLibrary))))
+	{
+		m_pPipelineLibrary = nullptr;
+		return false;
+	}
+	return true;
+}
+
+void CPipelineStateCache::Cleanup()
+{
+	for (auto& entry : m_pipelineStateMap)
+	{
+		if (entry.second)
+		{
+			entry.second->Release();
+		}
+	}
+	m_pipelineStateMap.clear();
+
+	if (m_pPipelineLibrary)
+	{
+		m_pPipelineLibrary->Release();
+		m_pPipelineLibrary = nullptr;
+	}
+	m_libraryFileData.clear();
+	m_cacheFile.Clear();
+	m_pD3DDevice = nullptr;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <d3d12.h>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "PipelineCacheFile.h"
+
+/**
+ * Renderer-wide graphics PSO cache keyed by HashGraphicsPipelineDesc().
+ *
+ * Every render object asks the cache for its PSO instead of owning one, so identical
+ * descriptions share a single ID3D12PipelineState. Compiled pipelines persist across
+ * runs through ID3D12PipelineLibrary when the driver supports it. Otherwise they go
+ * through per-PSO cached blobs in the CPipelineCacheFile format. A stale cache
+ * (driver/adapter change) is dropped and rebuilt.
+ * The cache owns the returned PSOs; callers must not Release them.
+ */
+class CPipelineStateCache
+{
+public:
+	CPipelineStateCache() = default;
+	~CPipelineStateCache();
+
+	bool Initialize(ID3D12Device5* pD3DDevice, const WCHAR* wchCacheFileName);
+	ID3D12PipelineState* GetGraphicsPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, UINT64 rootSignatureHash);
+
+	// 새로 만든 PSO가 있을 때만 파일을 다시 쓴다
+	bool Save();
+
+	UINT GetPipelineStateCount() const;
+	UINT GetLoadedFromDiskCount() const
+	{
+		return m_loadedFromDiskCount;
+	}
+
+private:
+	ID3D12PipelineState* LoadFromLibrary(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, const WCHAR* wchName);
+	ID3D12PipelineState* LoadFromCacheFile(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, UINT64 key);
+	bool InitializePipelineLibrary();
+	void Cleanup();
+
+private:
+	ID3D12Device5* m_pD3DDevice = nullptr;
+	ID3D12PipelineLibrary* m_pPipelineLibrary = nullptr;
+
+	// ID3D12PipelineLibrary는 생성에 사용한 메모리를 수명 동안 참조하므로 보관
+	std::vector<BYTE> m_libraryFileData;
+	CPipelineCacheFile m_cacheFile;
+
+	std::wstring m_libraryFileName;
+	std::wstring m_cacheFileName;
+
+	mutable std::mutex m_mutex;
+	std::unordered_map<UINT64, ID3D12PipelineState*> m_pipelineStateMap;
+	UINT m_loadedFromDiskCount = 0;
+	bool m_bDirty = false;
+};
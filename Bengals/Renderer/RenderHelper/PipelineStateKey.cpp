@@ -0,0 +1,151 @@
+#include "pch.h"
+#include "PipelineStateKey.h"
+
+namespace
+{
+	void AddShaderBytecode(CPipelineStateHasher& hasher, const D3D12_SHADER_BYTECODE& shader)
+	{
+		hasher.AddValue(static_cast<UINT64>(shader.BytecodeLength));
+		if (shader.pShaderBytecode && shader.BytecodeLength > 0)
+		{
+			hasher.AddBytes(shader.pShaderBytecode, shader.BytecodeLength);
+		}
+	}
+
+	void AddDepthStencilOp(CPipelineStateHasher& hasher, const D3D12_DEPTH_STENCILOP_DESC& op)
+	{
+		hasher.AddValue(op.StencilFailOp);
+		hasher.AddValue(op.StencilDepthFailOp);
+		hasher.AddValue(op.StencilPassOp);
+		hasher.AddValue(op.StencilFunc);
+	}
+}
+
+void CPipelineStateHasher::AddBytes(const void* pData, size_t size)
+{
+	const BYTE* pBytes = static_cast<const BYTE*>(pData);
+	for (size_t i = 0; i < size; i++)
+	{
+		m_hash ^= pBytes[i];
+		m_hash *= Prime;
+	}
+}
+
+void CPipelineStateHasher::AddString(const char* str)
+{
+	// 길이를 같이 넣어 "AB"+"C"와 "A"+"BC"가 같은 키가 되지 않게 한다
+	const size_t length = str ? strlen(str) : 0;
+	AddValue(static_cast<UINT64>(length));
+	AddBytes(str, length);
+}
+
+UINT64 CPipelineStateHasher::HashBytes(const void* pData, size_t size)
+{
+	CPipelineStateHasher hasher;
+	hasher.AddBytes(pData, size);
+	return hasher.GetHash();
+}
+
+UINT64 HashGraphicsPipelineDesc(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, UINT64 rootSignatureHash)
+{
+	CPipelineStateHasher hasher;
+	hasher.AddValue(rootSignatureHash);
+
+	AddShaderBytecode(hasher, desc.VS);
+	AddShaderBytecode(hasher, desc.PS);
+	AddShaderBytecode(hasher, desc.DS);
+	AddShaderBytecode(hasher, desc.HS);
+	AddShaderBytecode(hasher, desc.GS);
+
+	// Stream output
+	const D3D12_STREAM_OUTPUT_DESC& streamOutput = desc.StreamOutput;
+	hasher.AddValue(streamOutput.NumEntries);
+	for (UINT i = 0; i < streamOutput.NumEntries; i++)
+	{
+		const D3D12_SO_DECLARATION_ENTRY& entry = streamOutput.pSODeclaration[i];
+		hasher.AddValue(entry.Stream);
+		hasher.AddString(entry.SemanticName);
+		hasher.AddValue(entry.SemanticIndex);
+		hasher.AddValue(entry.StartComponent);
+		hasher.AddValue(entry.ComponentCount);
+		hasher.AddValue(entry.OutputSlot);
+	}
+	hasher.AddValue(streamOutput.NumStrides);
+	if (streamOutput.pBufferStrides && streamOutput.NumStrides > 0)
+	{
+		hasher.AddBytes(streamOutput.pBufferStrides, sizeof(UINT) * streamOutput.NumStrides);
+	}
+	hasher.AddValue(streamOutput.RasterizedStream);
+
+	// Blend
+	hasher.AddValue(desc.BlendState.AlphaToCoverageEnable);
+	hasher.AddValue(desc.BlendState.IndependentBlendEnable);
+	for (const D3D12_RENDER_TARGET_BLEND_DESC& rt : desc.BlendState.RenderTarget)
+	{
+		hasher.AddValue(rt.BlendEnable);
+		hasher.AddValue(rt.LogicOpEnable);
+		hasher.AddValue(rt.SrcBlend);
+		hasher.AddValue(rt.DestBlend);
+		hasher.AddValue(rt.BlendOp);
+		hasher.AddValue(rt.SrcBlendAlpha);
+		hasher.AddValue(rt.DestBlendAlpha);
+		hasher.AddValue(rt.BlendOpAlpha);
+		hasher.AddValue(rt.LogicOp);
+		hasher.AddValue(rt.RenderTargetWriteMask);
+	}
+	hasher.AddValue(desc.SampleMask);
+
+	// Rasterizer
+	const D3D12_RASTERIZER_DESC& rasterizer = desc.RasterizerState;
+	hasher.AddValue(rasterizer.FillMode);
+	hasher.AddValue(rasterizer.CullMode);
+	hasher.AddValue(rasterizer.FrontCounterClockwise);
+	hasher.AddValue(rasterizer.DepthBias);
+	hasher.AddValue(rasterizer.DepthBiasClamp);
+	hasher.AddValue(rasterizer.SlopeScaledDepthBias);
+	hasher.AddValue(rasterizer.DepthClipEnable);
+	hasher.AddValue(rasterizer.MultisampleEnable);
+	hasher.AddValue(rasterizer.AntialiasedLineEnable);
+	hasher.AddValue(rasterizer.ForcedSampleCount);
+	hasher.AddValue(rasterizer.ConservativeRaster);
+
+	// Depth stencil (UINT8 두 개 뒤에 패딩이 있으므로 필드 단위로)
+	const D3D12_DEPTH_STENCIL_DESC& depthStencil = desc.DepthStencilState;
+	hasher.AddValue(depthStencil.DepthEnable);
+	hasher.AddValue(depthStencil.DepthWriteMask);
+	hasher.AddValue(depthStencil.DepthFunc);
+	hasher.AddValue(depthStencil.StencilEnable);
+	hasher.AddValue(depthStencil.StencilReadMask);
+	hasher.AddValue(depthStencil.StencilWriteMask);
+	AddDepthStencilOp(hasher, depthStencil.FrontFace);
+	AddDepthStencilOp(hasher, depthStencil.BackFace);
+
+	// Input layout
+	hasher.AddValue(desc.InputLayout.NumElements);
+	for (UINT i = 0; i < desc.InputLayout.NumElements; i++)
+	{
+		const D3D12_INPUT_ELEMENT_DESC& element = desc.InputLayout.pInputElementDescs[i];
+		hasher.AddString(element.SemanticName);
+		hasher.AddValue(element.SemanticIndex);
+		hasher.AddValue(element.Format);
+		hasher.AddValue(element.InputSlot);
+		hasher.AddValue(element.AlignedByteOffset);
+		hasher.AddValue(element.InputSlotClass);
+		hasher.AddValue(element.InstanceDataStepRate);
+	}
+
+	hasher.AddValue(desc.IBStripCutValue);
+	hasher.AddValue(desc.PrimitiveTopologyType);
+	hasher.AddValue(desc.NumRenderTargets);
+	for (UINT i = 0; i < desc.NumRenderTargets && i < _countof(desc.RTVFormats); i++)
+	{
+		hasher.AddValue(desc.RTVFormats[i]);
+	}
+	hasher.AddValue(desc.DSVFormat);
+	hasher.AddValue(desc.SampleDesc.Count);
+	hasher.AddValue(desc.SampleDesc.Quality);
+	hasher.AddValue(desc.NodeMask);
+	hasher.AddValue(desc.Flags);
+
+	return hasher.GetHash();
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <d3d12.h>
+
+/**
+ * 64-bit FNV-1a hash of a full graphics pipeline description.
+ *
+ * Shader bytecode, input layout semantics and stream output entries are hashed by
+ * content, and every state block is hashed field by field so struct padding never
+ * leaks into the key. pRootSignature is a per-run pointer, so the caller passes a
+ * hash of the serialized root signature instead. CachedPSO is ignored.
+ * No device access; the key is stable across runs and processes.
+ */
+class CPipelineStateHasher
+{
+public:
+	static constexpr UINT64 OffsetBasis = 14695981039346656037ull;
+	static constexpr UINT64 Prime = 1099511628211ull;
+
+public:
+	void AddBytes(const void* pData, size_t size);
+	void AddString(const char* str);
+
+	template <typename T>
+	void AddValue(const T& value)
+	{
+		AddBytes(&value, sizeof(T));
+	}
+
+	UINT64 GetHash() const
+	{
+		return m_hash;
+	}
+
+	static UINT64 HashBytes(const void* pData, size_t size);
+
+private:
+	UINT64 m_hash = OffsetBasis;
+};
+
+UINT64 HashGraphicsPipelineDesc(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, UINT64 rootSignatureHash);
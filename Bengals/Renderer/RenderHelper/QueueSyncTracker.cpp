@@ -0,0 +1,133 @@
+#include "pch.h"
+#include "QueueSyncTracker.h"
+
+void CQueueSyncTracker::OnSignal(EQueueType queue, UINT64 fenceValue)
+{
+	m_stats.SignalCount++;
+
+	QueueState& state = m_queueStateList[static_cast<size_t>(queue)];
+	if (fenceValue <= state.LastSignaledValue)
+	{
+		ReportError("OnSignal: fence value did not increase");
+		return;
+	}
+
+	state.LastSignaledValue = fenceValue;
+	state.SignalRecordList.push_back({ fenceValue, state.WaitedValueList });
+}
+
+EQueueWaitResult CQueueSyncTracker::OnWait(EQueueType waitingQueue, const QueueSyncPoint& syncPoint)
+{
+	const QueueState& sourceState = m_queueStateList[static_cast<size_t>(syncPoint.Queue)];
+	if (syncPoint.FenceValue > sourceState.LastSignaledValue)
+	{
+		ReportError("OnWait: fence value was not signaled yet");
+		return EQueueWaitResult::Invalid;
+	}
+
+	// 같은 큐는 제출 순서로 보장된다
+	QueueState& waitingState = m_queueStateList[static_cast<size_t>(waitingQueue)];
+	UINT64& waitedValue = waitingState.WaitedValueList[static_cast<size_t>(syncPoint.Queue)];
+	if (waitingQueue == syncPoint.Queue || syncPoint.FenceValue <= waitedValue || syncPoint.FenceValue <= sourceState.CompletedValue)
+	{
+		m_stats.SkippedWaitCount++;
+		return EQueueWaitResult::Skipped;
+	}
+
+	waitedValue = syncPoint.FenceValue;
+	m_stats.WaitCount++;
+	return EQueueWaitResult::Waited;
+}
+
+void CQueueSyncTracker::OnCompleted(EQueueType queue, UINT64 completedValue)
+{
+	QueueState& state = m_queueStateList[static_cast<size_t>(queue)];
+	if (completedValue > state.LastSignaledValue)
+	{
+		ReportError("OnCompleted: fence value was not signaled yet");
+		return;
+	}
+	if (completedValue <= state.CompletedValue)
+	{
+		return;
+	}
+
+	state.CompletedValue = completedValue;
+	while (!state.SignalRecordList.empty() && state.SignalRecordList.front().FenceValue <= completedValue)
+	{
+		state.CompletedRecord = state.SignalRecordList.front();
+		state.SignalRecordList.pop_front();
+	}
+}
+
+UINT64 CQueueSyncTracker::GetImpliedCompletedValue(EQueueType queue, UINT64 fenceValue, EQueueType otherQueue) const
+{
+	const QueueState& state = m_queueStateList[static_cast<size_t>(queue)];
+	const size_t otherIndex = static_cast<size_t>(otherQueue);
+	if (queue == otherQueue)
+	{
+		return fenceValue;
+	}
+
+	// 대기 값은 signal 순서대로 커지므로 fenceValue 이하의 마지막 signal만 보면 된다
+	for (auto it = state.SignalRecordList.rbegin(); it != state.SignalRecordList.rend(); ++it)
+	{
+		if (it->FenceValue <= fenceValue)
+		{
+			return it->WaitedValueList[otherIndex];
+		}
+	}
+
+	// 정리한 기록보다 이전 값은 알 수 없으므로 보장하지 않는다
+	if (state.CompletedRecord.FenceValue > 0 && state.CompletedRecord.FenceValue <= fenceValue)
+	{
+		return state.CompletedRecord.WaitedValueList[otherIndex];
+	}
+	return 0;
+}
+
+bool CQueueSyncTracker::IsCompleted(const QueueSyncPoint& syncPoint) const
+{
+	if (syncPoint.FenceValue <= GetCompletedValue(syncPoint.Queue))
+	{
+		return true;
+	}
+
+	for (UINT queueIndex = 0; queueIndex < QueueCount; queueIndex++)
+	{
+		const EQueueType queue = static_cast<EQueueType>(queueIndex);
+		if (queue != syncPoint.Queue && GetImpliedCompletedValue(queue, GetCompletedValue(queue), syncPoint.Queue) >= syncPoint.FenceValue)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+UINT64 CQueueSyncTracker::GetLastSignaledValue(EQueueType queue) const
+{
+	return m_queueStateList[static_cast<size_t>(queue)].LastSignaledValue;
+}
+
+UINT64 CQueueSyncTracker::GetCompletedValue(EQueueType queue) const
+{
+	return m_queueStateList[static_cast<size_t>(queue)].CompletedValue;
+}
+
+UINT CQueueSyncTracker::GetPendingSignalCount(EQueueType queue) const
+{
+	return static_cast<UINT>(m_queueStateList[static_cast<size_t>(queue)].SignalRecordList.size());
+}
+
+void CQueueSyncTracker::Reset()
+{
+	m_queueStateList = {};
+	m_stats = {};
+	m_pLastError = nullptr;
+}
+
+void CQueueSyncTracker::ReportError(const char* pMessage)
+{
+	m_stats.ErrorCount++;
+	m_pLastError = pMessage;
+}
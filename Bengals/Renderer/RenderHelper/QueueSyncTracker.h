@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <deque>
+
+enum class EQueueType : UINT8
+{
+	Graphics,
+	Compute,
+	Count
+};
+
+// 큐의 fence가 FenceValue에 도달한 시점. FenceValue 0 = 기다릴 것 없음
+struct QueueSyncPoint
+{
+	EQueueType Queue = EQueueType::Graphics;
+	UINT64 FenceValue = 0;
+};
+
+enum class EQueueWaitResult : UINT8
+{
+	Waited,
+	Skipped,		// 같은 큐, 이미 기다린 값, 이미 끝난 값
+	Invalid			// 아직 signal하지 않은 값 (GPU 교착 위험)
+};
+
+struct QueueSyncStats
+{
+	UINT64 SignalCount = 0;
+	UINT64 WaitCount = 0;
+	UINT64 SkippedWaitCount = 0;
+	UINT64 ErrorCount = 0;
+};
+
+/**
+ * Fence bookkeeping for the graphics and async compute queues.
+ *
+ * Every queue signals its own fence with increasing values. OnWait() filters GPU waits
+ * that program order or an earlier wait already guarantee, and rejects waits on values
+ * that were not signaled yet, since the submitting thread would otherwise have to signal
+ * them later to avoid a hang. Each signal remembers what its queue had waited for, so
+ * GetImpliedCompletedValue() can tell that a finished graphics frame also means the
+ * compute work it consumed is done, without a second CPU fence wait.
+ * No device access: SignalQueue() / WaitQueue() issue the calls on ID3D12CommandQueue or
+ * CNullCommandQueue. Not thread-safe; the recording thread owns it.
+ */
+class CQueueSyncTracker
+{
+public:
+	static constexpr UINT QueueCount = static_cast<UINT>(EQueueType::Count);
+
+public:
+	CQueueSyncTracker() = default;
+	~CQueueSyncTracker() = default;
+
+	// 큐마다 fence 값은 증가해야 한다
+	void OnSignal(EQueueType queue, UINT64 fenceValue);
+	EQueueWaitResult OnWait(EQueueType waitingQueue, const QueueSyncPoint& syncPoint);
+	// CPU에서 확인한 완료 값. 그 이전 signal 기록을 정리한다
+	void OnCompleted(EQueueType queue, UINT64 completedValue);
+
+	// queue의 fenceValue가 끝났을 때 GPU 대기 관계로 함께 끝났다고 보장되는 otherQueue의 값
+	UINT64 GetImpliedCompletedValue(EQueueType queue, UINT64 fenceValue, EQueueType otherQueue) const;
+	bool IsCompleted(const QueueSyncPoint& syncPoint) const;
+
+	UINT64 GetLastSignaledValue(EQueueType queue) const;
+	UINT64 GetCompletedValue(EQueueType queue) const;
+	UINT GetPendingSignalCount(EQueueType queue) const;
+
+	const QueueSyncStats& GetStats() const { return m_stats; }
+	const char* GetLastError() const { return m_pLastError; }
+	void Reset();
+
+private:
+	using WaitedValueArray = std::array<UINT64, QueueCount>;
+
+	struct SignalRecord
+	{
+		UINT64 FenceValue = 0;
+		WaitedValueArray WaitedValueList = {};		// signal 전에 이 큐가 기다린 다른 큐의 값
+	};
+
+	struct QueueState
+	{
+		UINT64 LastSignaledValue = 0;
+		UINT64 CompletedValue = 0;
+		WaitedValueArray WaitedValueList = {};
+		std::deque<SignalRecord> SignalRecordList = {};		// 아직 완료를 확인하지 않은 signal
+		SignalRecord CompletedRecord = {};		// 정리한 signal 중 마지막
+	};
+
+	void ReportError(const char* pMessage);
+
+private:
+	std::array<QueueState, QueueCount> m_queueStateList = {};
+	QueueSyncStats m_stats = {};
+	const char* m_pLastError = nullptr;
+};
+
+// TQueue: ID3D12CommandQueue 또는 CNullCommandQueue, TFence: ID3D12Fence 또는 CNullFence
+template <typename TQueue, typename TFence>
+QueueSyncPoint SignalQueue(CQueueSyncTracker* pTracker, EQueueType queue, TQueue* pQueue, TFence* pFence, UINT64 fenceValue)
+{
+	pQueue->Signal(pFence, fenceValue);
+	pTracker->OnSignal(queue, fenceValue);
+	return { queue, fenceValue };
+}
+
+// pSourceFence는 syncPoint.Queue의 fence. 필요 없는 대기는 기록하지 않는다
+template <typename TQueue, typename TFence>
+EQueueWaitResult WaitQueue(CQueueSyncTracker* pTracker, EQueueType waitingQueue, TQueue* pQueue, TFence* pSourceFence, const QueueSyncPoint& syncPoint)
+{
+	const EQueueWaitResult result = pTracker->OnWait(waitingQueue, syncPoint);
+	if (result == EQueueWaitResult::Waited)
+	{
+		pQueue->Wait(pSourceFence, syncPoint.FenceValue);
+	}
+	return result;
+}
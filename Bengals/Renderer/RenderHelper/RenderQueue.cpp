@@ -2,10 +2,14 @@
 
 #include "RenderQueue.h"
 #include "CommandListPool.h"
+#include "GpuProfiler.h"
+#include "../Backend/DrawCommandRecorder.h"
+#include "Profiler/Profiler.h"
 #include "../../../Util/D3DUtil.h"
 #include "../D3D12Renderer.h"
 #include "../RenderObject/BasicMeshObject.h"
 #include "../RenderObject/SpriteObject.h"
+#include "../RenderObject/StaticMeshGroup.h"
 
 bool CRenderQueue::Initialize(CD3D12Renderer* pRenderer, UINT maxItemCount)
 {
@@ -42,11 +46,16 @@ UINT CRenderQueue::Process(
 	D3D12_CPU_DESCRIPTOR_HANDLE dsvDescriptorHandle,
 	UINT processCountPerCommandList)
 {
+	PROFILE_SCOPE("RenderQueue::Process");
+
 	if (!m_pRenderer || !pCommandListPool)
 	{
 		return 0;
 	}
 
+	CGpuProfiler* pGpuProfiler = m_pRenderer->GetGpuProfiler();
+	const DWORD contextIndex = m_pRenderer->GetCurrentContextIndex();
+
 	ID3D12Device5* pD3DDevice = m_pRenderer->GetD3DDevice();
 	if (!pD3DDevice)
 	{
@@ -66,6 +75,7 @@ UINT CRenderQueue::Process(
 	recordedCommandListArray.reserve(commandListCapacity);
 
 	ID3D12GraphicsCommandList* pCommandList = nullptr;
+	UINT gpuQuery = CGpuProfiler::InvalidQuery;
 	UINT processedItemCount = 0;
 	UINT processedItemCountPerCommandList = 0;
 
@@ -80,6 +90,10 @@ UINT CRenderQueue::Process(
 				return processedItemCount;
 			}
 
+			if (pGpuProfiler)
+			{
+				gpuQuery = pGpuProfiler->BeginQuery(pCommandList, contextIndex, "RenderQueue CommandList");
+			}
 			SetupCommandListForDraw(pCommandList, viewport, scissorRect, rtvDescriptorHandle, dsvDescriptorHandle);
 		}
 
@@ -93,6 +107,10 @@ UINT CRenderQueue::Process(
 
 		if (processedItemCountPerCommandList >= maxProcessCountPerCommandList)
 		{
+			if (pGpuProfiler)
+			{
+				pGpuProfiler->EndQuery(pCommandList, contextIndex, gpuQuery);
+			}
 			pCommandListPool->Close();
 			recordedCommandListArray.push_back(pCommandList);
 			pCommandList = nullptr;
@@ -102,6 +120,10 @@ UINT CRenderQueue::Process(
 
 	if (pCommandList)
 	{
+		if (pGpuProfiler)
+		{
+			pGpuProfiler->EndQuery(pCommandList, contextIndex, gpuQuery);
+		}
 		pCommandListPool->Close();
 		if (processedItemCountPerCommandList > 0)
 		{
@@ -127,7 +149,7 @@ bool CRenderQueue::ProcessRenderItem(ID3D12GraphicsCommandList* pCommandList, ID
 			return false;
 		}
 
-		renderItem.MeshItem.pMeshObject->Draw(pCommandList, renderThreadIndex, renderItem.MeshItem.WorldMatrix);
+		renderItem.MeshItem.pMeshObject->Draw(pCommandList, renderThreadIndex, renderItem.MeshItem.WorldMatrix, renderItem.MeshItem.LodIndex);
 		return true;
 
 	case ERenderItemType::Sprite:
@@ -139,12 +161,6 @@ bool CRenderQueue::ProcessRenderItem(ID3D12GraphicsCommandList* pCommandList, ID
 		}
 
 		TextureHandle* pTextureHandle = renderItem.SpriteItem.pTexHandle;
-		if (pTextureHandle && pTextureHandle->pUploadBuffer && pTextureHandle->bUpdated)
-		{
-			UpdateTexture(pD3DDevice, pCommandList, pTextureHandle->TextureResource, pTextureHandle->pUploadBuffer);
-			pTextureHandle->bUpdated = false;
-		}
-
 		if (pTextureHandle)
 		{
 			const RECT* pRect = renderItem.SpriteItem.bUseRect ? &renderItem.SpriteItem.SampleRect : nullptr;
@@ -170,6 +186,15 @@ bool CRenderQueue::ProcessRenderItem(ID3D12GraphicsCommandList* pCommandList, ID
 		return true;
 	}
 
+	case ERenderItemType::StaticMeshGroup:
+		if (!renderItem.StaticMeshGroupItem.pStaticMeshGroup)
+		{
+			return false;
+		}
+
+		renderItem.StaticMeshGroupItem.pStaticMeshGroup->Draw(pCommandList, renderThreadIndex);
+		return true;
+
 	default:
 		__debugbreak();
 		return false;
@@ -188,9 +213,7 @@ void CRenderQueue::SetupCommandListForDraw(
 		return;
 	}
 
-	pCommandList->RSSetViewports(1, &viewport);
-	pCommandList->RSSetScissorRects(1, &scissorRect);
-	pCommandList->OMSetRenderTargets(1, &rtvDescriptorHandle, FALSE, &dsvDescriptorHandle);
+	RecordRenderTargetSetup(pCommandList, viewport, scissorRect, rtvDescriptorHandle, dsvDescriptorHandle);
 }
 
 void CRenderQueue::Reset()
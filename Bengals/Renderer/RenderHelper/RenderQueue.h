@@ -9,17 +9,20 @@ class CD3D12Renderer;
 class CCommandListPool;
 class CBasicMeshObject;
 class CSpriteObject;
+class CStaticMeshGroup;
 
 enum class ERenderItemType
 {
 	MeshObject = 0,
-	Sprite
+	Sprite,
+	StaticMeshGroup
 };
 
 struct RenderMeshItem
 {
 	CBasicMeshObject* pMeshObject = nullptr;
 	XMMATRIX WorldMatrix = {};
+	UINT LodIndex = 0;		// 제출 시점에 화면 오차로 선택
 };
 
 struct RenderSpriteItem
@@ -33,6 +36,11 @@ struct RenderSpriteItem
 	TextureHandle* pTexHandle = nullptr;
 };
 
+struct RenderStaticMeshGroupItem
+{
+	CStaticMeshGroup* pStaticMeshGroup = nullptr;
+};
+
 struct RenderItem
 {
 	ERenderItemType Type = ERenderItemType::MeshObject;
@@ -40,6 +48,7 @@ struct RenderItem
 	{
 		RenderMeshItem MeshItem;
 		RenderSpriteItem SpriteItem;
+		RenderStaticMeshGroupItem StaticMeshGroupItem;
 	};
 
 	RenderItem()
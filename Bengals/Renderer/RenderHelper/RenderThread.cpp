@@ -3,6 +3,8 @@
 
 #include "RenderThread.h"
 #include "../D3D12Renderer.h"
+#include "Profiler/Profiler.h"
+#include "../../../Util/ProcessorInfo.h"
 
 UINT WINAPI RenderThread(void* pArg)
 {
@@ -13,6 +15,15 @@ UINT WINAPI RenderThread(void* pArg)
 		return 0;
 	}
 
+	char threadName[32];
+	sprintf_s(threadName, "RenderThread %u", static_cast<UINT>(pDesc->ThreadIndex));
+	PROFILE_THREAD_NAME(threadName);
+
+	if (pDesc->LogicalProcessorIndex != UINT_MAX)
+	{
+		SetCurrentThreadAffinity(pDesc->LogicalProcessorIndex);
+	}
+
 	const HANDLE* pEventList = pDesc->EventList;
 	while (true)
 	{
@@ -20,12 +31,15 @@ UINT WINAPI RenderThread(void* pArg)
 		switch (eventIndex)
 		{
 		case WAIT_OBJECT_0 + RenderThreadEventTypeProcess:
+		{
+			PROFILE_SCOPE("RenderThread");
 			pDesc->Renderer->ProcessByThread(pDesc->ThreadIndex);
 			if (pDesc->CompleteEvent)
 			{
 				SetEvent(pDesc->CompleteEvent);
 			}
 			break;
+		}
 
 		case WAIT_OBJECT_0 + RenderThreadEventTypeDestroy:
 			_endthreadex(0);
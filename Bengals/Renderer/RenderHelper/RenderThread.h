@@ -15,6 +15,7 @@ struct RenderThreadDesc
 {
 	CD3D12Renderer* Renderer = nullptr;
 	DWORD ThreadIndex = 0;
+	UINT LogicalProcessorIndex = UINT_MAX;		// UINT_MAX면 고정하지 않음
 	HANDLE ThreadHandle = nullptr;
 	HANDLE EventList[RenderThreadEventTypeCount] = {};
 	HANDLE CompleteEvent = nullptr;
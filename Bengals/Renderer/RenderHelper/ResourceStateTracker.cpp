@@ -0,0 +1,198 @@
+#include "pch.h"
+#include "ResourceStateTracker.h"
+
+void CResourceStateTracker::RegisterResource(ID3D12Resource* pResource, D3D12_RESOURCE_STATES state, EResourcePromotionType promotionType)
+{
+	if (!pResource)
+	{
+		__debugbreak();
+		return;
+	}
+
+	TrackedResource& resource = m_resourceMap[pResource];
+	if (resource.PendingBarrierIndex != UINT_MAX)
+	{
+		RemovePendingBarrier(resource.PendingBarrierIndex);
+	}
+
+	resource.State = state;
+	resource.PromotionType = promotionType;
+	resource.bPromoted = false;
+	resource.PendingBarrierIndex = UINT_MAX;
+}
+
+void CResourceStateTracker::UnregisterResource(ID3D12Resource* pResource)
+{
+	// 해제될 리소스의 barrier가 다음 FlushBarriers에서 기록되면 안 된다
+	auto it = m_resourceMap.find(pResource);
+	if (it == m_resourceMap.end())
+	{
+		return;
+	}
+
+	if (it->second.PendingBarrierIndex != UINT_MAX)
+	{
+		RemovePendingBarrier(it->second.PendingBarrierIndex);
+	}
+	m_resourceMap.erase(it);
+}
+
+bool CResourceStateTracker::IsRegistered(ID3D12Resource* pResource) const
+{
+	return m_resourceMap.find(pResource) != m_resourceMap.end();
+}
+
+bool CResourceStateTracker::TransitionResource(ID3D12Resource* pResource, D3D12_RESOURCE_STATES afterState)
+{
+	auto it = m_resourceMap.find(pResource);
+	if (it == m_resourceMap.end())
+	{
+		return false;
+	}
+
+	TrackedResource& resource = it->second;
+	const D3D12_RESOURCE_STATES currentState = resource.State;
+
+	// 이미 같은 상태이거나, 요청한 읽기 상태를 모두 포함한 읽기 상태
+	if (afterState == currentState ||
+		(afterState != D3D12_RESOURCE_STATE_COMMON && IsReadOnlyState(currentState) && (currentState & afterState) == afterState))
+	{
+		return true;
+	}
+
+	// 아직 기록되지 않은 barrier가 있으면 목적 상태만 바꾼다. 원래 상태로 돌아오면 barrier를 없앤다
+	if (resource.PendingBarrierIndex != UINT_MAX)
+	{
+		D3D12_RESOURCE_BARRIER& barrier = m_pendingBarrierList[resource.PendingBarrierIndex];
+		if (barrier.Transition.StateBefore == afterState)
+		{
+			RemovePendingBarrier(resource.PendingBarrierIndex);
+		}
+		else
+		{
+			barrier.Transition.StateAfter = afterState;
+		}
+		resource.State = afterState;
+		return true;
+	}
+
+	if (CanPromote(resource, afterState))
+	{
+		resource.State = (currentState == D3D12_RESOURCE_STATE_COMMON) ? afterState : (currentState | afterState);
+		resource.bPromoted = true;
+		return true;
+	}
+
+	D3D12_RESOURCE_BARRIER barrier = {};
+	barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+	barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+	barrier.Transition.pResource = pResource;
+	barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+	barrier.Transition.StateBefore = currentState;
+	barrier.Transition.StateAfter = afterState;
+
+	resource.PendingBarrierIndex = static_cast<UINT>(m_pendingBarrierList.size());
+	resource.State = afterState;
+	resource.bPromoted = false;
+	m_pendingBarrierList.push_back(barrier);
+	return true;
+}
+
+D3D12_RESOURCE_STATES CResourceStateTracker::GetResourceState(ID3D12Resource* pResource) const
+{
+	auto it = m_resourceMap.find(pResource);
+	return (it != m_resourceMap.end()) ? it->second.State : D3D12_RESOURCE_STATE_COMMON;
+}
+
+void CResourceStateTracker::OnCommandListsExecuted()
+{
+	if (!m_pendingBarrierList.empty())
+	{
+		// 닫기 전에 FlushBarriers를 하지 않았다
+		__debugbreak();
+	}
+
+	for (auto& entry : m_resourceMap)
+	{
+		TrackedResource& resource = entry.second;
+		if (resource.PromotionType == EResourcePromotionType::Buffer ||
+			(resource.PromotionType == EResourcePromotionType::Texture && resource.bPromoted && IsReadOnlyState(resource.State)))
+		{
+			resource.State = D3D12_RESOURCE_STATE_COMMON;
+		}
+		resource.bPromoted = false;
+	}
+}
+
+void CResourceStateTracker::Reset()
+{
+	m_resourceMap.clear();
+	m_pendingBarrierList.clear();
+}
+
+bool CResourceStateTracker::IsReadOnlyState(D3D12_RESOURCE_STATES state)
+{
+	return state != D3D12_RESOURCE_STATE_COMMON && (state & ~ReadOnlyStateMask) == 0;
+}
+
+bool CResourceStateTracker::CanPromote(const TrackedResource& resource, D3D12_RESOURCE_STATES afterState)
+{
+	if (resource.PromotionType == EResourcePromotionType::None)
+	{
+		return false;
+	}
+
+	if (resource.PromotionType == EResourcePromotionType::Texture)
+	{
+		constexpr D3D12_RESOURCE_STATES TexturePromotableStateMask =
+			D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE |
+			D3D12_RESOURCE_STATE_COPY_SOURCE | D3D12_RESOURCE_STATE_COPY_DEST;
+		if (afterState & ~TexturePromotableStateMask)
+		{
+			return false;
+		}
+	}
+
+	if (resource.State == D3D12_RESOURCE_STATE_COMMON)
+	{
+		return true;
+	}
+
+	// 읽기 상태로 승격된 뒤에는 다른 읽기 상태로만 추가 승격된다
+	return resource.bPromoted && IsReadOnlyState(resource.State) && IsReadOnlyState(afterState);
+}
+
+void CResourceStateTracker::RemovePendingBarrier(UINT barrierIndex)
+{
+	auto removedIt = m_resourceMap.find(m_pendingBarrierList[barrierIndex].Transition.pResource);
+	if (removedIt != m_resourceMap.end())
+	{
+		removedIt->second.PendingBarrierIndex = UINT_MAX;
+	}
+
+	// 한 번의 ResourceBarrier 안에서 서로 다른 리소스의 순서는 의미가 없으므로 마지막 항목과 교체
+	const UINT lastIndex = static_cast<UINT>(m_pendingBarrierList.size()) - 1;
+	if (barrierIndex != lastIndex)
+	{
+		m_pendingBarrierList[barrierIndex] = m_pendingBarrierList[lastIndex];
+		auto movedIt = m_resourceMap.find(m_pendingBarrierList[barrierIndex].Transition.pResource);
+		if (movedIt != m_resourceMap.end())
+		{
+			movedIt->second.PendingBarrierIndex = barrierIndex;
+		}
+	}
+	m_pendingBarrierList.pop_back();
+}
+
+void CResourceStateTracker::ClearPendingBarriers()
+{
+	for (const D3D12_RESOURCE_BARRIER& barrier : m_pendingBarrierList)
+	{
+		auto it = m_resourceMap.find(barrier.Transition.pResource);
+		if (it != m_resourceMap.end())
+		{
+			it->second.PendingBarrierIndex = UINT_MAX;
+		}
+	}
+	m_pendingBarrierList.clear();
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <d3d12.h>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Records the current state of each registered resource and batches transitions.
+ *
+ * TransitionResource() only queues a barrier. Transitions of the same resource before
+ * the next flush are merged into one, and dropped if they end in the state they
+ * started from. FlushBarriers() issues everything queued in one ResourceBarrier call;
+ * call it right before the next draw or copy.
+ * Implicit promotion out of COMMON and decay back to COMMON after ExecuteCommandLists
+ * follow the D3D12 rules, so those transitions produce no barrier at all.
+ * All subresources are tracked as one state.
+ * Not thread-safe: one tracker per recording thread. No device access; FlushBarriers is
+ * a template so CNullCommandList can record the resulting barrier sequence.
+ */
+
+enum class EResourcePromotionType : UINT8
+{
+	None = 0,		// 항상 명시적 barrier (swap chain back buffer 등)
+	Texture,		// COMMON -> 셰이더 읽기 / COPY_SOURCE / COPY_DEST 승격, 읽기 상태로 승격된 경우만 decay
+	Buffer			// COMMON -> 모든 상태 승격, 실행이 끝나면 항상 decay
+};
+
+class CResourceStateTracker
+{
+public:
+	static constexpr D3D12_RESOURCE_STATES ReadOnlyStateMask =
+		D3D12_RESOURCE_STATE_GENERIC_READ | D3D12_RESOURCE_STATE_DEPTH_READ | D3D12_RESOURCE_STATE_RESOLVE_SOURCE;
+
+public:
+	void RegisterResource(ID3D12Resource* pResource, D3D12_RESOURCE_STATES state, EResourcePromotionType promotionType = EResourcePromotionType::None);
+	// 해제 직전에 호출. 보류 중인 barrier는 기록하지 않고 버린다
+	void UnregisterResource(ID3D12Resource* pResource);
+	bool IsRegistered(ID3D12Resource* pResource) const;
+
+	// 등록되지 않은 리소스면 false. barrier는 FlushBarriers까지 보류된다
+	bool TransitionResource(ID3D12Resource* pResource, D3D12_RESOURCE_STATES afterState);
+	D3D12_RESOURCE_STATES GetResourceState(ID3D12Resource* pResource) const;
+
+	template <typename TCommandList>
+	void FlushBarriers(TCommandList* pCommandList)
+	{
+		if (m_pendingBarrierList.empty())
+		{
+			return;
+		}
+
+		pCommandList->ResourceBarrier(static_cast<UINT>(m_pendingBarrierList.size()), m_pendingBarrierList.data());
+		m_flushedBarrierCount += m_pendingBarrierList.size();
+		ClearPendingBarriers();
+	}
+
+	// 큐에 ExecuteCommandLists를 호출할 때마다 바로 뒤에 호출. 이후 제출되는 리스트 기준으로 암시적 decay 규칙대로 COMMON으로 되돌린다
+	void OnCommandListsExecuted();
+	void Reset();
+
+	UINT GetPendingBarrierCount() const
+	{
+		return static_cast<UINT>(m_pendingBarrierList.size());
+	}
+
+	const D3D12_RESOURCE_BARRIER* GetPendingBarriers() const
+	{
+		return m_pendingBarrierList.data();
+	}
+
+	UINT64 GetFlushedBarrierCount() const
+	{
+		return m_flushedBarrierCount;
+	}
+
+private:
+	struct TrackedResource
+	{
+		D3D12_RESOURCE_STATES State = D3D12_RESOURCE_STATE_COMMON;
+		EResourcePromotionType PromotionType = EResourcePromotionType::None;
+		bool bPromoted = false;
+		UINT PendingBarrierIndex = UINT_MAX;
+	};
+
+	static bool IsReadOnlyState(D3D12_RESOURCE_STATES state);
+	static bool CanPromote(const TrackedResource& resource, D3D12_RESOURCE_STATES afterState);
+
+	void RemovePendingBarrier(UINT barrierIndex);
+	void ClearPendingBarriers();
+
+private:
+	std::unordered_map<ID3D12Resource*, TrackedResource> m_resourceMap;
+	std::vector<D3D12_RESOURCE_BARRIER> m_pendingBarrierList;
+	UINT64 m_flushedBarrierCount = 0;
+};
@@ -0,0 +1,247 @@
+#include "pch.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include "ShaderArchive.h"
+#include "PipelineStateKey.h"
+
+namespace
+{
+	size_t AlignUp8(size_t size)
+	{
+		return (size + 7) & ~static_cast<size_t>(7);
+	}
+}
+
+bool CShaderArchive::Deserialize(const BYTE* pData, size_t size)
+{
+	Clear();
+
+	if (!pData || size < sizeof(FileHeader))
+	{
+		return false;
+	}
+
+	FileHeader header = {};
+	memcpy(&header, pData, sizeof(header));
+	if (header.Magic != Magic || header.Version != Version)
+	{
+		return false;
+	}
+
+	const BYTE* pPayload = pData + sizeof(FileHeader);
+	const size_t payloadSize = size - sizeof(FileHeader);
+	if (CPipelineStateHasher::HashBytes(pPayload, payloadSize) != header.PayloadHash)
+	{
+		return false;
+	}
+
+	const size_t tableSize = sizeof(FileEntry) * static_cast<size_t>(header.EntryCount) + sizeof(FileBlob) * static_cast<size_t>(header.BlobCount);
+	if (tableSize > payloadSize)
+	{
+		return false;
+	}
+
+	const BYTE* pEntryTable = pPayload;
+	const BYTE* pBlobTable = pEntryTable + sizeof(FileEntry) * header.EntryCount;
+	const BYTE* pBytecodeData = pPayload + tableSize;
+	const size_t bytecodeDataSize = payloadSize - tableSize;
+
+	m_blobList.resize(header.BlobCount);
+	for (UINT i = 0; i < header.BlobCount; i++)
+	{
+		FileBlob blob = {};
+		memcpy(&blob, pBlobTable + sizeof(FileBlob) * i, sizeof(blob));
+		if (blob.Offset > bytecodeDataSize || blob.Size > bytecodeDataSize - blob.Offset)
+		{
+			Clear();
+			return false;
+		}
+
+		const BYTE* pBytecode = pBytecodeData + blob.Offset;
+		m_blobList[i].assign(pBytecode, pBytecode + blob.Size);
+		m_blobIndexMap[blob.ContentHash] = i;
+	}
+
+	for (UINT i = 0; i < header.EntryCount; i++)
+	{
+		FileEntry entry = {};
+		memcpy(&entry, pEntryTable + sizeof(FileEntry) * i, sizeof(entry));
+		if (entry.BlobIndex >= header.BlobCount)
+		{
+			Clear();
+			return false;
+		}
+
+		ShaderEntry& shaderEntry = m_entryMap[entry.Key];
+		shaderEntry.SourceHash = entry.SourceHash;
+		shaderEntry.BlobIndex = entry.BlobIndex;
+	}
+
+	return true;
+}
+
+void CShaderArchive::Serialize(std::vector<BYTE>& outData) const
+{
+	std::vector<UINT64> keyList;
+	keyList.reserve(m_entryMap.size());
+	for (const auto& entry : m_entryMap)
+	{
+		keyList.push_back(entry.first);
+	}
+	std::sort(keyList.begin(), keyList.end());
+
+	// 키 순서로 처음 참조되는 순서대로 blob을 다시 번호 매긴다. 교체되어 참조가 없어진 blob은 빠진다
+	std::vector<UINT> remapTable(m_blobList.size(), UINT_MAX);
+	std::vector<UINT> writeBlobList;
+	writeBlobList.reserve(m_blobList.size());
+	for (UINT64 key : keyList)
+	{
+		const UINT blobIndex = m_entryMap.at(key).BlobIndex;
+		if (remapTable[blobIndex] == UINT_MAX)
+		{
+			remapTable[blobIndex] = static_cast<UINT>(writeBlobList.size());
+			writeBlobList.push_back(blobIndex);
+		}
+	}
+
+	const size_t tableSize = sizeof(FileEntry) * keyList.size() + sizeof(FileBlob) * writeBlobList.size();
+	size_t bytecodeDataSize = 0;
+	for (UINT blobIndex : writeBlobList)
+	{
+		bytecodeDataSize += AlignUp8(m_blobList[blobIndex].size());
+	}
+
+	outData.assign(sizeof(FileHeader) + tableSize + bytecodeDataSize, 0);
+
+	BYTE* pEntryTable = outData.data() + sizeof(FileHeader);
+	BYTE* pBlobTable = pEntryTable + sizeof(FileEntry) * keyList.size();
+	BYTE* pBytecodeData = pEntryTable + tableSize;
+
+	for (size_t i = 0; i < keyList.size(); i++)
+	{
+		const ShaderEntry& shaderEntry = m_entryMap.at(keyList[i]);
+		FileEntry entry = { keyList[i], shaderEntry.SourceHash, remapTable[shaderEntry.BlobIndex], 0 };
+		memcpy(pEntryTable + sizeof(FileEntry) * i, &entry, sizeof(entry));
+	}
+
+	size_t offset = 0;
+	for (size_t i = 0; i < writeBlobList.size(); i++)
+	{
+		const std::vector<BYTE>& bytecode = m_blobList[writeBlobList[i]];
+		FileBlob blob = { static_cast<UINT64>(offset), static_cast<UINT64>(bytecode.size()), CPipelineStateHasher::HashBytes(bytecode.data(), bytecode.size()) };
+		memcpy(pBlobTable + sizeof(FileBlob) * i, &blob, sizeof(blob));
+
+		if (!bytecode.empty())
+		{
+			memcpy(pBytecodeData + offset, bytecode.data(), bytecode.size());
+		}
+		offset += AlignUp8(bytecode.size());
+	}
+
+	FileHeader header = {};
+	header.Magic = Magic;
+	header.Version = Version;
+	header.EntryCount = static_cast<UINT>(keyList.size());
+	header.BlobCount = static_cast<UINT>(writeBlobList.size());
+	header.PayloadHash = CPipelineStateHasher::HashBytes(outData.data() + sizeof(FileHeader), outData.size() - sizeof(FileHeader));
+	memcpy(outData.data(), &header, sizeof(header));
+}
+
+bool CShaderArchive::ReadFromFile(const WCHAR* wchFileName)
+{
+	Clear();
+
+	std::ifstream file(std::filesystem::path(wchFileName), std::ios::binary | std::ios::ate);
+	if (!file)
+	{
+		return false;
+	}
+
+	const std::streamsize fileSize = file.tellg();
+	if (fileSize <= 0)
+	{
+		return false;
+	}
+
+	std::vector<BYTE> fileData(static_cast<size_t>(fileSize));
+	file.seekg(0, std::ios::beg);
+	if (!file.read(reinterpret_cast<char*>(fileData.data()), fileSize))
+	{
+		return false;
+	}
+
+	return Deserialize(fileData.data(), fileData.size());
+}
+
+bool CShaderArchive::WriteToFile(const WCHAR* wchFileName) const
+{
+	std::vector<BYTE> fileData;
+	Serialize(fileData);
+
+	std::ofstream file(std::filesystem::path(wchFileName), std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		return false;
+	}
+
+	file.write(reinterpret_cast<const char*>(fileData.data()), static_cast<std::streamsize>(fileData.size()));
+	return file.good();
+}
+
+bool CShaderArchive::FindShader(EShaderProgram program, EShaderStage stage, UINT permutationFlags, D3D12_SHADER_BYTECODE* pOutBytecode) const
+{
+	return FindEntry(MakeShaderKey(program, stage, permutationFlags), nullptr, pOutBytecode);
+}
+
+bool CShaderArchive::FindEntry(UINT64 key, UINT64* pOutSourceHash, D3D12_SHADER_BYTECODE* pOutBytecode) const
+{
+	auto it = m_entryMap.find(key);
+	if (it == m_entryMap.end())
+	{
+		return false;
+	}
+
+	if (pOutSourceHash)
+	{
+		*pOutSourceHash = it->second.SourceHash;
+	}
+	if (pOutBytecode)
+	{
+		const std::vector<BYTE>& bytecode = m_blobList[it->second.BlobIndex];
+		pOutBytecode->pShaderBytecode = bytecode.data();
+		pOutBytecode->BytecodeLength = bytecode.size();
+	}
+	return true;
+}
+
+void CShaderArchive::AddShader(UINT64 key, UINT64 sourceHash, const void* pBytecode, size_t bytecodeSize)
+{
+	ShaderEntry& shaderEntry = m_entryMap[key];
+	shaderEntry.SourceHash = sourceHash;
+	shaderEntry.BlobIndex = AddBlob(pBytecode, bytecodeSize);
+}
+
+void CShaderArchive::Clear()
+{
+	m_entryMap.clear();
+	m_blobList.clear();
+	m_blobIndexMap.clear();
+}
+
+UINT CShaderArchive::AddBlob(const void* pBytecode, size_t bytecodeSize)
+{
+	const UINT64 contentHash = CPipelineStateHasher::HashBytes(pBytecode, bytecodeSize);
+	auto it = m_blobIndexMap.find(contentHash);
+	if (it != m_blobIndexMap.end() && m_blobList[it->second].size() == bytecodeSize &&
+		memcmp(m_blobList[it->second].data(), pBytecode, bytecodeSize) == 0)
+	{
+		return it->second;
+	}
+
+	const BYTE* pBytes = static_cast<const BYTE*>(pBytecode);
+	const UINT blobIndex = static_cast<UINT>(m_blobList.size());
+	m_blobList.emplace_back(pBytes, pBytes + bytecodeSize);
+	m_blobIndexMap[contentHash] = blobIndex;
+	return blobIndex;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <d3d12.h>
+#include <unordered_map>
+#include <vector>
+#include "ShaderPermutation.h"
+
+/**
+ * Packed archive of precompiled shader bytecode, written by BengalsShaderBuild and
+ * loaded once by the renderer. Nothing is compiled at runtime.
+ *
+ *   Header  { Magic 'BSHA', Version, EntryCount, BlobCount, PayloadHash }
+ *   Entry[] { Key (MakeShaderKey), SourceHash, BlobIndex, Reserved }
+ *   Blob[]  { Offset, Size, ContentHash }
+ *   Bytecode, each blob padded to 8
+ *
+ * SourceHash covers the preprocessed source (includes and permutation defines
+ * already expanded), entry point, target and compile flags; the build tool reuses an
+ * entry's bytecode while it matches. Blobs are deduplicated by ContentHash, so
+ * permutations whose defines don't affect a stage share one blob.
+ * Entries are written in key order so the same inputs always produce the same file.
+ * No device access.
+ */
+class CShaderArchive
+{
+public:
+	static constexpr UINT Magic = 0x41485342;		// "BSHA"
+	static constexpr UINT Version = 1;
+
+public:
+	bool Deserialize(const BYTE* pData, size_t size);
+	void Serialize(std::vector<BYTE>& outData) const;
+
+	bool ReadFromFile(const WCHAR* wchFileName);
+	bool WriteToFile(const WCHAR* wchFileName) const;
+
+	bool FindShader(EShaderProgram program, EShaderStage stage, UINT permutationFlags, D3D12_SHADER_BYTECODE* pOutBytecode) const;
+	bool FindEntry(UINT64 key, UINT64* pOutSourceHash, D3D12_SHADER_BYTECODE* pOutBytecode) const;
+
+	void AddShader(UINT64 key, UINT64 sourceHash, const void* pBytecode, size_t bytecodeSize);
+	void Clear();
+
+	UINT GetEntryCount() const
+	{
+		return static_cast<UINT>(m_entryMap.size());
+	}
+
+	UINT GetBlobCount() const
+	{
+		return static_cast<UINT>(m_blobList.size());
+	}
+
+private:
+	struct FileHeader
+	{
+		UINT Magic;
+		UINT Version;
+		UINT EntryCount;
+		UINT BlobCount;
+		UINT64 PayloadHash;
+	};
+
+	struct FileEntry
+	{
+		UINT64 Key;
+		UINT64 SourceHash;
+		UINT BlobIndex;
+		UINT Reserved;
+	};
+
+	struct FileBlob
+	{
+		UINT64 Offset;
+		UINT64 Size;
+		UINT64 ContentHash;
+	};
+
+	struct ShaderEntry
+	{
+		UINT64 SourceHash = 0;
+		UINT BlobIndex = 0;
+	};
+
+	UINT AddBlob(const void* pBytecode, size_t bytecodeSize);
+
+private:
+	std::unordered_map<UINT64, ShaderEntry> m_entryMap;
+	std::vector<std::vector<BYTE>> m_blobList;
+	std::unordered_map<UINT64, UINT> m_blobIndexMap;		// ContentHash -> m_blobList index
+};
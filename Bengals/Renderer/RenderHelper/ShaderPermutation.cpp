@@ -0,0 +1,51 @@
+#include "pch.h"
+#include "ShaderPermutation.h"
+
+namespace
+{
+	// BINDLESS는 키와 define 이름만 예약. 셰이더가 분기를 갖게 되면 해당 프로그램 마스크에 추가
+	const ShaderProgramDesc ShaderProgramDescTable[static_cast<UINT>(EShaderProgram::Count)] =
+	{
+		{ L"Renderer/Shaders/DefaultShader.hlsl", { "VSMain", "PSMain" }, ShaderPermutationInstancing | ShaderPermutationAlphaTest | ShaderPermutationQuantizedVertex },
+		{ L"Renderer/Shaders/SpriteShader.hlsl", { "VSMain", "PSMain" }, ShaderPermutationAlphaTest },
+	};
+
+	const char* ShaderStageTargetTable[static_cast<UINT>(EShaderStage::Count)] =
+	{
+		"vs_5_0",
+		"ps_5_0",
+	};
+
+	const char* ShaderPermutationDefineNameTable[ShaderPermutationFlagCount] =
+	{
+		"INSTANCING",
+		"BINDLESS",
+		"ALPHA_TEST",
+		"QUANTIZED_VERTEX",
+	};
+}
+
+const ShaderProgramDesc& GetShaderProgramDesc(EShaderProgram program)
+{
+	return ShaderProgramDescTable[static_cast<UINT>(program)];
+}
+
+const char* GetShaderStageTarget(EShaderStage stage)
+{
+	return ShaderStageTargetTable[static_cast<UINT>(stage)];
+}
+
+const char* GetShaderPermutationDefineName(UINT flagBitIndex)
+{
+	if (flagBitIndex >= ShaderPermutationFlagCount)
+	{
+		return nullptr;
+	}
+	return ShaderPermutationDefineNameTable[flagBitIndex];
+}
+
+UINT64 MakeShaderKey(EShaderProgram program, EShaderStage stage, UINT permutationFlags)
+{
+	// [program:8][stage:8][reserved:16][permutation flags:32]
+	return (static_cast<UINT64>(program) << 56) | (static_cast<UINT64>(stage) << 48) | static_cast<UINT64>(permutationFlags);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+/**
+ * Shader program / permutation table shared by the renderer and BengalsShaderBuild.
+ *
+ * A shader is identified by (program, stage, permutation flags) and MakeShaderKey()
+ * packs the three into the archive key, so lookups never hash strings at runtime.
+ * Each permutation flag maps to one preprocessor define; a program only lists the
+ * flags its source actually branches on, and the build tool compiles every subset
+ * of that mask. Requesting a flag outside the mask is a miss, not a fallback.
+ * No device access.
+ */
+
+enum class EShaderProgram : UINT8
+{
+	Default = 0,
+	Sprite,
+	Count
+};
+
+enum class EShaderStage : UINT8
+{
+	Vertex = 0,
+	Pixel,
+	Count
+};
+
+enum EShaderPermutationFlag : UINT
+{
+	ShaderPermutationNone = 0,
+	ShaderPermutationInstancing = 1 << 0,
+	ShaderPermutationBindless = 1 << 1,
+	ShaderPermutationAlphaTest = 1 << 2,
+	ShaderPermutationQuantizedVertex = 1 << 3,
+	ShaderPermutationFlagCount = 4
+};
+
+struct ShaderProgramDesc
+{
+	const WCHAR* SourceFileName = nullptr;		// 작업 디렉터리(Bengals/) 기준
+	const char* EntryPointNames[static_cast<UINT>(EShaderStage::Count)] = {};
+	UINT PermutationMask = ShaderPermutationNone;
+};
+
+const ShaderProgramDesc& GetShaderProgramDesc(EShaderProgram program);
+const char* GetShaderStageTarget(EShaderStage stage);
+const char* GetShaderPermutationDefineName(UINT flagBitIndex);
+
+UINT64 MakeShaderKey(EShaderProgram program, EShaderStage stage, UINT permutationFlags);
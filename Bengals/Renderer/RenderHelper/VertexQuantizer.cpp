@@ -0,0 +1,118 @@
+#include "pch.h"
+#include "VertexQuantizer.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace
+{
+	constexpr float SnormMax = 32767.0f;
+	constexpr float UnormMax = 255.0f;
+
+	// 축 길이가 0이면 모든 정점이 offset에 있으므로 0으로 저장한다
+	INT16 QuantizeSnorm16(float value, float offset, float scale)
+	{
+		const float normalized = (scale > 0.0f) ? (value - offset) / scale : 0.0f;
+		const float clamped = (std::min)((std::max)(normalized, -1.0f), 1.0f);
+		return static_cast<INT16>(lroundf(clamped * SnormMax));
+	}
+
+	BYTE QuantizeUnorm8(float value)
+	{
+		const float clamped = (std::min)((std::max)(value, 0.0f), 1.0f);
+		return static_cast<BYTE>(lroundf(clamped * UnormMax));
+	}
+}
+
+bool QuantizeVertices(const VertexPos3Color4Tex2* pSrcVertexList, UINT vertexCount, VertexPackedPos3Color4Tex2* pDestVertexList, VertexQuantization* pOutQuantization)
+{
+	if (!pSrcVertexList || !pDestVertexList || !pOutQuantization || vertexCount == 0)
+	{
+		__debugbreak();
+		return false;
+	}
+
+	XMFLOAT3 minPosition = pSrcVertexList[0].Position;
+	XMFLOAT3 maxPosition = minPosition;
+	float maxAbsTexCoord = 0.0f;
+	for (UINT i = 0; i < vertexCount; i++)
+	{
+		const VertexPos3Color4Tex2& vertex = pSrcVertexList[i];
+		minPosition = { (std::min)(minPosition.x, vertex.Position.x), (std::min)(minPosition.y, vertex.Position.y), (std::min)(minPosition.z, vertex.Position.z) };
+		maxPosition = { (std::max)(maxPosition.x, vertex.Position.x), (std::max)(maxPosition.y, vertex.Position.y), (std::max)(maxPosition.z, vertex.Position.z) };
+		maxAbsTexCoord = (std::max)({ maxAbsTexCoord, fabsf(vertex.TexCoord.x), fabsf(vertex.TexCoord.y) });
+	}
+
+	VertexQuantization quantization = {};
+	quantization.PositionOffset = { (minPosition.x + maxPosition.x) * 0.5f, (minPosition.y + maxPosition.y) * 0.5f, (minPosition.z + maxPosition.z) * 0.5f };
+	quantization.PositionScale = { (maxPosition.x - minPosition.x) * 0.5f, (maxPosition.y - minPosition.y) * 0.5f, (maxPosition.z - minPosition.z) * 0.5f };
+	quantization.MaxAbsTexCoord = maxAbsTexCoord;
+
+	for (UINT i = 0; i < vertexCount; i++)
+	{
+		const VertexPos3Color4Tex2& src = pSrcVertexList[i];
+		VertexPackedPos3Color4Tex2& dest = pDestVertexList[i];
+
+		dest.Position[0] = QuantizeSnorm16(src.Position.x, quantization.PositionOffset.x, quantization.PositionScale.x);
+		dest.Position[1] = QuantizeSnorm16(src.Position.y, quantization.PositionOffset.y, quantization.PositionScale.y);
+		dest.Position[2] = QuantizeSnorm16(src.Position.z, quantization.PositionOffset.z, quantization.PositionScale.z);
+		dest.Position[3] = static_cast<INT16>(SnormMax);
+
+		dest.Color[0] = QuantizeUnorm8(src.Color.x);
+		dest.Color[1] = QuantizeUnorm8(src.Color.y);
+		dest.Color[2] = QuantizeUnorm8(src.Color.z);
+		dest.Color[3] = QuantizeUnorm8(src.Color.w);
+
+		dest.TexCoord[0] = PackedVector::XMConvertFloatToHalf(src.TexCoord.x);
+		dest.TexCoord[1] = PackedVector::XMConvertFloatToHalf(src.TexCoord.y);
+	}
+
+	*pOutQuantization = quantization;
+	return true;
+}
+
+VertexPos3Color4Tex2 DequantizeVertex(const VertexPackedPos3Color4Tex2& packedVertex, const VertexQuantization& quantization)
+{
+	// input assembler / QUANTIZED_VERTEX 셰이더와 같은 복원 (SNORM은 -32768도 -1로 처리)
+	auto DecodeSnorm16 = [](INT16 value) { return (std::max)(value / SnormMax, -1.0f); };
+
+	VertexPos3Color4Tex2 vertex = {};
+	vertex.Position.x = DecodeSnorm16(packedVertex.Position[0]) * quantization.PositionScale.x + quantization.PositionOffset.x;
+	vertex.Position.y = DecodeSnorm16(packedVertex.Position[1]) * quantization.PositionScale.y + quantization.PositionOffset.y;
+	vertex.Position.z = DecodeSnorm16(packedVertex.Position[2]) * quantization.PositionScale.z + quantization.PositionOffset.z;
+	vertex.Color = { packedVertex.Color[0] / UnormMax, packedVertex.Color[1] / UnormMax, packedVertex.Color[2] / UnormMax, packedVertex.Color[3] / UnormMax };
+	vertex.TexCoord = { PackedVector::XMConvertHalfToFloat(packedVertex.TexCoord[0]), PackedVector::XMConvertHalfToFloat(packedVertex.TexCoord[1]) };
+	return vertex;
+}
+
+VertexQuantizationError MeasureVertexQuantizationError(const VertexPos3Color4Tex2* pSrcVertexList, const VertexPackedPos3Color4Tex2* pPackedVertexList,
+	UINT vertexCount, const VertexQuantization& quantization)
+{
+	VertexQuantizationError error = {};
+	for (UINT i = 0; i < vertexCount; i++)
+	{
+		const VertexPos3Color4Tex2& src = pSrcVertexList[i];
+		const VertexPos3Color4Tex2 decoded = DequantizeVertex(pPackedVertexList[i], quantization);
+
+		error.Position = (std::max)({ error.Position,
+			fabsf(decoded.Position.x - src.Position.x), fabsf(decoded.Position.y - src.Position.y), fabsf(decoded.Position.z - src.Position.z) });
+		error.Color = (std::max)({ error.Color,
+			fabsf(decoded.Color.x - src.Color.x), fabsf(decoded.Color.y - src.Color.y), fabsf(decoded.Color.z - src.Color.z), fabsf(decoded.Color.w - src.Color.w) });
+		error.TexCoord = (std::max)({ error.TexCoord, fabsf(decoded.TexCoord.x - src.TexCoord.x), fabsf(decoded.TexCoord.y - src.TexCoord.y) });
+	}
+	return error;
+}
+
+VertexQuantizationError GetVertexQuantizationErrorBound(const VertexQuantization& quantization)
+{
+	const float maxScale = (std::max)({ quantization.PositionScale.x, quantization.PositionScale.y, quantization.PositionScale.z });
+	const float maxOffset = (std::max)({ fabsf(quantization.PositionOffset.x), fabsf(quantization.PositionOffset.y), fabsf(quantization.PositionOffset.z) });
+
+	// 반올림 오차 반 단계 + 복원 시 float 연산 오차 (값의 크기에 비례하는 몇 ulp)
+	VertexQuantizationError bound = {};
+	bound.Position = maxScale * (0.5f / SnormMax) + (maxScale + maxOffset) * 4.0f * FLT_EPSILON;
+	bound.Color = 0.5f / UnormMax + 4.0f * FLT_EPSILON;
+	// half 가수 10비트: 상대 오차 2^-11, 정규화 범위 밖(2^-14 미만)은 절대 오차 2^-25
+	bound.TexCoord = quantization.MaxAbsTexCoord * 0x1.0p-11f + 0x1.0p-25f;
+	return bound;
+}
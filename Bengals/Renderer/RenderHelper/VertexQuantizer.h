@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Types/typedef.h"
+
+/**
+ * CPU conversion of VertexPos3Color4Tex2 (36 bytes) into VertexPackedPos3Color4Tex2
+ * (16 bytes) at mesh creation.
+ *
+ * Position is stored as SNORM16 relative to the mesh's AABB: scale is the half extent
+ * and offset the center per axis, and DefaultShader's QUANTIZED_VERTEX variant restores
+ * it with the same pair; w is stored as 1. Color becomes RGBA8 UNORM (clamped to [0, 1])
+ * and the texture coordinate half floats, both decoded by the input assembler. Every
+ * value is rounded to nearest, so for in-range colors the per-component error stays
+ * within GetVertexQuantizationErrorBound(). No device access.
+ */
+
+struct VertexQuantization
+{
+	XMFLOAT3 PositionScale = { 1.0f, 1.0f, 1.0f };
+	XMFLOAT3 PositionOffset = {};
+	float MaxAbsTexCoord = 0.0f;		// 오차 한계 계산용
+};
+
+// 성분별 최대 절대 오차
+struct VertexQuantizationError
+{
+	float Position = 0.0f;
+	float Color = 0.0f;
+	float TexCoord = 0.0f;
+};
+
+bool QuantizeVertices(const VertexPos3Color4Tex2* pSrcVertexList, UINT vertexCount, VertexPackedPos3Color4Tex2* pDestVertexList, VertexQuantization* pOutQuantization);
+VertexPos3Color4Tex2 DequantizeVertex(const VertexPackedPos3Color4Tex2& packedVertex, const VertexQuantization& quantization);
+
+VertexQuantizationError MeasureVertexQuantizationError(const VertexPos3Color4Tex2* pSrcVertexList, const VertexPackedPos3Color4Tex2* pPackedVertexList,
+	UINT vertexCount, const VertexQuantization& quantization);
+VertexQuantizationError GetVertexQuantizationErrorBound(const VertexQuantization& quantization);
@@ -1,8 +1,10 @@
-#include "pch.h"
+﻿#include "pch.h"
 #include "BasicMeshObject.h"
 #include "../D3D12Renderer.h"
+#include <algorithm>
 #include <cassert>
-#include <d3dcompiler.h>
+#include <cmath>
+#include <cstring>
 #include <d3dx12.h>
 #include <span>
 #include "Types/typedef.h"
@@ -10,9 +12,15 @@
 #include "../RenderHelper/FrameGpuDescriptorAllocator.h"
 #include "../RenderHelper/ConstantBufferPool.h"
 #include "../Manager/CD3D12ResourceManager.h"
+#include "../RenderHelper/PipelineStateCache.h"
+#include "../RenderHelper/PipelineStateKey.h"
+#include "../RenderHelper/ShaderArchive.h"
+#include "../Backend/DrawCommandRecorder.h"
 
 ID3D12RootSignature* CBasicMeshObject::m_pRootSignature = nullptr;
 ID3D12PipelineState* CBasicMeshObject::m_pPipelineStateObject = nullptr;
+ID3D12PipelineState* CBasicMeshObject::m_pQuantizedPipelineStateObject = nullptr;
+UINT64 CBasicMeshObject::m_rootSignatureHash = 0;
 UINT CBasicMeshObject::m_initRefCount = 0;
 
 CBasicMeshObject::CBasicMeshObject(CD3D12Renderer* pRenderer)
@@ -49,13 +57,10 @@ bool CBasicMeshObject::Initialize(CD3D12Renderer* pRenderer)
 			return false;
 		}
 
-		if (!InitPipelineState())
+		if (!InitPipelineState(m_pRenderer))
 		{
-			if (m_pPipelineStateObject)
-			{
-				m_pPipelineStateObject->Release();
-				m_pPipelineStateObject = nullptr;
-			}
+			m_pPipelineStateObject = nullptr;
+			m_pQuantizedPipelineStateObject = nullptr;
 
 			if (m_pRootSignature)
 			{
@@ -122,39 +127,35 @@ bool CBasicMeshObject::InitRootSignature()
 		__debugbreak();
 		return bResult;
 	}
+	m_rootSignatureHash = CPipelineStateHasher::HashBytes(pSignature->GetBufferPointer(), pSignature->GetBufferSize());
 
 	return bResult = true;
 }
 
-bool CBasicMeshObject::InitPipelineState()
+bool CBasicMeshObject::InitPipelineState(CD3D12Renderer* pRenderer)
 {
 	bool bResult = false;
-	if (m_pRenderer == nullptr)
+	if (pRenderer == nullptr)
 	{
 		__debugbreak();
 		return bResult;
 	}
 
-	ID3D12Device5* pD3DDevice = m_pRenderer->GetD3DDevice();
+	ID3D12Device5* pD3DDevice = pRenderer->GetD3DDevice();
 	if (pD3DDevice == nullptr)
 	{
 		return bResult;
 	}
 
-	ComPtr<ID3DBlob> vertexShaderBlob = nullptr;
-	ComPtr<ID3DBlob> pixelShaderBlob = nullptr;
-
-#if defined(_DEBUG)
-	UINT compileFlags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
-#else
-	UINT compileFlags = 0;
-#endif
-	if (FAILED(D3DCompileFromFile(L"Renderer/Shaders/DefaultShader.hlsl", nullptr, nullptr, "VSMain", "vs_5_0", compileFlags, 0, vertexShaderBlob.ReleaseAndGetAddressOf(), nullptr)))
+	const CShaderArchive* pShaderArchive = pRenderer->GetShaderArchive();
+	D3D12_SHADER_BYTECODE vertexShader = {};
+	D3D12_SHADER_BYTECODE pixelShader = {};
+	if (!pShaderArchive->FindShader(EShaderProgram::Default, EShaderStage::Vertex, ShaderPermutationNone, &vertexShader))
 	{
 		__debugbreak();
 		return bResult;
 	}
-	if (FAILED(D3DCompileFromFile(L"Renderer/Shaders/DefaultShader.hlsl", nullptr, nullptr, "PSMain", "ps_5_0", compileFlags, 0, pixelShaderBlob.ReleaseAndGetAddressOf(), nullptr)))
+	if (!pShaderArchive->FindShader(EShaderProgram::Default, EShaderStage::Pixel, ShaderPermutationNone, &pixelShader))
 	{
 		__debugbreak();
 		return bResult;
@@ -170,8 +171,8 @@ bool CBasicMeshObject::InitPipelineState()
 	D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc = {};
 	psoDesc.InputLayout = { inputElementDescs, _countof(inputElementDescs) };
 	psoDesc.pRootSignature = m_pRootSignature;
-	psoDesc.VS = CD3DX12_SHADER_BYTECODE(vertexShaderBlob->GetBufferPointer(), vertexShaderBlob->GetBufferSize());
-	psoDesc.PS = CD3DX12_SHADER_BYTECODE(pixelShaderBlob->GetBufferPointer(), pixelShaderBlob->GetBufferSize());
+	psoDesc.VS = vertexShader;
+	psoDesc.PS = pixelShader;
 	psoDesc.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
 	psoDesc.RasterizerState.CullMode = D3D12_CULL_MODE_NONE;
 	psoDesc.BlendState = CD3DX12_BLEND_DESC(D3D12_DEFAULT);
@@ -186,7 +187,33 @@ bool CBasicMeshObject::InitPipelineState()
 	psoDesc.DSVFormat = DXGI_FORMAT_D32_FLOAT;
 	psoDesc.SampleDesc.Count = 1;
 
-	if (FAILED(pD3DDevice->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&m_pPipelineStateObject))))
+	// PSO는 렌더러 공용 캐시가 소유 (CleanSharedResource에서 Release하지 않는다)
+	m_pPipelineStateObject = pRenderer->GetPipelineStateCache()->GetGraphicsPipelineState(psoDesc, m_rootSignatureHash);
+	if (!m_pPipelineStateObject)
+	{
+		__debugbreak();
+		return bResult;
+	}
+
+	// 양자화 정점: 같은 PSO에 VS permutation과 input layout만 다르다
+	D3D12_SHADER_BYTECODE quantizedVertexShader = {};
+	if (!pShaderArchive->FindShader(EShaderProgram::Default, EShaderStage::Vertex, ShaderPermutationQuantizedVertex, &quantizedVertexShader))
+	{
+		__debugbreak();
+		return bResult;
+	}
+
+	D3D12_INPUT_ELEMENT_DESC quantizedInputElementDescs[] =
+	{
+		{ "POSITION", 0, DXGI_FORMAT_R16G16B16A16_SNORM, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+		{ "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, 8, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+		{ "TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
+	};
+	psoDesc.InputLayout = { quantizedInputElementDescs, _countof(quantizedInputElementDescs) };
+	psoDesc.VS = quantizedVertexShader;
+
+	m_pQuantizedPipelineStateObject = pRenderer->GetPipelineStateCache()->GetGraphicsPipelineState(psoDesc, m_rootSignatureHash);
+	if (!m_pQuantizedPipelineStateObject)
 	{
 		__debugbreak();
 		return bResult;
@@ -195,23 +222,43 @@ bool CBasicMeshObject::InitPipelineState()
 	return bResult = true;
 }
 
-bool CBasicMeshObject::BeginCreateMesh(const void* pVertexList, UINT vertexCount, UINT vertexSize, UINT triGroupCount)
+bool CBasicMeshObject::ReloadPipelineState(CD3D12Renderer* pRenderer)
 {
-	CD3D12ResourceManager* pResourceManager = m_pRenderer->GetResourceManager();
+	// 살아 있는 객체가 없으면 다음 Initialize가 새 아카이브로 만든다
+	if (m_initRefCount == 0)
+	{
+		return true;
+	}
 
-	if (triGroupCount > MaxTriGroupCountPerObj)
+	// 이전 PSO는 캐시가 계속 소유하므로 이미 기록된 프레임은 그대로 실행된다
+	ID3D12PipelineState* pPrevPipelineState = m_pPipelineStateObject;
+	ID3D12PipelineState* pPrevQuantizedPipelineState = m_pQuantizedPipelineStateObject;
+	if (!InitPipelineState(pRenderer))
 	{
-		__debugbreak();
+		m_pPipelineStateObject = pPrevPipelineState;
+		m_pQuantizedPipelineStateObject = pPrevQuantizedPipelineState;
 		return false;
 	}
+	return true;
+}
 
-	HRESULT hr = pResourceManager->CreateVertexBuffer(vertexSize, vertexCount, &m_vertexBufferView, m_vertexBuffer.ReleaseAndGetAddressOf(), pVertexList);
-	if (FAILED(hr))
+bool CBasicMeshObject::BeginCreateMesh(const void* pVertexList, UINT vertexCount, UINT vertexSize, UINT triGroupCount, UINT optimizeFlags, UINT maxLodCount)
+{
+	if (triGroupCount > MaxTriGroupCountPerObj || !pVertexList || vertexCount == 0 || vertexSize == 0 || maxLodCount == 0 || maxLodCount > MaxMeshLodCount)
 	{
 		__debugbreak();
 		return false;
 	}
 
+	// 최적화에는 모든 tri group의 인덱스가 필요하므로 업로드는 EndCreateMesh에서
+	const BYTE* pVertexData = static_cast<const BYTE*>(pVertexList);
+	m_pendingVertexData.assign(pVertexData, pVertexData + static_cast<size_t>(vertexCount) * vertexSize);
+	m_pendingVertexSize = vertexSize;
+	m_pendingIndexList.clear();
+	m_pendingGroupIndexCountList.clear();
+	m_optimizeFlags = optimizeFlags;
+	m_maxLodCount = maxLodCount;
+
 	m_triGroupList = std::make_unique<IndexedTriGroup[]>(triGroupCount);
 	m_maxTriGroupCount = triGroupCount;
 	m_triGroupCount = 0;
@@ -221,24 +268,32 @@ bool CBasicMeshObject::BeginCreateMesh(const void* pVertexList, UINT vertexCount
 
 bool CBasicMeshObject::InsertIndexedTriList(const WORD* pIndexList, UINT triCount, const WCHAR* texFileName)
 {
-	if (m_triGroupCount >= m_maxTriGroupCount)
+	return InsertIndexedTriListImpl(pIndexList, triCount, texFileName);
+}
+
+bool CBasicMeshObject::InsertIndexedTriList(const UINT* pIndexList, UINT triCount, const WCHAR* texFileName)
+{
+	return InsertIndexedTriListImpl(pIndexList, triCount, texFileName);
+}
+
+template <typename TIndex>
+bool CBasicMeshObject::InsertIndexedTriListImpl(const TIndex* pIndexList, UINT triCount, const WCHAR* texFileName)
+{
+	if (m_triGroupCount >= m_maxTriGroupCount || m_pendingVertexData.empty() || !pIndexList || triCount == 0)
 	{
 		__debugbreak();
 		return false;
 	}
 
-	CD3D12ResourceManager* pResourceManager = m_pRenderer->GetResourceManager();
-
-	IndexedTriGroup& triGroup = m_triGroupList[m_triGroupCount];
-
 	UINT indexCount = triCount * 3;
-	HRESULT hr = pResourceManager->CreateIndexBuffer(indexCount, &triGroup.IndexBufferView, triGroup.IndexBuffer.ReleaseAndGetAddressOf(), pIndexList);
-	if (FAILED(hr))
+	const UINT vertexCount = static_cast<UINT>(m_pendingVertexData.size() / m_pendingVertexSize);
+	if (static_cast<UINT>(*std::max_element(pIndexList, pIndexList + indexCount)) >= vertexCount)
 	{
 		__debugbreak();
 		return false;
 	}
-	triGroup.TriangleCount = triCount;
+
+	IndexedTriGroup& triGroup = m_triGroupList[m_triGroupCount];
 
 	triGroup.pTexHandle = (TextureHandle*)m_pRenderer->CreateTextureFromFile(texFileName);
 	if (triGroup.pTexHandle == nullptr)
@@ -247,18 +302,213 @@ bool CBasicMeshObject::InsertIndexedTriList(const WORD* pIndexList, UINT triCoun
 		return false;
 	}
 
+	m_pendingIndexList.insert(m_pendingIndexList.end(), pIndexList, pIndexList + indexCount);
+	m_pendingGroupIndexCountList.push_back(indexCount);
+
 	m_triGroupCount++;
 	return true;
 }
 
-void CBasicMeshObject::EndCreateMesh()
+bool CBasicMeshObject::EndCreateMesh()
 {
-	
+	if (m_pendingVertexData.empty() || m_triGroupCount != m_maxTriGroupCount)
+	{
+		__debugbreak();
+		return false;
+	}
+
+	// MeshOptimizeNone이어도 ACMR / ATVR은 기록된다
+	if (!OptimizeMesh(&m_pendingVertexData, m_pendingVertexSize, &m_pendingIndexList, m_pendingGroupIndexCountList, m_optimizeFlags, &m_optimizeStats))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	const UINT vertexCount = static_cast<UINT>(m_pendingVertexData.size() / m_pendingVertexSize);
+
+	// LOD는 LOD 0과 같은 정점 버퍼를 쓰고 인덱스만 줄인다 (위치가 없는 정점 형식이면 LOD 0만)
+	std::vector<MeshLodLevel> lodList;
+	const UINT maxLodCount = (m_pendingVertexSize >= sizeof(XMFLOAT3)) ? m_maxLodCount : 1;
+	if (!BuildMeshLodChain(m_pendingVertexData.data(), vertexCount, m_pendingVertexSize, m_pendingIndexList, m_pendingGroupIndexCountList, maxLodCount, m_optimizeFlags, &lodList))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	m_lodCount = static_cast<UINT>(lodList.size());
+	for (UINT lod = 0; lod < m_lodCount; lod++)
+	{
+		m_lodErrorList[lod] = lodList[lod].Error;
+	}
+	ComputeBounds(vertexCount);
+
+	// 최적화와 LOD는 float 위치가 필요하므로 양자화는 업로드 직전에
+	m_bQuantized = false;
+	m_vertexQuantization = {};
+	std::vector<VertexPackedPos3Color4Tex2> packedVertexList;
+	const void* pUploadVertexData = m_pendingVertexData.data();
+	UINT uploadVertexSize = m_pendingVertexSize;
+	if (m_optimizeFlags & MeshOptimizeQuantize)
+	{
+		if (m_pendingVertexSize != sizeof(VertexPos3Color4Tex2))
+		{
+			__debugbreak();
+			return false;
+		}
+
+		packedVertexList.resize(vertexCount);
+		if (!QuantizeVertices(reinterpret_cast<const VertexPos3Color4Tex2*>(m_pendingVertexData.data()), vertexCount, packedVertexList.data(), &m_vertexQuantization))
+		{
+			__debugbreak();
+			return false;
+		}
+
+		pUploadVertexData = packedVertexList.data();
+		uploadVertexSize = sizeof(VertexPackedPos3Color4Tex2);
+		m_bQuantized = true;
+	}
+
+	CD3D12ResourceManager* pResourceManager = m_pRenderer->GetResourceManager();
+
+	HRESULT hr = pResourceManager->CreateVertexBuffer(uploadVertexSize, vertexCount, &m_vertexBufferView, m_vertexBuffer.ReleaseAndGetAddressOf(), pUploadVertexData);
+	if (FAILED(hr))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	// lodIndexOffsetList[lod]: LOD 인덱스 리스트 안에서 i번째 tri group의 시작
+	UINT lodIndexOffsetList[MaxMeshLodCount] = {};
+	for (UINT i = 0; i < m_triGroupCount; i++)
+	{
+		if (!CreateTriGroupIndexBuffer(&m_triGroupList[i], lodList, lodIndexOffsetList, i))
+		{
+			return false;
+		}
+
+		for (UINT lod = 0; lod < m_lodCount; lod++)
+		{
+			lodIndexOffsetList[lod] += lodList[lod].GroupIndexCountList[i];
+		}
+	}
+
+	std::vector<BYTE>().swap(m_pendingVertexData);
+	std::vector<UINT>().swap(m_pendingIndexList);
+	std::vector<UINT>().swap(m_pendingGroupIndexCountList);
+	return true;
+}
+
+bool CBasicMeshObject::CreateTriGroupIndexBuffer(IndexedTriGroup* pTriGroup, const std::vector<MeshLodLevel>& lodList, const UINT* pLodIndexOffsetList, UINT groupIndex)
+{
+	// LOD 0 ~ N-1 인덱스를 이어 붙여 버퍼 하나로 올리고, LOD별 view는 오프셋으로 나눈다
+	// 모든 LOD가 16비트 cluster로 나뉘면 R16, 하나라도 안 되면 tri group 전체를 R32로
+	std::vector<WORD> index16List;
+	std::vector<UINT> index32List;
+	std::vector<WORD> lodIndex16List;
+	UINT lodIndexOffsetInGroup[MaxMeshLodCount] = {};
+	bool bIndex16 = true;
+	for (UINT lod = 0; lod < m_lodCount && bIndex16; lod++)
+	{
+		const MeshLodLevel& level = lodList[lod];
+		const UINT indexCount = level.GroupIndexCountList[groupIndex];
+		const UINT* pGroupIndexList = level.IndexList.data() + pLodIndexOffsetList[lod];
+
+		lodIndexOffsetInGroup[lod] = static_cast<UINT>(index16List.size());
+		bIndex16 = BuildIndexClusters16(pGroupIndexList, indexCount, MaxIndexClusterCount, &lodIndex16List, &pTriGroup->ClusterLists[lod]);
+		index16List.insert(index16List.end(), lodIndex16List.begin(), lodIndex16List.end());
+		pTriGroup->TriangleCounts[lod] = indexCount / 3;
+	}
+
+	if (!bIndex16)
+	{
+		for (UINT lod = 0; lod < m_lodCount; lod++)
+		{
+			const MeshLodLevel& level = lodList[lod];
+			const UINT indexCount = level.GroupIndexCountList[groupIndex];
+			const UINT* pGroupIndexList = level.IndexList.data() + pLodIndexOffsetList[lod];
+
+			lodIndexOffsetInGroup[lod] = static_cast<UINT>(index32List.size());
+			index32List.insert(index32List.end(), pGroupIndexList, pGroupIndexList + indexCount);
+			pTriGroup->ClusterLists[lod].assign(1, IndexedTriCluster{ 0, indexCount, 0 });
+			pTriGroup->TriangleCounts[lod] = indexCount / 3;
+		}
+	}
+
+	const DXGI_FORMAT indexFormat = bIndex16 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+	const UINT indexSize = bIndex16 ? sizeof(WORD) : sizeof(UINT);
+	const UINT indexCount = static_cast<UINT>(bIndex16 ? index16List.size() : index32List.size());
+	const void* pIndexData = bIndex16 ? static_cast<const void*>(index16List.data()) : static_cast<const void*>(index32List.data());
+
+	D3D12_INDEX_BUFFER_VIEW indexBufferView = {};
+	HRESULT hr = m_pRenderer->GetResourceManager()->CreateIndexBuffer(indexCount, &indexBufferView, pTriGroup->IndexBuffer.ReleaseAndGetAddressOf(), pIndexData, indexFormat);
+	if (FAILED(hr))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	for (UINT lod = 0; lod < m_lodCount; lod++)
+	{
+		D3D12_INDEX_BUFFER_VIEW& lodView = pTriGroup->IndexBufferViews[lod];
+		lodView.BufferLocation = indexBufferView.BufferLocation + static_cast<UINT64>(lodIndexOffsetInGroup[lod]) * indexSize;
+		lodView.Format = indexFormat;
+		lodView.SizeInBytes = pTriGroup->TriangleCounts[lod] * 3 * indexSize;
+	}
+	return true;
+}
+
+void CBasicMeshObject::ComputeBounds(UINT vertexCount)
+{
+	m_boundsCenter = {};
+	m_boundsRadius = 0.0f;
+	if (m_pendingVertexSize < sizeof(XMFLOAT3) || vertexCount == 0)
+	{
+		return;
+	}
+
+	auto LoadPosition = [this](UINT vertexIndex)
+		{
+			XMFLOAT3 position = {};
+			memcpy(&position, m_pendingVertexData.data() + static_cast<size_t>(vertexIndex) * m_pendingVertexSize, sizeof(position));
+			return position;
+		};
+
+	XMFLOAT3 minPosition = LoadPosition(0);
+	XMFLOAT3 maxPosition = minPosition;
+	for (UINT i = 1; i < vertexCount; i++)
+	{
+		const XMFLOAT3 position = LoadPosition(i);
+		minPosition = { (std::min)(minPosition.x, position.x), (std::min)(minPosition.y, position.y), (std::min)(minPosition.z, position.z) };
+		maxPosition = { (std::max)(maxPosition.x, position.x), (std::max)(maxPosition.y, position.y), (std::max)(maxPosition.z, position.z) };
+	}
+
+	m_boundsCenter = { (minPosition.x + maxPosition.x) * 0.5f, (minPosition.y + maxPosition.y) * 0.5f, (minPosition.z + maxPosition.z) * 0.5f };
+	float maxDistanceSq = 0.0f;
+	for (UINT i = 0; i < vertexCount; i++)
+	{
+		const XMFLOAT3 position = LoadPosition(i);
+		const float dx = position.x - m_boundsCenter.x;
+		const float dy = position.y - m_boundsCenter.y;
+		const float dz = position.z - m_boundsCenter.z;
+		maxDistanceSq = (std::max)(maxDistanceSq, dx * dx + dy * dy + dz * dz);
+	}
+	m_boundsRadius = sqrtf(maxDistanceSq);
 }
 
-void CBasicMeshObject::Draw(ID3D12GraphicsCommandList* pCommandList, DWORD renderThreadIndex, const XMMATRIX& worldMatrix)
+UINT CBasicMeshObject::SelectLod(const XMMATRIX& worldMatrix, const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix, float viewportHeight, float maxPixelError) const
 {
-	if (pCommandList == nullptr || m_pRenderer == nullptr || m_triGroupCount == 0)
+	if (m_lodCount <= 1)
+	{
+		return 0;
+	}
+
+	const float pixelsPerUnit = ComputeMeshLodPixelsPerUnit(worldMatrix, viewMatrix, projMatrix, viewportHeight, m_boundsCenter, m_boundsRadius);
+	return SelectMeshLod(m_lodErrorList, m_lodCount, pixelsPerUnit, maxPixelError);
+}
+
+void CBasicMeshObject::Draw(ID3D12GraphicsCommandList* pCommandList, DWORD renderThreadIndex, const XMMATRIX& worldMatrix, UINT lodIndex)
+{
+	if (pCommandList == nullptr || m_pRenderer == nullptr || m_triGroupCount == 0 || lodIndex >= m_lodCount)
 	{
 		__debugbreak();
 		return;
@@ -304,6 +554,10 @@ void CBasicMeshObject::Draw(ID3D12GraphicsCommandList* pCommandList, DWORD rende
 	pConstantBufferDefault->WorldMatrix = XMMatrixTranspose(worldMatrix);
 	pConstantBufferDefault->ViewMatrix = XMMatrixTranspose(viewMatrix);
 	pConstantBufferDefault->ProjectionMatrix = XMMatrixTranspose(projectionMatrix);
+	const XMFLOAT3& positionScale = m_vertexQuantization.PositionScale;
+	const XMFLOAT3& positionOffset = m_vertexQuantization.PositionOffset;
+	pConstantBufferDefault->PositionScale = { positionScale.x, positionScale.y, positionScale.z, 1.0f };
+	pConstantBufferDefault->PositionOffset = { positionOffset.x, positionOffset.y, positionOffset.z, 0.0f };
 
 	CD3DX12_CPU_DESCRIPTOR_HANDLE destHandle(cpuBaseDescriptorHandle, 0, descriptorSize);
 	pD3DDevice->CopyDescriptorsSimple(1, destHandle, pCB->CbvDescriptorHandle, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
@@ -315,23 +569,21 @@ void CBasicMeshObject::Draw(ID3D12GraphicsCommandList* pCommandList, DWORD rende
 		destHandle.Offset(1, descriptorSize);
 	}
 
-	pCommandList->SetGraphicsRootSignature(m_pRootSignature);
-	pCommandList->SetDescriptorHeaps(1, &pDescriptorHeap);
-	pCommandList->SetPipelineState(m_pPipelineStateObject);
-	pCommandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	pCommandList->IASetVertexBuffers(0, 1, &m_vertexBufferView);
-
-	pCommandList->SetGraphicsRootDescriptorTable(0, gpuBaseDescriptorHandle);
+	MeshDrawState drawState = {};
+	drawState.pRootSignature = m_pRootSignature;
+	drawState.pPipelineState = m_bQuantized ? m_pQuantizedPipelineStateObject : m_pPipelineStateObject;
+	drawState.pDescriptorHeap = pDescriptorHeap;
+	drawState.pVertexBufferView = &m_vertexBufferView;
+	drawState.GpuBaseDescriptorHandle = gpuBaseDescriptorHandle;
+	RecordMeshDrawSetup(pCommandList, drawState);
 
 	CD3DX12_GPU_DESCRIPTOR_HANDLE gpuSrvHandle(gpuBaseDescriptorHandle, DescriptorCountPerObj, descriptorSize);
 	for (UINT i = 0; i < m_triGroupCount; i++)
 	{
-		pCommandList->SetGraphicsRootDescriptorTable(1, gpuSrvHandle);
-		gpuSrvHandle.Offset(1, descriptorSize);
-
 		IndexedTriGroup& triGroup = m_triGroupList[i];
-		pCommandList->IASetIndexBuffer(&triGroup.IndexBufferView);
-		pCommandList->DrawIndexedInstanced(triGroup.TriangleCount * 3, 1, 0, 0, 0);
+		const std::vector<IndexedTriCluster>& clusterList = triGroup.ClusterLists[lodIndex];
+		RecordTriGroupDraw(pCommandList, gpuSrvHandle, &triGroup.IndexBufferViews[lodIndex], clusterList.data(), static_cast<UINT>(clusterList.size()));
+		gpuSrvHandle.Offset(1, descriptorSize);
 	}
 }
 
@@ -361,11 +613,8 @@ void CBasicMeshObject::CleanSharedResource()
 			m_pRootSignature = nullptr;
 		}
 
-		if (m_pPipelineStateObject)
-		{
-			m_pPipelineStateObject->Release();
-			m_pPipelineStateObject = nullptr;
-		}
+		m_pPipelineStateObject = nullptr;
+		m_pQuantizedPipelineStateObject = nullptr;
 	}
 }
 
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <vector>
+#include "../RenderHelper/MeshOptimizer.h"
+#include "../RenderHelper/MeshLod.h"
+#include "../RenderHelper/VertexQuantizer.h"
+
 struct IndexedTriGroup;
 class CD3D12Renderer;
 class CRenderQueue;
@@ -8,6 +13,7 @@ class CBasicMeshObject
 {
 	friend class CD3D12Renderer;
 	friend class CRenderQueue;
+	friend class CStaticMeshGroup;
 
 public:/*function*/
 	CBasicMeshObject() = delete;
@@ -18,13 +24,22 @@ public:/*function*/
 
 private: /*function*/
 	bool InitRootSignature();
-	bool InitPipelineState();
+	static bool InitPipelineState(CD3D12Renderer* pRenderer);
+	// 셰이더 아카이브가 바뀐 뒤 렌더러가 프레임 시작에서 호출. 실패하면 이전 PSO를 유지
+	static bool ReloadPipelineState(CD3D12Renderer* pRenderer);
 
-	bool BeginCreateMesh(const void* pVertexList, UINT vertexCount, UINT vertexSize, UINT triGroupCount);
+	// 정점 / 인덱스는 EndCreateMesh에서 optimizeFlags로 최적화하고 LOD를 만든 뒤 업로드
+	bool BeginCreateMesh(const void* pVertexList, UINT vertexCount, UINT vertexSize, UINT triGroupCount, UINT optimizeFlags, UINT maxLodCount);
 	bool InsertIndexedTriList(const WORD* pIndexList, UINT triCount, const WCHAR* texFileName);
-	void EndCreateMesh();
+	bool InsertIndexedTriList(const UINT* pIndexList, UINT triCount, const WCHAR* texFileName);
+	template <typename TIndex>
+	bool InsertIndexedTriListImpl(const TIndex* pIndexList, UINT triCount, const WCHAR* texFileName);
+	bool EndCreateMesh();
+	bool CreateTriGroupIndexBuffer(IndexedTriGroup* pTriGroup, const std::vector<MeshLodLevel>& lodList, const UINT* pLodIndexOffsetList, UINT groupIndex);
+	void ComputeBounds(UINT vertexCount);
 
-	void Draw(ID3D12GraphicsCommandList* pCommandList, DWORD renderThreadIndex, const XMMATRIX& worldMatrix);
+	UINT SelectLod(const XMMATRIX& worldMatrix, const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix, float viewportHeight, float maxPixelError) const;
+	void Draw(ID3D12GraphicsCommandList* pCommandList, DWORD renderThreadIndex, const XMMATRIX& worldMatrix, UINT lodIndex);
 
 	void Clean();
 	void CleanSharedResource();
@@ -38,6 +53,8 @@ private: /*variable*/
 
 	static ID3D12RootSignature* m_pRootSignature;
 	static ID3D12PipelineState* m_pPipelineStateObject;
+	static ID3D12PipelineState* m_pQuantizedPipelineStateObject;		// VertexPackedPos3Color4Tex2
+	static UINT64 m_rootSignatureHash;
 	static UINT m_initRefCount;
 
 	CD3D12Renderer* m_pRenderer = nullptr;
@@ -48,4 +65,22 @@ private: /*variable*/
 	std::unique_ptr<IndexedTriGroup[]> m_triGroupList;
 	UINT m_maxTriGroupCount = 0;
 	UINT m_triGroupCount = 0;
+
+	UINT m_lodCount = 1;
+	float m_lodErrorList[MaxMeshLodCount] = {};
+	XMFLOAT3 m_boundsCenter = {};
+	float m_boundsRadius = 0.0f;
+
+	// MeshOptimizeQuantize: 정점 버퍼가 VertexPackedPos3Color4Tex2
+	bool m_bQuantized = false;
+	VertexQuantization m_vertexQuantization = {};
+
+	// BeginCreateMesh ~ EndCreateMesh 사이에만 사용
+	std::vector<BYTE> m_pendingVertexData;
+	std::vector<UINT> m_pendingIndexList;
+	std::vector<UINT> m_pendingGroupIndexCountList;
+	UINT m_pendingVertexSize = 0;
+	UINT m_optimizeFlags = MeshOptimizeNone;
+	UINT m_maxLodCount = 1;
+	MeshOptimizeStats m_optimizeStats = {};
 };
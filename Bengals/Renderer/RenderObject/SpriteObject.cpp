@@ -1,16 +1,20 @@
 #include "pch.h"
 #include "SpriteObject.h"
 #include "../D3D12Renderer.h"
-#include <d3dcompiler.h>
 #include <d3dx12.h>
 #include "Types/typedef.h"
 #include "../../../Util/D3DUtil.h"
 #include "../RenderHelper/FrameGpuDescriptorAllocator.h"
 #include "../RenderHelper/ConstantBufferPool.h"
 #include "../Manager/CD3D12ResourceManager.h"
+#include "../RenderHelper/PipelineStateCache.h"
+#include "../RenderHelper/PipelineStateKey.h"
+#include "../RenderHelper/ShaderArchive.h"
+#include "../Backend/DrawCommandRecorder.h"
 
 ID3D12RootSignature* CSpriteObject::m_pRootSignature = nullptr;
 ID3D12PipelineState* CSpriteObject::m_pPipelineStateObject = nullptr;
+UINT64 CSpriteObject::m_rootSignatureHash = 0;
 ID3D12Resource* CSpriteObject::m_pVertexBuffer = nullptr;
 D3D12_VERTEX_BUFFER_VIEW CSpriteObject::m_vertexBufferView = {};
 ID3D12Resource* CSpriteObject::m_pIndexBuffer = nullptr;
@@ -56,7 +60,7 @@ bool CSpriteObject::Initialize(CD3D12Renderer* pRenderer)
 		{
 			return false;
 		}
-		if (!InitPipelineState())
+		if (!InitPipelineState(m_pRenderer))
 		{
 			return false;
 		}
@@ -159,38 +163,33 @@ bool CSpriteObject::InitRootSignature()
 		__debugbreak();
 		return false;
 	}
+	m_rootSignatureHash = CPipelineStateHasher::HashBytes(pSignature->GetBufferPointer(), pSignature->GetBufferSize());
 
 	return true;
 }
 
-bool CSpriteObject::InitPipelineState()
+bool CSpriteObject::InitPipelineState(CD3D12Renderer* pRenderer)
 {
-	if (!m_pRenderer)
+	if (!pRenderer)
 	{
 		return false;
 	}
 
-	ID3D12Device5* pD3DDevice = m_pRenderer->GetD3DDevice();
+	ID3D12Device5* pD3DDevice = pRenderer->GetD3DDevice();
 	if (!pD3DDevice)
 	{
 		return false;
 	}
 
-	ComPtr<ID3DBlob> vertexShaderBlob = nullptr;
-	ComPtr<ID3DBlob> pixelShaderBlob = nullptr;
-
-#if defined(_DEBUG)
-	UINT compileFlags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
-#else
-	UINT compileFlags = 0;
-#endif
-
-	if (FAILED(D3DCompileFromFile(L"Renderer/Shaders/SpriteShader.hlsl", nullptr, nullptr, "VSMain", "vs_5_0", compileFlags, 0, vertexShaderBlob.ReleaseAndGetAddressOf(), nullptr)))
+	const CShaderArchive* pShaderArchive = pRenderer->GetShaderArchive();
+	D3D12_SHADER_BYTECODE vertexShader = {};
+	D3D12_SHADER_BYTECODE pixelShader = {};
+	if (!pShaderArchive->FindShader(EShaderProgram::Sprite, EShaderStage::Vertex, ShaderPermutationNone, &vertexShader))
 	{
 		__debugbreak();
 		return false;
 	}
-	if (FAILED(D3DCompileFromFile(L"Renderer/Shaders/SpriteShader.hlsl", nullptr, nullptr, "PSMain", "ps_5_0", compileFlags, 0, pixelShaderBlob.ReleaseAndGetAddressOf(), nullptr)))
+	if (!pShaderArchive->FindShader(EShaderProgram::Sprite, EShaderStage::Pixel, ShaderPermutationNone, &pixelShader))
 	{
 		__debugbreak();
 		return false;
@@ -206,8 +205,8 @@ bool CSpriteObject::InitPipelineState()
 	D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc = {};
 	psoDesc.InputLayout = { inputElementDescs, _countof(inputElementDescs) };
 	psoDesc.pRootSignature = m_pRootSignature;
-	psoDesc.VS = CD3DX12_SHADER_BYTECODE(vertexShaderBlob->GetBufferPointer(), vertexShaderBlob->GetBufferSize());
-	psoDesc.PS = CD3DX12_SHADER_BYTECODE(pixelShaderBlob->GetBufferPointer(), pixelShaderBlob->GetBufferSize());
+	psoDesc.VS = vertexShader;
+	psoDesc.PS = pixelShader;
 	psoDesc.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
 	psoDesc.RasterizerState.CullMode = D3D12_CULL_MODE_NONE;
 	psoDesc.BlendState = CD3DX12_BLEND_DESC(D3D12_DEFAULT);
@@ -222,7 +221,9 @@ bool CSpriteObject::InitPipelineState()
 	psoDesc.DSVFormat = DXGI_FORMAT_D32_FLOAT;
 	psoDesc.SampleDesc.Count = 1;
 
-	if (FAILED(pD3DDevice->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&m_pPipelineStateObject))))
+	// PSO는 렌더러 공용 캐시가 소유 (CleanSharedResource에서 Release하지 않는다)
+	m_pPipelineStateObject = pRenderer->GetPipelineStateCache()->GetGraphicsPipelineState(psoDesc, m_rootSignatureHash);
+	if (!m_pPipelineStateObject)
 	{
 		__debugbreak();
 		return false;
@@ -231,6 +232,24 @@ bool CSpriteObject::InitPipelineState()
 	return true;
 }
 
+bool CSpriteObject::ReloadPipelineState(CD3D12Renderer* pRenderer)
+{
+	// 살아 있는 객체가 없으면 다음 Initialize가 새 아카이브로 만든다
+	if (m_initRefCount == 0)
+	{
+		return true;
+	}
+
+	// 이전 PSO는 캐시가 계속 소유하므로 이미 기록된 프레임은 그대로 실행된다
+	ID3D12PipelineState* pPrevPipelineState = m_pPipelineStateObject;
+	if (!InitPipelineState(pRenderer))
+	{
+		m_pPipelineStateObject = pPrevPipelineState;
+		return false;
+	}
+	return true;
+}
+
 bool CSpriteObject::InitSharedBuffers()
 {
 	if (!m_pRenderer)
@@ -373,14 +392,14 @@ void CSpriteObject::DrawWithTex(ID3D12GraphicsCommandList* pCommandList, DWORD r
 	destHandle.Offset(1, descriptorSize);
 	pD3DDevice->CopyDescriptorsSimple(1, destHandle, pTexHandle->SrvDescriptorHandle, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
-	pCommandList->SetGraphicsRootSignature(m_pRootSignature);
-	pCommandList->SetDescriptorHeaps(1, &pDescriptorHeap);
-	pCommandList->SetPipelineState(m_pPipelineStateObject);
-	pCommandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	pCommandList->IASetVertexBuffers(0, 1, &m_vertexBufferView);
-	pCommandList->IASetIndexBuffer(&m_indexBufferView);
-	pCommandList->SetGraphicsRootDescriptorTable(0, gpuBaseDescriptorHandle);
-	pCommandList->DrawIndexedInstanced(6, 1, 0, 0, 0);
+	SpriteDrawState drawState = {};
+	drawState.pRootSignature = m_pRootSignature;
+	drawState.pPipelineState = m_pPipelineStateObject;
+	drawState.pDescriptorHeap = pDescriptorHeap;
+	drawState.pVertexBufferView = &m_vertexBufferView;
+	drawState.pIndexBufferView = &m_indexBufferView;
+	drawState.GpuBaseDescriptorHandle = gpuBaseDescriptorHandle;
+	RecordSpriteDraw(pCommandList, drawState);
 }
 
 void CSpriteObject::Draw(
@@ -445,11 +464,7 @@ void CSpriteObject::CleanSharedResource()
 			m_pRootSignature = nullptr;
 		}
 
-		if (m_pPipelineStateObject)
-		{
-			m_pPipelineStateObject->Release();
-			m_pPipelineStateObject = nullptr;
-		}
+		m_pPipelineStateObject = nullptr;
 
 		if (m_pVertexBuffer)
 		{
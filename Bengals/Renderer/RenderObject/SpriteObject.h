@@ -36,7 +36,9 @@ public: /*function*/
 
 private: /*function*/
 	bool InitRootSignature();
-	bool InitPipelineState();
+	static bool InitPipelineState(CD3D12Renderer* pRenderer);
+	// 셰이더 아카이브가 바뀐 뒤 렌더러가 프레임 시작에서 호출. 실패하면 이전 PSO를 유지
+	static bool ReloadPipelineState(CD3D12Renderer* pRenderer);
 	bool InitSharedBuffers();
 
 	void Clean();
@@ -54,6 +56,7 @@ private: /*variable*/
 
 	static ID3D12RootSignature* m_pRootSignature;
 	static ID3D12PipelineState* m_pPipelineStateObject;
+	static UINT64 m_rootSignatureHash;
 	static ID3D12Resource* m_pVertexBuffer;
 	static D3D12_VERTEX_BUFFER_VIEW m_vertexBufferView;
 	static ID3D12Resource* m_pIndexBuffer;
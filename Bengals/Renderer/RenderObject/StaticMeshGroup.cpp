@@ -0,0 +1,650 @@
+#include "pch.h"
+#include "StaticMeshGroup.h"
+#include "BasicMeshObject.h"
+#include "../D3D12Renderer.h"
+#include <algorithm>
+#include <d3dx12.h>
+#include <numeric>
+#include "Types/typedef.h"
+#include "../RenderHelper/ConstantBufferPool.h"
+#include "../RenderHelper/GpuMemoryTag.h"
+#include "../RenderHelper/ResourceStateTracker.h"
+#include "../RenderHelper/PipelineStateCache.h"
+#include "../RenderHelper/PipelineStateKey.h"
+#include "../RenderHelper/ShaderArchive.h"
+#include "../Backend/DrawCommandRecorder.h"
+
+ID3D12RootSignature* CStaticMeshGroup::m_pRootSignature = nullptr;
+ID3D12PipelineState* CStaticMeshGroup::m_pPipelineStateObject = nullptr;
+ID3D12PipelineState* CStaticMeshGroup::m_pQuantizedPipelineStateObject = nullptr;
+UINT64 CStaticMeshGroup::m_rootSignatureHash = 0;
+UINT CStaticMeshGroup::m_initRefCount = 0;
+
+CStaticMeshGroup::CStaticMeshGroup(CD3D12Renderer* pRenderer, UINT maxInstanceCount)
+{
+	Initialize(pRenderer, maxInstanceCount);
+}
+
+CStaticMeshGroup::~CStaticMeshGroup()
+{
+	Clean();
+}
+
+bool CStaticMeshGroup::Initialize(CD3D12Renderer* pRenderer, UINT maxInstanceCount)
+{
+	if (!pRenderer || maxInstanceCount == 0 || pRenderer->GetFrameContextCount() > MaxFrameContextCount)
+	{
+		__debugbreak();
+		return false;
+	}
+
+	m_pRenderer = pRenderer;
+
+	if (m_initRefCount <= 0)
+	{
+		if (!InitRootSignature())
+		{
+			if (m_pRootSignature)
+			{
+				m_pRootSignature->Release();
+				m_pRootSignature = nullptr;
+			}
+
+			m_pRenderer = nullptr;
+			return false;
+		}
+
+		if (!InitPipelineState(m_pRenderer))
+		{
+			m_pPipelineStateObject = nullptr;
+			m_pQuantizedPipelineStateObject = nullptr;
+
+			if (m_pRootSignature)
+			{
+				m_pRootSignature->Release();
+				m_pRootSignature = nullptr;
+			}
+
+			m_pRenderer = nullptr;
+			return false;
+		}
+	}
+	m_initRefCount++;
+
+	m_maxInstanceCount = maxInstanceCount;
+	m_contextCount = pRenderer->GetFrameContextCount();
+	m_instanceMeshList.reserve(maxInstanceCount);
+	m_instanceSlotList.reserve(maxInstanceCount);
+	m_instanceDataList.reserve(maxInstanceCount);
+	m_slotDataList.reserve(maxInstanceCount);
+
+	if (!InitInstanceBuffer() || !InitContextBundles())
+	{
+		Clean();
+		return false;
+	}
+
+	return true;
+}
+
+bool CStaticMeshGroup::InitRootSignature()
+{
+	bool bResult = false;
+
+	if (m_pRenderer == nullptr)
+	{
+		__debugbreak();
+		return bResult;
+	}
+
+	ID3D12Device5* pD3DDevice = m_pRenderer->GetD3DDevice();
+	if (pD3DDevice == nullptr)
+	{
+		__debugbreak();
+		return bResult;
+	}
+
+	ComPtr<ID3DBlob> pSignature = nullptr;
+	ComPtr<ID3DBlob> pError = nullptr;
+
+	// RootParam 3: per-tri-group SRV (t0)
+	CD3DX12_DESCRIPTOR_RANGE rangesPerTriGroup[1] = {};
+	rangesPerTriGroup[0].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0);
+
+	// RootParam 0: camera CBV (b0), 1: instance buffer (t1), 2: base instance slot + 위치 복원 값 (b1)
+	CD3DX12_ROOT_PARAMETER rootParameters[4] = {};
+	rootParameters[0].InitAsConstantBufferView(0, 0, D3D12_SHADER_VISIBILITY_ALL);
+	rootParameters[1].InitAsShaderResourceView(1, 0, D3D12_SHADER_VISIBILITY_VERTEX);
+	rootParameters[2].InitAsConstants(sizeof(StaticMeshBatchConstants) / sizeof(UINT), 1, 0, D3D12_SHADER_VISIBILITY_VERTEX);
+	rootParameters[3].InitAsDescriptorTable(_countof(rangesPerTriGroup), rangesPerTriGroup, D3D12_SHADER_VISIBILITY_ALL);
+
+	CD3DX12_STATIC_SAMPLER_DESC sampler{0};
+	sampler.Filter = D3D12_FILTER_MIN_MAG_MIP_POINT;
+
+	CD3DX12_ROOT_SIGNATURE_DESC rootSignatureDesc;
+	rootSignatureDesc.Init(_countof(rootParameters), rootParameters, 1, &sampler, D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
+
+	if (FAILED(D3D12SerializeRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1, &pSignature, &pError)))
+	{
+		__debugbreak();
+		return bResult;
+	}
+
+	if (FAILED(pD3DDevice->CreateRootSignature(0, pSignature->GetBufferPointer(), pSignature->GetBufferSize(), IID_PPV_ARGS(&m_pRootSignature))))
+	{
+		__debugbreak();
+		return bResult;
+	}
+	m_rootSignatureHash = CPipelineStateHasher::HashBytes(pSignature->GetBufferPointer(), pSignature->GetBufferSize());
+
+	return bResult = true;
+}
+
+bool CStaticMeshGroup::InitPipelineState(CD3D12Renderer* pRenderer)
+{
+	bool bResult = false;
+	if (pRenderer == nullptr)
+	{
+		__debugbreak();
+		return bResult;
+	}
+
+	const CShaderArchive* pShaderArchive = pRenderer->GetShaderArchive();
+	D3D12_SHADER_BYTECODE vertexShader = {};
+	D3D12_SHADER_BYTECODE pixelShader = {};
+	if (!pShaderArchive->FindShader(EShaderProgram::Default, EShaderStage::Vertex, ShaderPermutationInstancing, &vertexShader))
+	{
+		__debugbreak();
+		return bResult;
+	}
+	if (!pShaderArchive->FindShader(EShaderProgram::Default, EShaderStage::Pixel, ShaderPermutationInstancing, &pixelShader))
+	{
+		__debugbreak();
+		return bResult;
+	}
+
+	// CBasicMeshObject와 같은 정점 형식 / 렌더 상태
+	D3D12_INPUT_ELEMENT_DESC inputElementDescs[] =
+	{
+		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+		{ "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+		{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 28, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
+	};
+
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc = {};
+	psoDesc.InputLayout = { inputElementDescs, _countof(inputElementDescs) };
+	psoDesc.pRootSignature = m_pRootSignature;
+	psoDesc.VS = vertexShader;
+	psoDesc.PS = pixelShader;
+	psoDesc.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+	psoDesc.RasterizerState.CullMode = D3D12_CULL_MODE_NONE;
+	psoDesc.BlendState = CD3DX12_BLEND_DESC(D3D12_DEFAULT);
+	psoDesc.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC{ D3D12_DEFAULT };
+	psoDesc.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_LESS_EQUAL;
+	psoDesc.DepthStencilState.DepthEnable = TRUE;
+	psoDesc.DepthStencilState.StencilEnable = FALSE;
+	psoDesc.SampleMask = UINT_MAX;
+	psoDesc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+	psoDesc.NumRenderTargets = 1;
+	psoDesc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
+	psoDesc.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+	psoDesc.SampleDesc.Count = 1;
+
+	// PSO는 렌더러 공용 캐시가 소유 (CleanSharedResource에서 Release하지 않는다)
+	m_pPipelineStateObject = pRenderer->GetPipelineStateCache()->GetGraphicsPipelineState(psoDesc, m_rootSignatureHash);
+	if (!m_pPipelineStateObject)
+	{
+		__debugbreak();
+		return bResult;
+	}
+
+	D3D12_SHADER_BYTECODE quantizedVertexShader = {};
+	if (!pShaderArchive->FindShader(EShaderProgram::Default, EShaderStage::Vertex, ShaderPermutationInstancing | ShaderPermutationQuantizedVertex, &quantizedVertexShader))
+	{
+		__debugbreak();
+		return bResult;
+	}
+
+	D3D12_INPUT_ELEMENT_DESC quantizedInputElementDescs[] =
+	{
+		{ "POSITION", 0, DXGI_FORMAT_R16G16B16A16_SNORM, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+		{ "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, 8, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+		{ "TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
+	};
+	psoDesc.InputLayout = { quantizedInputElementDescs, _countof(quantizedInputElementDescs) };
+	psoDesc.VS = quantizedVertexShader;
+
+	m_pQuantizedPipelineStateObject = pRenderer->GetPipelineStateCache()->GetGraphicsPipelineState(psoDesc, m_rootSignatureHash);
+	if (!m_pQuantizedPipelineStateObject)
+	{
+		__debugbreak();
+		return bResult;
+	}
+
+	return bResult = true;
+}
+
+bool CStaticMeshGroup::ReloadPipelineState(CD3D12Renderer* pRenderer)
+{
+	// 살아 있는 객체가 없으면 다음 Initialize가 새 아카이브로 만든다
+	if (m_initRefCount == 0)
+	{
+		return true;
+	}
+
+	// 이전 PSO는 캐시가 계속 소유하므로 이미 기록된 프레임은 그대로 실행된다
+	ID3D12PipelineState* pPrevPipelineState = m_pPipelineStateObject;
+	ID3D12PipelineState* pPrevQuantizedPipelineState = m_pQuantizedPipelineStateObject;
+	if (!InitPipelineState(pRenderer))
+	{
+		m_pPipelineStateObject = pPrevPipelineState;
+		m_pQuantizedPipelineStateObject = pPrevQuantizedPipelineState;
+		return false;
+	}
+	return true;
+}
+
+bool CStaticMeshGroup::InitInstanceBuffer()
+{
+	ID3D12Device5* pD3DDevice = m_pRenderer->GetD3DDevice();
+	if (!pD3DDevice)
+	{
+		__debugbreak();
+		return false;
+	}
+
+	const UINT64 instanceBufferSize = static_cast<UINT64>(m_maxInstanceCount) * InstanceDataSize;
+
+	// COMMON에서 시작하는 버퍼는 복사 / 셰이더 읽기로 암시적 승격되므로 barrier가 필요 없다
+	HRESULT hr = pD3DDevice->CreateCommittedResource(
+		&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
+		D3D12_HEAP_FLAG_NONE,
+		&CD3DX12_RESOURCE_DESC::Buffer(instanceBufferSize),
+		D3D12_RESOURCE_STATE_COMMON,
+		nullptr,
+		IID_PPV_ARGS(m_instanceBuffer.ReleaseAndGetAddressOf()));
+	if (FAILED(hr))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	m_instanceUploadSliceSize = instanceBufferSize;
+	hr = pD3DDevice->CreateCommittedResource(
+		&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
+		D3D12_HEAP_FLAG_NONE,
+		&CD3DX12_RESOURCE_DESC::Buffer(m_instanceUploadSliceSize * m_contextCount),
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(m_instanceUploadBuffer.ReleaseAndGetAddressOf()));
+	if (FAILED(hr))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	TagGpuMemory(pD3DDevice, m_instanceBuffer.Get(), EMemoryCategory::Geometry);
+	TagGpuMemory(pD3DDevice, m_instanceUploadBuffer.Get(), EMemoryCategory::Upload);
+
+	// 실행이 끝날 때마다 COMMON으로 decay하므로 PrepareFrame의 COPY_DEST는 승격으로 처리된다
+	m_pRenderer->GetResourceStateTracker()->RegisterResource(m_instanceBuffer.Get(), D3D12_RESOURCE_STATE_COMMON, EResourcePromotionType::Buffer);
+
+	CD3DX12_RANGE writeRange(0, 0);
+	if (FAILED(m_instanceUploadBuffer->Map(0, &writeRange, reinterpret_cast<void**>(&m_pMappedInstanceUploadBuffer))))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	return true;
+}
+
+bool CStaticMeshGroup::InitContextBundles()
+{
+	ID3D12Device5* pD3DDevice = m_pRenderer->GetD3DDevice();
+	if (!pD3DDevice)
+	{
+		__debugbreak();
+		return false;
+	}
+
+	m_descriptorSize = pD3DDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+	for (UINT i = 0; i < m_contextCount; i++)
+	{
+		ContextBundle& contextBundle = m_contextBundleList[i];
+		if (FAILED(pD3DDevice->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_BUNDLE, IID_PPV_ARGS(contextBundle.BundleAllocator.ReleaseAndGetAddressOf()))))
+		{
+			__debugbreak();
+			return false;
+		}
+
+		if (FAILED(pD3DDevice->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_BUNDLE, contextBundle.BundleAllocator.Get(), m_pPipelineStateObject,
+			IID_PPV_ARGS(contextBundle.Bundle.ReleaseAndGetAddressOf()))))
+		{
+			__debugbreak();
+			return false;
+		}
+
+		// 생성 직후는 기록 상태. 첫 PrepareFrame에서 Reset 후 기록한다
+		contextBundle.Bundle->Close();
+	}
+
+	return true;
+}
+
+UINT CStaticMeshGroup::AddInstance(CBasicMeshObject* pMeshObject, const XMMATRIX& worldMatrix)
+{
+	if (!pMeshObject || pMeshObject->m_triGroupCount == 0 || m_instanceMeshList.size() >= m_maxInstanceCount)
+	{
+		__debugbreak();
+		return UINT_MAX;
+	}
+
+	XMFLOAT4X4 instanceData = {};
+	XMStoreFloat4x4(&instanceData, XMMatrixTranspose(worldMatrix));
+
+	const UINT instanceIndex = static_cast<UINT>(m_instanceMeshList.size());
+	m_instanceMeshList.push_back(pMeshObject);
+	m_instanceSlotList.push_back(UINT_MAX);
+	m_instanceDataList.push_back(instanceData);
+
+	// slot 배치가 바뀌므로 다음 PrepareFrame에서 전체를 다시 정렬 / 업로드하고 번들을 다시 기록
+	m_bBatchesDirty = true;
+	m_contentVersion++;
+	return instanceIndex;
+}
+
+void CStaticMeshGroup::InvalidateBundles()
+{
+	m_contentVersion++;
+}
+
+void CStaticMeshGroup::SetInstanceTransform(UINT instanceIndex, const XMMATRIX& worldMatrix)
+{
+	if (instanceIndex >= m_instanceDataList.size())
+	{
+		__debugbreak();
+		return;
+	}
+
+	XMStoreFloat4x4(&m_instanceDataList[instanceIndex], XMMatrixTranspose(worldMatrix));
+	if (m_bBatchesDirty)
+	{
+		return;
+	}
+
+	// 번들은 slot만 참조하므로 행렬만 다시 업로드하면 된다
+	const UINT slot = m_instanceSlotList[instanceIndex];
+	m_slotDataList[slot] = m_instanceDataList[instanceIndex];
+	m_dirtySlotBegin = (std::min)(m_dirtySlotBegin, slot);
+	m_dirtySlotEnd = (std::max)(m_dirtySlotEnd, slot + 1);
+}
+
+void CStaticMeshGroup::PrepareFrame(ID3D12GraphicsCommandList* pCommandList, DWORD contextIndex, CResourceStateTracker* pStateTracker)
+{
+	if (!pCommandList || !pStateTracker || contextIndex >= m_contextCount)
+	{
+		__debugbreak();
+		return;
+	}
+
+	if (m_bBatchesDirty)
+	{
+		RebuildBatches();
+	}
+
+	// 이 컨텍스트의 upload slice는 Present에서 이전 사용이 끝난 것을 확인했다
+	if (m_dirtySlotBegin < m_dirtySlotEnd)
+	{
+		const UINT64 dstOffset = static_cast<UINT64>(m_dirtySlotBegin) * InstanceDataSize;
+		const UINT64 srcOffset = m_instanceUploadSliceSize * contextIndex + dstOffset;
+		const UINT64 copySize = static_cast<UINT64>(m_dirtySlotEnd - m_dirtySlotBegin) * InstanceDataSize;
+		memcpy(m_pMappedInstanceUploadBuffer + srcOffset, &m_slotDataList[m_dirtySlotBegin], copySize);
+
+		// 버퍼는 이전 ExecuteCommandLists 뒤 COMMON으로 decay했으므로 COPY_DEST로 승격된다
+		ID3D12Resource* pInstanceBuffer = m_instanceBuffer.Get();
+		pStateTracker->TransitionResource(pInstanceBuffer, D3D12_RESOURCE_STATE_COPY_DEST);
+		pStateTracker->FlushBarriers(pCommandList);
+		pCommandList->CopyBufferRegion(pInstanceBuffer, dstOffset, m_instanceUploadBuffer.Get(), srcOffset, copySize);
+
+		m_dirtySlotBegin = UINT_MAX;
+		m_dirtySlotEnd = 0;
+	}
+
+	ContextBundle& contextBundle = m_contextBundleList[contextIndex];
+	if (!m_batchList.empty() && (!contextBundle.bRecorded || contextBundle.RecordedVersion != m_contentVersion))
+	{
+		RecordBundle(contextIndex);
+	}
+}
+
+void CStaticMeshGroup::RebuildBatches()
+{
+	const UINT instanceCount = static_cast<UINT>(m_instanceMeshList.size());
+
+	// 같은 메시의 인스턴스를 연속된 slot에 모은다. 같은 메시 안에서는 추가 순서 유지
+	// 정점 형식(PSO)이 같은 메시끼리 먼저 묶어 번들 안의 PSO 전환을 줄인다
+	std::vector<UINT> slotOrder(instanceCount);
+	std::iota(slotOrder.begin(), slotOrder.end(), 0);
+	std::stable_sort(slotOrder.begin(), slotOrder.end(),
+		[this](UINT a, UINT b)
+		{
+			const CBasicMeshObject* pMeshA = m_instanceMeshList[a];
+			const CBasicMeshObject* pMeshB = m_instanceMeshList[b];
+			if (pMeshA->m_bQuantized != pMeshB->m_bQuantized)
+			{
+				return pMeshB->m_bQuantized;
+			}
+			return std::less<const CBasicMeshObject*>{}(pMeshA, pMeshB);
+		});
+
+	m_slotDataList.resize(instanceCount);
+	m_batchList.clear();
+	for (UINT slot = 0; slot < instanceCount; slot++)
+	{
+		const UINT instanceIndex = slotOrder[slot];
+		CBasicMeshObject* pMeshObject = m_instanceMeshList[instanceIndex];
+		m_instanceSlotList[instanceIndex] = slot;
+		m_slotDataList[slot] = m_instanceDataList[instanceIndex];
+
+		if (m_batchList.empty() || m_batchList.back().pMeshObject != pMeshObject)
+		{
+			m_batchList.push_back(InstanceBatch{ pMeshObject, slot, 0 });
+		}
+		m_batchList.back().InstanceCount++;
+	}
+
+	m_dirtySlotBegin = 0;
+	m_dirtySlotEnd = instanceCount;
+	m_bBatchesDirty = false;
+}
+
+bool CStaticMeshGroup::RecordBundle(DWORD contextIndex)
+{
+	ID3D12Device5* pD3DDevice = m_pRenderer->GetD3DDevice();
+	ContextBundle& contextBundle = m_contextBundleList[contextIndex];
+	contextBundle.bRecorded = false;
+
+	UINT requiredDescriptorCount = 0;
+	for (const InstanceBatch& batch : m_batchList)
+	{
+		requiredDescriptorCount += batch.pMeshObject->m_triGroupCount * CBasicMeshObject::DescriptorCountPerTriGroup;
+	}
+
+	// 이 컨텍스트의 이전 프레임은 끝났으므로 heap을 바로 교체해도 된다
+	if (requiredDescriptorCount > contextBundle.DescriptorCapacity)
+	{
+		D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+		heapDesc.NumDescriptors = requiredDescriptorCount;
+		heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+		heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+		if (FAILED(pD3DDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(contextBundle.DescriptorHeap.ReleaseAndGetAddressOf()))))
+		{
+			__debugbreak();
+			contextBundle.DescriptorCapacity = 0;
+			return false;
+		}
+		TagGpuMemory(pD3DDevice, contextBundle.DescriptorHeap.Get());
+		contextBundle.DescriptorCapacity = requiredDescriptorCount;
+	}
+
+	CD3DX12_CPU_DESCRIPTOR_HANDLE destHandle(contextBundle.DescriptorHeap->GetCPUDescriptorHandleForHeapStart());
+	for (const InstanceBatch& batch : m_batchList)
+	{
+		CBasicMeshObject* pMeshObject = batch.pMeshObject;
+		for (UINT i = 0; i < pMeshObject->m_triGroupCount; i++)
+		{
+			pD3DDevice->CopyDescriptorsSimple(1, destHandle, pMeshObject->m_triGroupList[i].pTexHandle->SrvDescriptorHandle, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+			destHandle.Offset(1, m_descriptorSize);
+		}
+	}
+
+	if (FAILED(contextBundle.BundleAllocator->Reset()) ||
+		FAILED(contextBundle.Bundle->Reset(contextBundle.BundleAllocator.Get(), m_pPipelineStateObject)))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	ID3D12GraphicsCommandList* pBundle = contextBundle.Bundle.Get();
+
+	StaticMeshGroupDrawState drawState = {};
+	drawState.pRootSignature = m_pRootSignature;
+	drawState.pPipelineState = m_pPipelineStateObject;
+	drawState.pDescriptorHeap = contextBundle.DescriptorHeap.Get();
+	RecordStaticMeshBundleSetup(pBundle, drawState);
+
+	CD3DX12_GPU_DESCRIPTOR_HANDLE gpuSrvHandle(contextBundle.DescriptorHeap->GetGPUDescriptorHandleForHeapStart());
+	ID3D12PipelineState* pCurrentPipelineState = m_pPipelineStateObject;
+	for (const InstanceBatch& batch : m_batchList)
+	{
+		CBasicMeshObject* pMeshObject = batch.pMeshObject;
+		ID3D12PipelineState* pPipelineState = pMeshObject->m_bQuantized ? m_pQuantizedPipelineStateObject : m_pPipelineStateObject;
+
+		StaticMeshBatchConstants batchConstants = {};
+		batchConstants.BaseSlot = batch.BaseSlot;
+		batchConstants.PositionScale = pMeshObject->m_vertexQuantization.PositionScale;
+		batchConstants.PositionOffset = pMeshObject->m_vertexQuantization.PositionOffset;
+		RecordStaticMeshBatchSetup(pBundle, (pPipelineState != pCurrentPipelineState) ? pPipelineState : nullptr, &pMeshObject->m_vertexBufferView, batchConstants);
+		pCurrentPipelineState = pPipelineState;
+
+		for (UINT i = 0; i < pMeshObject->m_triGroupCount; i++)
+		{
+			// 번들은 미리 기록되므로 LOD 0으로 고정
+			IndexedTriGroup& triGroup = pMeshObject->m_triGroupList[i];
+			const std::vector<IndexedTriCluster>& clusterList = triGroup.ClusterLists[0];
+			RecordStaticMeshTriGroupDraw(pBundle, gpuSrvHandle, &triGroup.IndexBufferViews[0], clusterList.data(), static_cast<UINT>(clusterList.size()), batch.InstanceCount);
+			gpuSrvHandle.Offset(1, m_descriptorSize);
+		}
+	}
+
+	if (FAILED(pBundle->Close()))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	contextBundle.RecordedVersion = m_contentVersion;
+	contextBundle.bRecorded = true;
+	return true;
+}
+
+void CStaticMeshGroup::Draw(ID3D12GraphicsCommandList* pCommandList, DWORD renderThreadIndex)
+{
+	if (pCommandList == nullptr || m_pRenderer == nullptr)
+	{
+		__debugbreak();
+		return;
+	}
+
+	// PrepareFrame 이후에 추가된 인스턴스는 다음 프레임부터 그려진다
+	const DWORD contextIndex = m_pRenderer->GetCurrentContextIndex();
+	ContextBundle& contextBundle = m_contextBundleList[contextIndex];
+	if (!contextBundle.bRecorded)
+	{
+		return;
+	}
+
+	CConstantBufferPool* pConstantBufferPool = m_pRenderer->GetConstantBufferPool(EConstantBufferType::Default, renderThreadIndex);
+	if (!pConstantBufferPool)
+	{
+		__debugbreak();
+		return;
+	}
+
+	ConstantBufferContainer* pCB = pConstantBufferPool->Allocate();
+	if (!pCB)
+	{
+		__debugbreak();
+		return;
+	}
+
+	ConstantBufferDefault* pConstantBufferDefault = reinterpret_cast<ConstantBufferDefault*>(pCB->SystemAddress);
+
+	XMMATRIX viewMatrix = {};
+	XMMATRIX projectionMatrix = {};
+	m_pRenderer->GetViewProjMatrix(&viewMatrix, &projectionMatrix);
+	pConstantBufferDefault->WorldMatrix = XMMatrixIdentity();
+	pConstantBufferDefault->ViewMatrix = XMMatrixTranspose(viewMatrix);
+	pConstantBufferDefault->ProjectionMatrix = XMMatrixTranspose(projectionMatrix);
+
+	StaticMeshGroupDrawState drawState = {};
+	drawState.pRootSignature = m_pRootSignature;
+	drawState.pPipelineState = m_pPipelineStateObject;
+	drawState.pDescriptorHeap = contextBundle.DescriptorHeap.Get();
+	RecordStaticMeshGroupDraw(pCommandList, drawState, pCB->GpuAddress, m_instanceBuffer->GetGPUVirtualAddress(), contextBundle.Bundle.Get());
+}
+
+void CStaticMeshGroup::Clean()
+{
+	if (m_pRenderer)
+	{
+		for (ContextBundle& contextBundle : m_contextBundleList)
+		{
+			contextBundle = ContextBundle{};
+		}
+
+		if (m_instanceUploadBuffer && m_pMappedInstanceUploadBuffer)
+		{
+			m_instanceUploadBuffer->Unmap(0, nullptr);
+			m_pMappedInstanceUploadBuffer = nullptr;
+		}
+		m_instanceUploadBuffer = nullptr;
+		if (m_instanceBuffer)
+		{
+			m_pRenderer->GetResourceStateTracker()->UnregisterResource(m_instanceBuffer.Get());
+		}
+		m_instanceBuffer = nullptr;
+
+		m_instanceMeshList.clear();
+		m_instanceSlotList.clear();
+		m_instanceDataList.clear();
+		m_slotDataList.clear();
+		m_batchList.clear();
+
+		CleanSharedResource();
+		m_pRenderer = nullptr;
+	}
+}
+
+void CStaticMeshGroup::CleanSharedResource()
+{
+	if (m_initRefCount <= 0 || m_pRenderer == nullptr)
+	{
+		return;
+	}
+
+	const UINT refCount = --m_initRefCount;
+	if (refCount <= 0)
+	{
+		if (m_pRootSignature)
+		{
+			m_pRootSignature->Release();
+			m_pRootSignature = nullptr;
+		}
+
+		m_pPipelineStateObject = nullptr;
+		m_pQuantizedPipelineStateObject = nullptr;
+	}
+}
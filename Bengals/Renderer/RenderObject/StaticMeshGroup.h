@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+/**
+ * Set of static mesh instances drawn through a pre-recorded bundle.
+ *
+ * Instances are sorted by mesh so each mesh's world matrices are contiguous in a
+ * persistent instance buffer, and the bundle draws each tri group once for all of them.
+ * Each frame context owns its own bundle and descriptor heap; PrepareFrame() re-records
+ * one only when instances were added since that context last recorded it. Moving an
+ * instance only re-uploads its matrix. Per frame, Draw() costs one camera CBV, two root
+ * arguments and ExecuteBundle regardless of the instance count.
+ * Meshes added to a group must outlive it.
+ */
+
+class CD3D12Renderer;
+class CRenderQueue;
+class CBasicMeshObject;
+class CResourceStateTracker;
+
+class CStaticMeshGroup
+{
+	friend class CD3D12Renderer;
+	friend class CRenderQueue;
+
+public:/*function*/
+	CStaticMeshGroup() = delete;
+	CStaticMeshGroup(CD3D12Renderer* pRenderer, UINT maxInstanceCount);
+	~CStaticMeshGroup();
+
+	bool Initialize(CD3D12Renderer* pRenderer, UINT maxInstanceCount);
+
+private: /*function*/
+	bool InitRootSignature();
+	static bool InitPipelineState(CD3D12Renderer* pRenderer);
+	// 셰이더 아카이브가 바뀐 뒤 렌더러가 프레임 시작에서 호출. 실패하면 이전 PSO를 유지
+	static bool ReloadPipelineState(CD3D12Renderer* pRenderer);
+	bool InitInstanceBuffer();
+	bool InitContextBundles();
+
+	UINT AddInstance(CBasicMeshObject* pMeshObject, const XMMATRIX& worldMatrix);
+	void SetInstanceTransform(UINT instanceIndex, const XMMATRIX& worldMatrix);
+	// 번들에 복사된 텍스처 SRV나 PSO가 바뀌었을 때: 각 컨텍스트가 다음 PrepareFrame에서 다시 기록한다
+	void InvalidateBundles();
+
+	// BeginRender에서 호출. 바뀐 인스턴스 행렬을 업로드하고 필요하면 이 컨텍스트의 번들을 다시 기록
+	void PrepareFrame(ID3D12GraphicsCommandList* pCommandList, DWORD contextIndex, CResourceStateTracker* pStateTracker);
+	void Draw(ID3D12GraphicsCommandList* pCommandList, DWORD renderThreadIndex);
+
+	void RebuildBatches();
+	bool RecordBundle(DWORD contextIndex);
+
+	void Clean();
+	void CleanSharedResource();
+
+private: /*variable*/
+	static constexpr UINT MaxFrameContextCount = 2;
+	static constexpr UINT InstanceDataSize = sizeof(XMFLOAT4X4);
+
+	struct InstanceBatch
+	{
+		CBasicMeshObject* pMeshObject = nullptr;
+		UINT BaseSlot = 0;
+		UINT InstanceCount = 0;
+	};
+
+	struct ContextBundle
+	{
+		ComPtr<ID3D12CommandAllocator> BundleAllocator = nullptr;
+		ComPtr<ID3D12GraphicsCommandList> Bundle = nullptr;
+		ComPtr<ID3D12DescriptorHeap> DescriptorHeap = nullptr;
+		UINT DescriptorCapacity = 0;
+		UINT64 RecordedVersion = 0;
+		bool bRecorded = false;
+	};
+
+	static ID3D12RootSignature* m_pRootSignature;
+	static ID3D12PipelineState* m_pPipelineStateObject;
+	static ID3D12PipelineState* m_pQuantizedPipelineStateObject;		// VertexPackedPos3Color4Tex2 메시용
+	static UINT64 m_rootSignatureHash;
+	static UINT m_initRefCount;
+
+	CD3D12Renderer* m_pRenderer = nullptr;
+	UINT m_maxInstanceCount = 0;
+	UINT m_contextCount = 0;
+
+	// 인스턴스 인덱스는 추가 순서, slot은 메시별로 정렬된 인스턴스 버퍼 위치
+	std::vector<CBasicMeshObject*> m_instanceMeshList;
+	std::vector<UINT> m_instanceSlotList;
+	std::vector<XMFLOAT4X4> m_instanceDataList;		// 인스턴스 순서, 전치된 world 행렬
+	std::vector<XMFLOAT4X4> m_slotDataList;			// slot 순서 (업로드 원본)
+	std::vector<InstanceBatch> m_batchList;
+	UINT64 m_contentVersion = 0;
+	bool m_bBatchesDirty = false;
+
+	// 아직 업로드되지 않은 slot 범위 [begin, end)
+	UINT m_dirtySlotBegin = UINT_MAX;
+	UINT m_dirtySlotEnd = 0;
+
+	ComPtr<ID3D12Resource> m_instanceBuffer = nullptr;
+	ComPtr<ID3D12Resource> m_instanceUploadBuffer = nullptr;		// 컨텍스트마다 한 slice
+	UINT8* m_pMappedInstanceUploadBuffer = nullptr;
+	UINT64 m_instanceUploadSliceSize = 0;
+
+	std::array<ContextBundle, MaxFrameContextCount> m_contextBundleList = {};
+	UINT m_descriptorSize = 0;
+};
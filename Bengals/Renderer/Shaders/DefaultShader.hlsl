@@ -1,13 +1,37 @@
 Texture2D texDiffuse : register(t0);
 SamplerState samplerDiffuse : register(s0);
 
+#if defined(ALPHA_TEST)
+static const float ALPHA_TEST_REF = 0.5f;
+#endif
+
 cbuffer CONSTANT_BUFFER_DEFAULT : register(b0)
 {
-    matrix g_matWorld;
+    matrix g_matWorld;  // INSTANCING이면 사용하지 않는다
     matrix g_matView;
     matrix g_matProj;
+    float4 g_positionScale;   // QUANTIZED_VERTEX: position = snorm * scale + offset (INSTANCING이면 b1 사용)
+    float4 g_positionOffset;
+};
+
+#if defined(INSTANCING)
+// 정적 메시 그룹의 영구 인스턴스 버퍼. 같은 메시의 인스턴스는 연속된 slot에 있다
+struct InstanceData
+{
+    matrix matWorld;
+};
+StructuredBuffer<InstanceData> g_instanceBuffer : register(t1);
+
+cbuffer CONSTANT_BUFFER_INSTANCE : register(b1)
+{
+    uint g_baseInstance;
+    float3 g_batchPositionScale;    // QUANTIZED_VERTEX: 배치 메시의 위치 복원
+    float3 g_batchPositionOffset;
 };
+#endif
 
+// QUANTIZED_VERTEX: POSITION은 R16G16B16A16_SNORM, COLOR는 R8G8B8A8_UNORM, TEXCOORD는 R16G16_FLOAT.
+// input assembler가 float로 풀어주므로 위치의 메시별 scale / offset만 셰이더가 복원한다
 struct VSInput
 {
     float4 Pos : POSITION0;
@@ -22,12 +46,24 @@ struct PSInput
     float2 TexCoord : TEXCOORD0;
 };
 
-PSInput VSMain(VSInput input)
+PSInput VSMain(VSInput input, uint instanceId : SV_InstanceID)
 {
     PSInput result = (PSInput) 0;
+#if defined(INSTANCING)
+    matrix matWorld = g_instanceBuffer[g_baseInstance + instanceId].matWorld;
+#else
+    matrix matWorld = g_matWorld;
+#endif
+#if defined(QUANTIZED_VERTEX) && defined(INSTANCING)
+    float4 pos = float4(input.Pos.xyz * g_batchPositionScale + g_batchPositionOffset, 1.0f);
+#elif defined(QUANTIZED_VERTEX)
+    float4 pos = float4(input.Pos.xyz * g_positionScale.xyz + g_positionOffset.xyz, 1.0f);
+#else
+    float4 pos = input.Pos;
+#endif
     matrix matViewProj = mul(g_matView, g_matProj); // view x proj
-    matrix matWorldViewProj = mul(g_matWorld, matViewProj); // world x view x proj
-    result.position = mul(input.Pos, matWorldViewProj); 
+    matrix matWorldViewProj = mul(matWorld, matViewProj); // world x view x proj
+    result.position = mul(pos, matWorldViewProj); 
     result.TexCoord = input.TexCoord;
     result.color = input.color;
     
@@ -37,5 +73,9 @@ PSInput VSMain(VSInput input)
 float4 PSMain(PSInput input) : SV_TARGET
 {
     float4 texColor = texDiffuse.Sample(samplerDiffuse, input.TexCoord);
-    return texColor * input.color;
+    float4 outColor = texColor * input.color;
+#if defined(ALPHA_TEST)
+    clip(outColor.a - ALPHA_TEST_REF);
+#endif
+    return outColor;
 }
@@ -1,6 +1,10 @@
 Texture2D texDiffuse : register(t0);
 SamplerState samplerDiffuse : register(s0);
 
+#if defined(ALPHA_TEST)
+static const float ALPHA_TEST_REF = 0.5f;
+#endif
+
 cbuffer CONSTANT_BUFFER_SPRITE : register(b0)
 {
     float2 g_ScreenRes;
@@ -50,5 +54,9 @@ PSInput VSMain(VSInput input)
 float4 PSMain(PSInput input) : SV_TARGET
 {
     float4 texColor = texDiffuse.Sample(samplerDiffuse, input.TexCoord);
-    return texColor * input.color;
+    float4 outColor = texColor * input.color;
+#if defined(ALPHA_TEST)
+    clip(outColor.a - ALPHA_TEST_REF);
+#endif
+    return outColor;
 }
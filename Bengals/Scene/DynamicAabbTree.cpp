@@ -0,0 +1,624 @@
+#include "pch.h"
+#include "DynamicAabbTree.h"
+#include <algorithm>
+
+bool CDynamicAabbTree::Initialize(UINT initialCapacity, float fatMargin)
+{
+	if (fatMargin < 0.0f)
+	{
+		__debugbreak();
+		return false;
+	}
+
+	Clear();
+	m_fatMargin = fatMargin;
+	m_nodeList.reserve(initialCapacity > 0 ? initialCapacity * 2 : 16);
+	return true;
+}
+
+void CDynamicAabbTree::Clear()
+{
+	m_nodeList.clear();
+	m_rootNode = NullNode;
+	m_freeList = NullNode;
+	m_proxyCount = 0;
+}
+
+int CDynamicAabbTree::CreateProxy(const Aabb& box, void* pUserData)
+{
+	const int proxyId = AllocateNode();
+
+	TreeNode& node = m_nodeList[proxyId];
+	node.TightBox = box;
+	node.FatBox.Min = { box.Min.x - m_fatMargin, box.Min.y - m_fatMargin, box.Min.z - m_fatMargin };
+	node.FatBox.Max = { box.Max.x + m_fatMargin, box.Max.y + m_fatMargin, box.Max.z + m_fatMargin };
+	node.pUserData = pUserData;
+	node.Height = 0;
+
+	InsertLeaf(proxyId);
+	m_proxyCount++;
+	return proxyId;
+}
+
+void CDynamicAabbTree::DestroyProxy(int proxyId)
+{
+	// 이미 해제된 id를 다시 넣으면 free list와 트리가 깨진다
+	if (!IsValidProxy(proxyId))
+	{
+		__debugbreak();
+		return;
+	}
+
+	RemoveLeaf(proxyId);
+	FreeNode(proxyId);
+	m_proxyCount--;
+}
+
+bool CDynamicAabbTree::MoveProxy(int proxyId, const Aabb& box)
+{
+	if (!IsValidProxy(proxyId))
+	{
+		__debugbreak();
+		return false;
+	}
+
+	TreeNode& node = m_nodeList[proxyId];
+	node.TightBox = box;
+
+	// refit 없이 끝나는 경우: fat box 안에 있고, 물체가 크게 줄어들지도 않았다
+	const float hugeMargin = m_fatMargin * 4.0f;
+	Aabb hugeBox = {};
+	hugeBox.Min = { box.Min.x - hugeMargin, box.Min.y - hugeMargin, box.Min.z - hugeMargin };
+	hugeBox.Max = { box.Max.x + hugeMargin, box.Max.y + hugeMargin, box.Max.z + hugeMargin };
+	if (Contains(node.FatBox, box) && Contains(hugeBox, node.FatBox))
+	{
+		return false;
+	}
+
+	RemoveLeaf(proxyId);
+
+	TreeNode& movedNode = m_nodeList[proxyId];
+	movedNode.FatBox.Min = { box.Min.x - m_fatMargin, box.Min.y - m_fatMargin, box.Min.z - m_fatMargin };
+	movedNode.FatBox.Max = { box.Max.x + m_fatMargin, box.Max.y + m_fatMargin, box.Max.z + m_fatMargin };
+
+	InsertLeaf(proxyId);
+	return true;
+}
+
+void* CDynamicAabbTree::GetUserData(int proxyId) const
+{
+	if (!IsValidProxy(proxyId))
+	{
+		return nullptr;
+	}
+
+	return m_nodeList[proxyId].pUserData;
+}
+
+const Aabb& CDynamicAabbTree::GetFatAabb(int proxyId) const
+{
+	return m_nodeList[proxyId].FatBox;
+}
+
+UINT CDynamicAabbTree::QueryFrustum(const BoundingFrustum& frustum, std::vector<void*>& outUserDataList) const
+{
+	const size_t prevCount = outUserDataList.size();
+	if (m_rootNode == NullNode)
+	{
+		return 0;
+	}
+
+	std::vector<int> stack = {};
+	stack.reserve(64);
+	stack.push_back(m_rootNode);
+
+	while (!stack.empty())
+	{
+		const int nodeId = stack.back();
+		stack.pop_back();
+
+		const TreeNode& node = m_nodeList[nodeId];
+		const ContainmentType containment = frustum.Contains(ToBoundingBox(node.FatBox));
+		if (containment == DISJOINT)
+		{
+			continue;
+		}
+
+		if (node.IsLeaf())
+		{
+			if (containment == CONTAINS || frustum.Intersects(ToBoundingBox(node.TightBox)))
+			{
+				outUserDataList.push_back(node.pUserData);
+			}
+			continue;
+		}
+
+		// 완전히 포함된 서브트리는 더 이상 검사하지 않는다
+		if (containment == CONTAINS)
+		{
+			CollectFrustumSubtree(nodeId, outUserDataList);
+			continue;
+		}
+
+		stack.push_back(node.Child1);
+		stack.push_back(node.Child2);
+	}
+
+	return static_cast<UINT>(outUserDataList.size() - prevCount);
+}
+
+UINT CDynamicAabbTree::QueryAabb(const Aabb& box, std::vector<void*>& outUserDataList) const
+{
+	const size_t prevCount = outUserDataList.size();
+	if (m_rootNode == NullNode)
+	{
+		return 0;
+	}
+
+	std::vector<int> stack = {};
+	stack.reserve(64);
+	stack.push_back(m_rootNode);
+
+	while (!stack.empty())
+	{
+		const int nodeId = stack.back();
+		stack.pop_back();
+
+		const TreeNode& node = m_nodeList[nodeId];
+		if (!Overlaps(node.FatBox, box))
+		{
+			continue;
+		}
+
+		if (node.IsLeaf())
+		{
+			if (Overlaps(node.TightBox, box))
+			{
+				outUserDataList.push_back(node.pUserData);
+			}
+			continue;
+		}
+
+		stack.push_back(node.Child1);
+		stack.push_back(node.Child2);
+	}
+
+	return static_cast<UINT>(outUserDataList.size() - prevCount);
+}
+
+bool CDynamicAabbTree::RayCast(FXMVECTOR origin, FXMVECTOR direction, float maxDistance, AabbRayHit* pOutHit) const
+{
+	if (!pOutHit || m_rootNode == NullNode)
+	{
+		return false;
+	}
+
+	const XMVECTOR rayDir = XMVector3Normalize(direction);
+	float closestDistance = maxDistance;
+	int closestProxyId = NullNode;
+
+	std::vector<int> stack = {};
+	stack.reserve(64);
+	stack.push_back(m_rootNode);
+
+	while (!stack.empty())
+	{
+		const int nodeId = stack.back();
+		stack.pop_back();
+
+		const TreeNode& node = m_nodeList[nodeId];
+		float distance = 0.0f;
+		if (!ToBoundingBox(node.FatBox).Intersects(origin, rayDir, distance))
+		{
+			continue;
+		}
+		if ((std::max)(distance, 0.0f) > closestDistance)
+		{
+			continue;
+		}
+
+		if (node.IsLeaf())
+		{
+			if (ToBoundingBox(node.TightBox).Intersects(origin, rayDir, distance))
+			{
+				distance = (std::max)(distance, 0.0f);
+				if (distance <= closestDistance)
+				{
+					closestDistance = distance;
+					closestProxyId = nodeId;
+				}
+			}
+			continue;
+		}
+
+		stack.push_back(node.Child1);
+		stack.push_back(node.Child2);
+	}
+
+	if (closestProxyId == NullNode)
+	{
+		return false;
+	}
+
+	pOutHit->ProxyId = closestProxyId;
+	pOutHit->pUserData = m_nodeList[closestProxyId].pUserData;
+	pOutHit->Distance = closestDistance;
+	return true;
+}
+
+int CDynamicAabbTree::GetHeight() const
+{
+	if (m_rootNode == NullNode)
+	{
+		return 0;
+	}
+
+	return m_nodeList[m_rootNode].Height;
+}
+
+Aabb CDynamicAabbTree::TransformAabb(const Aabb& localBox, FXMMATRIX worldMatrix)
+{
+	BoundingBox worldBox = {};
+	ToBoundingBox(localBox).Transform(worldBox, worldMatrix);
+
+	Aabb result = {};
+	result.Min = { worldBox.Center.x - worldBox.Extents.x, worldBox.Center.y - worldBox.Extents.y, worldBox.Center.z - worldBox.Extents.z };
+	result.Max = { worldBox.Center.x + worldBox.Extents.x, worldBox.Center.y + worldBox.Extents.y, worldBox.Center.z + worldBox.Extents.z };
+	return result;
+}
+
+int CDynamicAabbTree::AllocateNode()
+{
+	if (m_freeList == NullNode)
+	{
+		m_nodeList.emplace_back();
+		return static_cast<int>(m_nodeList.size()) - 1;
+	}
+
+	const int nodeId = m_freeList;
+	m_freeList = m_nodeList[nodeId].Parent;
+	m_nodeList[nodeId] = TreeNode{};
+	return nodeId;
+}
+
+void CDynamicAabbTree::FreeNode(int nodeId)
+{
+	TreeNode& node = m_nodeList[nodeId];
+	node = TreeNode{};
+	node.Parent = m_freeList;
+	m_freeList = nodeId;
+}
+
+bool CDynamicAabbTree::IsValidProxy(int proxyId) const
+{
+	if (proxyId < 0 || proxyId >= static_cast<int>(m_nodeList.size()))
+	{
+		return false;
+	}
+
+	const TreeNode& node = m_nodeList[proxyId];
+	return node.Height >= 0 && node.IsLeaf();
+}
+
+void CDynamicAabbTree::InsertLeaf(int leafId)
+{
+	if (m_rootNode == NullNode)
+	{
+		m_rootNode = leafId;
+		m_nodeList[leafId].Parent = NullNode;
+		return;
+	}
+
+	// SAH 비용이 가장 작은 형제 노드를 찾는다
+	const Aabb leafBox = m_nodeList[leafId].FatBox;
+	int index = m_rootNode;
+	while (!m_nodeList[index].IsLeaf())
+	{
+		const TreeNode& node = m_nodeList[index];
+		const int child1 = node.Child1;
+		const int child2 = node.Child2;
+
+		const float area = SurfaceArea(node.FatBox);
+		const float combinedArea = SurfaceArea(Union(node.FatBox, leafBox));
+
+		const float cost = 2.0f * combinedArea;
+		const float inheritanceCost = 2.0f * (combinedArea - area);
+
+		auto DescendCost = [&](int childId) -> float
+		{
+			const TreeNode& child = m_nodeList[childId];
+			const float unionArea = SurfaceArea(Union(leafBox, child.FatBox));
+			if (child.IsLeaf())
+			{
+				return unionArea + inheritanceCost;
+			}
+			return (unionArea - SurfaceArea(child.FatBox)) + inheritanceCost;
+		};
+
+		const float cost1 = DescendCost(child1);
+		const float cost2 = DescendCost(child2);
+		if (cost < cost1 && cost < cost2)
+		{
+			break;
+		}
+
+		index = (cost1 < cost2) ? child1 : child2;
+	}
+
+	const int siblingId = index;
+	const int oldParentId = m_nodeList[siblingId].Parent;
+
+	// AllocateNode가 m_nodeList를 재할당할 수 있으므로 이후에는 인덱스로만 접근
+	const int newParentId = AllocateNode();
+	TreeNode& newParent = m_nodeList[newParentId];
+	newParent.Parent = oldParentId;
+	newParent.FatBox = Union(leafBox, m_nodeList[siblingId].FatBox);
+	newParent.Height = m_nodeList[siblingId].Height + 1;
+	newParent.Child1 = siblingId;
+	newParent.Child2 = leafId;
+
+	if (oldParentId != NullNode)
+	{
+		TreeNode& oldParent = m_nodeList[oldParentId];
+		if (oldParent.Child1 == siblingId)
+		{
+			oldParent.Child1 = newParentId;
+		}
+		else
+		{
+			oldParent.Child2 = newParentId;
+		}
+	}
+	else
+	{
+		m_rootNode = newParentId;
+	}
+
+	m_nodeList[siblingId].Parent = newParentId;
+	m_nodeList[leafId].Parent = newParentId;
+
+	// 조상 노드의 박스와 높이를 갱신하며 균형을 맞춘다
+	index = m_nodeList[leafId].Parent;
+	while (index != NullNode)
+	{
+		index = Balance(index);
+
+		TreeNode& node = m_nodeList[index];
+		const TreeNode& child1 = m_nodeList[node.Child1];
+		const TreeNode& child2 = m_nodeList[node.Child2];
+		node.Height = 1 + (std::max)(child1.Height, child2.Height);
+		node.FatBox = Union(child1.FatBox, child2.FatBox);
+
+		index = node.Parent;
+	}
+}
+
+void CDynamicAabbTree::RemoveLeaf(int leafId)
+{
+	if (leafId == m_rootNode)
+	{
+		m_rootNode = NullNode;
+		return;
+	}
+
+	const int parentId = m_nodeList[leafId].Parent;
+	const int grandParentId = m_nodeList[parentId].Parent;
+	const int siblingId = (m_nodeList[parentId].Child1 == leafId) ? m_nodeList[parentId].Child2 : m_nodeList[parentId].Child1;
+
+	if (grandParentId == NullNode)
+	{
+		m_rootNode = siblingId;
+		m_nodeList[siblingId].Parent = NullNode;
+		FreeNode(parentId);
+		return;
+	}
+
+	TreeNode& grandParent = m_nodeList[grandParentId];
+	if (grandParent.Child1 == parentId)
+	{
+		grandParent.Child1 = siblingId;
+	}
+	else
+	{
+		grandParent.Child2 = siblingId;
+	}
+	m_nodeList[siblingId].Parent = grandParentId;
+	FreeNode(parentId);
+
+	int index = grandParentId;
+	while (index != NullNode)
+	{
+		index = Balance(index);
+
+		TreeNode& node = m_nodeList[index];
+		const TreeNode& child1 = m_nodeList[node.Child1];
+		const TreeNode& child2 = m_nodeList[node.Child2];
+		node.FatBox = Union(child1.FatBox, child2.FatBox);
+		node.Height = 1 + (std::max)(child1.Height, child2.Height);
+
+		index = node.Parent;
+	}
+}
+
+int CDynamicAabbTree::Balance(int nodeIdA)
+{
+	TreeNode* pA = &m_nodeList[nodeIdA];
+	if (pA->IsLeaf() || pA->Height < 2)
+	{
+		return nodeIdA;
+	}
+
+	const int nodeIdB = pA->Child1;
+	const int nodeIdC = pA->Child2;
+	TreeNode* pB = &m_nodeList[nodeIdB];
+	TreeNode* pC = &m_nodeList[nodeIdC];
+
+	const int balance = pC->Height - pB->Height;
+
+	// C를 위로 올린다
+	if (balance > 1)
+	{
+		const int nodeIdF = pC->Child1;
+		const int nodeIdG = pC->Child2;
+		TreeNode* pF = &m_nodeList[nodeIdF];
+		TreeNode* pG = &m_nodeList[nodeIdG];
+
+		pC->Child1 = nodeIdA;
+		pC->Parent = pA->Parent;
+		pA->Parent = nodeIdC;
+
+		if (pC->Parent != NullNode)
+		{
+			TreeNode& parent = m_nodeList[pC->Parent];
+			if (parent.Child1 == nodeIdA)
+			{
+				parent.Child1 = nodeIdC;
+			}
+			else
+			{
+				parent.Child2 = nodeIdC;
+			}
+		}
+		else
+		{
+			m_rootNode = nodeIdC;
+		}
+
+		if (pF->Height > pG->Height)
+		{
+			pC->Child2 = nodeIdF;
+			pA->Child2 = nodeIdG;
+			pG->Parent = nodeIdA;
+			pA->FatBox = Union(pB->FatBox, pG->FatBox);
+			pC->FatBox = Union(pA->FatBox, pF->FatBox);
+			pA->Height = 1 + (std::max)(pB->Height, pG->Height);
+			pC->Height = 1 + (std::max)(pA->Height, pF->Height);
+		}
+		else
+		{
+			pC->Child2 = nodeIdG;
+			pA->Child2 = nodeIdF;
+			pF->Parent = nodeIdA;
+			pA->FatBox = Union(pB->FatBox, pF->FatBox);
+			pC->FatBox = Union(pA->FatBox, pG->FatBox);
+			pA->Height = 1 + (std::max)(pB->Height, pF->Height);
+			pC->Height = 1 + (std::max)(pA->Height, pG->Height);
+		}
+
+		return nodeIdC;
+	}
+
+	// B를 위로 올린다
+	if (balance < -1)
+	{
+		const int nodeIdD = pB->Child1;
+		const int nodeIdE = pB->Child2;
+		TreeNode* pD = &m_nodeList[nodeIdD];
+		TreeNode* pE = &m_nodeList[nodeIdE];
+
+		pB->Child1 = nodeIdA;
+		pB->Parent = pA->Parent;
+		pA->Parent = nodeIdB;
+
+		if (pB->Parent != NullNode)
+		{
+			TreeNode& parent = m_nodeList[pB->Parent];
+			if (parent.Child1 == nodeIdA)
+			{
+				parent.Child1 = nodeIdB;
+			}
+			else
+			{
+				parent.Child2 = nodeIdB;
+			}
+		}
+		else
+		{
+			m_rootNode = nodeIdB;
+		}
+
+		if (pD->Height > pE->Height)
+		{
+			pB->Child2 = nodeIdD;
+			pA->Child1 = nodeIdE;
+			pE->Parent = nodeIdA;
+			pA->FatBox = Union(pC->FatBox, pE->FatBox);
+			pB->FatBox = Union(pA->FatBox, pD->FatBox);
+			pA->Height = 1 + (std::max)(pC->Height, pE->Height);
+			pB->Height = 1 + (std::max)(pA->Height, pD->Height);
+		}
+		else
+		{
+			pB->Child2 = nodeIdE;
+			pA->Child1 = nodeIdD;
+			pD->Parent = nodeIdA;
+			pA->FatBox = Union(pC->FatBox, pD->FatBox);
+			pB->FatBox = Union(pA->FatBox, pE->FatBox);
+			pA->Height = 1 + (std::max)(pC->Height, pD->Height);
+			pB->Height = 1 + (std::max)(pA->Height, pE->Height);
+		}
+
+		return nodeIdB;
+	}
+
+	return nodeIdA;
+}
+
+void CDynamicAabbTree::CollectFrustumSubtree(int nodeId, std::vector<void*>& outUserDataList) const
+{
+	std::vector<int> stack = {};
+	stack.reserve(64);
+	stack.push_back(nodeId);
+
+	while (!stack.empty())
+	{
+		const TreeNode& node = m_nodeList[stack.back()];
+		stack.pop_back();
+
+		if (node.IsLeaf())
+		{
+			outUserDataList.push_back(node.pUserData);
+			continue;
+		}
+
+		stack.push_back(node.Child1);
+		stack.push_back(node.Child2);
+	}
+}
+
+Aabb CDynamicAabbTree::Union(const Aabb& a, const Aabb& b)
+{
+	Aabb result = {};
+	result.Min = { (std::min)(a.Min.x, b.Min.x), (std::min)(a.Min.y, b.Min.y), (std::min)(a.Min.z, b.Min.z) };
+	result.Max = { (std::max)(a.Max.x, b.Max.x), (std::max)(a.Max.y, b.Max.y), (std::max)(a.Max.z, b.Max.z) };
+	return result;
+}
+
+float CDynamicAabbTree::SurfaceArea(const Aabb& box)
+{
+	const float dx = box.Max.x - box.Min.x;
+	const float dy = box.Max.y - box.Min.y;
+	const float dz = box.Max.z - box.Min.z;
+	return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+bool CDynamicAabbTree::Contains(const Aabb& outer, const Aabb& inner)
+{
+	return outer.Min.x <= inner.Min.x && outer.Min.y <= inner.Min.y && outer.Min.z <= inner.Min.z &&
+		inner.Max.x <= outer.Max.x && inner.Max.y <= outer.Max.y && inner.Max.z <= outer.Max.z;
+}
+
+bool CDynamicAabbTree::Overlaps(const Aabb& a, const Aabb& b)
+{
+	return a.Min.x <= b.Max.x && b.Min.x <= a.Max.x &&
+		a.Min.y <= b.Max.y && b.Min.y <= a.Max.y &&
+		a.Min.z <= b.Max.z && b.Min.z <= a.Max.z;
+}
+
+BoundingBox CDynamicAabbTree::ToBoundingBox(const Aabb& box)
+{
+	BoundingBox result = {};
+	result.Center = { (box.Min.x + box.Max.x) * 0.5f, (box.Min.y + box.Max.y) * 0.5f, (box.Min.z + box.Max.z) * 0.5f };
+	result.Extents = { (box.Max.x - box.Min.x) * 0.5f, (box.Max.y - box.Min.y) * 0.5f, (box.Max.z - box.Min.z) * 0.5f };
+	return result;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <DirectXCollision.h>
+#include <vector>
+
+/**
+ * Dynamic bounding volume hierarchy for scene queries and culling.
+ *
+ * Leaves hold a tight AABB plus a fat AABB enlarged by a margin. MoveProxy only
+ * re-inserts a leaf when its tight box escapes the fat box, so small per-frame
+ * motion costs nothing. Internal nodes are kept balanced with AVL-style rotations.
+ * CPU only; no D3D dependency.
+ */
+
+struct Aabb
+{
+	XMFLOAT3 Min = {};
+	XMFLOAT3 Max = {};
+};
+
+struct AabbRayHit
+{
+	int ProxyId = -1;
+	void* pUserData = nullptr;
+	float Distance = 0.0f;
+};
+
+class CDynamicAabbTree
+{
+public:
+	static constexpr int NullNode = -1;
+
+public:
+	CDynamicAabbTree() = default;
+	~CDynamicAabbTree() = default;
+
+	bool Initialize(UINT initialCapacity, float fatMargin);
+	void Clear();
+
+	int CreateProxy(const Aabb& box, void* pUserData);
+	void DestroyProxy(int proxyId);
+	bool MoveProxy(int proxyId, const Aabb& box);
+
+	void* GetUserData(int proxyId) const;
+	const Aabb& GetFatAabb(int proxyId) const;
+
+	UINT QueryFrustum(const BoundingFrustum& frustum, std::vector<void*>& outUserDataList) const;
+	UINT QueryAabb(const Aabb& box, std::vector<void*>& outUserDataList) const;
+	bool RayCast(FXMVECTOR origin, FXMVECTOR direction, float maxDistance, AabbRayHit* pOutHit) const;
+
+	UINT GetProxyCount() const
+	{
+		return m_proxyCount;
+	}
+
+	int GetHeight() const;
+
+	static Aabb TransformAabb(const Aabb& localBox, FXMMATRIX worldMatrix);
+
+private:
+	struct TreeNode
+	{
+		Aabb FatBox = {};
+		Aabb TightBox = {};
+		void* pUserData = nullptr;
+		int Parent = NullNode;	// next free node when the node is in the free list
+		int Child1 = NullNode;
+		int Child2 = NullNode;
+		int Height = -1;		// leaf = 0, free = -1
+
+		bool IsLeaf() const
+		{
+			return Child1 == NullNode;
+		}
+	};
+
+	int AllocateNode();
+	void FreeNode(int nodeId);
+	// 살아 있는 leaf인지. free list의 노드도 자식이 없으므로 Height로 구분한다
+	bool IsValidProxy(int proxyId) const;
+
+	void InsertLeaf(int leafId);
+	void RemoveLeaf(int leafId);
+	int Balance(int nodeId);
+	void CollectFrustumSubtree(int nodeId, std::vector<void*>& outUserDataList) const;
+
+	static Aabb Union(const Aabb& a, const Aabb& b);
+	static float SurfaceArea(const Aabb& box);
+	static bool Contains(const Aabb& outer, const Aabb& inner);
+	static bool Overlaps(const Aabb& a, const Aabb& b);
+	static BoundingBox ToBoundingBox(const Aabb& box);
+
+private:
+	std::vector<TreeNode> m_nodeList = {};
+	int m_rootNode = NullNode;
+	int m_freeList = NullNode;
+	UINT m_proxyCount = 0;
+	float m_fatMargin = 0.1f;
+};
@@ -0,0 +1,401 @@
+#include "pch.h"
+#include "OcclusionCuller.h"
+#include <algorithm>
+#include <cmath>
+#include <xmmintrin.h>
+
+namespace
+{
+	// clip w가 이보다 작은 꼭짓점은 카메라 뒤 / near plane 근처로 본다
+	constexpr float MinClipW = 1e-4f;
+
+	float Cross(float originX, float originY, float aX, float aY, float bX, float bY)
+	{
+		return (aX - originX) * (bY - originY) - (aY - originY) * (bX - originX);
+	}
+}
+
+bool COcclusionCuller::Initialize(UINT width, UINT height)
+{
+	if (width == 0 || height == 0 || (width % 4) != 0)
+	{
+		__debugbreak();
+		return false;
+	}
+
+	m_width = width;
+	m_height = height;
+	m_occluderCount = 0;
+
+	m_levelList.clear();
+	UINT levelWidth = width;
+	UINT levelHeight = height;
+	while (true)
+	{
+		DepthLevel level = {};
+		level.Width = levelWidth;
+		level.Height = levelHeight;
+		level.DepthList.assign(static_cast<size_t>(levelWidth) * levelHeight, 1.0f);
+		m_levelList.push_back(std::move(level));
+
+		if (levelWidth == 1 && levelHeight == 1)
+		{
+			break;
+		}
+		levelWidth = (std::max)(1u, (levelWidth + 1) / 2);
+		levelHeight = (std::max)(1u, (levelHeight + 1) / 2);
+	}
+	return true;
+}
+
+void COcclusionCuller::BeginFrame(const XMFLOAT4X4& viewProjMatrix)
+{
+	m_viewProjMatrix = viewProjMatrix;
+	m_occluderCount = 0;
+
+	if (!m_levelList.empty())
+	{
+		std::fill(m_levelList[0].DepthList.begin(), m_levelList[0].DepthList.end(), 1.0f);
+	}
+}
+
+bool COcclusionCuller::AddOccluder(const Aabb& localBounds, const XMFLOAT4X4& worldMatrix)
+{
+	if (m_levelList.empty())
+	{
+		return false;
+	}
+
+	XMFLOAT4X4 worldViewProjMatrix = {};
+	MultiplyMatrix(worldMatrix, m_viewProjMatrix, &worldViewProjMatrix);
+
+	ScreenVertex vertices[8] = {};
+	if (!ProjectBox(localBounds, worldViewProjMatrix, vertices))
+	{
+		return false;
+	}
+
+	// 박스 안쪽 어느 점도 가장 먼 꼭짓점보다 멀지 않으므로 실루엣 전체를 그 깊이로 기록
+	float farDepth = 0.0f;
+	for (const ScreenVertex& vertex : vertices)
+	{
+		farDepth = (std::max)(farDepth, vertex.Z);
+	}
+
+	ScreenVertex hull[8] = {};
+	const UINT hullVertexCount = BuildConvexHull(vertices, hull);
+	if (hullVertexCount < 3)
+	{
+		return false;
+	}
+
+	RasterizeConvexPolygon(hull, hullVertexCount, farDepth);
+	m_occluderCount++;
+	return true;
+}
+
+void COcclusionCuller::EndOccluders()
+{
+	BuildDepthPyramid();
+}
+
+bool COcclusionCuller::IsOccluded(const Aabb& worldBounds) const
+{
+	if (m_occluderCount == 0)
+	{
+		return false;
+	}
+
+	ScreenVertex vertices[8] = {};
+	if (!ProjectBox(worldBounds, m_viewProjMatrix, vertices))
+	{
+		return false;
+	}
+
+	float minX = vertices[0].X;
+	float maxX = vertices[0].X;
+	float minY = vertices[0].Y;
+	float maxY = vertices[0].Y;
+	float nearDepth = vertices[0].Z;
+	for (UINT i = 1; i < 8; i++)
+	{
+		minX = (std::min)(minX, vertices[i].X);
+		maxX = (std::max)(maxX, vertices[i].X);
+		minY = (std::min)(minY, vertices[i].Y);
+		maxY = (std::max)(maxY, vertices[i].Y);
+		nearDepth = (std::min)(nearDepth, vertices[i].Z);
+	}
+
+	// 화면 밖은 frustum 컬링이 판단
+	if (maxX <= 0.0f || maxY <= 0.0f || minX >= static_cast<float>(m_width) || minY >= static_cast<float>(m_height))
+	{
+		return false;
+	}
+
+	// 사각형이 걸치는 픽셀 범위 (양 끝 포함)
+	const int maxPixelX = static_cast<int>(m_width) - 1;
+	const int maxPixelY = static_cast<int>(m_height) - 1;
+	const int x0 = (std::clamp)(static_cast<int>(floorf(minX)), 0, maxPixelX);
+	const int x1 = (std::clamp)(static_cast<int>(floorf(maxX)), 0, maxPixelX);
+	const int y0 = (std::clamp)(static_cast<int>(floorf(minY)), 0, maxPixelY);
+	const int y1 = (std::clamp)(static_cast<int>(floorf(maxY)), 0, maxPixelY);
+
+	// 축마다 texel 2개 이하로 덮이는 level을 고른다
+	UINT levelIndex = 0;
+	while (levelIndex + 1 < m_levelList.size() &&
+		((x1 >> levelIndex) - (x0 >> levelIndex) > 1 || (y1 >> levelIndex) - (y0 >> levelIndex) > 1))
+	{
+		levelIndex++;
+	}
+
+	const DepthLevel& level = m_levelList[levelIndex];
+	for (int y = y0 >> levelIndex; y <= (y1 >> levelIndex); y++)
+	{
+		const float* pRow = level.DepthList.data() + static_cast<size_t>(y) * level.Width;
+		for (int x = x0 >> levelIndex; x <= (x1 >> levelIndex); x++)
+		{
+			if (pRow[x] >= nearDepth)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+float COcclusionCuller::GetScreenArea(const Aabb& worldBounds) const
+{
+	ScreenVertex vertices[8] = {};
+	if (!ProjectBox(worldBounds, m_viewProjMatrix, vertices))
+	{
+		return 0.0f;
+	}
+
+	float minX = vertices[0].X;
+	float maxX = vertices[0].X;
+	float minY = vertices[0].Y;
+	float maxY = vertices[0].Y;
+	for (UINT i = 1; i < 8; i++)
+	{
+		minX = (std::min)(minX, vertices[i].X);
+		maxX = (std::max)(maxX, vertices[i].X);
+		minY = (std::min)(minY, vertices[i].Y);
+		maxY = (std::max)(maxY, vertices[i].Y);
+	}
+
+	minX = (std::max)(minX, 0.0f);
+	minY = (std::max)(minY, 0.0f);
+	maxX = (std::min)(maxX, static_cast<float>(m_width));
+	maxY = (std::min)(maxY, static_cast<float>(m_height));
+	if (minX >= maxX || minY >= maxY)
+	{
+		return 0.0f;
+	}
+	return (maxX - minX) * (maxY - minY);
+}
+
+const float* COcclusionCuller::GetDepthLevel(UINT level) const
+{
+	if (level >= m_levelList.size())
+	{
+		return nullptr;
+	}
+	return m_levelList[level].DepthList.data();
+}
+
+bool COcclusionCuller::ProjectBox(const Aabb& box, const XMFLOAT4X4& matrix, ScreenVertex outVertices[8]) const
+{
+	// row vector 규약: clip = x * r0 + y * r1 + z * r2 + r3
+	const __m128 row0 = _mm_loadu_ps(&matrix.m[0][0]);
+	const __m128 row1 = _mm_loadu_ps(&matrix.m[1][0]);
+	const __m128 row2 = _mm_loadu_ps(&matrix.m[2][0]);
+	const __m128 row3 = _mm_loadu_ps(&matrix.m[3][0]);
+
+	const float halfWidth = static_cast<float>(m_width) * 0.5f;
+	const float halfHeight = static_cast<float>(m_height) * 0.5f;
+
+	for (UINT i = 0; i < 8; i++)
+	{
+		const float x = (i & 1) ? box.Max.x : box.Min.x;
+		const float y = (i & 2) ? box.Max.y : box.Min.y;
+		const float z = (i & 4) ? box.Max.z : box.Min.z;
+
+		__m128 clip = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(x), row0), _mm_mul_ps(_mm_set1_ps(y), row1));
+		clip = _mm_add_ps(clip, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(z), row2), row3));
+
+		alignas(16) float clipPos[4];
+		_mm_store_ps(clipPos, clip);
+
+		// near plane을 넘는 박스는 화면 사각형을 믿을 수 없다
+		if (clipPos[3] < MinClipW || clipPos[2] < 0.0f)
+		{
+			return false;
+		}
+
+		const float invW = 1.0f / clipPos[3];
+		outVertices[i].X = (clipPos[0] * invW + 1.0f) * halfWidth;
+		outVertices[i].Y = (1.0f - clipPos[1] * invW) * halfHeight;
+		outVertices[i].Z = clipPos[2] * invW;
+	}
+	return true;
+}
+
+void COcclusionCuller::RasterizeConvexPolygon(const ScreenVertex* pVertices, UINT vertexCount, float depth)
+{
+	float minX = pVertices[0].X;
+	float maxX = pVertices[0].X;
+	float minY = pVertices[0].Y;
+	float maxY = pVertices[0].Y;
+	for (UINT i = 1; i < vertexCount; i++)
+	{
+		minX = (std::min)(minX, pVertices[i].X);
+		maxX = (std::max)(maxX, pVertices[i].X);
+		minY = (std::min)(minY, pVertices[i].Y);
+		maxY = (std::max)(maxY, pVertices[i].Y);
+	}
+
+	// 폴리곤이 완전히 덮는 픽셀만 후보
+	int x0 = (std::max)(static_cast<int>(ceilf(minX)), 0);
+	const int x1 = (std::min)(static_cast<int>(floorf(maxX)) - 1, static_cast<int>(m_width) - 1);
+	const int y0 = (std::max)(static_cast<int>(ceilf(minY)), 0);
+	const int y1 = (std::min)(static_cast<int>(floorf(maxY)) - 1, static_cast<int>(m_height) - 1);
+	if (x0 > x1 || y0 > y1)
+	{
+		return;
+	}
+	x0 &= ~3;
+
+	// 변마다 E(p) = A * x + B * y + C, 안쪽이 양수 (hull이 Cross > 0 방향으로 감김).
+	// 픽셀 중심에서 0.5 * (|A| + |B|) 이상이면 픽셀 사각형 전체가 안쪽
+	__m128 edgeAList[8];
+	float edgeBList[8];
+	float edgeCList[8];
+	for (UINT i = 0; i < vertexCount; i++)
+	{
+		const ScreenVertex& a = pVertices[i];
+		const ScreenVertex& b = pVertices[(i + 1) % vertexCount];
+		const float edgeA = a.Y - b.Y;
+		const float edgeB = b.X - a.X;
+		edgeAList[i] = _mm_set1_ps(edgeA);
+		edgeBList[i] = edgeB;
+		edgeCList[i] = -(edgeA * a.X + edgeB * a.Y) - 0.5f * (fabsf(edgeA) + fabsf(edgeB));
+	}
+
+	const __m128 pixelCenterOffset = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 occluderDepth = _mm_set1_ps(depth);
+
+	float* pDepthBuffer = m_levelList[0].DepthList.data();
+	for (int y = y0; y <= y1; y++)
+	{
+		const float pixelCenterY = static_cast<float>(y) + 0.5f;
+		__m128 edgeRowList[8];
+		for (UINT i = 0; i < vertexCount; i++)
+		{
+			edgeRowList[i] = _mm_set1_ps(edgeBList[i] * pixelCenterY + edgeCList[i]);
+		}
+
+		float* pRow = pDepthBuffer + static_cast<size_t>(y) * m_width;
+		for (int x = x0; x <= x1; x += 4)
+		{
+			const __m128 pixelCenterX = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), pixelCenterOffset);
+
+			__m128 insideMask = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeAList[0], pixelCenterX), edgeRowList[0]), zero);
+			for (UINT i = 1; i < vertexCount; i++)
+			{
+				insideMask = _mm_and_ps(insideMask, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeAList[i], pixelCenterX), edgeRowList[i]), zero));
+			}
+			if (_mm_movemask_ps(insideMask) == 0)
+			{
+				continue;
+			}
+
+			const __m128 oldDepth = _mm_loadu_ps(pRow + x);
+			const __m128 newDepth = _mm_min_ps(oldDepth, occluderDepth);
+			_mm_storeu_ps(pRow + x, _mm_or_ps(_mm_and_ps(insideMask, newDepth), _mm_andnot_ps(insideMask, oldDepth)));
+		}
+	}
+}
+
+void COcclusionCuller::BuildDepthPyramid()
+{
+	for (size_t levelIndex = 1; levelIndex < m_levelList.size(); levelIndex++)
+	{
+		const DepthLevel& srcLevel = m_levelList[levelIndex - 1];
+		DepthLevel& destLevel = m_levelList[levelIndex];
+
+		// 홀수 크기면 마지막 texel은 가장자리를 다시 읽는다
+		for (UINT y = 0; y < destLevel.Height; y++)
+		{
+			const UINT srcY0 = y * 2;
+			const UINT srcY1 = (std::min)(srcY0 + 1, srcLevel.Height - 1);
+			const float* pSrcRow0 = srcLevel.DepthList.data() + static_cast<size_t>(srcY0) * srcLevel.Width;
+			const float* pSrcRow1 = srcLevel.DepthList.data() + static_cast<size_t>(srcY1) * srcLevel.Width;
+			float* pDestRow = destLevel.DepthList.data() + static_cast<size_t>(y) * destLevel.Width;
+			for (UINT x = 0; x < destLevel.Width; x++)
+			{
+				const UINT srcX0 = x * 2;
+				const UINT srcX1 = (std::min)(srcX0 + 1, srcLevel.Width - 1);
+				const float maxDepth0 = (std::max)(pSrcRow0[srcX0], pSrcRow0[srcX1]);
+				const float maxDepth1 = (std::max)(pSrcRow1[srcX0], pSrcRow1[srcX1]);
+				pDestRow[x] = (std::max)(maxDepth0, maxDepth1);
+			}
+		}
+	}
+}
+
+UINT COcclusionCuller::BuildConvexHull(const ScreenVertex inVertices[8], ScreenVertex outHull[8])
+{
+	// Andrew's monotone chain. 결과는 Cross > 0 방향, 일직선 위의 점은 제외
+	ScreenVertex sortedVertices[8];
+	std::copy(inVertices, inVertices + 8, sortedVertices);
+	std::sort(sortedVertices, sortedVertices + 8, [](const ScreenVertex& a, const ScreenVertex& b)
+		{
+			return a.X < b.X || (a.X == b.X && a.Y < b.Y);
+		});
+
+	ScreenVertex chain[16];
+	UINT count = 0;
+	for (UINT i = 0; i < 8; i++)
+	{
+		const ScreenVertex& p = sortedVertices[i];
+		while (count >= 2 && Cross(chain[count - 2].X, chain[count - 2].Y, chain[count - 1].X, chain[count - 1].Y, p.X, p.Y) <= 0.0f)
+		{
+			count--;
+		}
+		chain[count++] = p;
+	}
+
+	const UINT lowerCount = count + 1;
+	for (int i = 6; i >= 0; i--)
+	{
+		const ScreenVertex& p = sortedVertices[i];
+		while (count >= lowerCount && Cross(chain[count - 2].X, chain[count - 2].Y, chain[count - 1].X, chain[count - 1].Y, p.X, p.Y) <= 0.0f)
+		{
+			count--;
+		}
+		chain[count++] = p;
+	}
+
+	// 마지막 점은 첫 점과 같다
+	const UINT hullCount = (count > 1) ? count - 1 : count;
+	std::copy(chain, chain + hullCount, outHull);
+	return hullCount;
+}
+
+void COcclusionCuller::MultiplyMatrix(const XMFLOAT4X4& a, const XMFLOAT4X4& b, XMFLOAT4X4* pOutMatrix)
+{
+	const __m128 bRow0 = _mm_loadu_ps(&b.m[0][0]);
+	const __m128 bRow1 = _mm_loadu_ps(&b.m[1][0]);
+	const __m128 bRow2 = _mm_loadu_ps(&b.m[2][0]);
+	const __m128 bRow3 = _mm_loadu_ps(&b.m[3][0]);
+
+	for (UINT i = 0; i < 4; i++)
+	{
+		__m128 row = _mm_mul_ps(_mm_set1_ps(a.m[i][0]), bRow0);
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[i][1]), bRow1));
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[i][2]), bRow2));
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[i][3]), bRow3));
+		_mm_storeu_ps(&pOutMatrix->m[i][0], row);
+	}
+}
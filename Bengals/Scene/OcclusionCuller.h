@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vector>
+#include "DynamicAabbTree.h"
+
+/**
+ * CPU occlusion culling against a low-resolution software depth buffer.
+ *
+ * Each frame BeginFrame / AddOccluder / EndOccluders rasterize a few large occluder
+ * boxes, then IsOccluded tests world AABBs against a max-depth pyramid built from the
+ * buffer. An occluder is drawn as its convex screen silhouette at its farthest depth,
+ * four pixels at a time with SSE, and only into pixels it fully covers, so it never
+ * hides more than the real box would. A box is occluded when its nearest depth lies
+ * behind every pyramid texel under its screen rectangle; boxes crossing the near plane
+ * are always visible. Depth follows D3D (0 near, 1 far). CPU only; IsOccluded may be
+ * called from several threads once EndOccluders has returned.
+ */
+
+class COcclusionCuller
+{
+public:
+	static constexpr UINT DefaultWidth = 256;
+	static constexpr UINT DefaultHeight = 128;
+
+public:
+	COcclusionCuller() = default;
+	~COcclusionCuller() = default;
+
+	// width는 4의 배수 (SSE로 4픽셀씩 기록)
+	bool Initialize(UINT width = DefaultWidth, UINT height = DefaultHeight);
+
+	void BeginFrame(const XMFLOAT4X4& viewProjMatrix);
+	bool AddOccluder(const Aabb& localBounds, const XMFLOAT4X4& worldMatrix);
+	void EndOccluders();
+
+	bool IsOccluded(const Aabb& worldBounds) const;
+
+	// occluder 선택용. 화면 밖이거나 near plane에 걸리면 0
+	float GetScreenArea(const Aabb& worldBounds) const;
+
+	UINT GetOccluderCount() const
+	{
+		return m_occluderCount;
+	}
+
+	UINT GetWidth() const
+	{
+		return m_width;
+	}
+
+	UINT GetHeight() const
+	{
+		return m_height;
+	}
+
+	// level 0 = 픽셀 깊이, 이후 2x2 최댓값 (디버그 표시용)
+	const float* GetDepthLevel(UINT level) const;
+	UINT GetLevelCount() const
+	{
+		return static_cast<UINT>(m_levelList.size());
+	}
+
+private:
+	struct ScreenVertex
+	{
+		float X = 0.0f;
+		float Y = 0.0f;
+		float Z = 0.0f;
+	};
+
+	struct DepthLevel
+	{
+		std::vector<float> DepthList = {};
+		UINT Width = 0;
+		UINT Height = 0;
+	};
+
+	bool ProjectBox(const Aabb& box, const XMFLOAT4X4& matrix, ScreenVertex outVertices[8]) const;
+	void RasterizeConvexPolygon(const ScreenVertex* pVertices, UINT vertexCount, float depth);
+	void BuildDepthPyramid();
+
+	static UINT BuildConvexHull(const ScreenVertex inVertices[8], ScreenVertex outHull[8]);
+	static void MultiplyMatrix(const XMFLOAT4X4& a, const XMFLOAT4X4& b, XMFLOAT4X4* pOutMatrix);
+
+private:
+	std::vector<DepthLevel> m_levelList = {};
+	XMFLOAT4X4 m_viewProjMatrix = {};
+	UINT m_width = 0;
+	UINT m_height = 0;
+	UINT m_occluderCount = 0;
+};
@@ -0,0 +1,167 @@
+#include "pch.h"
+#include <algorithm>
+#include "WorkerPool.h"
+#include "TaskGraph.h"
+#include "Profiler/Profiler.h"
+
+TaskHandle CTaskGraph::AddTask(const char* name, TaskFunc func)
+{
+	if (!func)
+	{
+		__debugbreak();
+		return InvalidTask;
+	}
+
+	auto pNode = std::make_unique<TaskNode>();
+	pNode->Name = name;
+	pNode->Func = std::move(func);
+
+	m_taskList.push_back(std::move(pNode));
+	return static_cast<TaskHandle>(m_taskList.size() - 1);
+}
+
+TaskHandle CTaskGraph::AddParallelTask(const char* name, UINT itemCount, UINT batchSize, RangeTaskFunc func)
+{
+	if (!func || batchSize == 0)
+	{
+		__debugbreak();
+		return InvalidTask;
+	}
+
+	auto pNode = std::make_unique<TaskNode>();
+	pNode->Name = name;
+	pNode->RangeFunc = std::move(func);
+	pNode->ItemCount = itemCount;
+	pNode->BatchSize = batchSize;
+
+	m_taskList.push_back(std::move(pNode));
+	return static_cast<TaskHandle>(m_taskList.size() - 1);
+}
+
+bool CTaskGraph::AddDependency(TaskHandle beforeTask, TaskHandle afterTask)
+{
+	if (beforeTask >= m_taskList.size() || afterTask >= m_taskList.size() || beforeTask == afterTask)
+	{
+		__debugbreak();
+		return false;
+	}
+
+	m_taskList[beforeTask]->SuccessorList.push_back(afterTask);
+	m_taskList[afterTask]->DependencyCount++;
+	return true;
+}
+
+void CTaskGraph::Execute(CWorkerPool* pWorkerPool)
+{
+	if (!pWorkerPool)
+	{
+		__debugbreak();
+		return;
+	}
+
+	if (m_taskList.empty())
+	{
+		return;
+	}
+
+	std::atomic<UINT> pendingJobCounter = 0;
+	m_pWorkerPool = pWorkerPool;
+	m_pPendingJobCounter = &pendingJobCounter;
+	m_completedTaskCount.store(0, std::memory_order_relaxed);
+
+	for (auto& pNode : m_taskList)
+	{
+		pNode->RemainingDependencyCount.store(pNode->DependencyCount, std::memory_order_relaxed);
+	}
+
+	for (TaskHandle task = 0; task < m_taskList.size(); task++)
+	{
+		if (m_taskList[task]->DependencyCount == 0)
+		{
+			ScheduleTask(task);
+		}
+	}
+
+	// 후속 작업은 선행 작업의 job이 끝나기 전에 Submit되므로 카운터가 중간에 0이 되지 않는다
+	pWorkerPool->Wait(pendingJobCounter);
+
+	if (m_completedTaskCount.load(std::memory_order_acquire) != m_taskList.size())
+	{
+		// dependency cycle
+		__debugbreak();
+	}
+
+	m_pWorkerPool = nullptr;
+	m_pPendingJobCounter = nullptr;
+}
+
+void CTaskGraph::Reset()
+{
+	m_taskList.clear();
+}
+
+const char* CTaskGraph::GetTaskName(TaskHandle task) const
+{
+	if (task >= m_taskList.size())
+	{
+		return nullptr;
+	}
+	return m_taskList[task]->Name;
+}
+
+void CTaskGraph::ScheduleTask(TaskHandle task)
+{
+	TaskNode* pNode = m_taskList[task].get();
+
+	if (!pNode->RangeFunc)
+	{
+		m_pWorkerPool->Submit([this, pNode, task]()
+			{
+				{
+					PROFILE_SCOPE(pNode->Name);
+					pNode->Func();
+				}
+				CompleteTask(task);
+			}, m_pPendingJobCounter);
+		return;
+	}
+
+	const UINT batchCount = (pNode->ItemCount + pNode->BatchSize - 1) / pNode->BatchSize;
+	if (batchCount == 0)
+	{
+		CompleteTask(task);
+		return;
+	}
+
+	pNode->RemainingBatchCount.store(batchCount, std::memory_order_relaxed);
+	for (UINT batchIndex = 0; batchIndex < batchCount; batchIndex++)
+	{
+		const UINT beginIndex = batchIndex * pNode->BatchSize;
+		const UINT endIndex = (std::min)(beginIndex + pNode->BatchSize, pNode->ItemCount);
+
+		m_pWorkerPool->Submit([this, pNode, task, beginIndex, endIndex]()
+			{
+				{
+					PROFILE_SCOPE(pNode->Name);
+					pNode->RangeFunc(beginIndex, endIndex);
+				}
+				if (pNode->RemainingBatchCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					CompleteTask(task);
+				}
+			}, m_pPendingJobCounter);
+	}
+}
+
+void CTaskGraph::CompleteTask(TaskHandle task)
+{
+	m_completedTaskCount.fetch_add(1, std::memory_order_acq_rel);
+
+	for (TaskHandle successor : m_taskList[task]->SuccessorList)
+	{
+		if (m_taskList[successor]->RemainingDependencyCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			ScheduleTask(successor);
+		}
+	}
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <climits>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class CWorkerPool;
+
+using TaskHandle = UINT;
+
+/**
+ * Small dependency graph of jobs executed on a CWorkerPool.
+ *
+ * A task becomes ready once every task it depends on has completed. Parallel tasks
+ * split [0, itemCount) into batches that run as separate jobs; the task completes
+ * when its last batch finishes. Execute() blocks until the whole graph is done.
+ * The graph may be executed repeatedly; Reset() removes all tasks.
+ */
+class CTaskGraph
+{
+public:
+	using TaskFunc = std::function<void()>;
+	using RangeTaskFunc = std::function<void(UINT beginIndex, UINT endIndex)>;
+
+	static constexpr TaskHandle InvalidTask = UINT_MAX;
+
+public:
+	CTaskGraph() = default;
+	~CTaskGraph() = default;
+
+	TaskHandle AddTask(const char* name, TaskFunc func);
+	TaskHandle AddParallelTask(const char* name, UINT itemCount, UINT batchSize, RangeTaskFunc func);
+	bool AddDependency(TaskHandle beforeTask, TaskHandle afterTask);
+
+	void Execute(CWorkerPool* pWorkerPool);
+	void Reset();
+
+	UINT GetTaskCount() const
+	{
+		return static_cast<UINT>(m_taskList.size());
+	}
+
+	const char* GetTaskName(TaskHandle task) const;
+
+private:
+	struct TaskNode
+	{
+		const char* Name = nullptr;
+		TaskFunc Func = nullptr;
+		RangeTaskFunc RangeFunc = nullptr;
+		UINT ItemCount = 0;
+		UINT BatchSize = 0;
+		std::vector<TaskHandle> SuccessorList = {};
+		UINT DependencyCount = 0;
+		std::atomic<UINT> RemainingDependencyCount = 0;
+		std::atomic<UINT> RemainingBatchCount = 0;
+	};
+
+	void ScheduleTask(TaskHandle task);
+	void CompleteTask(TaskHandle task);
+
+private:
+	std::vector<std::unique_ptr<TaskNode>> m_taskList = {};
+
+	// Execute() 동안에만 유효
+	CWorkerPool* m_pWorkerPool = nullptr;
+	std::atomic<UINT>* m_pPendingJobCounter = nullptr;
+	std::atomic<UINT> m_completedTaskCount = 0;
+};
@@ -0,0 +1,182 @@
+#include "pch.h"
+#include <string>
+#include "WorkerPool.h"
+#include "Profiler/Profiler.h"
+#include "../../Util/ProcessorInfo.h"
+
+CWorkerPool::~CWorkerPool()
+{
+	Cleanup();
+}
+
+bool CWorkerPool::Initialize(UINT workerCount, bool bPinToCores)
+{
+	Cleanup();
+
+	// 물리 코어보다 워커가 많으면 SMT 형제끼리 겹치므로 고정하지 않고 OS에 맡긴다
+	m_workerAffinityList.clear();
+	if (bPinToCores)
+	{
+		const ProcessorTopology& topology = GetProcessorTopology();
+		if (workerCount < topology.GetPhysicalCoreCount())
+		{
+			GetWorkerAffinityList(topology, 1, &m_workerAffinityList);
+		}
+	}
+
+	m_bQuit = false;
+	m_workerList.reserve(workerCount);
+	for (UINT workerIndex = 0; workerIndex < workerCount; workerIndex++)
+	{
+		m_workerList.emplace_back(&CWorkerPool::WorkerMain, this, workerIndex);
+	}
+
+	return true;
+}
+
+void CWorkerPool::Submit(JobFunc job, std::atomic<UINT>* pCounter)
+{
+	if (!job)
+	{
+		__debugbreak();
+		return;
+	}
+
+	if (pCounter)
+	{
+		pCounter->fetch_add(1, std::memory_order_relaxed);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_jobQueue.push_back(Job{ std::move(job), pCounter });
+	}
+	m_queueCondition.notify_one();
+}
+
+void CWorkerPool::Wait(std::atomic<UINT>& counter)
+{
+	while (true)
+	{
+		const UINT pendingCount = counter.load(std::memory_order_acquire);
+		if (pendingCount == 0)
+		{
+			// 마지막 작업이 아직 notify_all 중일 수 있다. 끝난 뒤에 반환해야 호출자가 counter를 없앨 수 있다
+			std::lock_guard<std::mutex> lock(m_counterMutex);
+			break;
+		}
+
+		// 대기하는 동안 호출 스레드도 큐의 작업을 처리한다
+		if (RunPendingJob())
+		{
+			continue;
+		}
+
+		counter.wait(pendingCount, std::memory_order_acquire);
+	}
+}
+
+bool CWorkerPool::RunPendingJob()
+{
+	Job job = {};
+	if (!PopJob(&job))
+	{
+		return false;
+	}
+
+	RunJob(job);
+	return true;
+}
+
+UINT CWorkerPool::GetDefaultWorkerCount()
+{
+	// 메인 스레드가 Wait() 중에 작업을 돕기 때문에 코어 하나는 남겨둔다.
+	// SMT 형제 스레드는 같은 코어의 실행 유닛과 L1/L2를 나눠 쓰므로 물리 코어 수 기준
+	const UINT physicalCoreCount = GetProcessorTopology().GetPhysicalCoreCount();
+	if (physicalCoreCount <= 1)
+	{
+		return 0;
+	}
+
+	return physicalCoreCount - 1;
+}
+
+void CWorkerPool::WorkerMain(UINT workerIndex)
+{
+	PROFILE_THREAD_NAME(("Worker " + std::to_string(workerIndex)).c_str());
+
+	if (workerIndex < m_workerAffinityList.size())
+	{
+		SetCurrentThreadAffinity(m_workerAffinityList[workerIndex]);
+	}
+
+	while (true)
+	{
+		Job job = {};
+		{
+			std::unique_lock<std::mutex> lock(m_queueMutex);
+			m_queueCondition.wait(lock, [this]() { return m_bQuit || !m_jobQueue.empty(); });
+			if (m_jobQueue.empty())
+			{
+				// m_bQuit && empty
+				return;
+			}
+
+			job = std::move(m_jobQueue.front());
+			m_jobQueue.pop_front();
+		}
+
+		RunJob(job);
+	}
+}
+
+bool CWorkerPool::PopJob(Job* pOutJob)
+{
+	std::lock_guard<std::mutex> lock(m_queueMutex);
+	if (m_jobQueue.empty())
+	{
+		return false;
+	}
+
+	*pOutJob = std::move(m_jobQueue.front());
+	m_jobQueue.pop_front();
+	return true;
+}
+
+void CWorkerPool::RunJob(Job& job)
+{
+	job.Func();
+
+	if (job.pCounter)
+	{
+		std::lock_guard<std::mutex> lock(m_counterMutex);
+		if (job.pCounter->fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			job.pCounter->notify_all();
+		}
+	}
+}
+
+void CWorkerPool::Cleanup()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_bQuit = true;
+	}
+	m_queueCondition.notify_all();
+
+	for (std::thread& worker : m_workerList)
+	{
+		if (worker.joinable())
+		{
+			worker.join();
+		}
+	}
+
+	m_workerList.clear();
+
+	// 워커가 없으면 큐가 남아 있다. 버리면 그 counter를 기다리는 스레드가 끝나지 않으므로 여기서 실행
+	while (RunPendingJob())
+	{
+	}
+}
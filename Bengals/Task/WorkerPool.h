@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Worker thread pool shared by the game update and the renderer.
+ *
+ * Jobs go into a single FIFO queue. Each job can be tied to a counter that is
+ * incremented on Submit() and decremented after the job has run; Wait() returns
+ * when the counter reaches zero and runs queued jobs on the calling thread meanwhile,
+ * so a pool with zero workers still makes progress. The counter usually lives on the
+ * waiting thread's stack, so the final decrement and its notify happen under
+ * m_counterMutex and Wait() takes the same lock before returning.
+ * Cleanup() runs jobs still in the queue so no counter is left waiting.
+ * The default size is one worker per physical core minus the main thread's core; with
+ * bPinToCores each worker is pinned to its own physical core (see GetWorkerAffinityList).
+ */
+class CWorkerPool
+{
+public:
+	using JobFunc = std::function<void()>;
+
+public:
+	CWorkerPool() = default;
+	~CWorkerPool();
+
+	bool Initialize(UINT workerCount, bool bPinToCores = true);
+
+	void Submit(JobFunc job, std::atomic<UINT>* pCounter);
+	void Wait(std::atomic<UINT>& counter);
+	bool RunPendingJob();
+
+	UINT GetWorkerCount() const
+	{
+		return static_cast<UINT>(m_workerList.size());
+	}
+
+	static UINT GetDefaultWorkerCount();
+
+private:
+	struct Job
+	{
+		JobFunc Func = nullptr;
+		std::atomic<UINT>* pCounter = nullptr;
+	};
+
+	void WorkerMain(UINT workerIndex);
+	bool PopJob(Job* pOutJob);
+	void RunJob(Job& job);
+	void Cleanup();
+
+private:
+	std::vector<std::thread> m_workerList = {};
+	std::vector<uint32_t> m_workerAffinityList = {};		// 워커 인덱스 -> logical processor, 비어 있으면 고정하지 않음
+	std::deque<Job> m_jobQueue = {};
+	std::mutex m_queueMutex;
+	std::condition_variable m_queueCondition;
+	std::mutex m_counterMutex;		// counter 감소 ~ notify 구간. Wait는 이것이 끝난 뒤 반환
+	bool m_bQuit = false;
+};
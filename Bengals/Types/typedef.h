@@ -1,7 +1,11 @@
 #pragma once
 
 #include <DirectXMath.h>
+#include <DirectXPackedVector.h>
 #include <string>
+#include "../Renderer/RenderHelper/DirtyRectList.h"
+#include "../Renderer/RenderHelper/MeshLod.h"
+#include "../Renderer/RenderHelper/IndexCluster.h"
 
 using namespace DirectX;
 
@@ -18,6 +22,14 @@ struct VertexPos3Color4Tex2
 	XMFLOAT2 TexCoord;
 };
 
+// VertexPos3Color4Tex2의 양자화 형식 (36 -> 16 bytes). VertexQuantizer.h 참고
+struct VertexPackedPos3Color4Tex2
+{
+	INT16 Position[4];		// SNORM16, 메시 bounds 기준. w = 1
+	BYTE Color[4];			// RGBA8 UNORM
+	PackedVector::HALF TexCoord[2];
+};
+
 union RGBA
 {
 	struct
@@ -35,6 +47,8 @@ struct ConstantBufferDefault
 	XMMATRIX WorldMatrix;
 	XMMATRIX ViewMatrix;
 	XMMATRIX ProjectionMatrix;
+	XMFLOAT4 PositionScale;		// QUANTIZED_VERTEX: position = snorm * scale + offset
+	XMFLOAT4 PositionOffset;
 };
 
 struct ConstantBufferSprite
@@ -67,18 +81,30 @@ struct ConstantBufferProperty
 struct TextureHandle
 {
 	ID3D12Resource* TextureResource = nullptr;
-	ID3D12Resource* pUploadBuffer = nullptr;
 	D3D12_CPU_DESCRIPTOR_HANDLE SrvDescriptorHandle = {};
+
+	// 동적 텍스처: 프레임 컨텍스트마다 업로드 slice 하나. GPU가 읽는 중인 slice에는 쓰지 않는다
+	ID3D12Resource* pUploadBuffer = nullptr;
+	BYTE* pMappedUploadBuffer = nullptr;		// 영구 매핑
+	UINT64 UploadSliceSize = 0;
+	UINT UploadSliceIndex = 0;					// 이번 프레임에 쓴 slice
 	bool bUpdated = false;
-	DWORD RefCount = 0;
+	CDirtyRectList DirtyRectList;				// 이번 프레임에 텍스처로 복사할 영역
+	std::vector<CDirtyRectList> StaleRectLists;	// slice별로 다른 slice에만 쓰여 아직 반영되지 않은 영역
+
+	DWORD RefCount = 0;		// 파일 텍스처는 같은 경로로 받은 횟수
 	bool bFromFile = false;
-	std::wstring FilePath;
+	UINT64 ContentHash = 0;			// 파일 텍스처: DDS 파일 바이트의 CAssetArchive::HashBytes
+	UINT64 ContentSize = 0;
+	UINT64 ResourceSize = 0;		// GPU 할당 크기 (중복 제거 통계용)
+	UINT64 PathId = 0;				// 경로 하나에 핸들 하나. 내용이 같은 경로끼리는 TextureResource만 공유 (AddRef)
 };
 
 struct IndexedTriGroup
 {
-	ComPtr<ID3D12Resource> IndexBuffer = nullptr;
-	D3D12_INDEX_BUFFER_VIEW IndexBufferView = {};
-	UINT TriangleCount = 0;
+	ComPtr<ID3D12Resource> IndexBuffer = nullptr;		// LOD 0 ~ LodCount-1의 인덱스를 이어 붙인 버퍼
+	D3D12_INDEX_BUFFER_VIEW IndexBufferViews[MaxMeshLodCount] = {};		// 모든 LOD가 같은 형식 (R16 / R32)
+	UINT TriangleCounts[MaxMeshLodCount] = {};
+	std::vector<IndexedTriCluster> ClusterLists[MaxMeshLodCount];		// R32면 cluster 1개
 	TextureHandle* pTexHandle = nullptr;
 };
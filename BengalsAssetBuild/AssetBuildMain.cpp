@@ -0,0 +1,203 @@
+#include "pch.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Asset/AssetArchive.h"
+
+// usage: BengalsAssetBuild [--root DIR] [--mount PREFIX] [--out FILE] [--compress none|lz4] [--align N]
+//   DIR 아래의 모든 파일을 하나의 아카이브로 묶는다. 항목 경로는 PREFIX + DIR 기준 상대 경로이다.
+//   PREFIX 기본값은 --root에 준 문자열이므로, 게임이 여는 경로(L"../Resources/Image/...")와 같게 만들려면
+//   작업 디렉터리 기준 경로를 그대로 --root로 준다. 내용이 같으면 파일을 다시 쓰지 않는다.
+//   Linux: g++ -std=c++20 -O2 -include pch.h -I. -I../Bengals AssetBuildMain.cpp
+//          ../Bengals/Asset/AssetArchive.cpp ../Bengals/Asset/Lz4Codec.cpp ../Bengals/Asset/MappedFile.cpp -o BengalsAssetBuild
+
+namespace
+{
+	struct AssetBuildOptions
+	{
+		const char* pSourceRoot = "../Resources";
+		const char* pMountPrefix = nullptr;		// nullptr이면 pSourceRoot
+		const char* pOutputFileName = "Assets.bpk";
+		EAssetCompression Compression = EAssetCompression::Lz4;
+		UINT PayloadAlignment = CAssetArchive::DefaultPayloadAlignment;
+	};
+
+	struct AssetBuildStats
+	{
+		UINT FileCount = 0;
+		UINT CompressedCount = 0;
+		UINT64 SourceSize = 0;
+		UINT64 StoredSize = 0;
+	};
+
+	bool ParseOptions(int argc, char* argv[], AssetBuildOptions* pOutOptions)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			const char* pArg = argv[i];
+			const bool bHasValue = (i + 1 < argc);
+			if (strcmp(pArg, "--root") == 0 && bHasValue)
+			{
+				pOutOptions->pSourceRoot = argv[++i];
+			}
+			else if (strcmp(pArg, "--mount") == 0 && bHasValue)
+			{
+				pOutOptions->pMountPrefix = argv[++i];
+			}
+			else if (strcmp(pArg, "--out") == 0 && bHasValue)
+			{
+				pOutOptions->pOutputFileName = argv[++i];
+			}
+			else if (strcmp(pArg, "--compress") == 0 && bHasValue)
+			{
+				const char* pValue = argv[++i];
+				if (strcmp(pValue, "none") == 0)
+				{
+					pOutOptions->Compression = EAssetCompression::None;
+				}
+				else if (strcmp(pValue, "lz4") == 0)
+				{
+					pOutOptions->Compression = EAssetCompression::Lz4;
+				}
+				else
+				{
+					printf("unsupported compression: %s\n", pValue);
+					return false;
+				}
+			}
+			else if (strcmp(pArg, "--align") == 0 && bHasValue)
+			{
+				pOutOptions->PayloadAlignment = static_cast<UINT>(strtoul(argv[++i], nullptr, 10));
+				if (pOutOptions->PayloadAlignment == 0)
+				{
+					printf("invalid alignment\n");
+					return false;
+				}
+			}
+			else
+			{
+				printf("unknown or incomplete option: %s\n", pArg);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool ReadBinaryFile(const std::filesystem::path& path, std::vector<BYTE>& outData)
+	{
+		outData.clear();
+
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file)
+		{
+			return false;
+		}
+
+		const std::streamsize fileSize = file.tellg();
+		if (fileSize < 0)
+		{
+			return false;
+		}
+
+		outData.resize(static_cast<size_t>(fileSize));
+		file.seekg(0, std::ios::beg);
+		return fileSize == 0 || static_cast<bool>(file.read(reinterpret_cast<char*>(outData.data()), fileSize));
+	}
+
+	std::string ToUtf8(const std::filesystem::path& path)
+	{
+		const std::u8string utf8 = path.generic_u8string();
+		return std::string(reinterpret_cast<const char*>(utf8.data()), utf8.size());
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	AssetBuildOptions options = {};
+	if (!ParseOptions(argc, argv, &options))
+	{
+		return 2;
+	}
+
+	const std::filesystem::path sourceRoot = options.pSourceRoot;
+	std::string mountPrefix = options.pMountPrefix ? options.pMountPrefix : options.pSourceRoot;
+	if (!mountPrefix.empty() && mountPrefix.back() != '/' && mountPrefix.back() != '\\')
+	{
+		mountPrefix += '/';
+	}
+
+	const std::filesystem::path outputPath = std::filesystem::absolute(options.pOutputFileName);
+
+	std::error_code errorCode;
+	std::vector<std::filesystem::path> fileList;
+	for (std::filesystem::recursive_directory_iterator iter(sourceRoot, errorCode), end; !errorCode && iter != end; iter.increment(errorCode))
+	{
+		if (iter->is_regular_file() && std::filesystem::absolute(iter->path()) != outputPath)
+		{
+			fileList.push_back(iter->path());
+		}
+	}
+	if (errorCode)
+	{
+		printf("cannot enumerate %s\n", options.pSourceRoot);
+		return 2;
+	}
+
+	// 디렉터리 순회 순서와 관계없이 같은 결과
+	std::sort(fileList.begin(), fileList.end());
+
+	CAssetArchiveBuilder builder;
+	AssetBuildStats stats = {};
+	std::vector<BYTE> data;
+	for (const std::filesystem::path& filePath : fileList)
+	{
+		const std::string entryName = mountPrefix + ToUtf8(filePath.lexically_relative(sourceRoot));
+		if (!ReadBinaryFile(filePath, data))
+		{
+			printf("cannot read %s\n", ToUtf8(filePath).c_str());
+			return 1;
+		}
+
+		UINT64 storedSize = 0;
+		if (!builder.AddEntry(entryName.c_str(), data.data(), data.size(), options.Compression, &storedSize))
+		{
+			// 대소문자만 다른 경로 등
+			printf("duplicate entry: %s\n", entryName.c_str());
+			return 1;
+		}
+
+		stats.FileCount++;
+		stats.SourceSize += data.size();
+		stats.StoredSize += storedSize;
+		if (storedSize < data.size())
+		{
+			stats.CompressedCount++;
+		}
+	}
+
+	// 내용이 같으면 파일을 다시 쓰지 않는다 (타임스탬프 유지)
+	std::vector<BYTE> newData;
+	builder.Serialize(newData, options.PayloadAlignment);
+	std::vector<BYTE> oldData;
+	if (ReadBinaryFile(outputPath, oldData) && oldData == newData)
+	{
+		printf("assets up to date: %u entries\n", builder.GetEntryCount());
+		return 0;
+	}
+
+	std::ofstream file(outputPath, std::ios::binary | std::ios::trunc);
+	if (!file || !file.write(reinterpret_cast<const char*>(newData.data()), static_cast<std::streamsize>(newData.size())))
+	{
+		printf("cannot write %s\n", ToUtf8(outputPath).c_str());
+		return 1;
+	}
+
+	printf("%s: %u entries (%u compressed), %llu -> %llu payload bytes, %zu bytes total\n",
+		ToUtf8(outputPath).c_str(), stats.FileCount, stats.CompressedCount,
+		static_cast<unsigned long long>(stats.SourceSize), static_cast<unsigned long long>(stats.StoredSize), newData.size());
+	return 0;
+}
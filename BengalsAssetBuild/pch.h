@@ -0,0 +1,37 @@
+// pch.h: precompiled header for the offline asset archive build tool.
+// 디바이스와 d3d 헤더를 쓰지 않는다. Linux에서도 g++로 빌드된다 (AssetBuildMain.cpp 참고).
+
+#ifndef PCH_H
+#define PCH_H
+
+#ifdef _WIN32
+
+#define WIN32_LEAN_AND_MEAN             // Exclude rarely-used stuff from Windows headers
+
+#include <windows.h>
+
+#else
+
+#include <cstdint>
+
+typedef uint8_t BYTE;
+typedef uint8_t UINT8;
+typedef uint16_t WORD;
+typedef uint32_t DWORD;
+typedef int32_t INT;
+typedef uint32_t UINT;
+typedef uint64_t UINT64;
+typedef wchar_t WCHAR;
+
+#define __debugbreak() __builtin_trap()
+
+#endif
+
+// C RunTime Header Files
+#include <stdlib.h>
+#include <memory.h>
+
+// C++ Standard Library
+#include <memory>
+
+#endif //PCH_H
@@ -0,0 +1,289 @@
+#include "pch.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "AabbTreeBench.h"
+#include "BenchCheck.h"
+#include "Scene/DynamicAabbTree.h"
+
+namespace
+{
+	constexpr UINT ProxyCountList[] = { 10000, 100000, 1000000 };
+	constexpr UINT MoveCountPerIteration = 10000;
+	constexpr UINT QueryCountPerIteration = 1000;
+	constexpr UINT VerifyQueryCount = 16;
+	constexpr float FatMargin = 0.1f;				// CGame과 같은 값
+	constexpr float ProxySpacing = 4.0f;			// proxy 하나가 차지하는 평균 간격. 크기와 관계없이 밀도가 같다
+	constexpr float ProxyHalfSize = 0.5f;
+	constexpr float QueryHalfSize = 8.0f;
+	constexpr float JitterDistance = 0.05f;			// fat margin 안쪽의 프레임당 이동
+	constexpr UINT TeleportPercent = 5;				// 다시 삽입되는 이동의 비율
+	constexpr float DistanceEpsilon = 1e-3f;
+
+	struct AabbTreeBenchResult
+	{
+		double CreateNs = 0.0;
+		double MoveNs = 0.0;
+		double QueryNs = 0.0;
+		double RayCastNs = 0.0;
+		double ReinsertPercent = 0.0;
+		double HitsPerQuery = 0.0;
+		double RayHitPercent = 0.0;
+		int Height = 0;
+	};
+
+	struct MoveRequest
+	{
+		int ProxyIndex = 0;
+		Aabb Box = {};
+	};
+
+	struct RayRequest
+	{
+		XMFLOAT3 Origin = {};
+		XMFLOAT3 Direction = {};
+	};
+
+	Aabb MakeBox(const XMFLOAT3& center, float halfSize)
+	{
+		Aabb box = {};
+		box.Min = { center.x - halfSize, center.y - halfSize, center.z - halfSize };
+		box.Max = { center.x + halfSize, center.y + halfSize, center.z + halfSize };
+		return box;
+	}
+
+	XMFLOAT3 GetCenter(const Aabb& box)
+	{
+		return { (box.Min.x + box.Max.x) * 0.5f, (box.Min.y + box.Max.y) * 0.5f, (box.Min.z + box.Max.z) * 0.5f };
+	}
+
+	bool Overlaps(const Aabb& a, const Aabb& b)
+	{
+		return a.Min.x <= b.Max.x && b.Min.x <= a.Max.x &&
+			a.Min.y <= b.Max.y && b.Min.y <= a.Max.y &&
+			a.Min.z <= b.Max.z && b.Min.z <= a.Max.z;
+	}
+
+	double GetElapsedNs(std::chrono::steady_clock::time_point begin)
+	{
+		return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+	}
+
+	class CAabbTreeBenchScene
+	{
+	public:
+		CAabbTreeBenchScene(UINT proxyCount, UINT seed)
+			: m_random(seed)
+			, m_worldSize(std::cbrt(static_cast<float>(proxyCount)) * ProxySpacing)
+			, m_positionDistribution(0.0f, m_worldSize)
+		{
+			m_boxList.reserve(proxyCount);
+			m_proxyIdList.reserve(proxyCount);
+		}
+
+		bool Create(UINT proxyCount, AabbTreeBenchResult* pOutResult)
+		{
+			if (!m_tree.Initialize(proxyCount, FatMargin))
+			{
+				return false;
+			}
+
+			for (UINT i = 0; i < proxyCount; i++)
+			{
+				m_boxList.push_back(MakeBox(GetRandomPosition(), ProxyHalfSize));
+			}
+
+			const auto begin = std::chrono::steady_clock::now();
+			for (UINT i = 0; i < proxyCount; i++)
+			{
+				m_proxyIdList.push_back(m_tree.CreateProxy(m_boxList[i], reinterpret_cast<void*>(static_cast<size_t>(i) + 1)));
+			}
+			pOutResult->CreateNs = GetElapsedNs(begin) / proxyCount;
+			return m_tree.GetProxyCount() == proxyCount;
+		}
+
+		void RunIteration(double* pMoveNs, double* pQueryNs, double* pRayCastNs, UINT64* pReinsertCount, UINT64* pHitCount, UINT64* pRayHitCount)
+		{
+			// 요청은 시간을 재기 전에 만든다
+			const UINT proxyCount = static_cast<UINT>(m_boxList.size());
+			std::uniform_real_distribution<float> jitterDistribution(-JitterDistance, JitterDistance);
+			m_moveList.clear();
+			for (UINT i = 0; i < MoveCountPerIteration; i++)
+			{
+				MoveRequest move = {};
+				move.ProxyIndex = static_cast<int>(m_random() % proxyCount);
+				XMFLOAT3 center = GetCenter(m_boxList[move.ProxyIndex]);
+				if (m_random() % 100 < TeleportPercent)
+				{
+					center = GetRandomPosition();
+				}
+				else
+				{
+					center = { center.x + jitterDistribution(m_random), center.y + jitterDistribution(m_random), center.z + jitterDistribution(m_random) };
+				}
+				move.Box = MakeBox(center, ProxyHalfSize);
+				m_moveList.push_back(move);
+			}
+
+			m_queryList.clear();
+			m_rayList.clear();
+			for (UINT i = 0; i < QueryCountPerIteration; i++)
+			{
+				m_queryList.push_back(MakeBox(GetRandomPosition(), QueryHalfSize));
+				m_rayList.push_back(GetRandomRay());
+			}
+
+			auto begin = std::chrono::steady_clock::now();
+			for (const MoveRequest& move : m_moveList)
+			{
+				*pReinsertCount += m_tree.MoveProxy(m_proxyIdList[move.ProxyIndex], move.Box) ? 1 : 0;
+				m_boxList[move.ProxyIndex] = move.Box;
+			}
+			*pMoveNs += GetElapsedNs(begin);
+
+			begin = std::chrono::steady_clock::now();
+			for (const Aabb& query : m_queryList)
+			{
+				m_resultList.clear();
+				*pHitCount += m_tree.QueryAabb(query, m_resultList);
+			}
+			*pQueryNs += GetElapsedNs(begin);
+
+			begin = std::chrono::steady_clock::now();
+			for (const RayRequest& ray : m_rayList)
+			{
+				AabbRayHit hit = {};
+				*pRayHitCount += m_tree.RayCast(XMLoadFloat3(&ray.Origin), XMLoadFloat3(&ray.Direction), m_worldSize, &hit) ? 1 : 0;
+			}
+			*pRayCastNs += GetElapsedNs(begin);
+		}
+
+		// 트리 결과를 전체 순회와 비교
+		bool Verify()
+		{
+			bool bResult = true;
+			for (UINT i = 0; i < VerifyQueryCount; i++)
+			{
+				const Aabb query = MakeBox(GetRandomPosition(), QueryHalfSize);
+				m_resultList.clear();
+				const UINT hitCount = m_tree.QueryAabb(query, m_resultList);
+
+				UINT expectedCount = 0;
+				for (const Aabb& box : m_boxList)
+				{
+					expectedCount += Overlaps(box, query) ? 1 : 0;
+				}
+				bResult &= Check(hitCount == expectedCount && m_resultList.size() == expectedCount, "QueryAabb matches brute force");
+
+				const RayRequest ray = GetRandomRay();
+				const XMVECTOR origin = XMLoadFloat3(&ray.Origin);
+				const XMVECTOR direction = XMVector3Normalize(XMLoadFloat3(&ray.Direction));
+				AabbRayHit hit = {};
+				const bool bHit = m_tree.RayCast(origin, direction, m_worldSize, &hit);
+
+				float expectedDistance = m_worldSize;
+				bool bExpectedHit = false;
+				for (const Aabb& box : m_boxList)
+				{
+					BoundingBox boundingBox = {};
+					boundingBox.Center = GetCenter(box);
+					boundingBox.Extents = { ProxyHalfSize, ProxyHalfSize, ProxyHalfSize };
+					float distance = 0.0f;
+					if (boundingBox.Intersects(origin, direction, distance) && (std::max)(distance, 0.0f) <= expectedDistance)
+					{
+						expectedDistance = (std::max)(distance, 0.0f);
+						bExpectedHit = true;
+					}
+				}
+				bResult &= Check(bHit == bExpectedHit && (!bHit || std::fabs(hit.Distance - expectedDistance) < DistanceEpsilon), "RayCast matches brute force");
+			}
+			return bResult;
+		}
+
+		int GetHeight() const
+		{
+			return m_tree.GetHeight();
+		}
+
+	private:
+		XMFLOAT3 GetRandomPosition()
+		{
+			return { m_positionDistribution(m_random), m_positionDistribution(m_random), m_positionDistribution(m_random) };
+		}
+
+		RayRequest GetRandomRay()
+		{
+			std::uniform_real_distribution<float> directionDistribution(-1.0f, 1.0f);
+			RayRequest ray = {};
+			ray.Origin = GetRandomPosition();
+			ray.Direction = { directionDistribution(m_random), directionDistribution(m_random), directionDistribution(m_random) };
+			if (std::fabs(ray.Direction.x) + std::fabs(ray.Direction.y) + std::fabs(ray.Direction.z) < 1e-3f)
+			{
+				ray.Direction.x = 1.0f;
+			}
+			return ray;
+		}
+
+	private:
+		std::mt19937 m_random;
+		float m_worldSize = 0.0f;
+		std::uniform_real_distribution<float> m_positionDistribution;
+		CDynamicAabbTree m_tree;
+		std::vector<Aabb> m_boxList;		// 현재 tight box (전체 순회 비교용)
+		std::vector<int> m_proxyIdList;
+		std::vector<MoveRequest> m_moveList;
+		std::vector<Aabb> m_queryList;
+		std::vector<RayRequest> m_rayList;
+		std::vector<void*> m_resultList;
+	};
+}
+
+bool RunAabbTreeBench(UINT iterationCount)
+{
+	printf("aabb tree: iterations=%u, moves/iteration=%u, queries/iteration=%u, rays/iteration=%u\n\n",
+		iterationCount, MoveCountPerIteration, QueryCountPerIteration, QueryCountPerIteration);
+	printf("%8s %6s %10s %8s %9s %9s %10s %9s %8s\n",
+		"proxies", "height", "create ns", "move ns", "reinsert", "query ns", "hits/query", "ray ns", "ray hit");
+
+	bool bResult = true;
+	for (UINT proxyCount : ProxyCountList)
+	{
+		CAabbTreeBenchScene scene(proxyCount, proxyCount);
+		AabbTreeBenchResult result = {};
+		if (!Check(scene.Create(proxyCount, &result), "CreateProxy"))
+		{
+			bResult = false;
+			continue;
+		}
+
+		double moveNs = 0.0;
+		double queryNs = 0.0;
+		double rayCastNs = 0.0;
+		UINT64 reinsertCount = 0;
+		UINT64 hitCount = 0;
+		UINT64 rayHitCount = 0;
+		for (UINT i = 0; i < iterationCount; i++)
+		{
+			scene.RunIteration(&moveNs, &queryNs, &rayCastNs, &reinsertCount, &hitCount, &rayHitCount);
+		}
+
+		const double moveCount = static_cast<double>(iterationCount) * MoveCountPerIteration;
+		const double queryCount = static_cast<double>(iterationCount) * QueryCountPerIteration;
+		result.MoveNs = moveNs / moveCount;
+		result.QueryNs = queryNs / queryCount;
+		result.RayCastNs = rayCastNs / queryCount;
+		result.ReinsertPercent = reinsertCount * 100.0 / moveCount;
+		result.HitsPerQuery = hitCount / queryCount;
+		result.RayHitPercent = rayHitCount * 100.0 / queryCount;
+		result.Height = scene.GetHeight();
+
+		printf("%8u %6d %10.1f %8.1f %8.1f%% %9.1f %10.2f %9.1f %7.1f%%\n",
+			proxyCount, result.Height, result.CreateNs, result.MoveNs, result.ReinsertPercent,
+			result.QueryNs, result.HitsPerQuery, result.RayCastNs, result.RayHitPercent);
+
+		bResult &= scene.Verify();
+	}
+	return bResult;
+}
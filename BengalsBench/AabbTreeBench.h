@@ -0,0 +1,9 @@
+#pragma once
+
+/**
+ * CDynamicAabbTree 단독 벤치마크. 10k / 100k / 1M proxy를 같은 밀도로 흩어 만들고 CreateProxy, MoveProxy
+ * (대부분 fat box 안의 작은 이동 + 일부 순간이동), QueryAabb, RayCast를 N회씩 실행해 ns/op와 트리 높이를
+ * 출력한다. 일부 질의는 전체 순회 결과와 비교해 다르면 false. GPU 없이 실행된다.
+ */
+
+bool RunAabbTreeBench(UINT iterationCount);
@@ -0,0 +1,105 @@
+#include "pch.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "AllocationCounter.h"
+
+namespace
+{
+	std::atomic<UINT64> g_allocationCount = 0;
+	std::atomic<UINT64> g_allocatedBytes = 0;
+
+	void* CountedAlloc(size_t size)
+	{
+		g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+		g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+		void* pMem = malloc(size ? size : 1);
+		if (!pMem)
+		{
+			throw std::bad_alloc();
+		}
+		return pMem;
+	}
+
+	void* CountedAlignedAlloc(size_t size, std::align_val_t alignment)
+	{
+		g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+		g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+		void* pMem = _aligned_malloc(size ? size : 1, static_cast<size_t>(alignment));
+		if (!pMem)
+		{
+			throw std::bad_alloc();
+		}
+		return pMem;
+	}
+}
+
+AllocationCounters GetAllocationCounters()
+{
+	AllocationCounters counters = {};
+	counters.AllocationCount = g_allocationCount.load(std::memory_order_relaxed);
+	counters.AllocatedBytes = g_allocatedBytes.load(std::memory_order_relaxed);
+	return counters;
+}
+
+void* operator new(size_t size)
+{
+	return CountedAlloc(size);
+}
+
+void* operator new[](size_t size)
+{
+	return CountedAlloc(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	return CountedAlignedAlloc(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return CountedAlignedAlloc(size, alignment);
+}
+
+void operator delete(void* pMem) noexcept
+{
+	free(pMem);
+}
+
+void operator delete[](void* pMem) noexcept
+{
+	free(pMem);
+}
+
+void operator delete(void* pMem, size_t) noexcept
+{
+	free(pMem);
+}
+
+void operator delete[](void* pMem, size_t) noexcept
+{
+	free(pMem);
+}
+
+void operator delete(void* pMem, std::align_val_t) noexcept
+{
+	_aligned_free(pMem);
+}
+
+void operator delete[](void* pMem, std::align_val_t) noexcept
+{
+	_aligned_free(pMem);
+}
+
+void operator delete(void* pMem, size_t, std::align_val_t) noexcept
+{
+	_aligned_free(pMem);
+}
+
+void operator delete[](void* pMem, size_t, std::align_val_t) noexcept
+{
+	_aligned_free(pMem);
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+/**
+ * 전역 operator new/delete를 교체해 힙 할당 횟수와 바이트 수를 센다.
+ * 프레임 전후 값의 차이로 프레임당 할당을 측정한다. (malloc 직접 호출은 포함하지 않음)
+ */
+
+struct AllocationCounters
+{
+	UINT64 AllocationCount = 0;
+	UINT64 AllocatedBytes = 0;
+};
+
+AllocationCounters GetAllocationCounters();
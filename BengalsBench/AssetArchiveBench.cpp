@@ -0,0 +1,133 @@
+#include "pch.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "AssetArchiveBench.h"
+#include "Asset/AssetArchive.h"
+
+namespace
+{
+	using BenchClock = std::chrono::high_resolution_clock;
+
+	double ElapsedMs(BenchClock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+	}
+
+	bool ReadBinaryFile(const std::filesystem::path& path, std::vector<BYTE>& outData)
+	{
+		outData.clear();
+
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file)
+		{
+			return false;
+		}
+
+		const std::streamsize fileSize = file.tellg();
+		if (fileSize < 0)
+		{
+			return false;
+		}
+
+		outData.resize(static_cast<size_t>(fileSize));
+		file.seekg(0, std::ios::beg);
+		return fileSize == 0 || static_cast<bool>(file.read(reinterpret_cast<char*>(outData.data()), fileSize));
+	}
+}
+
+bool RunAssetArchiveBench(const char* pSourceRoot, UINT iterationCount)
+{
+	std::vector<std::filesystem::path> fileList;
+	std::error_code errorCode;
+	for (std::filesystem::recursive_directory_iterator iter(pSourceRoot, errorCode), end; !errorCode && iter != end; iter.increment(errorCode))
+	{
+		if (iter->is_regular_file())
+		{
+			fileList.push_back(iter->path());
+		}
+	}
+	if (errorCode || fileList.empty())
+	{
+		printf("no files under %s\n", pSourceRoot);
+		return false;
+	}
+
+	const std::filesystem::path archivePath = std::filesystem::temp_directory_path() / "BengalsBench.bpk";
+	std::vector<std::vector<BYTE>> sourceDataList(fileList.size());
+	std::vector<std::wstring> entryNameList(fileList.size());
+
+	CAssetArchiveBuilder builder;
+	for (size_t i = 0; i < fileList.size(); i++)
+	{
+		if (!ReadBinaryFile(fileList[i], sourceDataList[i]))
+		{
+			printf("cannot read %s\n", fileList[i].string().c_str());
+			return false;
+		}
+		entryNameList[i] = fileList[i].wstring();
+		builder.AddEntry(fileList[i].generic_string().c_str(), sourceDataList[i].data(), sourceDataList[i].size(), EAssetCompression::Lz4);
+	}
+	if (!builder.WriteToFile(archivePath))
+	{
+		printf("cannot write %s\n", archivePath.string().c_str());
+		return false;
+	}
+
+	printf("%zu files under %s, %u iterations\n", fileList.size(), pSourceRoot, iterationCount);
+
+	// 파일마다 open / read / close
+	std::vector<BYTE> data;
+	BenchClock::time_point start = BenchClock::now();
+	for (UINT iteration = 0; iteration < iterationCount; iteration++)
+	{
+		for (const std::filesystem::path& filePath : fileList)
+		{
+			ReadBinaryFile(filePath, data);
+		}
+	}
+	const double looseMs = ElapsedMs(start) / iterationCount;
+
+	// 아카이브 open 한 번 + 항목 조회 / 읽기
+	bool bMatch = true;
+	UINT compressedCount = 0;
+	start = BenchClock::now();
+	for (UINT iteration = 0; iteration < iterationCount; iteration++)
+	{
+		CAssetArchive archive;
+		if (!archive.Open(archivePath))
+		{
+			printf("cannot open %s\n", archivePath.string().c_str());
+			return false;
+		}
+
+		compressedCount = 0;
+		for (size_t i = 0; i < fileList.size(); i++)
+		{
+			const AssetEntryInfo* pEntry = archive.FindEntry(entryNameList[i].c_str());
+			if (!pEntry || !archive.ReadEntry(*pEntry, &data) || data != sourceDataList[i])
+			{
+				bMatch = false;
+				continue;
+			}
+			compressedCount += (pEntry->Compression != EAssetCompression::None) ? 1 : 0;
+		}
+	}
+	const double archiveMs = ElapsedMs(start) / iterationCount;
+
+	const UINT64 archiveSize = std::filesystem::file_size(archivePath, errorCode);
+	std::filesystem::remove(archivePath, errorCode);
+
+	printf("  loose files   %8.3f ms\n", looseMs);
+	printf("  archive       %8.3f ms  (%u of %zu entries LZ4, %llu bytes)\n", archiveMs, compressedCount, fileList.size(),
+		static_cast<unsigned long long>(archiveSize));
+
+	if (!bMatch)
+	{
+		printf("archive content mismatch\n");
+	}
+	return bMatch;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+/**
+ * CAssetArchive 벤치마크. sourceRoot 아래 파일을 하나씩 열어 읽는 경우와, 같은 파일로 만든
+ * 아카이브를 매핑해 항목을 찾고 읽는 경우의 시간을 비교한다. 아카이브에서 읽은 내용이
+ * 원본과 다르면 false. GPU 없이 실행된다.
+ */
+
+bool RunAssetArchiveBench(const char* pSourceRoot, UINT iterationCount);
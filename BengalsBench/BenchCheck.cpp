@@ -0,0 +1,12 @@
+#include "pch.h"
+#include <cstdio>
+#include "BenchCheck.h"
+
+bool Check(bool bCondition, const char* pMessage)
+{
+	if (!bCondition)
+	{
+		printf("  FAILED: %s\n", pMessage);
+	}
+	return bCondition;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+/**
+ * 벤치마크 검증 모드의 공통 검사. 조건이 거짓이면 "  FAILED: <메시지>"를 출력하고 조건을 그대로 반환한다.
+ * bResult &= Check(...) 형태로 모아 마지막에 종료 코드로 쓴다.
+ */
+
+bool Check(bool bCondition, const char* pMessage);
@@ -0,0 +1,366 @@
+#include "pch.h"
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "AabbTreeBench.h"
+#include "AllocationCounter.h"
+#include "AssetArchiveBench.h"
+#include "BenchScene.h"
+#include "DeferredReleaseBench.h"
+#include "FramePacingBench.h"
+#include "MeshLodBench.h"
+#include "MemoryTrackerBench.h"
+#include "MeshOptimizeBench.h"
+#include "QueueSyncBench.h"
+#include "ResourceStateBench.h"
+#include "VertexQuantizeBench.h"
+#include "Task/WorkerPool.h"
+#include "Profiler/Profiler.h"
+
+// usage: BengalsBench [--frames N] [--warmup N] [--scene MESH_COUNT]... [--sprites N] [--max-threads N] [--static] [--no-occlusion] [--trace FILE]
+//        BengalsBench --mesh-opt [--frames N]
+//        BengalsBench --mesh-lod [--frames N]
+//        BengalsBench --vertex-quant [--frames N]
+//        BengalsBench --asset-archive DIR [--frames N]
+//        BengalsBench --memory-tracker [--frames N]
+//        BengalsBench --queue-sync [--frames N]
+//        BengalsBench --frame-pacing [--frames N]
+//        BengalsBench --resource-state [--frames N]
+//        BengalsBench --aabb-tree [--frames N]
+//        BengalsBench --deferred-release [--frames N]
+//   씬 크기 x 스레드 수(1, 2, 4, ... max) 조합마다 CPU ns/draw, 프레임당 할당, 스레드 스케일링을 출력한다.
+//   null 백엔드 검증 오류가 하나라도 있으면 1을 반환한다 (CI용).
+//   --mesh-opt는 프레임 대신 MeshOptimizer pass를 N회씩 실행해 시간과 ACMR / ATVR를 출력한다.
+//   --mesh-lod는 큰 메시의 LOD 체인 생성과 객체별 LOD 선택을 N회씩 실행한다 (생성이 느리므로 작은 N 권장).
+//   --vertex-quant는 큰 메시의 정점 양자화를 N회씩 실행하고, 오차가 한계를 넘으면 1을 반환한다.
+//   --asset-archive는 DIR의 파일을 하나씩 읽는 경우와 같은 파일의 아카이브에서 읽는 경우를 N회씩 비교한다.
+//   --memory-tracker는 CMemoryTracker 기록 비용을 스레드 수별로 N회씩 재고, 집계 / budget 검사가 틀리면 1을 반환한다.
+//   --queue-sync는 null graphics / compute 큐로 1000프레임씩 N회 제출해 큐 사이 fence 기록을 검증한다.
+//   --frame-pacing은 시뮬레이션 시계로 CFramePacer의 목표 FPS / 통계 / pending 수 전환을 검증하고 N * 1000프레임 비용을 잰다.
+//   --resource-state는 CNullCommandList에 기록된 barrier로 CResourceStateTracker의 병합 / 상쇄 / 승격을 검증하고 렌더러 프레임 순서를 N * 1000회 실행한다.
+//   --aabb-tree는 10k / 100k / 1M proxy의 CDynamicAabbTree에서 생성 / 이동 / AABB 질의 / ray cast를 N회씩 재고, 전체 순회와 다르면 1을 반환한다.
+//   --deferred-release는 완료 fence 값을 직접 넘겨 CDeferredReleaseQueue의 해제 순서 / 중첩 해제 / fence 보정을 검증하고 N * 1000프레임 비용을 잰다.
+
+namespace
+{
+	struct BenchOptions
+	{
+		UINT FrameCount = 200;
+		UINT WarmupFrameCount = 20;
+		std::vector<UINT> MeshCountList;
+		int SpriteCount = -1;		// -1: MeshCount / 10
+		UINT MaxThreadCount = 0;	// 0: hardware_concurrency
+		bool bAnimate = true;
+		bool bOcclusionCulling = true;
+		bool bMeshOptimizeBench = false;
+		bool bMeshLodBench = false;
+		bool bVertexQuantizeBench = false;
+		bool bMemoryTrackerBench = false;
+		bool bQueueSyncBench = false;
+		bool bFramePacingBench = false;
+		bool bResourceStateBench = false;
+		bool bAabbTreeBench = false;
+		bool bDeferredReleaseBench = false;
+		const char* pAssetArchiveRoot = nullptr;
+		const char* pTraceFileName = nullptr;
+	};
+
+	struct BenchRunResult
+	{
+		double UpdateMs = 0.0;
+		double SubmitMs = 0.0;
+		double DrawCountPerFrame = 0.0;
+		double NsPerDraw = 0.0;
+		double AllocationsPerFrame = 0.0;
+		double AllocatedKBPerFrame = 0.0;
+		UINT64 ErrorCount = 0;
+		const char* pLastError = nullptr;
+	};
+
+	bool ParseOptions(int argc, char* argv[], BenchOptions* pOutOptions)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			const char* pArg = argv[i];
+			const bool bHasValue = (i + 1 < argc);
+			if (strcmp(pArg, "--frames") == 0 && bHasValue)
+			{
+				pOutOptions->FrameCount = static_cast<UINT>(atoi(argv[++i]));
+			}
+			else if (strcmp(pArg, "--warmup") == 0 && bHasValue)
+			{
+				pOutOptions->WarmupFrameCount = static_cast<UINT>(atoi(argv[++i]));
+			}
+			else if (strcmp(pArg, "--scene") == 0 && bHasValue)
+			{
+				pOutOptions->MeshCountList.push_back(static_cast<UINT>(atoi(argv[++i])));
+			}
+			else if (strcmp(pArg, "--sprites") == 0 && bHasValue)
+			{
+				pOutOptions->SpriteCount = atoi(argv[++i]);
+			}
+			else if (strcmp(pArg, "--max-threads") == 0 && bHasValue)
+			{
+				pOutOptions->MaxThreadCount = static_cast<UINT>(atoi(argv[++i]));
+			}
+			else if (strcmp(pArg, "--static") == 0)
+			{
+				pOutOptions->bAnimate = false;
+			}
+			else if (strcmp(pArg, "--no-occlusion") == 0)
+			{
+				pOutOptions->bOcclusionCulling = false;
+			}
+			else if (strcmp(pArg, "--mesh-opt") == 0)
+			{
+				pOutOptions->bMeshOptimizeBench = true;
+			}
+			else if (strcmp(pArg, "--mesh-lod") == 0)
+			{
+				pOutOptions->bMeshLodBench = true;
+			}
+			else if (strcmp(pArg, "--vertex-quant") == 0)
+			{
+				pOutOptions->bVertexQuantizeBench = true;
+			}
+			else if (strcmp(pArg, "--memory-tracker") == 0)
+			{
+				pOutOptions->bMemoryTrackerBench = true;
+			}
+			else if (strcmp(pArg, "--queue-sync") == 0)
+			{
+				pOutOptions->bQueueSyncBench = true;
+			}
+			else if (strcmp(pArg, "--frame-pacing") == 0)
+			{
+				pOutOptions->bFramePacingBench = true;
+			}
+			else if (strcmp(pArg, "--resource-state") == 0)
+			{
+				pOutOptions->bResourceStateBench = true;
+			}
+			else if (strcmp(pArg, "--aabb-tree") == 0)
+			{
+				pOutOptions->bAabbTreeBench = true;
+			}
+			else if (strcmp(pArg, "--deferred-release") == 0)
+			{
+				pOutOptions->bDeferredReleaseBench = true;
+			}
+			else if (strcmp(pArg, "--asset-archive") == 0 && bHasValue)
+			{
+				pOutOptions->pAssetArchiveRoot = argv[++i];
+			}
+			else if (strcmp(pArg, "--trace") == 0 && bHasValue)
+			{
+				pOutOptions->pTraceFileName = argv[++i];
+			}
+			else
+			{
+				printf("unknown or incomplete option: %s\n", pArg);
+				return false;
+			}
+		}
+
+		if (pOutOptions->MeshCountList.empty())
+		{
+			pOutOptions->MeshCountList = { 1000, 10000, 100000 };
+		}
+		if (pOutOptions->MaxThreadCount == 0)
+		{
+			pOutOptions->MaxThreadCount = (std::max)(1u, std::thread::hardware_concurrency());
+		}
+		if (pOutOptions->FrameCount == 0)
+		{
+			pOutOptions->FrameCount = 1;
+		}
+		return true;
+	}
+
+	bool RunBench(const BenchOptions& options, UINT meshCount, UINT threadCount, BenchRunResult* pOutResult)
+	{
+		// 메인 스레드도 Wait() 중에 잡을 실행하므로 워커는 threadCount - 1개
+		CWorkerPool workerPool;
+		if (!workerPool.Initialize(threadCount - 1))
+		{
+			return false;
+		}
+
+		BenchSceneDesc desc = {};
+		desc.MeshCount = meshCount;
+		desc.SpriteCount = (options.SpriteCount < 0) ? meshCount / 10 : static_cast<UINT>(options.SpriteCount);
+		desc.RenderThreadCount = (std::min)(threadCount, 8u);		// CD3D12Renderer::MaxRenderThreadCount
+		desc.bAnimate = options.bAnimate;
+		desc.bOcclusionCulling = options.bOcclusionCulling;
+
+		CBenchScene scene;
+		if (!scene.Initialize(desc, &workerPool))
+		{
+			return false;
+		}
+
+		BenchFrameStats frameStats = {};
+		for (UINT i = 0; i < options.WarmupFrameCount; i++)
+		{
+			scene.RunFrame(&frameStats);
+		}
+
+		UINT64 updateNs = 0;
+		UINT64 submitNs = 0;
+		UINT64 drawCount = 0;
+		UINT64 errorCount = 0;
+		const char* pLastError = nullptr;
+
+		const AllocationCounters allocBegin = GetAllocationCounters();
+		for (UINT i = 0; i < options.FrameCount; i++)
+		{
+			scene.RunFrame(&frameStats);
+			updateNs += frameStats.UpdateNs;
+			submitNs += frameStats.SubmitNs;
+			drawCount += frameStats.BackendStats.DrawCount;
+			errorCount += frameStats.BackendStats.ErrorCount;
+			if (frameStats.pLastError)
+			{
+				pLastError = frameStats.pLastError;
+			}
+		}
+		const AllocationCounters allocEnd = GetAllocationCounters();
+
+		const double frameCount = static_cast<double>(options.FrameCount);
+		pOutResult->UpdateMs = updateNs / frameCount / 1.0e6;
+		pOutResult->SubmitMs = submitNs / frameCount / 1.0e6;
+		pOutResult->DrawCountPerFrame = drawCount / frameCount;
+		pOutResult->NsPerDraw = (drawCount > 0) ? static_cast<double>(submitNs) / drawCount : 0.0;
+		pOutResult->AllocationsPerFrame = (allocEnd.AllocationCount - allocBegin.AllocationCount) / frameCount;
+		pOutResult->AllocatedKBPerFrame = (allocEnd.AllocatedBytes - allocBegin.AllocatedBytes) / frameCount / 1024.0;
+		pOutResult->ErrorCount = errorCount;
+		pOutResult->pLastError = pLastError;
+		return true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	BenchOptions options = {};
+	if (!ParseOptions(argc, argv, &options))
+	{
+		return 2;
+	}
+
+	if (options.bMeshOptimizeBench)
+	{
+		return RunMeshOptimizeBench(options.FrameCount) ? 0 : 1;
+	}
+
+	if (options.bMeshLodBench)
+	{
+		return RunMeshLodBench(options.FrameCount) ? 0 : 1;
+	}
+
+	if (options.bVertexQuantizeBench)
+	{
+		return RunVertexQuantizeBench(options.FrameCount) ? 0 : 1;
+	}
+
+	if (options.bMemoryTrackerBench)
+	{
+		return RunMemoryTrackerBench(options.FrameCount) ? 0 : 1;
+	}
+
+	if (options.bQueueSyncBench)
+	{
+		return RunQueueSyncBench(options.FrameCount) ? 0 : 1;
+	}
+
+	if (options.bFramePacingBench)
+	{
+		return RunFramePacingBench(options.FrameCount) ? 0 : 1;
+	}
+
+	if (options.bResourceStateBench)
+	{
+		return RunResourceStateBench(options.FrameCount) ? 0 : 1;
+	}
+
+	if (options.bAabbTreeBench)
+	{
+		return RunAabbTreeBench(options.FrameCount) ? 0 : 1;
+	}
+
+	if (options.bDeferredReleaseBench)
+	{
+		return RunDeferredReleaseBench(options.FrameCount) ? 0 : 1;
+	}
+
+	if (options.pAssetArchiveRoot)
+	{
+		return RunAssetArchiveBench(options.pAssetArchiveRoot, options.FrameCount) ? 0 : 1;
+	}
+
+	PROFILE_THREAD_NAME("Main");
+	CProfiler::Get().SetEnabled(options.pTraceFileName != nullptr);
+
+	std::vector<UINT> threadCountList;
+	for (UINT threadCount = 1; threadCount < options.MaxThreadCount; threadCount *= 2)
+	{
+		threadCountList.push_back(threadCount);
+	}
+	threadCountList.push_back(options.MaxThreadCount);
+
+	printf("frames=%u warmup=%u animate=%d occlusion=%d\n\n", options.FrameCount, options.WarmupFrameCount, options.bAnimate ? 1 : 0, options.bOcclusionCulling ? 1 : 0);
+	printf("%8s %7s %10s %10s %9s %9s %12s %10s %8s %7s\n",
+		"meshes", "threads", "update ms", "submit ms", "draws", "ns/draw", "allocs/frame", "KB/frame", "speedup", "errors");
+
+	UINT64 totalErrorCount = 0;
+	for (UINT meshCount : options.MeshCountList)
+	{
+		double baseFrameMs = 0.0;
+		for (UINT threadCount : threadCountList)
+		{
+			BenchRunResult result = {};
+			if (!RunBench(options, meshCount, threadCount, &result))
+			{
+				printf("%8u %7u  failed to initialize\n", meshCount, threadCount);
+				totalErrorCount++;
+				continue;
+			}
+
+			const double frameMs = result.UpdateMs + result.SubmitMs;
+			if (baseFrameMs == 0.0)
+			{
+				baseFrameMs = frameMs;
+			}
+
+			printf("%8u %7u %10.3f %10.3f %9.0f %9.1f %12.1f %10.1f %7.2fx %7llu\n",
+				meshCount,
+				threadCount,
+				result.UpdateMs,
+				result.SubmitMs,
+				result.DrawCountPerFrame,
+				result.NsPerDraw,
+				result.AllocationsPerFrame,
+				result.AllocatedKBPerFrame,
+				(frameMs > 0.0) ? baseFrameMs / frameMs : 0.0,
+				static_cast<unsigned long long>(result.ErrorCount));
+
+			if (result.pLastError)
+			{
+				printf("         last error: %s\n", result.pLastError);
+			}
+			totalErrorCount += result.ErrorCount;
+		}
+	}
+
+	if (options.pTraceFileName)
+	{
+		CProfiler::Get().ExportChromeTrace(options.pTraceFileName);
+	}
+
+	if (totalErrorCount > 0)
+	{
+		printf("\nnull backend reported %llu validation error(s)\n", static_cast<unsigned long long>(totalErrorCount));
+		return 1;
+	}
+	return 0;
+}
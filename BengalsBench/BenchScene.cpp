@@ -0,0 +1,514 @@
+#include "pch.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include "BenchScene.h"
+#include "Task/WorkerPool.h"
+#include "Profiler/Profiler.h"
+#include "Renderer/Backend/DrawCommandRecorder.h"
+
+namespace
+{
+	// 실제 리소스가 없으므로 null 백엔드 검증을 통과하는 0이 아닌 더미 핸들을 사용
+	template <typename T>
+	T* MakeFakeObject(UINT64 token)
+	{
+		return reinterpret_cast<T*>(static_cast<uintptr_t>(token));
+	}
+
+	ID3D12RootSignature* const FakeMeshRootSignature = MakeFakeObject<ID3D12RootSignature>(0x1000);
+	ID3D12PipelineState* const FakeMeshPipelineState = MakeFakeObject<ID3D12PipelineState>(0x1100);
+	ID3D12RootSignature* const FakeSpriteRootSignature = MakeFakeObject<ID3D12RootSignature>(0x2000);
+	ID3D12PipelineState* const FakeSpritePipelineState = MakeFakeObject<ID3D12PipelineState>(0x2100);
+	ID3D12DescriptorHeap* const FakeDescriptorHeap = MakeFakeObject<ID3D12DescriptorHeap>(0x3000);
+
+	constexpr UINT64 FakeCbvDescriptorBase = 0x40000000ull;
+	constexpr UINT64 FakeSrvDescriptorBase = 0x50000000ull;
+	constexpr UINT64 FakeGpuVirtualAddressBase = 0x100000000ull;
+
+	constexpr UINT ViewportWidth = 1920;
+	constexpr UINT ViewportHeight = 1080;
+
+	UINT64 GetTimeNs()
+	{
+		return static_cast<UINT64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+}
+
+bool CBenchScene::Initialize(const BenchSceneDesc& desc, CWorkerPool* pWorkerPool)
+{
+	if (!pWorkerPool || desc.MeshCount == 0 || desc.RenderThreadCount == 0)
+	{
+		return false;
+	}
+
+	m_desc = desc;
+	m_pWorkerPool = pWorkerPool;
+
+	CreateMeshes();
+
+	if (!m_sceneTree.Initialize(desc.MeshCount, 0.1f))
+	{
+		return false;
+	}
+
+	// CGame과 같은 밀도(21x21 격자에 300개)를 유지하도록 배치 영역을 오브젝트 수에 맞춰 넓힌다
+	const float halfExtent = 10.0f * sqrtf(static_cast<float>(desc.MeshCount) / 300.0f);
+	std::mt19937 rng(1234);
+	std::uniform_real_distribution<float> posDist(-halfExtent, halfExtent);
+	std::uniform_real_distribution<float> rotDist(0.0f, XM_PI);
+	std::uniform_real_distribution<float> speedDist(-0.02f, 0.02f);
+
+	// 프록시가 오브젝트 주소를 user data로 들고 있으므로 재할당되지 않게 미리 확보
+	m_objectList.resize(desc.MeshCount);
+	for (UINT i = 0; i < desc.MeshCount; i++)
+	{
+		BenchObject& obj = m_objectList[i];
+		obj.Pos = { posDist(rng), 0.0f, posDist(rng) };
+		obj.RotY = rotDist(rng);
+		obj.RotSpeed = desc.bAnimate ? speedDist(rng) : 0.0f;
+		obj.MeshIndex = (i % 8 == 7) ? 1 : 0;		// box 7 : quad 1
+		obj.LocalBounds.Min = { -0.25f, -0.25f, (obj.MeshIndex == 0) ? -0.25f : 0.0f };
+		obj.LocalBounds.Max = { 0.25f, 0.25f, (obj.MeshIndex == 0) ? 0.25f : 0.0f };
+		obj.WorldMatrix = XMMatrixMultiply(XMMatrixRotationY(obj.RotY), XMMatrixTranslation(obj.Pos.x, obj.Pos.y, obj.Pos.z));
+		obj.WorldBounds = CDynamicAabbTree::TransformAabb(obj.LocalBounds, obj.WorldMatrix);
+		obj.ProxyId = m_sceneTree.CreateProxy(obj.WorldBounds, &obj);
+	}
+	m_visibleObjectList.reserve(desc.MeshCount);
+	m_visibleOccludedList.reserve(desc.MeshCount);
+	m_occluderCandidateList.reserve(desc.MeshCount);
+	if (!m_occlusionCuller.Initialize())
+	{
+		return false;
+	}
+	m_drawList.reserve(static_cast<size_t>(desc.MeshCount) + desc.SpriteCount);
+
+	// Camera (CD3D12Renderer::InitializeCamera와 같은 투영)
+	m_cameraPos = { 0.0f, 0.0f, -10.0f };
+	m_projectionMatrix = XMMatrixPerspectiveFovLH(XM_PIDIV4, static_cast<float>(ViewportWidth) / ViewportHeight, 0.1f, 1000.0f);
+	m_viewport = { 0.0f, 0.0f, static_cast<float>(ViewportWidth), static_cast<float>(ViewportHeight), 0.0f, 1.0f };
+	m_scissorRect = { 0, 0, static_cast<LONG>(ViewportWidth), static_cast<LONG>(ViewportHeight) };
+
+	// 렌더 스레드별 컨텍스트. 최악의 경우(전부 보임)에도 프레임 중 재할당이 없도록 잡는다
+	const UINT itemCount = desc.MeshCount + desc.SpriteCount;
+	const UINT itemCountPerThread = (itemCount + desc.RenderThreadCount - 1) / desc.RenderThreadCount;
+	const UINT commandListCountPerThread = (itemCountPerThread + ProcessCountPerCommandList - 1) / ProcessCountPerCommandList;
+
+	m_renderContexts.resize(desc.RenderThreadCount);
+	for (UINT i = 0; i < desc.RenderThreadCount; i++)
+	{
+		BenchRenderContext& context = m_renderContexts[i];
+		context.RenderQueue.reserve(itemCountPerThread);
+		context.CommandListPool.resize(commandListCountPerThread);
+		context.DescriptorCapacity = itemCountPerThread * 8;
+		context.CpuDescriptorBase = 0x10000000ull + static_cast<UINT64>(i) * context.DescriptorCapacity * DescriptorSize;
+		context.GpuDescriptorBase = 0x20000000ull + static_cast<UINT64>(i) * context.DescriptorCapacity * DescriptorSize;
+		context.DefaultCBPool.resize(itemCountPerThread);
+		context.SpriteCBPool.resize(itemCountPerThread);
+	}
+
+	return true;
+}
+
+void CBenchScene::RunFrame(BenchFrameStats* pOutStats)
+{
+	PROFILE_SCOPE("Frame");
+	m_frameIndex++;
+
+	// Update (CGame::Update와 같은 graph)
+	//   Transform (parallel) -> SceneSync -> Culling -> OcclusionRaster -> OcclusionTest (parallel) -> Snapshot
+	//   Camera -----------------------------> Culling
+	const UINT64 updateBeginNs = GetTimeNs();
+	{
+		PROFILE_SCOPE("Update");
+		m_updateTaskGraph.Reset();
+
+		TaskHandle cameraTask = m_updateTaskGraph.AddTask("Camera", [this]()
+			{
+				m_cameraPos.x = sinf(static_cast<float>(m_frameIndex) * 0.01f);
+				XMVECTOR cameraPos = XMVectorSet(m_cameraPos.x, m_cameraPos.y, m_cameraPos.z, 1.0f);
+				m_viewMatrix = XMMatrixLookToLH(cameraPos, XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+			});
+		TaskHandle transformTask = m_updateTaskGraph.AddParallelTask("Transform", static_cast<UINT>(m_objectList.size()), ObjectBatchSize,
+			[this](UINT beginIndex, UINT endIndex) { UpdateObjects(beginIndex, endIndex); });
+		TaskHandle sceneSyncTask = m_updateTaskGraph.AddTask("SceneSync", [this]() { SyncSceneProxies(); });
+		TaskHandle cullingTask = m_updateTaskGraph.AddTask("Culling", [this]() { CullSceneObjects(); });
+		TaskHandle snapshotTask = m_updateTaskGraph.AddTask("Snapshot", [this]() { BuildDrawList(); });
+
+		m_updateTaskGraph.AddDependency(transformTask, sceneSyncTask);
+		m_updateTaskGraph.AddDependency(sceneSyncTask, cullingTask);
+		m_updateTaskGraph.AddDependency(cameraTask, cullingTask);
+		if (m_desc.bOcclusionCulling)
+		{
+			TaskHandle occlusionRasterTask = m_updateTaskGraph.AddTask("OcclusionRaster", [this]() { RasterizeOccluders(); });
+			TaskHandle occlusionTestTask = m_updateTaskGraph.AddParallelTask("OcclusionTest", static_cast<UINT>(m_objectList.size()), ObjectBatchSize,
+				[this](UINT beginIndex, UINT endIndex) { TestOcclusion(beginIndex, endIndex); });
+			m_updateTaskGraph.AddDependency(cullingTask, occlusionRasterTask);
+			m_updateTaskGraph.AddDependency(occlusionRasterTask, occlusionTestTask);
+			m_updateTaskGraph.AddDependency(occlusionTestTask, snapshotTask);
+		}
+		else
+		{
+			m_updateTaskGraph.AddDependency(cullingTask, snapshotTask);
+		}
+
+		m_updateTaskGraph.Execute(m_pWorkerPool);
+	}
+	const UINT64 submitBeginNs = GetTimeNs();
+
+	SubmitDrawList();
+
+	const UINT64 submitEndNs = GetTimeNs();
+
+	if (pOutStats)
+	{
+		*pOutStats = {};
+		pOutStats->UpdateNs = submitBeginNs - updateBeginNs;
+		pOutStats->SubmitNs = submitEndNs - submitBeginNs;
+		pOutStats->VisibleMeshCount = m_visibleObjectList.size();
+		for (BenchRenderContext& context : m_renderContexts)
+		{
+			pOutStats->CommandListCount += context.CommandListCount;
+			pOutStats->BackendStats.Accumulate(context.Device.GetStats());
+			if (context.Device.GetLastError())
+			{
+				pOutStats->pLastError = context.Device.GetLastError();
+			}
+			for (UINT i = 0; i < context.CommandListCount; i++)
+			{
+				const CNullCommandList& commandList = context.CommandListPool[i];
+				pOutStats->BackendStats.Accumulate(commandList.GetStats());
+				if (commandList.GetLastError())
+				{
+					pOutStats->pLastError = commandList.GetLastError();
+				}
+			}
+		}
+	}
+}
+
+void CBenchScene::CreateMeshes()
+{
+	// CGameObject::CreateBoxMesh / CreateQuadMesh와 같은 레이아웃 (box: tri group 6개, weld 후 정점 24개 / quad: 1개)
+	UINT64 gpuAddress = FakeGpuVirtualAddressBase;
+	UINT64 srvDescriptor = FakeSrvDescriptorBase;
+
+	auto CreateMesh = [&](UINT vertexCount, UINT triGroupCount, UINT triCountPerGroup)
+		{
+			BenchMesh mesh = {};
+			mesh.VertexBufferView.BufferLocation = gpuAddress;
+			mesh.VertexBufferView.StrideInBytes = sizeof(VertexPos3Color4Tex2);
+			mesh.VertexBufferView.SizeInBytes = vertexCount * sizeof(VertexPos3Color4Tex2);
+			gpuAddress += 0x10000;
+
+			for (UINT i = 0; i < triGroupCount; i++)
+			{
+				BenchTriGroup triGroup = {};
+				triGroup.Cluster.IndexCount = triCountPerGroup * 3;
+				triGroup.IndexBufferView.BufferLocation = gpuAddress;
+				triGroup.IndexBufferView.Format = DXGI_FORMAT_R16_UINT;
+				triGroup.IndexBufferView.SizeInBytes = triCountPerGroup * 3 * sizeof(WORD);
+				triGroup.SrvDescriptorHandle.ptr = static_cast<SIZE_T>(srvDescriptor);
+				gpuAddress += 0x10000;
+				srvDescriptor += DescriptorSize;
+				mesh.TriGroupList.push_back(triGroup);
+			}
+			m_meshList.push_back(std::move(mesh));
+		};
+
+	CreateMesh(24, 6, 2);
+	CreateMesh(4, 1, 2);
+}
+
+void CBenchScene::UpdateObjects(UINT beginIndex, UINT endIndex)
+{
+	for (UINT i = beginIndex; i < endIndex; i++)
+	{
+		BenchObject& obj = m_objectList[i];
+		if (obj.RotSpeed == 0.0f)
+		{
+			continue;
+		}
+
+		obj.RotY += obj.RotSpeed;
+		obj.WorldMatrix = XMMatrixMultiply(XMMatrixRotationY(obj.RotY), XMMatrixTranslation(obj.Pos.x, obj.Pos.y, obj.Pos.z));
+		obj.WorldBounds = CDynamicAabbTree::TransformAabb(obj.LocalBounds, obj.WorldMatrix);
+		obj.bBoundsDirty = true;
+	}
+}
+
+void CBenchScene::SyncSceneProxies()
+{
+	for (BenchObject& obj : m_objectList)
+	{
+		if (obj.bBoundsDirty)
+		{
+			m_sceneTree.MoveProxy(obj.ProxyId, obj.WorldBounds);
+			obj.bBoundsDirty = false;
+		}
+	}
+}
+
+void CBenchScene::CullSceneObjects()
+{
+	BoundingFrustum frustum = {};
+	BoundingFrustum::CreateFromMatrix(frustum, m_projectionMatrix);
+	frustum.Transform(frustum, XMMatrixInverse(nullptr, m_viewMatrix));
+
+	m_visibleObjectList.clear();
+	m_sceneTree.QueryFrustum(frustum, m_visibleObjectList);
+	m_visibleOccludedList.assign(m_visibleObjectList.size(), 0);
+}
+
+void CBenchScene::RasterizeOccluders()
+{
+	// CGame::RasterizeOccluders와 같은 선택 기준
+	XMFLOAT4X4 viewProjMatrix = {};
+	XMStoreFloat4x4(&viewProjMatrix, XMMatrixMultiply(m_viewMatrix, m_projectionMatrix));
+	m_occlusionCuller.BeginFrame(viewProjMatrix);
+
+	m_occluderCandidateList.clear();
+	for (void* pVisibleObj : m_visibleObjectList)
+	{
+		const BenchObject* pObj = static_cast<const BenchObject*>(pVisibleObj);
+		const float screenArea = m_occlusionCuller.GetScreenArea(pObj->WorldBounds);
+		if (screenArea >= MinOccluderScreenArea)
+		{
+			m_occluderCandidateList.push_back({ screenArea, pObj });
+		}
+	}
+
+	const size_t occluderCount = (std::min)(m_occluderCandidateList.size(), static_cast<size_t>(MaxOccluderCount));
+	std::partial_sort(m_occluderCandidateList.begin(), m_occluderCandidateList.begin() + occluderCount, m_occluderCandidateList.end(),
+		[](const std::pair<float, const BenchObject*>& a, const std::pair<float, const BenchObject*>& b) { return a.first > b.first; });
+
+	for (size_t i = 0; i < occluderCount; i++)
+	{
+		const BenchObject* pObj = m_occluderCandidateList[i].second;
+		XMFLOAT4X4 worldMatrix = {};
+		XMStoreFloat4x4(&worldMatrix, pObj->WorldMatrix);
+		m_occlusionCuller.AddOccluder(pObj->LocalBounds, worldMatrix);
+	}
+
+	m_occlusionCuller.EndOccluders();
+}
+
+void CBenchScene::TestOcclusion(UINT beginIndex, UINT endIndex)
+{
+	endIndex = (std::min)(endIndex, static_cast<UINT>(m_visibleObjectList.size()));
+	for (UINT i = beginIndex; i < endIndex; i++)
+	{
+		const BenchObject* pObj = static_cast<const BenchObject*>(m_visibleObjectList[i]);
+		m_visibleOccludedList[i] = m_occlusionCuller.IsOccluded(pObj->WorldBounds) ? 1 : 0;
+	}
+}
+
+void CBenchScene::BuildDrawList()
+{
+	m_drawList.clear();
+	for (size_t i = 0; i < m_visibleObjectList.size(); i++)
+	{
+		if (m_visibleOccludedList[i])
+		{
+			continue;
+		}
+
+		const BenchObject* pObj = static_cast<const BenchObject*>(m_visibleObjectList[i]);
+		BenchDrawItem item = {};
+		item.pMesh = &m_meshList[pObj->MeshIndex];
+		item.WorldMatrix = pObj->WorldMatrix;
+		m_drawList.push_back(item);
+	}
+
+	for (UINT i = 0; i < m_desc.SpriteCount; i++)
+	{
+		BenchDrawItem item = {};
+		item.SpritePos = { static_cast<float>((i * 37) % ViewportWidth), static_cast<float>((i * 53) % ViewportHeight) };
+		m_drawList.push_back(item);
+	}
+}
+
+void CBenchScene::SubmitDrawList()
+{
+	PROFILE_SCOPE("RecordFrame");
+
+	// BeginRender: 스레드별 할당기/커맨드 리스트 리셋
+	for (BenchRenderContext& context : m_renderContexts)
+	{
+		context.RenderQueue.clear();
+		context.CommandListCount = 0;
+		context.DescriptorAllocatedCount = 0;
+		context.DefaultCBAllocatedCount = 0;
+		context.SpriteCBAllocatedCount = 0;
+		context.Device.ResetStats();
+	}
+
+	// RenderMeshObject / RenderSprite: 렌더 큐 라운드로빈
+	UINT renderThreadIndex = 0;
+	for (const BenchDrawItem& item : m_drawList)
+	{
+		m_renderContexts[renderThreadIndex].RenderQueue.push_back(item);
+		renderThreadIndex = (renderThreadIndex + 1) % m_desc.RenderThreadCount;
+	}
+
+	// EndRender: ProcessRenderQueues와 같이 큐마다 워커 잡 하나
+	std::atomic<UINT> jobCounter = 0;
+	for (UINT i = 0; i < m_desc.RenderThreadCount; i++)
+	{
+		m_pWorkerPool->Submit([this, i]() { ProcessRenderQueue(i); }, &jobCounter);
+	}
+	m_pWorkerPool->Wait(jobCounter);
+}
+
+void CBenchScene::ProcessRenderQueue(UINT renderThreadIndex)
+{
+	PROFILE_SCOPE("RenderQueue::Process");
+
+	BenchRenderContext& context = m_renderContexts[renderThreadIndex];
+	const D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = { 0x60000000ull };
+	const D3D12_CPU_DESCRIPTOR_HANDLE dsvHandle = { 0x70000000ull };
+
+	CNullCommandList* pCommandList = nullptr;
+	UINT processedItemCountPerCommandList = 0;
+
+	for (const BenchDrawItem& item : context.RenderQueue)
+	{
+		if (!pCommandList)
+		{
+			pCommandList = &context.CommandListPool[context.CommandListCount++];
+			pCommandList->Reset();
+			pCommandList->ResetStats();
+			RecordRenderTargetSetup(pCommandList, m_viewport, m_scissorRect, rtvHandle, dsvHandle);
+		}
+
+		const bool bRecorded = item.pMesh ? RecordMeshItem(pCommandList, context, item) : RecordSpriteItem(pCommandList, context, item);
+		if (!bRecorded)
+		{
+			continue;
+		}
+
+		processedItemCountPerCommandList++;
+		if (processedItemCountPerCommandList >= ProcessCountPerCommandList)
+		{
+			pCommandList->Close();
+			pCommandList = nullptr;
+			processedItemCountPerCommandList = 0;
+		}
+	}
+
+	if (pCommandList)
+	{
+		pCommandList->Close();
+	}
+}
+
+bool CBenchScene::RecordMeshItem(CNullCommandList* pCommandList, BenchRenderContext& context, const BenchDrawItem& item)
+{
+	// CBasicMeshObject::Draw와 같은 순서
+	const BenchMesh& mesh = *item.pMesh;
+	const UINT triGroupCount = static_cast<UINT>(mesh.TriGroupList.size());
+
+	D3D12_CPU_DESCRIPTOR_HANDLE cpuBaseDescriptorHandle = {};
+	D3D12_GPU_DESCRIPTOR_HANDLE gpuBaseDescriptorHandle = {};
+	if (!AllocateDescriptors(context, 1 + triGroupCount, &cpuBaseDescriptorHandle, &gpuBaseDescriptorHandle))
+	{
+		return false;
+	}
+
+	if (context.DefaultCBAllocatedCount >= context.DefaultCBPool.size())
+	{
+		return false;
+	}
+	const UINT cbIndex = context.DefaultCBAllocatedCount++;
+	ConstantBufferDefault* pConstantBufferDefault = &context.DefaultCBPool[cbIndex];
+	pConstantBufferDefault->WorldMatrix = XMMatrixTranspose(item.WorldMatrix);
+	pConstantBufferDefault->ViewMatrix = XMMatrixTranspose(m_viewMatrix);
+	pConstantBufferDefault->ProjectionMatrix = XMMatrixTranspose(m_projectionMatrix);
+
+	D3D12_CPU_DESCRIPTOR_HANDLE cbvHandle = { static_cast<SIZE_T>(FakeCbvDescriptorBase + static_cast<UINT64>(cbIndex) * DescriptorSize) };
+	D3D12_CPU_DESCRIPTOR_HANDLE destHandle = cpuBaseDescriptorHandle;
+	context.Device.CopyDescriptorsSimple(1, destHandle, cbvHandle, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	for (UINT i = 0; i < triGroupCount; i++)
+	{
+		destHandle.ptr += DescriptorSize;
+		context.Device.CopyDescriptorsSimple(1, destHandle, mesh.TriGroupList[i].SrvDescriptorHandle, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	}
+
+	MeshDrawState drawState = {};
+	drawState.pRootSignature = FakeMeshRootSignature;
+	drawState.pPipelineState = FakeMeshPipelineState;
+	drawState.pDescriptorHeap = FakeDescriptorHeap;
+	drawState.pVertexBufferView = &mesh.VertexBufferView;
+	drawState.GpuBaseDescriptorHandle = gpuBaseDescriptorHandle;
+	RecordMeshDrawSetup(pCommandList, drawState);
+
+	D3D12_GPU_DESCRIPTOR_HANDLE gpuSrvHandle = gpuBaseDescriptorHandle;
+	for (UINT i = 0; i < triGroupCount; i++)
+	{
+		gpuSrvHandle.ptr += DescriptorSize;
+		const BenchTriGroup& triGroup = mesh.TriGroupList[i];
+		RecordTriGroupDraw(pCommandList, gpuSrvHandle, &triGroup.IndexBufferView, &triGroup.Cluster, 1);
+	}
+	return true;
+}
+
+bool CBenchScene::RecordSpriteItem(CNullCommandList* pCommandList, BenchRenderContext& context, const BenchDrawItem& item)
+{
+	// CSpriteObject::DrawWithTex와 같은 순서 (CBV + SRV)
+	const BenchMesh& quadMesh = m_meshList[1];
+
+	if (context.SpriteCBAllocatedCount >= context.SpriteCBPool.size())
+	{
+		return false;
+	}
+	const UINT cbIndex = context.SpriteCBAllocatedCount++;
+	ConstantBufferSprite* pConstantBufferSprite = &context.SpriteCBPool[cbIndex];
+	pConstantBufferSprite->ScreenRes = XMFLOAT2(static_cast<float>(ViewportWidth), static_cast<float>(ViewportHeight));
+	pConstantBufferSprite->Pos = item.SpritePos;
+	pConstantBufferSprite->Scale = XMFLOAT2(1.0f, 1.0f);
+	pConstantBufferSprite->TexSize = XMFLOAT2(64.0f, 64.0f);
+	pConstantBufferSprite->TexSamplePos = XMFLOAT2(0.0f, 0.0f);
+	pConstantBufferSprite->TexSampleSize = XMFLOAT2(64.0f, 64.0f);
+	pConstantBufferSprite->Z = 0.0f;
+	pConstantBufferSprite->Alpha = 1.0f;
+
+	D3D12_CPU_DESCRIPTOR_HANDLE cpuBaseDescriptorHandle = {};
+	D3D12_GPU_DESCRIPTOR_HANDLE gpuBaseDescriptorHandle = {};
+	if (!AllocateDescriptors(context, 2, &cpuBaseDescriptorHandle, &gpuBaseDescriptorHandle))
+	{
+		return false;
+	}
+
+	D3D12_CPU_DESCRIPTOR_HANDLE cbvHandle = { static_cast<SIZE_T>(FakeCbvDescriptorBase + static_cast<UINT64>(cbIndex) * DescriptorSize) };
+	D3D12_CPU_DESCRIPTOR_HANDLE destHandle = cpuBaseDescriptorHandle;
+	context.Device.CopyDescriptorsSimple(1, destHandle, cbvHandle, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	destHandle.ptr += DescriptorSize;
+	context.Device.CopyDescriptorsSimple(1, destHandle, quadMesh.TriGroupList[0].SrvDescriptorHandle, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+	SpriteDrawState drawState = {};
+	drawState.pRootSignature = FakeSpriteRootSignature;
+	drawState.pPipelineState = FakeSpritePipelineState;
+	drawState.pDescriptorHeap = FakeDescriptorHeap;
+	drawState.pVertexBufferView = &quadMesh.VertexBufferView;
+	drawState.pIndexBufferView = &quadMesh.TriGroupList[0].IndexBufferView;
+	drawState.GpuBaseDescriptorHandle = gpuBaseDescriptorHandle;
+	RecordSpriteDraw(pCommandList, drawState);
+	return true;
+}
+
+bool CBenchScene::AllocateDescriptors(BenchRenderContext& context, UINT count, D3D12_CPU_DESCRIPTOR_HANDLE* pOutCpuHandle, D3D12_GPU_DESCRIPTOR_HANDLE* pOutGpuHandle)
+{
+	if (context.DescriptorAllocatedCount + count > context.DescriptorCapacity)
+	{
+		__debugbreak();
+		return false;
+	}
+
+	const UINT64 offset = static_cast<UINT64>(context.DescriptorAllocatedCount) * DescriptorSize;
+	pOutCpuHandle->ptr = static_cast<SIZE_T>(context.CpuDescriptorBase + offset);
+	pOutGpuHandle->ptr = context.GpuDescriptorBase + offset;
+	context.DescriptorAllocatedCount += count;
+	return true;
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <vector>
+#include "Scene/DynamicAabbTree.h"
+#include "Scene/OcclusionCuller.h"
+#include "Task/TaskGraph.h"
+#include "Types/typedef.h"
+#include "Renderer/Backend/NullRenderBackend.h"
+
+class CWorkerPool;
+
+/**
+ * CGame과 같은 프레임 구조(Task graph Update -> 스냅샷 -> 렌더 큐 라운드로빈 -> 스레드별 커맨드 리스트 기록)를
+ * null 백엔드 위에서 실행하는 헤드리스 벤치마크 씬.
+ * 메시/스프라이트 드로우는 실제 렌더 오브젝트와 같은 DrawCommandRecorder 경로로 기록한다.
+ */
+
+struct BenchSceneDesc
+{
+	UINT MeshCount = 1000;
+	UINT SpriteCount = 100;
+	UINT RenderThreadCount = 1;
+	bool bAnimate = true;
+	bool bOcclusionCulling = true;
+};
+
+struct BenchFrameStats
+{
+	UINT64 UpdateNs = 0;
+	UINT64 SubmitNs = 0;
+	UINT64 VisibleMeshCount = 0;
+	UINT64 CommandListCount = 0;
+	NullBackendStats BackendStats = {};
+	const char* pLastError = nullptr;
+};
+
+class CBenchScene
+{
+public:
+	CBenchScene() = default;
+	~CBenchScene() = default;
+
+	bool Initialize(const BenchSceneDesc& desc, CWorkerPool* pWorkerPool);
+	void RunFrame(BenchFrameStats* pOutStats);
+
+private:
+	struct BenchObject
+	{
+		XMFLOAT3 Pos = {};
+		float RotY = 0.0f;
+		float RotSpeed = 0.0f;
+		UINT MeshIndex = 0;
+		XMMATRIX WorldMatrix = {};
+		Aabb LocalBounds = {};
+		Aabb WorldBounds = {};
+		int ProxyId = CDynamicAabbTree::NullNode;
+		bool bBoundsDirty = false;
+	};
+
+	struct BenchTriGroup
+	{
+		D3D12_INDEX_BUFFER_VIEW IndexBufferView = {};
+		IndexedTriCluster Cluster = {};
+		D3D12_CPU_DESCRIPTOR_HANDLE SrvDescriptorHandle = {};
+	};
+
+	struct BenchMesh
+	{
+		D3D12_VERTEX_BUFFER_VIEW VertexBufferView = {};
+		std::vector<BenchTriGroup> TriGroupList;
+	};
+
+	struct BenchDrawItem
+	{
+		const BenchMesh* pMesh = nullptr;		// nullptr이면 sprite
+		XMMATRIX WorldMatrix = {};
+		XMFLOAT2 SpritePos = {};
+	};
+
+	// RenderThreadContext + CFrameGpuDescriptorAllocator + CConstantBufferPool에 대응
+	struct BenchRenderContext
+	{
+		std::vector<BenchDrawItem> RenderQueue;
+		std::vector<CNullCommandList> CommandListPool;
+		UINT CommandListCount = 0;
+		CNullRenderDevice Device;
+		UINT DescriptorAllocatedCount = 0;
+		UINT DescriptorCapacity = 0;
+		UINT64 CpuDescriptorBase = 0;
+		UINT64 GpuDescriptorBase = 0;
+		std::vector<ConstantBufferDefault> DefaultCBPool;
+		std::vector<ConstantBufferSprite> SpriteCBPool;
+		UINT DefaultCBAllocatedCount = 0;
+		UINT SpriteCBAllocatedCount = 0;
+	};
+
+private:
+	void CreateMeshes();
+	void UpdateObjects(UINT beginIndex, UINT endIndex);
+	void SyncSceneProxies();
+	void CullSceneObjects();
+	void RasterizeOccluders();
+	void TestOcclusion(UINT beginIndex, UINT endIndex);
+	void BuildDrawList();
+	void SubmitDrawList();
+	void ProcessRenderQueue(UINT renderThreadIndex);
+	bool RecordMeshItem(CNullCommandList* pCommandList, BenchRenderContext& context, const BenchDrawItem& item);
+	bool RecordSpriteItem(CNullCommandList* pCommandList, BenchRenderContext& context, const BenchDrawItem& item);
+	bool AllocateDescriptors(BenchRenderContext& context, UINT count, D3D12_CPU_DESCRIPTOR_HANDLE* pOutCpuHandle, D3D12_GPU_DESCRIPTOR_HANDLE* pOutGpuHandle);
+
+private:
+	static constexpr UINT ObjectBatchSize = 64;
+	static constexpr UINT ProcessCountPerCommandList = 200;
+	static constexpr UINT DescriptorSize = 32;
+	static constexpr UINT MaxOccluderCount = 16;			// CGame과 같은 값
+	static constexpr float MinOccluderScreenArea = 64.0f;
+
+	BenchSceneDesc m_desc = {};
+	CWorkerPool* m_pWorkerPool = nullptr;
+	CTaskGraph m_updateTaskGraph;
+
+	std::vector<BenchMesh> m_meshList;
+	std::vector<BenchObject> m_objectList;
+	CDynamicAabbTree m_sceneTree;
+	std::vector<void*> m_visibleObjectList;
+	COcclusionCuller m_occlusionCuller;
+	std::vector<std::pair<float, const BenchObject*>> m_occluderCandidateList;
+	std::vector<UINT8> m_visibleOccludedList;
+	std::vector<BenchDrawItem> m_drawList;
+	std::vector<BenchRenderContext> m_renderContexts;
+
+	XMFLOAT3 m_cameraPos = {};
+	XMMATRIX m_viewMatrix = {};
+	XMMATRIX m_projectionMatrix = {};
+	D3D12_VIEWPORT m_viewport = {};
+	D3D12_RECT m_scissorRect = {};
+	UINT64 m_frameIndex = 0;
+};
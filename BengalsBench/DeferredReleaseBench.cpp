@@ -0,0 +1,218 @@
+#include "pch.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "DeferredReleaseBench.h"
+#include "BenchCheck.h"
+#include "Renderer/RenderHelper/DeferredReleaseQueue.h"
+
+namespace
+{
+	constexpr UINT FrameCountPerIteration = 1000;
+	constexpr UINT ReleaseCountPerFrame = 16;
+	constexpr UINT64 FrameLatency = 2;		// CD3D12Renderer::MaxPendingFrameCount
+
+	// release 실행 순서 기록
+	class CReleaseLog
+	{
+	public:
+		CDeferredReleaseQueue::ReleaseFunc MakeRelease(int id)
+		{
+			return [this, id]() { m_idList.push_back(id); };
+		}
+
+		bool Equals(std::initializer_list<int> expectedList) const
+		{
+			return m_idList == std::vector<int>(expectedList);
+		}
+
+		void Clear()
+		{
+			m_idList.clear();
+		}
+
+	private:
+		std::vector<int> m_idList;
+	};
+
+	bool VerifyOrdering()
+	{
+		CDeferredReleaseQueue queue;
+		CReleaseLog log;
+		bool bResult = true;
+
+		bResult &= Check(queue.ProcessCompleted(0) == 0, "empty queue releases nothing");
+
+		// 같은 fence 값은 넣은 순서대로
+		queue.Enqueue(1, log.MakeRelease(0));
+		queue.Enqueue(1, log.MakeRelease(1));
+		queue.Enqueue(2, log.MakeRelease(2));
+		queue.Enqueue(4, log.MakeRelease(3));
+		queue.Enqueue(4, log.MakeRelease(4));
+		bResult &= Check(queue.GetPendingCount() == 5, "pending count after enqueue");
+
+		// 아직 아무것도 끝나지 않았다
+		bResult &= Check(queue.ProcessCompleted(0) == 0 && log.Equals({}), "nothing released before its fence");
+
+		// 일부만 완료: 1까지만 실행되고 나머지는 남는다
+		bResult &= Check(queue.ProcessCompleted(1) == 2 && log.Equals({ 0, 1 }), "partial completion releases in enqueue order");
+		bResult &= Check(queue.GetPendingCount() == 3, "partial completion keeps later entries");
+
+		// 중간 값(3)은 fence 2까지만 실행한다
+		bResult &= Check(queue.ProcessCompleted(3) == 1 && log.Equals({ 0, 1, 2 }), "stops at the first pending fence");
+
+		// 같은 값을 다시 넘겨도 다시 실행하지 않는다
+		bResult &= Check(queue.ProcessCompleted(3) == 0, "repeated completed value releases nothing");
+
+		// 완료 값이 건너뛰어도 남은 것을 모두 실행
+		bResult &= Check(queue.ProcessCompleted(10) == 2 && log.Equals({ 0, 1, 2, 3, 4 }), "skipped completed value releases the rest");
+		bResult &= Check(queue.GetPendingCount() == 0 && queue.GetErrorCount() == 0, "queue empty without errors");
+		return bResult;
+	}
+
+	bool VerifyNestedRelease()
+	{
+		CDeferredReleaseQueue queue;
+		CReleaseLog log;
+		bool bResult = true;
+
+		// 메시가 해제되면서 텍스처 해제를 추가하는 경우: 다음 fence 값(3)으로 넣으면 이번 처리에서는 실행되지 않는다
+		queue.Enqueue(2, [&queue, &log]()
+		{
+			log.MakeRelease(0)();
+			queue.Enqueue(3, log.MakeRelease(1));
+		});
+		bResult &= Check(queue.ProcessCompleted(2) == 1 && log.Equals({ 0 }), "nested release with a later fence waits");
+		bResult &= Check(queue.GetPendingCount() == 1, "nested release is pending");
+		bResult &= Check(queue.ProcessCompleted(3) == 1 && log.Equals({ 0, 1 }), "nested release runs once its fence completes");
+
+		// 이미 완료된 fence 값으로 넣으면 같은 ProcessCompleted 안에서 실행된다
+		log.Clear();
+		queue.Enqueue(4, [&queue, &log]()
+		{
+			log.MakeRelease(2)();
+			queue.Enqueue(4, log.MakeRelease(3));
+		});
+		bResult &= Check(queue.ProcessCompleted(4) == 2 && log.Equals({ 2, 3 }), "nested release with a completed fence runs in the same call");
+		bResult &= Check(queue.GetPendingCount() == 0, "nothing left after nested release");
+
+		// Flush는 release가 추가한 release까지 비운다 (종료 시 메시 -> 텍스처 순서)
+		log.Clear();
+		queue.Enqueue(5, log.MakeRelease(4));
+		queue.Enqueue(9, [&queue, &log]()
+		{
+			log.MakeRelease(5)();
+			queue.Enqueue(10, [&queue, &log]()
+			{
+				log.MakeRelease(6)();
+				queue.Enqueue(11, log.MakeRelease(7));
+			});
+		});
+		bResult &= Check(queue.Flush() == 4 && log.Equals({ 4, 5, 6, 7 }), "flush drains nested releases");
+		bResult &= Check(queue.GetPendingCount() == 0 && queue.GetErrorCount() == 0, "queue empty after flush without errors");
+		bResult &= Check(queue.Flush() == 0, "flush on empty queue");
+		return bResult;
+	}
+
+	// 렌더러 순서: 프레임 중간에 compute용 signal(3)이 있어도 미룬 해제는 프레임 끝 fence(4)에 묶인다
+	bool VerifyNextFence()
+	{
+		CDeferredReleaseQueue queue;
+		CReleaseLog log;
+		bool bResult = true;
+
+		queue.Enqueue(2, log.MakeRelease(0));
+		bResult &= Check(queue.EnqueueForNextFence(log.MakeRelease(1)), "release for the next fence is accepted");
+		bResult &= Check(queue.GetPendingCount() == 2, "untagged release counts as pending");
+
+		// 중간 signal 값이 완료되어도 아직 fence가 없는 release는 실행되지 않는다
+		bResult &= Check(queue.ProcessCompleted(3) == 1 && log.Equals({ 0 }), "mid-frame signal does not run untagged release");
+
+		bResult &= Check(queue.AssignFence(4), "frame-end fence is assigned");
+		bResult &= Check(queue.ProcessCompleted(3) == 0 && log.Equals({ 0 }), "tagged release waits for the frame-end fence");
+		bResult &= Check(queue.ProcessCompleted(4) == 1 && log.Equals({ 0, 1 }), "tagged release runs at the frame-end fence");
+
+		// 작은 값은 Enqueue와 같이 보고하고 보정
+		queue.Enqueue(6, log.MakeRelease(2));
+		queue.EnqueueForNextFence(log.MakeRelease(3));
+		bResult &= Check(!queue.AssignFence(5) && queue.GetErrorCount() == 1, "smaller frame-end fence is reported");
+		bResult &= Check(queue.ProcessCompleted(5) == 0, "clamped frame-end release waits for the last fence");
+
+		// Flush는 fence를 받지 못한 release까지 실행
+		queue.EnqueueForNextFence(log.MakeRelease(4));
+		bResult &= Check(queue.Flush() == 3 && log.Equals({ 0, 1, 2, 3, 4 }) && queue.GetPendingCount() == 0, "flush runs untagged releases");
+		return bResult;
+	}
+
+	bool VerifyFenceGuard()
+	{
+		CDeferredReleaseQueue queue;
+		CReleaseLog log;
+		bool bResult = true;
+
+		bResult &= Check(queue.Enqueue(5, log.MakeRelease(0)), "increasing fence is accepted");
+
+		// 작아진 값은 오류로 보고하고 마지막 값(5)으로 올려 넣는다
+		bResult &= Check(!queue.Enqueue(3, log.MakeRelease(1)), "decreasing fence returns false");
+		bResult &= Check(queue.GetErrorCount() == 1 && queue.GetLastError() != nullptr, "decreasing fence is reported");
+		bResult &= Check(queue.GetPendingCount() == 2, "decreasing fence is still enqueued");
+
+		// 보정된 값(5)이 마지막 값이므로 그 사이 값(4)도 작아진 값이다
+		bResult &= Check(!queue.Enqueue(4, log.MakeRelease(2)) && queue.GetErrorCount() == 2, "clamped value becomes the last fence value");
+
+		// 원래 값(3, 4)으로는 실행되지 않는다: 그때 풀면 앞의 5보다 먼저 해제되는 것
+		bResult &= Check(queue.ProcessCompleted(4) == 0 && log.Equals({}), "clamped entries do not run at their original fence");
+		bResult &= Check(queue.ProcessCompleted(5) == 3 && log.Equals({ 0, 1, 2 }), "clamped entries run after the earlier entry");
+
+		// 빈 함수는 넣지 않는다
+		bResult &= Check(!queue.Enqueue(6, nullptr), "empty release returns false");
+		bResult &= Check(queue.GetErrorCount() == 3 && queue.GetPendingCount() == 0, "empty release is reported and dropped");
+
+		// 큐가 빈 뒤에는 더 작은 값도 정상이다 (비교 대상이 없다)
+		bResult &= Check(queue.Enqueue(1, log.MakeRelease(3)) && queue.GetErrorCount() == 3, "smaller fence after the queue drained is accepted");
+		bResult &= Check(queue.ProcessCompleted(1) == 1, "entry after drain runs");
+		return bResult;
+	}
+}
+
+bool RunDeferredReleaseBench(UINT iterationCount)
+{
+	bool bResult = VerifyOrdering();
+	bResult &= VerifyNestedRelease();
+	bResult &= VerifyNextFence();
+	bResult &= VerifyFenceGuard();
+	printf("ordering / nested / next fence / fence guard checks: %s\n\n", bResult ? "ok" : "FAILED");
+
+	// 렌더러 순서: 프레임 중에 release를 넣고 Present 앞 fence 값을 붙인 뒤, FrameLatency 프레임 전 fence까지 처리
+	const UINT frameCount = iterationCount * FrameCountPerIteration;
+	CDeferredReleaseQueue queue;
+	UINT64 releasedCount = 0;
+	UINT64 processedCount = 0;
+	UINT maxPendingCount = 0;
+
+	const auto begin = std::chrono::steady_clock::now();
+	for (UINT frame = 0; frame < frameCount; frame++)
+	{
+		const UINT64 pendingFenceValue = frame + 1;
+		for (UINT i = 0; i < ReleaseCountPerFrame; i++)
+		{
+			queue.EnqueueForNextFence([&releasedCount]() { releasedCount++; });
+		}
+		queue.AssignFence(pendingFenceValue);
+		maxPendingCount = (std::max)(maxPendingCount, queue.GetPendingCount());
+
+		const UINT64 completedFenceValue = (pendingFenceValue > FrameLatency) ? pendingFenceValue - FrameLatency : 0;
+		processedCount += queue.ProcessCompleted(completedFenceValue);
+	}
+	const double elapsedNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+	processedCount += queue.Flush();
+
+	const UINT64 enqueuedCount = static_cast<UINT64>(frameCount) * ReleaseCountPerFrame;
+	bResult &= Check(releasedCount == enqueuedCount && processedCount == enqueuedCount, "every release runs exactly once");
+	bResult &= Check(maxPendingCount == (FrameLatency + 1) * ReleaseCountPerFrame, "pending releases bounded by frame latency");
+	bResult &= Check(queue.GetErrorCount() == 0, queue.GetLastError() ? queue.GetLastError() : "queue error");
+
+	printf("%9s %12s %12s %12s\n", "frames", "releases", "max pending", "ns/release");
+	printf("%9u %12llu %12u %12.1f\n", frameCount, static_cast<unsigned long long>(enqueuedCount), maxPendingCount, elapsedNs / enqueuedCount);
+	return bResult;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+/**
+ * CDeferredReleaseQueue 단독 검증. 완료 fence 값을 직접 넘겨 Enqueue / ProcessCompleted / Flush의 실행 순서,
+ * 일부만 완료된 경우, release 안에서 추가한 release, 프레임 끝 fence에 묶는 EnqueueForNextFence / AssignFence,
+ * 작아진 fence 값의 보정과 오류 보고를 확인하고, 렌더러처럼 프레임마다 release를 넣고 2프레임 뒤에 처리하는
+ * 순서를 N * 1000프레임 실행해 비용을 잰다.
+ * 검증이 틀리면 false. GPU 없이 실행된다.
+ */
+
+bool RunDeferredReleaseBench(UINT iterationCount);
@@ -0,0 +1,211 @@
+#include "pch.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "FramePacingBench.h"
+#include "BenchCheck.h"
+#include "Renderer/RenderHelper/FrameClock.h"
+#include "Renderer/RenderHelper/FramePacer.h"
+
+namespace
+{
+	constexpr UINT MaxPendingFrameCount = 2;		// CD3D12Renderer::MaxPendingFrameCount (SwapChainFrameCount - 1)
+	constexpr UINT FrameCountPerIteration = 1000;
+	constexpr double TimeEpsilon = 1e-6;
+
+	bool IsNear(double value, double expected)
+	{
+		return std::fabs(value - expected) < TimeEpsilon;
+	}
+
+	// pending 1이면 CPU가 GPU를 기다려 직렬, 2 이상이면 둘이 겹친다. 반환: 이 프레임의 시간 (EndFrame 간격)
+	double RunFrame(CFramePacer* pPacer, CSimulatedFrameClock* pClock, double cpuSeconds, double gpuSeconds)
+	{
+		const double beginTime = pClock->GetTimeInSeconds();
+		pClock->Advance((pPacer->GetPendingFrameCount() > 1) ? (std::max)(cpuSeconds, gpuSeconds) : cpuSeconds + gpuSeconds);
+		pPacer->WaitForFrameSlot();
+		pPacer->EndFrame(gpuSeconds);
+		return pClock->GetTimeInSeconds() - beginTime;
+	}
+
+	bool InitializePacer(CFramePacer* pPacer, CSimulatedFrameClock* pClock, float targetFps, bool bAdaptive)
+	{
+		FramePacingDesc desc = {};
+		desc.TargetFps = targetFps;
+		desc.bAdaptivePendingFrames = bAdaptive;
+		if (!pPacer->Initialize(pClock, MaxPendingFrameCount, desc))
+		{
+			return false;
+		}
+
+		// 첫 프레임은 기준만 잡는다
+		RunFrame(pPacer, pClock, 0.001, 0.0);
+		return true;
+	}
+
+	bool VerifyLimiter()
+	{
+		constexpr float TargetFps = 60.0f;
+		const double frameInterval = 1.0 / TargetFps;
+
+		CSimulatedFrameClock clock;
+		CFramePacer pacer;
+		bool bResult = Check(InitializePacer(&pacer, &clock, TargetFps, false), "initialize");
+
+		// 목표보다 빠른 프레임은 정확히 간격마다 끝난다
+		bool bCadence = true;
+		for (UINT frame = 0; frame < 120; frame++)
+		{
+			bCadence &= IsNear(RunFrame(&pacer, &clock, 0.004, 0.002), frameInterval);
+		}
+		bResult &= Check(bCadence, "limiter cadence");
+
+		// 한 간격 안쪽으로 늦으면 다음 프레임이 따라잡아 두 프레임 합이 두 간격
+		const double lateFrame = RunFrame(&pacer, &clock, 0.020, 0.002);
+		const double catchUpFrame = RunFrame(&pacer, &clock, 0.004, 0.002);
+		bResult &= Check(IsNear(lateFrame + catchUpFrame, 2.0 * frameInterval) && catchUpFrame < frameInterval, "small delay is caught up");
+
+		// 한 간격 이상 밀리면 기준을 다시 잡는다: 뒤 프레임이 몰아서 짧아지지 않는다
+		const double hitchFrame = RunFrame(&pacer, &clock, 0.050, 0.002);
+		bool bResync = IsNear(hitchFrame, 0.050);
+		for (UINT frame = 0; frame < 60; frame++)
+		{
+			bResync &= IsNear(RunFrame(&pacer, &clock, 0.004, 0.002), frameInterval);
+		}
+		bResult &= Check(bResync, "hitch resync");
+		return bResult;
+	}
+
+	bool VerifyFrameTimeStats()
+	{
+		CSimulatedFrameClock clock;
+		CFramePacer pacer;
+		bool bResult = Check(InitializePacer(&pacer, &clock, 0.0f, false), "initialize");
+
+		// 200프레임 중 10프레임만 30ms
+		for (UINT frame = 0; frame < 200; frame++)
+		{
+			RunFrame(&pacer, &clock, (frame % 20 == 19) ? 0.030 : 0.010, 0.001);
+		}
+
+		FrameTimeStats stats = {};
+		pacer.GetFrameTimeStats(&stats);
+		bResult &= Check(stats.SampleCount == 200, "sample count");
+		bResult &= Check(IsNear(stats.P50Ms, 10.0) && IsNear(stats.P99Ms, 30.0) && IsNear(stats.MaxMs, 30.0), "p50 / p99 / max");
+		bResult &= Check(IsNear(stats.AverageMs, 11.0), "average");
+		bResult &= Check(stats.PendingFrameCount == MaxPendingFrameCount, "fixed pending count");
+
+		pacer.ResetStats();
+		pacer.GetFrameTimeStats(&stats);
+		bResult &= Check(stats.SampleCount == 0, "reset stats");
+		return bResult;
+	}
+
+	struct PendingScenarioStep
+	{
+		UINT WindowCount = 0;
+		double CpuSeconds = 0.0;
+		double GpuSeconds = 0.0;
+	};
+
+	struct PendingScenarioResult
+	{
+		std::vector<UINT> TransitionFrameList = {};		// pending 수가 바뀐 프레임 번호
+		UINT FinalPendingFrameCount = 0;
+	};
+
+	PendingScenarioResult RunPendingScenario(const PendingScenarioStep* pStepList, UINT stepCount)
+	{
+		CSimulatedFrameClock clock;
+		CFramePacer pacer;
+		InitializePacer(&pacer, &clock, 0.0f, true);
+
+		PendingScenarioResult result = {};
+		UINT pendingFrameCount = pacer.GetPendingFrameCount();
+		UINT frameIndex = 0;
+		for (UINT stepIndex = 0; stepIndex < stepCount; stepIndex++)
+		{
+			const PendingScenarioStep& step = pStepList[stepIndex];
+			for (UINT frame = 0; frame < step.WindowCount * CFramePacer::AdaptWindowFrameCount; frame++, frameIndex++)
+			{
+				RunFrame(&pacer, &clock, step.CpuSeconds, step.GpuSeconds);
+				if (pacer.GetPendingFrameCount() != pendingFrameCount)
+				{
+					pendingFrameCount = pacer.GetPendingFrameCount();
+					result.TransitionFrameList.push_back(frameIndex);
+				}
+			}
+		}
+		result.FinalPendingFrameCount = pendingFrameCount;
+		return result;
+	}
+
+	bool VerifyPendingFrameCount()
+	{
+		constexpr UINT WindowFrameCount = CFramePacer::AdaptWindowFrameCount;
+		bool bResult = true;
+
+		// CPU와 GPU가 비슷하면 1에서는 대기가 크고 2에서는 거의 없다. 한 번 올라간 뒤 그대로여야 한다
+		const PendingScenarioStep balancedStep = { 20, 0.008, 0.006 };
+		PendingScenarioResult balanced = RunPendingScenario(&balancedStep, 1);
+		bResult &= Check(balanced.TransitionFrameList.size() == 1 && balanced.TransitionFrameList[0] == WindowFrameCount - 1, "balanced load raises once");
+		bResult &= Check(balanced.FinalPendingFrameCount == 2, "balanced load stays at 2 (no oscillation)");
+
+		// GPU가 한가하면 1에서 움직이지 않는다
+		const PendingScenarioStep cpuBoundStep = { 20, 0.010, 0.0005 };
+		PendingScenarioResult cpuBound = RunPendingScenario(&cpuBoundStep, 1);
+		bResult &= Check(cpuBound.TransitionFrameList.empty() && cpuBound.FinalPendingFrameCount == 1, "cpu-bound load stays at 1");
+
+		// 두 기준 사이는 어느 쪽으로도 움직이지 않는다
+		const PendingScenarioStep betweenStep = { 20, 0.008, 0.0012 };
+		PendingScenarioResult between = RunPendingScenario(&betweenStep, 1);
+		bResult &= Check(between.TransitionFrameList.empty() && between.FinalPendingFrameCount == 1, "load between thresholds stays at 1");
+
+		// GPU 부하가 줄면 LowerPendingWindowCount 창이 연속으로 낮은 뒤에만 1로 내려간다
+		const PendingScenarioStep dropStepList[] = { { 10, 0.008, 0.006 }, { 10, 0.008, 0.0005 } };
+		PendingScenarioResult drop = RunPendingScenario(dropStepList, 2);
+		const UINT dropFrame = 10 * WindowFrameCount;
+		bResult &= Check(drop.TransitionFrameList.size() == 2 && drop.FinalPendingFrameCount == 1, "load drop lowers once");
+		bResult &= Check(drop.TransitionFrameList.size() == 2 && drop.TransitionFrameList[1] == dropFrame + CFramePacer::LowerPendingWindowCount * WindowFrameCount - 1, "lowering waits for consecutive low windows");
+
+		// 낮은 창 사이에 바쁜 창이 끼면 다시 센다
+		const PendingScenarioStep spikeStepList[] = { { 2, 0.008, 0.006 }, { 2, 0.008, 0.0005 }, { 1, 0.008, 0.006 }, { 2, 0.008, 0.0005 } };
+		PendingScenarioResult spike = RunPendingScenario(spikeStepList, 4);
+		bResult &= Check(spike.TransitionFrameList.size() == 1 && spike.FinalPendingFrameCount == 2, "busy window resets the low count");
+
+		printf("%-22s %11s %13s\n", "scenario", "transitions", "final pending");
+		printf("%-22s %11zu %13u\n", "balanced 8/6 ms", balanced.TransitionFrameList.size(), balanced.FinalPendingFrameCount);
+		printf("%-22s %11zu %13u\n", "cpu-bound 10/0.5 ms", cpuBound.TransitionFrameList.size(), cpuBound.FinalPendingFrameCount);
+		printf("%-22s %11zu %13u\n", "between 8/1.2 ms", between.TransitionFrameList.size(), between.FinalPendingFrameCount);
+		printf("%-22s %11zu %13u\n", "gpu load drop", drop.TransitionFrameList.size(), drop.FinalPendingFrameCount);
+		printf("%-22s %11zu %13u\n\n", "short gpu spike", spike.TransitionFrameList.size(), spike.FinalPendingFrameCount);
+		return bResult;
+	}
+}
+
+bool RunFramePacingBench(UINT iterationCount)
+{
+	bool bResult = VerifyLimiter();
+	bResult &= VerifyFrameTimeStats();
+	printf("limiter / stats checks: %s\n\n", bResult ? "ok" : "FAILED");
+
+	bResult &= VerifyPendingFrameCount();
+
+	CSimulatedFrameClock clock;
+	CFramePacer pacer;
+	bResult &= Check(InitializePacer(&pacer, &clock, 0.0f, true), "initialize");
+
+	const auto begin = std::chrono::steady_clock::now();
+	for (UINT i = 0; i < iterationCount * FrameCountPerIteration; i++)
+	{
+		RunFrame(&pacer, &clock, 0.008, 0.006);
+	}
+	const double elapsedNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+
+	FrameTimeStats stats = {};
+	pacer.GetFrameTimeStats(&stats);
+	printf("%9s %9s %9s %9s\n", "frames", "p50 ms", "p99 ms", "ns/frame");
+	printf("%9u %9.3f %9.3f %9.1f\n", iterationCount * FrameCountPerIteration, stats.P50Ms, stats.P99Ms, elapsedNs / (iterationCount * FrameCountPerIteration));
+	return bResult;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+/**
+ * CFramePacer 단독 검증. CSimulatedFrameClock으로 CPU / GPU 시간을 정해 둔 프레임을 돌리면서
+ * 목표 FPS 간격, 히치 뒤 기준 재설정, p50 / p99 통계, pending 프레임 수 전환(진동 없음)을 확인하고
+ * EndFrame 비용을 N * 1000프레임으로 잰다. 검증이 틀리면 false. GPU 없이 실행된다.
+ */
+
+bool RunFramePacingBench(UINT iterationCount);
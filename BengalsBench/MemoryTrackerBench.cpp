@@ -0,0 +1,134 @@
+#include "pch.h"
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "MemoryTrackerBench.h"
+#include "BenchCheck.h"
+#include "Profiler/MemoryTracker.h"
+
+namespace
+{
+	constexpr UINT RecordCountPerIteration = 100000;		// 스레드당 할당 + 해제 쌍
+	constexpr UINT64 RecordSize = 64 * 1024;
+
+	// 스레드마다 할당 / 해제 쌍을 반복. 반환: 전체 기록 1회당 ns
+	double RunRecordThreads(CMemoryTracker* pTracker, UINT threadCount)
+	{
+		const auto begin = std::chrono::steady_clock::now();
+
+		std::vector<std::thread> threadList;
+		for (UINT threadIndex = 0; threadIndex < threadCount; threadIndex++)
+		{
+			threadList.emplace_back([pTracker, threadIndex]()
+				{
+					const EMemoryCategory category = static_cast<EMemoryCategory>(threadIndex % CMemoryTracker::CategoryCount);
+					for (UINT i = 0; i < RecordCountPerIteration; i++)
+					{
+						pTracker->RecordAllocation(category, RecordSize);
+						pTracker->RecordFree(category, RecordSize);
+					}
+				});
+		}
+		for (std::thread& thread : threadList)
+		{
+			thread.join();
+		}
+
+		const double elapsedNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+		return elapsedNs / (static_cast<double>(threadCount) * RecordCountPerIteration * 2);
+	}
+
+	bool VerifyAccounting()
+	{
+		CMemoryTracker tracker;
+		std::vector<MemoryBudgetEvent> eventList;
+		tracker.SetBudgetCallback([&eventList](const MemoryBudgetEvent& budgetEvent)
+			{
+				eventList.push_back(budgetEvent);
+			});
+		tracker.SetBudget(EMemoryCategory::Texture, 3 * RecordSize);
+
+		bool bResult = true;
+		MemoryStats stats = {};
+
+		// 프레임 0: 텍스처 4개 (budget 초과), geometry 1개
+		for (UINT i = 0; i < 4; i++)
+		{
+			tracker.RecordAllocation(EMemoryCategory::Texture, RecordSize);
+		}
+		tracker.RecordAllocation(EMemoryCategory::Geometry, RecordSize);
+		tracker.EndFrame();
+		tracker.GetStats(&stats);
+
+		const MemoryCategoryStats& texture = stats.CategoryList[static_cast<size_t>(EMemoryCategory::Texture)];
+		bResult &= Check(texture.CurrentBytes == 4 * RecordSize, "texture current after frame 0");
+		bResult &= Check(texture.FrameAllocatedBytes == 4 * RecordSize, "texture churn after frame 0");
+		bResult &= Check(stats.Total.CurrentBytes == 5 * RecordSize && stats.Total.AllocationCount == 5, "total after frame 0");
+		bResult &= Check(eventList.size() == 1 && eventList[0].Category == EMemoryCategory::Texture && eventList[0].bOverBudget, "over-budget event");
+
+		// 프레임 1: 아무 변화 없음 -> 이벤트 없음, churn 0
+		tracker.EndFrame();
+		tracker.GetStats(&stats);
+		bResult &= Check(stats.CategoryList[static_cast<size_t>(EMemoryCategory::Texture)].FrameAllocatedBytes == 0, "texture churn after idle frame");
+		bResult &= Check(eventList.size() == 1, "budget event is edge-triggered");
+
+		// 프레임 2: 전부 해제 -> budget 안으로 복귀, peak는 유지
+		for (UINT i = 0; i < 4; i++)
+		{
+			tracker.RecordFree(EMemoryCategory::Texture, RecordSize);
+		}
+		tracker.RecordFree(EMemoryCategory::Geometry, RecordSize);
+		tracker.EndFrame();
+		tracker.GetStats(&stats);
+
+		const MemoryCategoryStats& textureAfterFree = stats.CategoryList[static_cast<size_t>(EMemoryCategory::Texture)];
+		bResult &= Check(stats.Total.CurrentBytes == 0 && stats.Total.AllocationCount == 0, "total returns to zero");
+		bResult &= Check(textureAfterFree.PeakBytes == 4 * RecordSize && stats.Total.PeakBytes == 5 * RecordSize, "peak survives free");
+		bResult &= Check(textureAfterFree.FrameFreedBytes == 4 * RecordSize, "texture freed churn");
+		bResult &= Check(eventList.size() == 2 && !eventList[1].bOverBudget, "back-under-budget event");
+		bResult &= Check(stats.FrameIndex == 3, "frame index");
+
+		tracker.ResetPeaks();
+		tracker.GetStats(&stats);
+		bResult &= Check(stats.Total.PeakBytes == 0, "peak after ResetPeaks");
+
+		std::string report;
+		tracker.WriteReport(report);
+		bResult &= Check(!report.empty(), "report text");
+		return bResult;
+	}
+}
+
+bool RunMemoryTrackerBench(UINT iterationCount)
+{
+	bool bResult = VerifyAccounting();
+	printf("accounting checks: %s\n\n", bResult ? "ok" : "FAILED");
+
+	const UINT maxThreadCount = (std::max)(1u, std::thread::hardware_concurrency());
+	printf("%7s %12s %10s\n", "threads", "records", "ns/record");
+
+	for (UINT threadCount = 1; ; threadCount = (std::min)(threadCount * 2, maxThreadCount))
+	{
+		CMemoryTracker tracker;
+		double nsPerRecord = 0.0;
+		for (UINT i = 0; i < iterationCount; i++)
+		{
+			nsPerRecord += RunRecordThreads(&tracker, threadCount);
+		}
+		nsPerRecord /= iterationCount;
+
+		MemoryStats stats = {};
+		tracker.GetStats(&stats);
+		bResult &= Check(stats.Total.CurrentBytes == 0 && stats.Total.AllocationCount == 0, "concurrent records balance out");
+		bResult &= Check(stats.Total.PeakBytes <= static_cast<UINT64>(threadCount) * RecordSize, "concurrent peak bound");
+
+		printf("%7u %12llu %10.2f\n", threadCount, static_cast<unsigned long long>(threadCount) * RecordCountPerIteration * 2, nsPerRecord);
+
+		if (threadCount == maxThreadCount)
+		{
+			break;
+		}
+	}
+	return bResult;
+}
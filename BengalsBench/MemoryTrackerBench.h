@@ -0,0 +1,8 @@
+#pragma once
+
+/**
+ * CMemoryTracker 단독 벤치마크. 여러 스레드에서 할당 / 해제 기록을 N회씩 실행해 ns/op를 출력하고,
+ * 현재 크기 / peak / 프레임 churn / budget 콜백이 기대값과 다르면 false. GPU 없이 실행된다.
+ */
+
+bool RunMemoryTrackerBench(UINT iterationCount);
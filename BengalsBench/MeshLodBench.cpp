@@ -0,0 +1,191 @@
+#include "pch.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "MeshLodBench.h"
+#include "Renderer/RenderHelper/IndexCluster.h"
+#include "Renderer/RenderHelper/MeshLod.h"
+#include "Renderer/RenderHelper/MeshOptimizer.h"
+
+namespace
+{
+	struct BenchVertex
+	{
+		XMFLOAT3 Position = {};
+		XMFLOAT2 TexCoord = {};
+	};
+
+	struct BenchMeshSource
+	{
+		const char* pName = nullptr;
+		std::vector<BenchVertex> VertexList;
+		std::vector<UINT> IndexList;
+	};
+
+	BenchMeshSource CreateSphere(UINT sliceCount, UINT stackCount)
+	{
+		BenchMeshSource mesh = {};
+		mesh.pName = "sphere 256x128";
+
+		for (UINT stack = 0; stack <= stackCount; stack++)
+		{
+			const float phi = XM_PI * stack / stackCount;
+			for (UINT slice = 0; slice <= sliceCount; slice++)
+			{
+				const float theta = XM_2PI * slice / sliceCount;
+				BenchVertex vertex = {};
+				vertex.Position = { sinf(phi) * cosf(theta), cosf(phi), sinf(phi) * sinf(theta) };
+				vertex.TexCoord = { static_cast<float>(slice) / sliceCount, static_cast<float>(stack) / stackCount };
+				mesh.VertexList.push_back(vertex);
+			}
+		}
+
+		for (UINT stack = 0; stack < stackCount; stack++)
+		{
+			for (UINT slice = 0; slice < sliceCount; slice++)
+			{
+				const UINT i0 = stack * (sliceCount + 1) + slice;
+				const UINT i1 = i0 + sliceCount + 1;
+				mesh.IndexList.insert(mesh.IndexList.end(), { i0, i0 + 1, i1 + 1, i0, i1 + 1, i1 });
+			}
+		}
+		return mesh;
+	}
+
+	// 경계가 열린 높이맵 지형 (경계 정점은 경계를 따라서만 줄어든다)
+	BenchMeshSource CreateTerrain(UINT gridSize)
+	{
+		BenchMeshSource mesh = {};
+		mesh.pName = "terrain 256x256";
+
+		for (UINT y = 0; y <= gridSize; y++)
+		{
+			for (UINT x = 0; x <= gridSize; x++)
+			{
+				const float u = static_cast<float>(x) / gridSize;
+				const float v = static_cast<float>(y) / gridSize;
+				const float height = 0.05f * sinf(u * 12.0f) * cosf(v * 9.0f) + 0.01f * sinf(u * 57.0f + v * 31.0f);
+				mesh.VertexList.push_back({ { u, height, v }, { u, v } });
+			}
+		}
+
+		for (UINT y = 0; y < gridSize; y++)
+		{
+			for (UINT x = 0; x < gridSize; x++)
+			{
+				const UINT i0 = y * (gridSize + 1) + x;
+				const UINT i1 = i0 + gridSize + 1;
+				mesh.IndexList.insert(mesh.IndexList.end(), { i0, i1, i1 + 1, i0, i1 + 1, i0 + 1 });
+			}
+		}
+		return mesh;
+	}
+
+	bool RunSelectionBench(const std::vector<MeshLodLevel>& lodList, UINT iterationCount)
+	{
+		static constexpr UINT ObjectCount = 100000;
+		static constexpr float ViewportHeight = 720.0f;
+		static constexpr float MaxPixelError = 1.0f;
+
+		float lodErrorList[MaxMeshLodCount] = {};
+		const UINT lodCount = static_cast<UINT>(lodList.size());
+		for (UINT lod = 0; lod < lodCount; lod++)
+		{
+			lodErrorList[lod] = lodList[lod].Error;
+		}
+
+		// 카메라 앞 2 ~ 200 거리에 무작위 배치 (CD3D12Renderer::InitializeCamera와 같은 투영)
+		const XMMATRIX viewMatrix = XMMatrixLookToLH(XMVectorSet(0.0f, 0.0f, -1.0f, 1.0f), XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+		const XMMATRIX projMatrix = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.1f, 1000.0f);
+
+		std::mt19937 rng(4321);
+		std::uniform_real_distribution<float> distanceDist(2.0f, 200.0f);
+		std::uniform_real_distribution<float> offsetDist(-20.0f, 20.0f);
+		std::uniform_real_distribution<float> scaleDist(0.5f, 2.0f);
+		std::vector<XMMATRIX> worldMatrixList(ObjectCount);
+		for (XMMATRIX& worldMatrix : worldMatrixList)
+		{
+			const float scale = scaleDist(rng);
+			worldMatrix = XMMatrixMultiply(XMMatrixScaling(scale, scale, scale), XMMatrixTranslation(offsetDist(rng), offsetDist(rng), distanceDist(rng)));
+		}
+
+		UINT lodHistogram[MaxMeshLodCount] = {};
+		double totalMs = 0.0;
+		for (UINT i = 0; i < iterationCount; i++)
+		{
+			std::fill(std::begin(lodHistogram), std::end(lodHistogram), 0u);
+
+			const auto beginTime = std::chrono::steady_clock::now();
+			for (const XMMATRIX& worldMatrix : worldMatrixList)
+			{
+				const float pixelsPerUnit = ComputeMeshLodPixelsPerUnit(worldMatrix, viewMatrix, projMatrix, ViewportHeight, XMFLOAT3(0.0f, 0.0f, 0.0f), 1.0f);
+				lodHistogram[SelectMeshLod(lodErrorList, lodCount, pixelsPerUnit, MaxPixelError)]++;
+			}
+			totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - beginTime).count();
+		}
+
+		const double averageMs = totalMs / iterationCount;
+		printf("  select %u objects: %.3f ms (%.1f ns/object), lod", ObjectCount, averageMs, averageMs * 1.0e6 / ObjectCount);
+		for (UINT lod = 0; lod < lodCount; lod++)
+		{
+			printf(" %u:%u", lod, lodHistogram[lod]);
+		}
+		printf("\n");
+		return true;
+	}
+}
+
+bool RunMeshLodBench(UINT iterationCount)
+{
+	iterationCount = (std::max)(1u, iterationCount);
+
+	std::vector<BenchMeshSource> meshList;
+	meshList.push_back(CreateSphere(256, 128));
+	meshList.push_back(CreateTerrain(256));
+
+	printf("mesh lod: iterations=%u lods=%u reduction=%.2f\n\n", iterationCount, MaxMeshLodCount, MeshLodReduction);
+
+	bool bResult = true;
+	for (const BenchMeshSource& mesh : meshList)
+	{
+		const BYTE* pVertexData = reinterpret_cast<const BYTE*>(mesh.VertexList.data());
+		const UINT vertexCount = static_cast<UINT>(mesh.VertexList.size());
+		const std::vector<UINT> groupIndexCountList = { static_cast<UINT>(mesh.IndexList.size()) };
+
+		std::vector<MeshLodLevel> lodList;
+		double totalMs = 0.0;
+		for (UINT i = 0; i < iterationCount; i++)
+		{
+			const auto beginTime = std::chrono::steady_clock::now();
+			if (!BuildMeshLodChain(pVertexData, vertexCount, sizeof(BenchVertex), mesh.IndexList, groupIndexCountList, MaxMeshLodCount, MeshOptimizeVertexCache, &lodList))
+			{
+				bResult = false;
+				break;
+			}
+			totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - beginTime).count();
+		}
+		if (lodList.empty())
+		{
+			continue;
+		}
+
+		printf("%s: %u verts, build %.3f ms\n", mesh.pName, vertexCount, totalMs / iterationCount);
+		for (UINT lod = 0; lod < lodList.size(); lod++)
+		{
+			const MeshLodLevel& level = lodList[lod];
+			const VertexCacheStats cacheStats = ComputeVertexCacheStats(level.IndexList.data(), static_cast<UINT>(level.IndexList.size()), vertexCount);
+			// CBasicMeshObject::EndCreateMesh와 같은 인덱스 폭 선택
+			std::vector<WORD> index16List;
+			std::vector<IndexedTriCluster> clusterList;
+			const bool bIndex16 = BuildIndexClusters16(level.IndexList.data(), static_cast<UINT>(level.IndexList.size()), MaxIndexClusterCount, &index16List, &clusterList);
+			printf("  lod %u: %8zu tris  error %.5f  ACMR %.3f  index %s x%zu (%zu bytes)\n", lod, level.IndexList.size() / 3, level.Error, cacheStats.Acmr,
+				bIndex16 ? "R16" : "R32", bIndex16 ? clusterList.size() : 1, level.IndexList.size() * (bIndex16 ? sizeof(WORD) : sizeof(UINT)));
+		}
+
+		bResult = RunSelectionBench(lodList, iterationCount) && bResult;
+		printf("\n");
+	}
+	return bResult;
+}
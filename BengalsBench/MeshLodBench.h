@@ -0,0 +1,8 @@
+#pragma once
+
+/**
+ * MeshLod 단독 벤치마크. 큰 메시마다 LOD 체인 생성 시간과 LOD별 삼각형 수 / 오차를,
+ * 이어서 무작위 배치한 객체들의 LOD 선택 시간과 분포를 출력한다. GPU 없이 실행된다.
+ */
+
+bool RunMeshLodBench(UINT iterationCount);
@@ -0,0 +1,209 @@
+#include "pch.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "MeshOptimizeBench.h"
+#include "Renderer/RenderHelper/MeshOptimizer.h"
+
+namespace
+{
+	struct BenchVertex
+	{
+		XMFLOAT3 Position = {};
+		XMFLOAT2 TexCoord = {};
+	};
+
+	struct BenchMeshSource
+	{
+		const char* pName = nullptr;
+		std::vector<BenchVertex> VertexList;
+		std::vector<UINT> IndexList;
+		std::vector<UINT> GroupIndexCountList;
+	};
+
+	// 삼각형마다 정점을 따로 두는 soup (CGameObject::CreateBoxMesh가 만드는 형태)
+	void AppendTriangleSoup(BenchMeshSource* pMesh, const BenchVertex& a, const BenchVertex& b, const BenchVertex& c)
+	{
+		for (const BenchVertex* pVertex : { &a, &b, &c })
+		{
+			pMesh->IndexList.push_back(static_cast<UINT>(pMesh->VertexList.size()));
+			pMesh->VertexList.push_back(*pVertex);
+		}
+	}
+
+	BenchMeshSource CreateBoxSoup()
+	{
+		static constexpr float HalfBoxLen = 0.25f;
+		const XMFLOAT3 cornerList[8] =
+		{
+			{ -HalfBoxLen, HalfBoxLen, HalfBoxLen }, { -HalfBoxLen, -HalfBoxLen, HalfBoxLen },
+			{ HalfBoxLen, -HalfBoxLen, HalfBoxLen }, { HalfBoxLen, HalfBoxLen, HalfBoxLen },
+			{ -HalfBoxLen, HalfBoxLen, -HalfBoxLen }, { -HalfBoxLen, -HalfBoxLen, -HalfBoxLen },
+			{ HalfBoxLen, -HalfBoxLen, -HalfBoxLen }, { HalfBoxLen, HalfBoxLen, -HalfBoxLen }
+		};
+		const UINT faceCornerList[6][4] = { { 3, 0, 1, 2 }, { 4, 7, 6, 5 }, { 0, 4, 5, 1 }, { 7, 3, 2, 6 }, { 0, 3, 7, 4 }, { 2, 1, 5, 6 } };
+		const XMFLOAT2 texCoordList[4] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+
+		BenchMeshSource mesh = {};
+		mesh.pName = "box soup";
+		for (const auto& faceCorner : faceCornerList)
+		{
+			BenchVertex quad[4] = {};
+			for (UINT i = 0; i < 4; i++)
+			{
+				quad[i] = { cornerList[faceCorner[i]], texCoordList[i] };
+			}
+			AppendTriangleSoup(&mesh, quad[0], quad[1], quad[2]);
+			AppendTriangleSoup(&mesh, quad[0], quad[2], quad[3]);
+			mesh.GroupIndexCountList.push_back(6);
+		}
+		return mesh;
+	}
+
+	BenchMeshSource CreateShuffledGridSoup(UINT gridSize)
+	{
+		BenchMeshSource mesh = {};
+		mesh.pName = "grid soup 128x128";
+
+		auto MakeVertex = [gridSize](UINT x, UINT y)
+			{
+				return BenchVertex{ { static_cast<float>(x), static_cast<float>(y), 0.0f }, { static_cast<float>(x) / gridSize, static_cast<float>(y) / gridSize } };
+			};
+
+		std::vector<UINT> cellList(gridSize * gridSize);
+		for (UINT i = 0; i < cellList.size(); i++)
+		{
+			cellList[i] = i;
+		}
+		std::mt19937 rng(1234);
+		std::shuffle(cellList.begin(), cellList.end(), rng);
+
+		for (UINT cell : cellList)
+		{
+			const UINT x = cell % gridSize;
+			const UINT y = cell / gridSize;
+			AppendTriangleSoup(&mesh, MakeVertex(x, y), MakeVertex(x + 1, y), MakeVertex(x + 1, y + 1));
+			AppendTriangleSoup(&mesh, MakeVertex(x, y), MakeVertex(x + 1, y + 1), MakeVertex(x, y + 1));
+		}
+		mesh.GroupIndexCountList.push_back(static_cast<UINT>(mesh.IndexList.size()));
+		return mesh;
+	}
+
+	// 정점은 공유하지만 삼각형 순서가 무작위인 구 (DCC 툴에서 나온 메시에 가까운 경우)
+	BenchMeshSource CreateShuffledSphere(UINT sliceCount, UINT stackCount)
+	{
+		BenchMeshSource mesh = {};
+		mesh.pName = "sphere 64x128 shuffled";
+
+		for (UINT stack = 0; stack <= stackCount; stack++)
+		{
+			const float phi = XM_PI * stack / stackCount;
+			for (UINT slice = 0; slice <= sliceCount; slice++)
+			{
+				const float theta = XM_2PI * slice / sliceCount;
+				BenchVertex vertex = {};
+				vertex.Position = { sinf(phi) * cosf(theta), cosf(phi), sinf(phi) * sinf(theta) };
+				vertex.TexCoord = { static_cast<float>(slice) / sliceCount, static_cast<float>(stack) / stackCount };
+				mesh.VertexList.push_back(vertex);
+			}
+		}
+
+		std::vector<UINT> triList;
+		for (UINT stack = 0; stack < stackCount; stack++)
+		{
+			for (UINT slice = 0; slice < sliceCount; slice++)
+			{
+				const UINT i0 = stack * (sliceCount + 1) + slice;
+				const UINT i1 = i0 + sliceCount + 1;
+				triList.insert(triList.end(), { i0, i0 + 1, i1 + 1 });
+				triList.insert(triList.end(), { i0, i1 + 1, i1 });
+			}
+		}
+
+		std::vector<UINT> triOrder(triList.size() / 3);
+		for (UINT i = 0; i < triOrder.size(); i++)
+		{
+			triOrder[i] = i;
+		}
+		std::mt19937 rng(5678);
+		std::shuffle(triOrder.begin(), triOrder.end(), rng);
+		for (UINT tri : triOrder)
+		{
+			mesh.IndexList.insert(mesh.IndexList.end(), triList.begin() + tri * 3, triList.begin() + tri * 3 + 3);
+		}
+		mesh.GroupIndexCountList.push_back(static_cast<UINT>(mesh.IndexList.size()));
+		return mesh;
+	}
+
+	const char* GetFlagName(UINT optimizeFlags)
+	{
+		switch (optimizeFlags)
+		{
+		case MeshOptimizeWeld:
+			return "weld";
+		case MeshOptimizeDefault:
+			return "default";
+		case MeshOptimizeDefault | MeshOptimizeOverdraw:
+			return "default+overdraw";
+		default:
+			return "custom";
+		}
+	}
+}
+
+bool RunMeshOptimizeBench(UINT iterationCount)
+{
+	iterationCount = (std::max)(1u, iterationCount);
+
+	std::vector<BenchMeshSource> meshList;
+	meshList.push_back(CreateBoxSoup());
+	meshList.push_back(CreateShuffledGridSoup(128));
+	meshList.push_back(CreateShuffledSphere(128, 64));
+
+	const UINT flagList[] = { MeshOptimizeWeld, MeshOptimizeDefault, MeshOptimizeDefault | MeshOptimizeOverdraw };
+
+	printf("mesh optimizer: iterations=%u cache=%u\n\n", iterationCount, MeshVertexCacheSize);
+	printf("%-24s %-18s %8s %8s %7s %7s %7s %7s %10s\n",
+		"mesh", "passes", "verts", "->", "ACMR", "->", "ATVR", "->", "ms");
+
+	bool bResult = true;
+	for (const BenchMeshSource& mesh : meshList)
+	{
+		const BYTE* pVertexBegin = reinterpret_cast<const BYTE*>(mesh.VertexList.data());
+		const std::vector<BYTE> sourceVertexData(pVertexBegin, pVertexBegin + mesh.VertexList.size() * sizeof(BenchVertex));
+
+		for (UINT optimizeFlags : flagList)
+		{
+			MeshOptimizeStats stats = {};
+			double totalMs = 0.0;
+			for (UINT i = 0; i < iterationCount; i++)
+			{
+				std::vector<BYTE> vertexData = sourceVertexData;
+				std::vector<UINT> indexList = mesh.IndexList;
+
+				const auto beginTime = std::chrono::steady_clock::now();
+				if (!OptimizeMesh(&vertexData, sizeof(BenchVertex), &indexList, mesh.GroupIndexCountList, optimizeFlags, &stats))
+				{
+					bResult = false;
+					break;
+				}
+				totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - beginTime).count();
+			}
+
+			printf("%-24s %-18s %8u %8u %7.3f %7.3f %7.3f %7.3f %10.3f\n",
+				mesh.pName,
+				GetFlagName(optimizeFlags),
+				stats.VertexCountBefore,
+				stats.VertexCountAfter,
+				stats.CacheBefore.Acmr,
+				stats.CacheAfter.Acmr,
+				stats.CacheBefore.Atvr,
+				stats.CacheAfter.Atvr,
+				totalMs / iterationCount);
+		}
+	}
+	return bResult;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+/**
+ * MeshOptimizer 단독 벤치마크. 생성한 메시마다 pass 조합별 처리 시간과
+ * 최적화 전후 정점 수 / ACMR / ATVR를 출력한다. GPU 없이 실행된다.
+ */
+
+bool RunMeshOptimizeBench(UINT iterationCount);
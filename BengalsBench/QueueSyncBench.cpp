@@ -0,0 +1,211 @@
+#include "pch.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include "QueueSyncBench.h"
+#include "Renderer/Backend/NullRenderBackend.h"
+#include "Renderer/RenderHelper/QueueSyncTracker.h"
+
+namespace
+{
+	constexpr UINT FrameCountPerIteration = 1000;
+	constexpr UINT MaxPendingFrameCount = 2;		// CD3D12Renderer와 같은 프레임 컨텍스트 수
+
+	struct SimulatedFrameContext
+	{
+		UINT64 LastFenceValue = 0;
+		UINT64 LastComputeFenceValue = 0;
+	};
+
+	class CQueueSyncSimulation
+	{
+	public:
+		explicit CQueueSyncSimulation(UINT seed)
+			: m_random(seed)
+		{
+			m_commandList.Close();
+		}
+
+		// CD3D12Renderer의 BeginRender ~ Present 순서를 따른다
+		bool RunFrame()
+		{
+			SimulatedFrameContext& ctx = m_frameContextList[m_contextIndex];
+
+			// 그림자 등 compute가 읽을 graphics 작업
+			ExecuteCommandList(&m_graphicsQueue);
+			const QueueSyncPoint graphicsPoint = SignalGraphics();
+
+			// compute 컬링: graphics 결과를 기다리고, graphics 본 패스가 그 결과를 기다린다
+			WaitQueue(&m_tracker, EQueueType::Compute, &m_computeQueue, &m_graphicsFence, graphicsPoint);
+			ExecuteCommandList(&m_computeQueue);
+			const QueueSyncPoint cullPoint = SignalCompute(&ctx);
+
+			WaitQueue(&m_tracker, EQueueType::Graphics, &m_graphicsQueue, &m_computeFence, cullPoint);
+			ExecuteCommandList(&m_graphicsQueue);
+			// 같은 지점을 다시 기다리는 패스는 기록되지 않아야 한다
+			if (WaitQueue(&m_tracker, EQueueType::Graphics, &m_graphicsQueue, &m_computeFence, cullPoint) != EQueueWaitResult::Skipped)
+			{
+				return Fail("repeated wait was not skipped");
+			}
+			ExecuteCommandList(&m_graphicsQueue);
+
+			// graphics가 기다리지 않는 compute (파티클 다음 프레임용 등)
+			if (m_random() % 3 == 0)
+			{
+				ExecuteCommandList(&m_computeQueue);
+				SignalCompute(&ctx);
+			}
+
+			// SetFence + 다음 컨텍스트 대기 (Present)
+			ctx.LastFenceValue = SignalGraphics().FenceValue;
+			m_contextIndex = (m_contextIndex + 1) % MaxPendingFrameCount;
+			const SimulatedFrameContext& nextCtx = m_frameContextList[m_contextIndex];
+
+			if (!RunGpuUntil(&m_graphicsFence, nextCtx.LastFenceValue))
+			{
+				return false;
+			}
+			m_tracker.OnCompleted(EQueueType::Graphics, m_graphicsFence.GetCompletedValue());
+
+			// WaitForComputeFenceValue: 추적기가 끝났다고 하면 실제로도 끝나 있어야 한다
+			if (m_tracker.IsCompleted({ EQueueType::Compute, nextCtx.LastComputeFenceValue }))
+			{
+				if (m_computeFence.GetCompletedValue() < nextCtx.LastComputeFenceValue)
+				{
+					return Fail("compute reported complete before its fence");
+				}
+				m_skippedCpuWaitCount++;
+			}
+			else if (!RunGpuUntil(&m_computeFence, nextCtx.LastComputeFenceValue))
+			{
+				return false;
+			}
+			m_tracker.OnCompleted(EQueueType::Compute, m_computeFence.GetCompletedValue());
+
+			// 아직 signal하지 않은 값을 기다리면 거부되어야 한다
+			const QueueSyncPoint futurePoint = { EQueueType::Compute, m_tracker.GetLastSignaledValue(EQueueType::Compute) + 1 };
+			if (m_tracker.OnWait(EQueueType::Graphics, futurePoint) != EQueueWaitResult::Invalid)
+			{
+				return Fail("wait on an unsignaled value was accepted");
+			}
+			m_invalidWaitCount++;
+			return true;
+		}
+
+		bool Finish()
+		{
+			CNullCommandQueue* queueList[] = { &m_graphicsQueue, &m_computeQueue };
+			if (!DrainNullCommandQueues(queueList, 2))
+			{
+				return Fail("queues deadlocked while draining");
+			}
+			if (m_graphicsQueue.GetStats().ErrorCount > 0 || m_computeQueue.GetStats().ErrorCount > 0)
+			{
+				return Fail("null command queue reported an error");
+			}
+			// 의도한 Invalid 대기만 오류로 세어져야 한다
+			if (m_tracker.GetStats().ErrorCount != m_invalidWaitCount)
+			{
+				return Fail(m_tracker.GetLastError());
+			}
+			return true;
+		}
+
+		const QueueSyncStats& GetStats() const { return m_tracker.GetStats(); }
+		UINT64 GetSkippedCpuWaitCount() const { return m_skippedCpuWaitCount; }
+		UINT64 GetStepCount() const { return m_stepCount; }
+
+	private:
+		void ExecuteCommandList(CNullCommandQueue* pQueue)
+		{
+			CNullCommandList* pCommandList = &m_commandList;
+			pQueue->ExecuteCommandLists(1, &pCommandList);
+		}
+
+		QueueSyncPoint SignalGraphics()
+		{
+			return SignalQueue(&m_tracker, EQueueType::Graphics, &m_graphicsQueue, &m_graphicsFence, ++m_graphicsFenceValue);
+		}
+
+		QueueSyncPoint SignalCompute(SimulatedFrameContext* pCtx)
+		{
+			pCtx->LastComputeFenceValue = ++m_computeFenceValue;
+			return SignalQueue(&m_tracker, EQueueType::Compute, &m_computeQueue, &m_computeFence, m_computeFenceValue);
+		}
+
+		// 두 큐를 무작위 순서로 한 명령씩 실행. 매 단계 추적기가 보장하는 값이 실제 fence 이하인지 확인
+		bool RunGpuUntil(const CNullFence* pFence, UINT64 fenceValue)
+		{
+			CNullCommandQueue* queueList[] = { &m_graphicsQueue, &m_computeQueue };
+			while (pFence->GetCompletedValue() < fenceValue)
+			{
+				const UINT first = m_random() % 2;
+				if (!queueList[first]->ExecuteNext() && !queueList[1 - first]->ExecuteNext())
+				{
+					return Fail("queues deadlocked before the fence was reached");
+				}
+				m_stepCount++;
+
+				if (m_tracker.GetImpliedCompletedValue(EQueueType::Graphics, m_graphicsFence.GetCompletedValue(), EQueueType::Compute) > m_computeFence.GetCompletedValue() ||
+					m_tracker.GetImpliedCompletedValue(EQueueType::Compute, m_computeFence.GetCompletedValue(), EQueueType::Graphics) > m_graphicsFence.GetCompletedValue())
+				{
+					return Fail("implied completion is ahead of the fence");
+				}
+			}
+			return true;
+		}
+
+		bool Fail(const char* pMessage)
+		{
+			printf("  FAILED: %s\n", pMessage ? pMessage : "(null)");
+			return false;
+		}
+
+	private:
+		std::mt19937 m_random;
+		CQueueSyncTracker m_tracker;
+		CNullCommandQueue m_graphicsQueue;
+		CNullCommandQueue m_computeQueue;
+		CNullFence m_graphicsFence;
+		CNullFence m_computeFence;
+		CNullCommandList m_commandList;
+		UINT64 m_graphicsFenceValue = 0;
+		UINT64 m_computeFenceValue = 0;
+		SimulatedFrameContext m_frameContextList[MaxPendingFrameCount] = {};
+		UINT m_contextIndex = 0;
+		UINT64 m_skippedCpuWaitCount = 0;
+		UINT64 m_stepCount = 0;
+		UINT64 m_invalidWaitCount = 0;
+	};
+}
+
+bool RunQueueSyncBench(UINT iterationCount)
+{
+	printf("queue sync: iterations=%u, frames/iteration=%u\n\n", iterationCount, FrameCountPerIteration);
+	printf("%5s %9s %8s %9s %13s %10s %9s\n", "seed", "signals", "waits", "skipped", "cpu waits cut", "gpu steps", "ns/frame");
+
+	bool bResult = true;
+	for (UINT iteration = 0; iteration < iterationCount && bResult; iteration++)
+	{
+		CQueueSyncSimulation simulation(iteration + 1);
+
+		const auto begin = std::chrono::steady_clock::now();
+		for (UINT frame = 0; frame < FrameCountPerIteration && bResult; frame++)
+		{
+			bResult = simulation.RunFrame();
+		}
+		bResult = bResult && simulation.Finish();
+		const double elapsedNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+
+		const QueueSyncStats& stats = simulation.GetStats();
+		printf("%5u %9llu %8llu %9llu %13llu %10llu %9.1f\n",
+			iteration + 1,
+			static_cast<unsigned long long>(stats.SignalCount),
+			static_cast<unsigned long long>(stats.WaitCount),
+			static_cast<unsigned long long>(stats.SkippedWaitCount),
+			static_cast<unsigned long long>(simulation.GetSkippedCpuWaitCount()),
+			static_cast<unsigned long long>(simulation.GetStepCount()),
+			elapsedNs / FrameCountPerIteration);
+	}
+	return bResult;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+/**
+ * CQueueSyncTracker 단독 벤치마크. null graphics / compute 큐에 렌더러와 같은 순서로 프레임을 N회 제출하고
+ * GPU 진행을 무작위로 섞어 실행하면서, 교착이 없는지와 추적기가 보장하는 완료 값이 실제 fence를
+ * 넘지 않는지 확인한다. 중복 대기 제거 수와 기록 비용을 출력하고, 검증이 틀리면 false. GPU 없이 실행된다.
+ */
+
+bool RunQueueSyncBench(UINT iterationCount);
@@ -0,0 +1,234 @@
+#include "pch.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "ResourceStateBench.h"
+#include "BenchCheck.h"
+#include "Renderer/Backend/NullRenderBackend.h"
+#include "Renderer/RenderHelper/ResourceStateTracker.h"
+
+namespace
+{
+	constexpr UINT FrameCountPerIteration = 1000;
+	constexpr UINT BackBufferCount = 3;			// CD3D12Renderer::SwapChainFrameCount
+	constexpr UINT DynamicTextureCount = 16;
+
+	// 추적기는 포인터를 키로만 쓰고 역참조하지 않는다
+	ID3D12Resource* GetFakeResource(UINT index)
+	{
+		static BYTE s_resourceStorage[64] = {};
+		return reinterpret_cast<ID3D12Resource*>(&s_resourceStorage[index]);
+	}
+
+	bool IsBarrier(const D3D12_RESOURCE_BARRIER& barrier, ID3D12Resource* pResource, D3D12_RESOURCE_STATES stateBefore, D3D12_RESOURCE_STATES stateAfter)
+	{
+		return barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION && barrier.Transition.pResource == pResource &&
+			barrier.Transition.StateBefore == stateBefore && barrier.Transition.StateAfter == stateAfter;
+	}
+
+	bool HasBarrier(const std::vector<D3D12_RESOURCE_BARRIER>& barrierList, ID3D12Resource* pResource, D3D12_RESOURCE_STATES stateBefore, D3D12_RESOURCE_STATES stateAfter)
+	{
+		for (const D3D12_RESOURCE_BARRIER& barrier : barrierList)
+		{
+			if (IsBarrier(barrier, pResource, stateBefore, stateAfter))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// 새 커맨드 리스트에 보류 중인 barrier를 기록하고 기록된 목록을 돌려준다
+	const std::vector<D3D12_RESOURCE_BARRIER>& Flush(CResourceStateTracker* pTracker, CNullCommandList* pCommandList)
+	{
+		pCommandList->Reset();
+		pTracker->FlushBarriers(pCommandList);
+		pCommandList->Close();
+		return pCommandList->GetRecordedBarriers();
+	}
+
+	bool VerifyBarrierSequences()
+	{
+		ID3D12Resource* pBackBuffer = GetFakeResource(0);
+		ID3D12Resource* pTexture = GetFakeResource(1);
+		ID3D12Resource* pBuffer = GetFakeResource(2);
+		ID3D12Resource* pPromotedTexture = GetFakeResource(3);
+
+		CResourceStateTracker tracker;
+		CNullCommandList commandList;
+		tracker.RegisterResource(pBackBuffer, D3D12_RESOURCE_STATE_PRESENT);
+		tracker.RegisterResource(pTexture, D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE, EResourcePromotionType::Texture);
+		tracker.RegisterResource(pBuffer, D3D12_RESOURCE_STATE_COMMON, EResourcePromotionType::Buffer);
+		tracker.RegisterResource(pPromotedTexture, D3D12_RESOURCE_STATE_COMMON, EResourcePromotionType::Texture);
+		bool bResult = true;
+
+		// 병합: flush 전 같은 리소스의 전환은 처음 상태 -> 마지막 상태 하나
+		tracker.TransitionResource(pBackBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+		tracker.TransitionResource(pBackBuffer, D3D12_RESOURCE_STATE_COPY_SOURCE);
+		const std::vector<D3D12_RESOURCE_BARRIER>& merged = Flush(&tracker, &commandList);
+		bResult &= Check(merged.size() == 1 && IsBarrier(merged[0], pBackBuffer, D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_COPY_SOURCE), "transitions before a flush are merged");
+
+		// 상쇄: 원래 상태로 돌아오면 barrier가 없다
+		tracker.TransitionResource(pBackBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+		tracker.TransitionResource(pBackBuffer, D3D12_RESOURCE_STATE_COPY_SOURCE);
+		bResult &= Check(tracker.GetPendingBarrierCount() == 0 && Flush(&tracker, &commandList).empty(), "round trip is cancelled");
+
+		// 묶음: 서로 다른 리소스는 ResourceBarrier 한 번
+		const UINT64 barrierCallCount = commandList.GetStats().BarrierCallCount;
+		tracker.TransitionResource(pBackBuffer, D3D12_RESOURCE_STATE_PRESENT);
+		tracker.TransitionResource(pTexture, D3D12_RESOURCE_STATE_COPY_DEST);
+		const std::vector<D3D12_RESOURCE_BARRIER>& batched = Flush(&tracker, &commandList);
+		bResult &= Check(batched.size() == 2 && commandList.GetStats().BarrierCallCount == barrierCallCount + 1, "different resources share one ResourceBarrier");
+		bResult &= Check(HasBarrier(batched, pBackBuffer, D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_PRESENT) &&
+			HasBarrier(batched, pTexture, D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_COPY_DEST), "batched barrier contents");
+
+		// 이미 포함된 읽기 상태로는 barrier가 없다
+		tracker.TransitionResource(pTexture, D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE);
+		Flush(&tracker, &commandList);
+		tracker.TransitionResource(pTexture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		bResult &= Check(tracker.GetPendingBarrierCount() == 0 && tracker.GetResourceState(pTexture) == D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE, "read subset needs no barrier");
+
+		// 버퍼: COMMON에서 승격, 실행 뒤 decay, 읽기로 승격된 뒤의 쓰기는 barrier
+		tracker.TransitionResource(pBuffer, D3D12_RESOURCE_STATE_COPY_DEST);
+		bResult &= Check(tracker.GetPendingBarrierCount() == 0 && tracker.GetResourceState(pBuffer) == D3D12_RESOURCE_STATE_COPY_DEST, "buffer is promoted out of COMMON");
+		tracker.OnCommandListsExecuted();
+		bResult &= Check(tracker.GetResourceState(pBuffer) == D3D12_RESOURCE_STATE_COMMON, "buffer decays after execute");
+		tracker.TransitionResource(pBuffer, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
+		bResult &= Check(tracker.GetPendingBarrierCount() == 0, "decayed buffer is promoted again");
+		tracker.TransitionResource(pBuffer, D3D12_RESOURCE_STATE_COPY_DEST);
+		const std::vector<D3D12_RESOURCE_BARRIER>& bufferWrite = Flush(&tracker, &commandList);
+		bResult &= Check(bufferWrite.size() == 1 && IsBarrier(bufferWrite[0], pBuffer, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER, D3D12_RESOURCE_STATE_COPY_DEST), "write after read promotion needs a barrier");
+		tracker.OnCommandListsExecuted();
+
+		// 텍스처: 읽기 승격은 합쳐지고 decay한다. 명시적 barrier나 쓰기 승격 뒤에는 decay하지 않는다
+		tracker.TransitionResource(pPromotedTexture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		tracker.TransitionResource(pPromotedTexture, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		bResult &= Check(tracker.GetPendingBarrierCount() == 0 &&
+			tracker.GetResourceState(pPromotedTexture) == (D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE), "texture read promotions combine");
+		tracker.OnCommandListsExecuted();
+		bResult &= Check(tracker.GetResourceState(pPromotedTexture) == D3D12_RESOURCE_STATE_COMMON, "read-promoted texture decays");
+		tracker.TransitionResource(pPromotedTexture, D3D12_RESOURCE_STATE_RENDER_TARGET);
+		const std::vector<D3D12_RESOURCE_BARRIER>& renderTarget = Flush(&tracker, &commandList);
+		bResult &= Check(renderTarget.size() == 1 && IsBarrier(renderTarget[0], pPromotedTexture, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_RENDER_TARGET), "render target is not promoted");
+		tracker.OnCommandListsExecuted();
+		bResult &= Check(tracker.GetResourceState(pPromotedTexture) == D3D12_RESOURCE_STATE_RENDER_TARGET, "explicit state does not decay");
+		tracker.RegisterResource(pPromotedTexture, D3D12_RESOURCE_STATE_COMMON, EResourcePromotionType::Texture);
+		tracker.TransitionResource(pPromotedTexture, D3D12_RESOURCE_STATE_COPY_DEST);
+		tracker.OnCommandListsExecuted();
+		bResult &= Check(tracker.GetResourceState(pPromotedTexture) == D3D12_RESOURCE_STATE_COPY_DEST, "write-promoted texture does not decay");
+
+		// 해제: 보류 중인 barrier를 버리고, 남은 barrier의 위치도 맞아야 한다
+		tracker.TransitionResource(pTexture, D3D12_RESOURCE_STATE_COPY_DEST);
+		tracker.TransitionResource(pBackBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+		tracker.UnregisterResource(pTexture);
+		tracker.TransitionResource(pBackBuffer, D3D12_RESOURCE_STATE_COPY_SOURCE);
+		const std::vector<D3D12_RESOURCE_BARRIER>& afterUnregister = Flush(&tracker, &commandList);
+		bResult &= Check(!tracker.IsRegistered(pTexture) && afterUnregister.size() == 1 &&
+			IsBarrier(afterUnregister[0], pBackBuffer, D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_COPY_SOURCE), "unregister drops its pending barrier");
+
+		bResult &= Check(commandList.GetStats().ErrorCount == 0, commandList.GetLastError() ? commandList.GetLastError() : "null command list error");
+		return bResult;
+	}
+
+	// CD3D12Renderer의 BeginRender / EndRender 순서. 동적 텍스처와 인스턴스 버퍼는 수명 동안 등록되어 있다
+	class CRendererFrameSimulation
+	{
+	public:
+		CRendererFrameSimulation()
+		{
+			for (UINT i = 0; i < BackBufferCount; i++)
+			{
+				m_tracker.RegisterResource(GetBackBuffer(i), D3D12_RESOURCE_STATE_PRESENT);
+			}
+			for (UINT i = 0; i < DynamicTextureCount; i++)
+			{
+				m_tracker.RegisterResource(GetDynamicTexture(i), D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE, EResourcePromotionType::Texture);
+			}
+			m_tracker.RegisterResource(GetInstanceBuffer(), D3D12_RESOURCE_STATE_COMMON, EResourcePromotionType::Buffer);
+		}
+
+		bool RunFrame(UINT frameIndex)
+		{
+			ID3D12Resource* pBackBuffer = GetBackBuffer(frameIndex % BackBufferCount);
+			const UINT updatedTextureCount = (frameIndex % 4 == 3) ? 0 : DynamicTextureCount / 2;
+
+			// BeginRender: 렌더 타깃 전환과 업로드 전 COPY_DEST가 한 번에 기록된다
+			const UINT64 barrierCallCount = m_commandList.GetStats().BarrierCallCount;
+			m_commandList.Reset();
+			m_tracker.TransitionResource(pBackBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+			for (UINT i = 0; i < updatedTextureCount; i++)
+			{
+				m_tracker.TransitionResource(GetDynamicTexture(frameIndex + i), D3D12_RESOURCE_STATE_COPY_DEST);
+			}
+			m_tracker.FlushBarriers(&m_commandList);
+			for (UINT i = 0; i < updatedTextureCount; i++)
+			{
+				m_tracker.TransitionResource(GetDynamicTexture(frameIndex + i), D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE);
+			}
+
+			// StaticMeshGroup::PrepareFrame: 인스턴스 버퍼는 decay한 COMMON에서 COPY_DEST로 승격된다
+			m_tracker.TransitionResource(GetInstanceBuffer(), D3D12_RESOURCE_STATE_COPY_DEST);
+			m_tracker.FlushBarriers(&m_commandList);
+			m_tracker.FlushBarriers(&m_commandList);
+			m_commandList.Close();
+			m_tracker.OnCommandListsExecuted();
+
+			// 인스턴스 버퍼는 barrier가 없다: 업로드 전 묶음 하나 + 업로드 뒤 ALL_SHADER_RESOURCE 묶음 하나
+			const bool bBeginBarriers = (m_commandList.GetRecordedBarriers().size() == 1 + 2 * updatedTextureCount) &&
+				HasBarrier(m_commandList.GetRecordedBarriers(), pBackBuffer, D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RENDER_TARGET);
+			const bool bBeginBatched = (m_commandList.GetStats().BarrierCallCount - barrierCallCount == ((updatedTextureCount > 0) ? 2u : 1u));
+			const bool bDecayed = (m_tracker.GetResourceState(GetInstanceBuffer()) == D3D12_RESOURCE_STATE_COMMON);
+
+			// EndRender: 렌더 스레드 리스트 실행, 그 뒤 PRESENT 전환 리스트
+			m_tracker.OnCommandListsExecuted();
+			m_commandList.Reset();
+			m_tracker.TransitionResource(pBackBuffer, D3D12_RESOURCE_STATE_PRESENT);
+			m_tracker.FlushBarriers(&m_commandList);
+			m_commandList.Close();
+			m_tracker.OnCommandListsExecuted();
+
+			const bool bEndBarriers = (m_commandList.GetRecordedBarriers().size() == 1) &&
+				IsBarrier(m_commandList.GetRecordedBarriers()[0], pBackBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT);
+			return Check(bBeginBarriers && bBeginBatched, "BeginRender barrier sequence") &&
+				Check(bDecayed, "instance buffer decays after BeginRender") &&
+				Check(bEndBarriers, "EndRender barrier sequence") &&
+				Check(m_commandList.GetStats().ErrorCount == 0, m_commandList.GetLastError() ? m_commandList.GetLastError() : "null command list error");
+		}
+
+		const NullBackendStats& GetStats() const { return m_commandList.GetStats(); }
+
+	private:
+		static ID3D12Resource* GetBackBuffer(UINT index) { return GetFakeResource(8 + index); }
+		static ID3D12Resource* GetDynamicTexture(UINT index) { return GetFakeResource(16 + index % DynamicTextureCount); }
+		static ID3D12Resource* GetInstanceBuffer() { return GetFakeResource(16 + DynamicTextureCount); }
+
+	private:
+		CResourceStateTracker m_tracker;
+		CNullCommandList m_commandList;
+	};
+}
+
+bool RunResourceStateBench(UINT iterationCount)
+{
+	bool bResult = VerifyBarrierSequences();
+	printf("barrier sequence checks: %s\n\n", bResult ? "ok" : "FAILED");
+
+	CRendererFrameSimulation simulation;
+	const UINT frameCount = iterationCount * FrameCountPerIteration;
+	const auto begin = std::chrono::steady_clock::now();
+	for (UINT frame = 0; frame < frameCount && bResult; frame++)
+	{
+		bResult = simulation.RunFrame(frame);
+	}
+	const double elapsedNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+
+	const NullBackendStats& stats = simulation.GetStats();
+	printf("%9s %10s %13s %10s %9s\n", "frames", "barriers", "barrier calls", "per call", "ns/frame");
+	printf("%9u %10llu %13llu %10.2f %9.1f\n",
+		frameCount,
+		static_cast<unsigned long long>(stats.BarrierCount),
+		static_cast<unsigned long long>(stats.BarrierCallCount),
+		(stats.BarrierCallCount > 0) ? static_cast<double>(stats.BarrierCount) / stats.BarrierCallCount : 0.0,
+		elapsedNs / frameCount);
+	return bResult;
+}
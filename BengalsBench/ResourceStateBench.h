@@ -0,0 +1,10 @@
+#pragma once
+
+/**
+ * CResourceStateTracker 단독 검증. CNullCommandList에 기록된 barrier 순서로 병합, 상쇄, 묶음 기록,
+ * 암시적 승격 / decay, UnregisterResource의 보류 barrier 제거를 확인하고, 렌더러의 BeginRender / EndRender
+ * 순서(back buffer, 동적 텍스처, 인스턴스 버퍼)를 N * 1000프레임 실행해 프레임당 비용을 잰다.
+ * 검증이 틀리면 false. GPU 없이 실행된다.
+ */
+
+bool RunResourceStateBench(UINT iterationCount);
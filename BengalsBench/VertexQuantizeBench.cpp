@@ -0,0 +1,127 @@
+#include "pch.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "VertexQuantizeBench.h"
+#include "Types/typedef.h"
+#include "Renderer/RenderHelper/VertexQuantizer.h"
+
+namespace
+{
+	struct BenchMeshSource
+	{
+		const char* pName = nullptr;
+		std::vector<VertexPos3Color4Tex2> VertexList;
+	};
+
+	BenchMeshSource CreateSphere(UINT sliceCount, UINT stackCount)
+	{
+		BenchMeshSource mesh = {};
+		mesh.pName = "sphere 256x128";
+
+		for (UINT stack = 0; stack <= stackCount; stack++)
+		{
+			const float phi = XM_PI * stack / stackCount;
+			for (UINT slice = 0; slice <= sliceCount; slice++)
+			{
+				const float theta = XM_2PI * slice / sliceCount;
+				VertexPos3Color4Tex2 vertex = {};
+				vertex.Position = { sinf(phi) * cosf(theta), cosf(phi), sinf(phi) * sinf(theta) };
+				vertex.Color = { 0.5f + 0.5f * cosf(theta), 0.5f + 0.5f * cosf(phi), 0.5f, 1.0f };
+				vertex.TexCoord = { static_cast<float>(slice) / sliceCount, static_cast<float>(stack) / stackCount };
+				mesh.VertexList.push_back(vertex);
+			}
+		}
+		return mesh;
+	}
+
+	// 원점에서 먼 큰 지형 (offset / scale 정밀도와 반복 UV 확인용)
+	BenchMeshSource CreateTerrain(UINT gridSize)
+	{
+		BenchMeshSource mesh = {};
+		mesh.pName = "terrain 512x512";
+
+		for (UINT y = 0; y <= gridSize; y++)
+		{
+			for (UINT x = 0; x <= gridSize; x++)
+			{
+				const float u = static_cast<float>(x) / gridSize;
+				const float v = static_cast<float>(y) / gridSize;
+				const float height = 20.0f * sinf(u * 12.0f) * cosf(v * 9.0f);
+				VertexPos3Color4Tex2 vertex = {};
+				vertex.Position = { 1000.0f + u * 500.0f, height, -300.0f + v * 500.0f };
+				vertex.Color = { u, v, 1.0f - u, 1.0f };
+				vertex.TexCoord = { u * 16.0f, v * 16.0f };
+				mesh.VertexList.push_back(vertex);
+			}
+		}
+		return mesh;
+	}
+
+	BenchMeshSource CreateRandomCloud(UINT vertexCount)
+	{
+		BenchMeshSource mesh = {};
+		mesh.pName = "random 256k";
+
+		std::mt19937 rng(1234);
+		std::uniform_real_distribution<float> positionDist(-50.0f, 50.0f);
+		std::uniform_real_distribution<float> unitDist(0.0f, 1.0f);
+		std::uniform_real_distribution<float> texCoordDist(-4.0f, 4.0f);
+		mesh.VertexList.resize(vertexCount);
+		for (VertexPos3Color4Tex2& vertex : mesh.VertexList)
+		{
+			vertex.Position = { positionDist(rng), positionDist(rng) * 0.1f, positionDist(rng) };
+			vertex.Color = { unitDist(rng), unitDist(rng), unitDist(rng), unitDist(rng) };
+			vertex.TexCoord = { texCoordDist(rng), texCoordDist(rng) };
+		}
+		return mesh;
+	}
+}
+
+bool RunVertexQuantizeBench(UINT iterationCount)
+{
+	iterationCount = (std::max)(1u, iterationCount);
+
+	std::vector<BenchMeshSource> meshList;
+	meshList.push_back(CreateSphere(256, 128));
+	meshList.push_back(CreateTerrain(512));
+	meshList.push_back(CreateRandomCloud(256 * 1024));
+
+	printf("vertex quantize: iterations=%u, %zu -> %zu bytes/vertex\n\n", iterationCount, sizeof(VertexPos3Color4Tex2), sizeof(VertexPackedPos3Color4Tex2));
+
+	bool bResult = true;
+	for (const BenchMeshSource& mesh : meshList)
+	{
+		const UINT vertexCount = static_cast<UINT>(mesh.VertexList.size());
+		std::vector<VertexPackedPos3Color4Tex2> packedVertexList(vertexCount);
+		VertexQuantization quantization = {};
+
+		double totalMs = 0.0;
+		for (UINT i = 0; i < iterationCount; i++)
+		{
+			const auto beginTime = std::chrono::steady_clock::now();
+			if (!QuantizeVertices(mesh.VertexList.data(), vertexCount, packedVertexList.data(), &quantization))
+			{
+				bResult = false;
+				break;
+			}
+			totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - beginTime).count();
+		}
+
+		const size_t bytesBefore = static_cast<size_t>(vertexCount) * sizeof(VertexPos3Color4Tex2);
+		const size_t bytesAfter = static_cast<size_t>(vertexCount) * sizeof(VertexPackedPos3Color4Tex2);
+		const VertexQuantizationError error = MeasureVertexQuantizationError(mesh.VertexList.data(), packedVertexList.data(), vertexCount, quantization);
+		const VertexQuantizationError bound = GetVertexQuantizationErrorBound(quantization);
+		const bool bWithinBound = error.Position <= bound.Position && error.Color <= bound.Color && error.TexCoord <= bound.TexCoord;
+
+		printf("%s: %u verts, %zu -> %zu bytes (%.1f%% saved), quantize %.3f ms\n", mesh.pName, vertexCount, bytesBefore, bytesAfter,
+			100.0 * (1.0 - static_cast<double>(bytesAfter) / bytesBefore), totalMs / iterationCount);
+		printf("  max error  position %.3e (bound %.3e)  color %.3e (bound %.3e)  texcoord %.3e (bound %.3e)  %s\n\n",
+			error.Position, bound.Position, error.Color, bound.Color, error.TexCoord, bound.TexCoord, bWithinBound ? "ok" : "EXCEEDED");
+
+		bResult = bWithinBound && bResult;
+	}
+	return bResult;
+}
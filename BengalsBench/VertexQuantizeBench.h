@@ -0,0 +1,8 @@
+#pragma once
+
+/**
+ * VertexQuantizer 단독 벤치마크. 큰 메시마다 정점 버퍼 크기(전 / 후), 양자화 시간,
+ * 성분별 최대 오차와 오차 한계를 출력한다. 한계를 넘는 성분이 있으면 false. GPU 없이 실행된다.
+ */
+
+bool RunVertexQuantizeBench(UINT iterationCount);
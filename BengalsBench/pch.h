@@ -0,0 +1,28 @@
+// pch.h: precompiled header for the headless benchmark.
+// Bengals/pch.h와 달리 DXGI/D2D/d3dx12를 포함하지 않는다. GPU와 창 없이 실행되는 코드만 빌드한다.
+
+#ifndef PCH_H
+#define PCH_H
+
+#define WIN32_LEAN_AND_MEAN             // Exclude rarely-used stuff from Windows headers
+
+#include <windows.h>
+#include <wrl/client.h>
+
+// d3d (타입 정의만 사용, d3d12.lib는 링크하지 않는다)
+#include <d3d12.h>
+
+#include <DirectXMath.h>
+#include <DirectXCollision.h>
+using namespace DirectX;
+using namespace Microsoft::WRL;
+
+// C RunTime Header Files
+#include <stdlib.h>
+#include <malloc.h>
+#include <memory.h>
+
+// C++ Standard Library
+#include <memory>
+
+#endif //PCH_H
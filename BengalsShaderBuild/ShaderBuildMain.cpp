@@ -0,0 +1,255 @@
+#include "pch.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Renderer/RenderHelper/ShaderArchive.h"
+#include "Renderer/RenderHelper/ShaderPermutation.h"
+#include "Renderer/RenderHelper/PipelineStateKey.h"
+
+#pragma comment(lib, "D3DCompiler.lib")
+
+// usage: BengalsShaderBuild [--root DIR] [--out FILE] [--debug] [--force]
+//   ShaderPermutation.cpp의 프로그램 테이블에 있는 모든 (프로그램, 스테이지, 퍼뮤테이션)을 컴파일해 아카이브로 쓴다.
+//   기존 아카이브에서 전처리 결과 해시가 같은 항목은 다시 컴파일하지 않는다. Bengals 빌드 전에 매번 실행된다.
+//   컴파일 오류가 있으면 1을 반환하고 아카이브는 건드리지 않는다.
+
+namespace
+{
+	struct ShaderBuildOptions
+	{
+		const char* pSourceRoot = ".";
+		const char* pOutputFileName = "ShaderArchive.bsa";
+		bool bDebugShaders = false;
+		bool bForceRebuild = false;
+	};
+
+	struct ShaderBuildStats
+	{
+		UINT CompiledCount = 0;
+		UINT ReusedCount = 0;
+		UINT ErrorCount = 0;
+	};
+
+	bool ParseOptions(int argc, char* argv[], ShaderBuildOptions* pOutOptions)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			const char* pArg = argv[i];
+			const bool bHasValue = (i + 1 < argc);
+			if (strcmp(pArg, "--root") == 0 && bHasValue)
+			{
+				pOutOptions->pSourceRoot = argv[++i];
+			}
+			else if (strcmp(pArg, "--out") == 0 && bHasValue)
+			{
+				pOutOptions->pOutputFileName = argv[++i];
+			}
+			else if (strcmp(pArg, "--debug") == 0)
+			{
+				pOutOptions->bDebugShaders = true;
+			}
+			else if (strcmp(pArg, "--force") == 0)
+			{
+				pOutOptions->bForceRebuild = true;
+			}
+			else
+			{
+				printf("unknown or incomplete option: %s\n", pArg);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool ReadBinaryFile(const std::filesystem::path& path, std::vector<BYTE>& outData)
+	{
+		outData.clear();
+
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file)
+		{
+			return false;
+		}
+
+		const std::streamsize fileSize = file.tellg();
+		if (fileSize < 0)
+		{
+			return false;
+		}
+
+		outData.resize(static_cast<size_t>(fileSize));
+		file.seekg(0, std::ios::beg);
+		return fileSize == 0 || static_cast<bool>(file.read(reinterpret_cast<char*>(outData.data()), fileSize));
+	}
+
+	void PrintErrorBlob(ID3DBlob* pErrorBlob)
+	{
+		if (pErrorBlob && pErrorBlob->GetBufferSize() > 0)
+		{
+			printf("%.*s\n", static_cast<int>(pErrorBlob->GetBufferSize()), static_cast<const char*>(pErrorBlob->GetBufferPointer()));
+		}
+	}
+
+	bool BuildShader(const ShaderBuildOptions& options, const CShaderArchive& prevArchive, EShaderProgram program, EShaderStage stage, UINT permutationFlags,
+		const std::vector<BYTE>& source, CShaderArchive* pOutArchive, ShaderBuildStats* pStats)
+	{
+		const ShaderProgramDesc& programDesc = GetShaderProgramDesc(program);
+		const std::string sourceName = std::filesystem::path(programDesc.SourceFileName).string();
+		const char* pEntryPoint = programDesc.EntryPointNames[static_cast<UINT>(stage)];
+		const char* pTarget = GetShaderStageTarget(stage);
+
+		std::vector<D3D_SHADER_MACRO> macroList;
+		for (UINT bit = 0; bit < ShaderPermutationFlagCount; bit++)
+		{
+			if (permutationFlags & (1u << bit))
+			{
+				macroList.push_back({ GetShaderPermutationDefineName(bit), "1" });
+			}
+		}
+		macroList.push_back({ nullptr, nullptr });
+
+		// include와 define을 모두 펼친 결과를 해시해야 헤더만 바뀐 경우도 다시 컴파일된다
+		ComPtr<ID3DBlob> preprocessedBlob = nullptr;
+		ComPtr<ID3DBlob> errorBlob = nullptr;
+		if (FAILED(D3DPreprocess(source.data(), source.size(), sourceName.c_str(), macroList.data(), D3D_COMPILE_STANDARD_FILE_INCLUDE,
+			preprocessedBlob.ReleaseAndGetAddressOf(), errorBlob.ReleaseAndGetAddressOf())))
+		{
+			printf("%s %s: preprocess failed\n", sourceName.c_str(), pEntryPoint);
+			PrintErrorBlob(errorBlob.Get());
+			pStats->ErrorCount++;
+			return false;
+		}
+
+		const char* pPreprocessed = static_cast<const char*>(preprocessedBlob->GetBufferPointer());
+		const size_t preprocessedLength = strnlen(pPreprocessed, preprocessedBlob->GetBufferSize());
+
+		const UINT compileFlags = options.bDebugShaders ?
+			(D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION) :
+			D3DCOMPILE_OPTIMIZATION_LEVEL3;
+
+		CPipelineStateHasher hasher;
+		hasher.AddBytes(pPreprocessed, preprocessedLength);
+		hasher.AddString(pEntryPoint);
+		hasher.AddString(pTarget);
+		hasher.AddValue(compileFlags);
+		hasher.AddValue(static_cast<UINT>(D3D_COMPILER_VERSION));
+		const UINT64 sourceHash = hasher.GetHash();
+
+		const UINT64 key = MakeShaderKey(program, stage, permutationFlags);
+
+		UINT64 prevSourceHash = 0;
+		D3D12_SHADER_BYTECODE prevBytecode = {};
+		if (!options.bForceRebuild && prevArchive.FindEntry(key, &prevSourceHash, &prevBytecode) && prevSourceHash == sourceHash)
+		{
+			pOutArchive->AddShader(key, sourceHash, prevBytecode.pShaderBytecode, prevBytecode.BytecodeLength);
+			pStats->ReusedCount++;
+			return true;
+		}
+
+		ComPtr<ID3DBlob> bytecodeBlob = nullptr;
+		if (FAILED(D3DCompile(pPreprocessed, preprocessedLength, sourceName.c_str(), nullptr, nullptr, pEntryPoint, pTarget, compileFlags, 0,
+			bytecodeBlob.ReleaseAndGetAddressOf(), errorBlob.ReleaseAndGetAddressOf())))
+		{
+			printf("%s %s %s (permutation 0x%x): compile failed\n", sourceName.c_str(), pEntryPoint, pTarget, permutationFlags);
+			PrintErrorBlob(errorBlob.Get());
+			pStats->ErrorCount++;
+			return false;
+		}
+		PrintErrorBlob(errorBlob.Get());		// warnings
+
+		// PSO 생성에는 reflection/디버그 정보가 필요 없다
+		if (!options.bDebugShaders)
+		{
+			ComPtr<ID3DBlob> strippedBlob = nullptr;
+			if (SUCCEEDED(D3DStripShader(bytecodeBlob->GetBufferPointer(), bytecodeBlob->GetBufferSize(),
+				D3DCOMPILER_STRIP_REFLECTION_DATA | D3DCOMPILER_STRIP_DEBUG_INFO, strippedBlob.ReleaseAndGetAddressOf())))
+			{
+				bytecodeBlob = strippedBlob;
+			}
+		}
+
+		pOutArchive->AddShader(key, sourceHash, bytecodeBlob->GetBufferPointer(), bytecodeBlob->GetBufferSize());
+		pStats->CompiledCount++;
+		return true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	ShaderBuildOptions options = {};
+	if (!ParseOptions(argc, argv, &options))
+	{
+		return 2;
+	}
+
+	const std::filesystem::path outputPath = std::filesystem::absolute(options.pOutputFileName);
+
+	// 프로그램 테이블의 경로는 Bengals/ 기준이므로 작업 디렉터리를 맞춘다
+	std::error_code errorCode;
+	std::filesystem::current_path(options.pSourceRoot, errorCode);
+	if (errorCode)
+	{
+		printf("cannot enter source root: %s\n", options.pSourceRoot);
+		return 2;
+	}
+
+	CShaderArchive prevArchive;
+	prevArchive.ReadFromFile(outputPath.c_str());
+
+	CShaderArchive archive;
+	ShaderBuildStats stats = {};
+	for (UINT programIndex = 0; programIndex < static_cast<UINT>(EShaderProgram::Count); programIndex++)
+	{
+		const EShaderProgram program = static_cast<EShaderProgram>(programIndex);
+		const ShaderProgramDesc& programDesc = GetShaderProgramDesc(program);
+
+		std::vector<BYTE> source;
+		if (!ReadBinaryFile(programDesc.SourceFileName, source))
+		{
+			printf("cannot read %s\n", std::filesystem::path(programDesc.SourceFileName).string().c_str());
+			stats.ErrorCount++;
+			continue;
+		}
+
+		// PermutationMask의 모든 부분집합 (빈 집합 포함)
+		const UINT mask = programDesc.PermutationMask;
+		UINT permutationFlags = 0;
+		do
+		{
+			for (UINT stageIndex = 0; stageIndex < static_cast<UINT>(EShaderStage::Count); stageIndex++)
+			{
+				BuildShader(options, prevArchive, program, static_cast<EShaderStage>(stageIndex), permutationFlags, source, &archive, &stats);
+			}
+			permutationFlags = (permutationFlags - mask) & mask;
+		} while (permutationFlags != 0);
+	}
+
+	if (stats.ErrorCount > 0)
+	{
+		printf("shader build failed: %u error(s)\n", stats.ErrorCount);
+		return 1;
+	}
+
+	// 내용이 같으면 파일을 다시 쓰지 않는다 (타임스탬프 유지)
+	std::vector<BYTE> newData;
+	archive.Serialize(newData);
+	std::vector<BYTE> oldData;
+	if (ReadBinaryFile(outputPath, oldData) && oldData == newData)
+	{
+		printf("shaders up to date: %u entries, %u blobs\n", archive.GetEntryCount(), archive.GetBlobCount());
+		return 0;
+	}
+
+	if (!archive.WriteToFile(outputPath.c_str()))
+	{
+		printf("cannot write %s\n", outputPath.string().c_str());
+		return 1;
+	}
+
+	printf("%s: %u entries, %u blobs (%u compiled, %u reused)\n",
+		outputPath.string().c_str(), archive.GetEntryCount(), archive.GetBlobCount(), stats.CompiledCount, stats.ReusedCount);
+	return 0;
+}
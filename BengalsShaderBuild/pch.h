@@ -0,0 +1,26 @@
+// pch.h: precompiled header for the offline shader build tool.
+// 디바이스를 만들지 않는다. d3d12.h는 D3D12_SHADER_BYTECODE 등 타입 정의만 사용한다.
+
+#ifndef PCH_H
+#define PCH_H
+
+#define WIN32_LEAN_AND_MEAN             // Exclude rarely-used stuff from Windows headers
+
+#include <windows.h>
+#include <wrl/client.h>
+
+// d3d
+#include <d3d12.h>
+#include <d3dcompiler.h>
+
+using namespace Microsoft::WRL;
+
+// C RunTime Header Files
+#include <stdlib.h>
+#include <malloc.h>
+#include <memory.h>
+
+// C++ Standard Library
+#include <memory>
+
+#endif //PCH_H
@@ -176,7 +176,6 @@ void UpdateTexture(ID3D12Device* pD3DDevice, ID3D12GraphicsCommandList* pCommand
 
 	pD3DDevice->GetCopyableFootprints(&Desc, 0, Desc.MipLevels, 0, Footprint, Rows, RowSize, &TotalBytes);
 
-	pCommandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(pDestTexResource, D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_COPY_DEST));
 	for (DWORD i = 0; i < Desc.MipLevels; i++)
 	{
 
@@ -193,7 +192,35 @@ void UpdateTexture(ID3D12Device* pD3DDevice, ID3D12GraphicsCommandList* pCommand
 
 		pCommandList->CopyTextureRegion(&destLocation, 0, 0, 0, &srcLocation, nullptr);
 	}
-	pCommandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(pDestTexResource, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE));
 
 }
 
+void UpdateTextureRegions(ID3D12Device* pD3DDevice, ID3D12GraphicsCommandList* pCommandList, ID3D12Resource* pDestTexResource, ID3D12Resource* pSrcTexResource, UINT64 srcOffset, const RECT* pRects, UINT rectCount)
+{
+	D3D12_PLACED_SUBRESOURCE_FOOTPRINT Footprint = {};
+	UINT	Rows = 0;
+	UINT64	RowSize = 0;
+	UINT64	TotalBytes = 0;
+
+	D3D12_RESOURCE_DESC Desc = pDestTexResource->GetDesc();
+	pD3DDevice->GetCopyableFootprints(&Desc, 0, 1, srcOffset, &Footprint, &Rows, &RowSize, &TotalBytes);
+
+	D3D12_TEXTURE_COPY_LOCATION	destLocation = {};
+	destLocation.pResource = pDestTexResource;
+	destLocation.SubresourceIndex = 0;
+	destLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+
+	// 업로드 버퍼는 텍스처 전체와 같은 배치이므로 원본과 대상 좌표가 같다
+	D3D12_TEXTURE_COPY_LOCATION	srcLocation = {};
+	srcLocation.PlacedFootprint = Footprint;
+	srcLocation.pResource = pSrcTexResource;
+	srcLocation.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+
+	for (UINT i = 0; i < rectCount; i++)
+	{
+		const RECT& rect = pRects[i];
+		D3D12_BOX srcBox = { static_cast<UINT>(rect.left), static_cast<UINT>(rect.top), 0, static_cast<UINT>(rect.right), static_cast<UINT>(rect.bottom), 1 };
+		pCommandList->CopyTextureRegion(&destLocation, srcBox.left, srcBox.top, 0, &srcLocation, &srcBox);
+	}
+}
+
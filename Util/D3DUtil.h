@@ -10,7 +10,10 @@ void GetSoftwareAdapter(IDXGIFactory2* pFactory, IDXGIAdapter1** ppAdapter);
 void SetDebugLayerInfo(ID3D12Device* InD3DDevice);
 void SetDefaultSamplerDesc(D3D12_STATIC_SAMPLER_DESC* pOutSamplerDesc, UINT RegisterIndex);
 
+// barrier를 기록하지 않는다. pDestTexResource는 COPY_DEST 상태여야 한다 (CResourceStateTracker)
 void UpdateTexture(ID3D12Device* pD3DDevice, ID3D12GraphicsCommandList* pCommandList, ID3D12Resource* pDestTexResource, ID3D12Resource* pSrcTexResource);
+// mip 0의 pRects 영역만 복사한다. srcOffset은 업로드 버퍼 안의 이미지 시작 위치 (512 정렬). barrier 조건은 UpdateTexture와 같다
+void UpdateTextureRegions(ID3D12Device* pD3DDevice, ID3D12GraphicsCommandList* pCommandList, ID3D12Resource* pDestTexResource, ID3D12Resource* pSrcTexResource, UINT64 srcOffset, const RECT* pRects, UINT rectCount);
 
 inline size_t AlignConstantBufferSize(size_t size)
 {
@@ -1,148 +1,486 @@
 #include "pch.h"
-#include <Windows.h>
 #include "ProcessorInfo.h"
+#include <algorithm>
+#include <map>
+#include <string>
+#include <thread>
 
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#endif
 
-typedef BOOL(WINAPI *LPFN_GLPI)(PSYSTEM_LOGICAL_PROCESSOR_INFORMATION, PDWORD);
-DWORD CountSetBits(ULONG_PTR bitMask);
-
-BOOL GetPhysicalCoreCount(DWORD* pdwOutPhysicalCoreCount, DWORD* pdwOutLogicalCoreCount)
+namespace
 {
-	BOOL	bResult = FALSE;
+	// 플랫폼별 조회 결과. logical processor 목록만 모아두고 소속 관계는 BuildTopology에서 계산
+	struct RawProcessorTopology
+	{
+		std::vector<std::vector<uint32_t>> CoreList;
+		std::vector<uint32_t> CoreEfficiencyClassList;
+		std::vector<std::vector<uint32_t>> PackageList;
+		std::vector<std::vector<uint32_t>> NumaNodeList;
+		std::vector<ProcessorCacheInfo> CacheList;
+	};
 
+	uint32_t FindOwnerIndex(const std::vector<std::vector<uint32_t>>& ownerList, uint32_t logicalProcessorIndex)
 	{
-		LPFN_GLPI glpi;
+		for (size_t i = 0; i < ownerList.size(); i++)
+		{
+			if (std::binary_search(ownerList[i].begin(), ownerList[i].end(), logicalProcessorIndex))
+			{
+				return static_cast<uint32_t>(i);
+			}
+		}
+		return UINT32_MAX;
+	}
 
-		PSYSTEM_LOGICAL_PROCESSOR_INFORMATION pBuffer = nullptr;
-		PSYSTEM_LOGICAL_PROCESSOR_INFORMATION ptr = nullptr;
-		DWORD returnLength = 0;
-		DWORD logicalProcessorCount = 0;
-		DWORD numaNodeCount = 0;
-		DWORD processorCoreCount = 0;
-		DWORD processorL1CacheCount = 0;
-		DWORD processorL2CacheCount = 0;
-		DWORD processorL3CacheCount = 0;
-		DWORD processorPackageCount = 0;
-		DWORD byteOffset = 0;
-		PCACHE_DESCRIPTOR Cache;
+	uint32_t FindCacheIndex(const std::vector<ProcessorCacheInfo>& cacheList, uint32_t level, uint32_t logicalProcessorIndex)
+	{
+		for (size_t i = 0; i < cacheList.size(); i++)
+		{
+			const ProcessorCacheInfo& cache = cacheList[i];
+			if (cache.Level == level &&
+				std::binary_search(cache.LogicalProcessorList.begin(), cache.LogicalProcessorList.end(), logicalProcessorIndex))
+			{
+				return static_cast<uint32_t>(i);
+			}
+		}
+		return UINT32_MAX;
+	}
 
+	void BuildTopology(RawProcessorTopology& raw, ProcessorTopology* pOutTopology)
+	{
+		for (std::vector<uint32_t>& logicalList : raw.CoreList)
+		{
+			std::sort(logicalList.begin(), logicalList.end());
+		}
+		for (std::vector<uint32_t>& logicalList : raw.PackageList)
+		{
+			std::sort(logicalList.begin(), logicalList.end());
+		}
+		for (std::vector<uint32_t>& logicalList : raw.NumaNodeList)
+		{
+			std::sort(logicalList.begin(), logicalList.end());
+		}
+		for (ProcessorCacheInfo& cache : raw.CacheList)
+		{
+			std::sort(cache.LogicalProcessorList.begin(), cache.LogicalProcessorList.end());
+		}
 
+		*pOutTopology = ProcessorTopology{};
+		pOutTopology->CacheList = std::move(raw.CacheList);
+		pOutTopology->PackageCount = (std::max)(1u, static_cast<uint32_t>(raw.PackageList.size()));
+		pOutTopology->NumaNodeCount = (std::max)(1u, static_cast<uint32_t>(raw.NumaNodeList.size()));
 
-		glpi = (LPFN_GLPI)GetProcAddress(GetModuleHandle(TEXT("kernel32")), "GetLogicalProcessorInformation");
-		if (nullptr == glpi)
+		for (size_t i = 0; i < raw.CoreList.size(); i++)
 		{
-			SYSTEM_INFO systemInfo;
-			GetSystemInfo(&systemInfo);
-			*pdwOutPhysicalCoreCount = systemInfo.dwNumberOfProcessors;
-			*pdwOutLogicalCoreCount = systemInfo.dwNumberOfProcessors;
+			if (raw.CoreList[i].empty())
+			{
+				continue;
+			}
 
-			OutputDebugStringW(L"\nGetLogicalProcessorInformation is not supported.\n");
-			goto lb_return;
+			ProcessorCoreInfo core = {};
+			core.LogicalProcessorList = std::move(raw.CoreList[i]);
+			const uint32_t firstLogicalProcessor = core.LogicalProcessorList[0];
+			core.PackageIndex = (std::min)(FindOwnerIndex(raw.PackageList, firstLogicalProcessor), pOutTopology->PackageCount - 1);
+			core.NumaNodeIndex = (std::min)(FindOwnerIndex(raw.NumaNodeList, firstLogicalProcessor), pOutTopology->NumaNodeCount - 1);
+			core.EfficiencyClass = (i < raw.CoreEfficiencyClassList.size()) ? raw.CoreEfficiencyClassList[i] : 0;
+			core.L2CacheIndex = FindCacheIndex(pOutTopology->CacheList, 2, firstLogicalProcessor);
+			core.L3CacheIndex = FindCacheIndex(pOutTopology->CacheList, 3, firstLogicalProcessor);
+
+			pOutTopology->LogicalProcessorCount += static_cast<uint32_t>(core.LogicalProcessorList.size());
+			pOutTopology->CoreList.push_back(std::move(core));
 		}
 
-		BOOL done = FALSE;
-		while (!done)
+		std::sort(pOutTopology->CoreList.begin(), pOutTopology->CoreList.end(),
+			[](const ProcessorCoreInfo& a, const ProcessorCoreInfo& b)
+			{
+				if (a.PackageIndex != b.PackageIndex)
+				{
+					return a.PackageIndex < b.PackageIndex;
+				}
+				return a.LogicalProcessorList[0] < b.LogicalProcessorList[0];
+			});
+	}
+
+	void BuildFallbackTopology(RawProcessorTopology* pOutRaw)
+	{
+		*pOutRaw = RawProcessorTopology{};
+		const uint32_t logicalProcessorCount = (std::max)(1u, std::thread::hardware_concurrency());
+		for (uint32_t i = 0; i < logicalProcessorCount; i++)
 		{
-			DWORD rc = glpi(pBuffer, &returnLength);
+			pOutRaw->CoreList.push_back({ i });
+		}
+	}
 
-			if (FALSE == rc)
+#ifdef _WIN32
+	void AppendGroupMask(const GROUP_AFFINITY& groupMask, std::vector<uint32_t>* pOutLogicalList)
+	{
+		for (uint32_t bit = 0; bit < sizeof(KAFFINITY) * 8; bit++)
+		{
+			if (groupMask.Mask & (static_cast<KAFFINITY>(1) << bit))
 			{
-				if (GetLastError() == ERROR_INSUFFICIENT_BUFFER)
+				pOutLogicalList->push_back(static_cast<uint32_t>(groupMask.Group) * 64 + bit);
+			}
+		}
+	}
+
+	bool QueryPlatformTopology(RawProcessorTopology* pOutRaw)
+	{
+		DWORD bufferSize = 0;
+		GetLogicalProcessorInformationEx(RelationAll, nullptr, &bufferSize);
+		if (GetLastError() != ERROR_INSUFFICIENT_BUFFER || bufferSize == 0)
+		{
+			OutputDebugStringW(L"\nGetLogicalProcessorInformationEx is not supported.\n");
+			return false;
+		}
+
+		std::vector<BYTE> buffer(bufferSize);
+		if (!GetLogicalProcessorInformationEx(RelationAll, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()), &bufferSize))
+		{
+			return false;
+		}
+
+		// 레코드마다 크기가 다르므로 Size만큼 진행
+		for (DWORD byteOffset = 0; byteOffset < bufferSize;)
+		{
+			const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX* pInfo = reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + byteOffset);
+			switch (pInfo->Relationship)
+			{
+			case RelationProcessorCore:
+			{
+				// A hyperthreaded core supplies more than one logical processor.
+				std::vector<uint32_t> logicalList;
+				for (WORD i = 0; i < pInfo->Processor.GroupCount; i++)
 				{
-					if (pBuffer)
-						free(pBuffer);
+					AppendGroupMask(pInfo->Processor.GroupMask[i], &logicalList);
+				}
+				pOutRaw->CoreList.push_back(std::move(logicalList));
+				pOutRaw->CoreEfficiencyClassList.push_back(pInfo->Processor.EfficiencyClass);
+				break;
+			}
 
-					pBuffer = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION)malloc(returnLength);
+			case RelationProcessorPackage:
+			{
+				std::vector<uint32_t> logicalList;
+				for (WORD i = 0; i < pInfo->Processor.GroupCount; i++)
+				{
+					AppendGroupMask(pInfo->Processor.GroupMask[i], &logicalList);
 				}
-				else
+				pOutRaw->PackageList.push_back(std::move(logicalList));
+				break;
+			}
+
+			case RelationNumaNode:
+			{
+				// Non-NUMA systems report a single record of this type.
+				std::vector<uint32_t> logicalList;
+				AppendGroupMask(pInfo->NumaNode.GroupMask, &logicalList);
+				pOutRaw->NumaNodeList.push_back(std::move(logicalList));
+				break;
+			}
+
+			case RelationCache:
+				if (pInfo->Cache.Type == CacheData || pInfo->Cache.Type == CacheUnified)
 				{
-					break;
+					ProcessorCacheInfo cache = {};
+					cache.Level = pInfo->Cache.Level;
+					cache.SizeInBytes = pInfo->Cache.CacheSize;
+					cache.LineSize = pInfo->Cache.LineSize;
+					AppendGroupMask(pInfo->Cache.GroupMask, &cache.LogicalProcessorList);
+					pOutRaw->CacheList.push_back(std::move(cache));
 				}
+				break;
+
+			default:
+				break;
 			}
-			else
+			byteOffset += pInfo->Size;
+		}
+
+		return !pOutRaw->CoreList.empty();
+	}
+#else
+	bool ReadTextFile(const std::string& path, std::string* pOutText)
+	{
+		std::ifstream file(path);
+		if (!file)
+		{
+			return false;
+		}
+
+		std::getline(file, *pOutText);
+		return true;
+	}
+
+	// "0-3,8,10-11" 형식의 cpu 목록
+	bool ParseCpuList(const std::string& text, std::vector<uint32_t>* pOutLogicalList)
+	{
+		pOutLogicalList->clear();
+
+		size_t pos = 0;
+		while (pos < text.size())
+		{
+			size_t end = text.find(',', pos);
+			if (end == std::string::npos)
+			{
+				end = text.size();
+			}
+
+			const std::string range = text.substr(pos, end - pos);
+			if (!range.empty() && range[0] >= '0' && range[0] <= '9')
 			{
-				done = TRUE;
+				const size_t dash = range.find('-');
+				const uint32_t first = static_cast<uint32_t>(std::stoul(range.substr(0, dash)));
+				const uint32_t last = (dash == std::string::npos) ? first : static_cast<uint32_t>(std::stoul(range.substr(dash + 1)));
+				for (uint32_t i = first; i <= last; i++)
+				{
+					pOutLogicalList->push_back(i);
+				}
 			}
+			pos = end + 1;
+		}
+
+		return !pOutLogicalList->empty();
+	}
+
+	// "32K", "1024K", "8M"
+	uint64_t ParseCacheSize(const std::string& text)
+	{
+		if (text.empty() || text[0] < '0' || text[0] > '9')
+		{
+			return 0;
 		}
 
-		ptr = pBuffer;
+		uint64_t size = std::stoull(text);
+		switch (text.back())
+		{
+		case 'K':
+			size *= 1024;
+			break;
+		case 'M':
+			size *= 1024 * 1024;
+			break;
+		case 'G':
+			size *= 1024ull * 1024 * 1024;
+			break;
+		}
+		return size;
+	}
+
+	bool QueryPlatformTopology(RawProcessorTopology* pOutRaw)
+	{
+		const std::string cpuRoot = "/sys/devices/system/cpu/";
+
+		std::string text;
+		std::vector<uint32_t> onlineList;
+		if (!ReadTextFile(cpuRoot + "online", &text) || !ParseCpuList(text, &onlineList))
+		{
+			return false;
+		}
 
-		while (byteOffset + sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION) <= returnLength)
+		// 같은 목록을 가진 cpu끼리 한 코어 / 패키지 / 캐시
+		std::map<std::string, size_t> coreMap;
+		std::map<std::string, size_t> packageMap;
+		std::map<std::string, size_t> cacheMap;
+		for (uint32_t cpu : onlineList)
 		{
-			switch (ptr->Relationship)
+			const std::string cpuPath = cpuRoot + "cpu" + std::to_string(cpu) + "/";
+
+			std::vector<uint32_t> logicalList;
+			if (!ReadTextFile(cpuPath + "topology/thread_siblings_list", &text) || !ParseCpuList(text, &logicalList))
 			{
-				case RelationNumaNode:
-					// Non-NUMA systems report a single record of this type.
-					numaNodeCount++;
-					break;
+				logicalList = { cpu };
+				text = std::to_string(cpu);
+			}
+			if (coreMap.emplace(text, pOutRaw->CoreList.size()).second)
+			{
+				pOutRaw->CoreList.push_back(logicalList);
+			}
 
-				case RelationProcessorCore:
-					processorCoreCount++;
+			// package_cpus_list는 5.x 커널부터, 이전에는 core_siblings_list
+			if (ReadTextFile(cpuPath + "topology/package_cpus_list", &text) || ReadTextFile(cpuPath + "topology/core_siblings_list", &text))
+			{
+				if (packageMap.emplace(text, pOutRaw->PackageList.size()).second)
+				{
+					std::vector<uint32_t> packageList;
+					ParseCpuList(text, &packageList);
+					pOutRaw->PackageList.push_back(std::move(packageList));
+				}
+			}
 
-					// A hyperthreaded core supplies more than one logical processor.
-					logicalProcessorCount += CountSetBits(ptr->ProcessorMask);
+			for (uint32_t cacheIndex = 0;; cacheIndex++)
+			{
+				const std::string cachePath = cpuPath + "cache/index" + std::to_string(cacheIndex) + "/";
+				std::string levelText;
+				if (!ReadTextFile(cachePath + "level", &levelText))
+				{
 					break;
+				}
 
-				case RelationCache:
-					// Cache data is in ptr->Cache, one CACHE_DESCRIPTOR structure for each cache. 
-					Cache = &ptr->Cache;
-					if (Cache->Level == 1)
-					{
-						processorL1CacheCount++;
-					}
-					else if (Cache->Level == 2)
-					{
-						processorL2CacheCount++;
-					}
-					else if (Cache->Level == 3)
-					{
-						processorL3CacheCount++;
-					}
-					break;
+				std::string typeText;
+				ReadTextFile(cachePath + "type", &typeText);
+				if (typeText == "Instruction")
+				{
+					continue;
+				}
 
-				case RelationProcessorPackage:
-					// Logical processors share a physical package.
-					processorPackageCount++;
-					break;
+				std::string sharedText;
+				if (!ReadTextFile(cachePath + "shared_cpu_list", &sharedText))
+				{
+					sharedText = std::to_string(cpu);
+				}
+				if (!cacheMap.emplace(levelText + ":" + sharedText, pOutRaw->CacheList.size()).second)
+				{
+					continue;
+				}
 
-				default:
-					OutputDebugStringW(L"\nError: Unsupported LOGICAL_PROCESSOR_RELATIONSHIP value.\n");
-					break;
+				ProcessorCacheInfo cache = {};
+				cache.Level = static_cast<uint32_t>(std::stoul(levelText));
+				if (ReadTextFile(cachePath + "size", &text))
+				{
+					cache.SizeInBytes = ParseCacheSize(text);
+				}
+				if (ReadTextFile(cachePath + "coherency_line_size", &text) && !text.empty())
+				{
+					cache.LineSize = static_cast<uint32_t>(std::stoul(text));
+				}
+				ParseCpuList(sharedText, &cache.LogicalProcessorList);
+				pOutRaw->CacheList.push_back(std::move(cache));
 			}
-			byteOffset += sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION);
-			ptr++;
 		}
-		*pdwOutPhysicalCoreCount = processorCoreCount;
-		*pdwOutLogicalCoreCount = logicalProcessorCount;
-		//numaNodeCount;
-		//processorPackageCount;
-		//processorCoreCount;
-		//logicalProcessorCount;
-		//processorL1CacheCount;
-		//processorL2CacheCount;
-		//processorL3CacheCount
 
-		free(pBuffer);
+		const std::string nodeRoot = "/sys/devices/system/node/";
+		std::vector<uint32_t> nodeList;
+		if (ReadTextFile(nodeRoot + "online", &text) && ParseCpuList(text, &nodeList))
+		{
+			for (uint32_t node : nodeList)
+			{
+				std::vector<uint32_t> logicalList;
+				if (ReadTextFile(nodeRoot + "node" + std::to_string(node) + "/cpulist", &text) && ParseCpuList(text, &logicalList))
+				{
+					pOutRaw->NumaNodeList.push_back(std::move(logicalList));
+				}
+			}
+		}
 
-		bResult = TRUE;
+		return !pOutRaw->CoreList.empty();
 	}
-lb_return:
+#endif
+}
+
+bool QueryProcessorTopology(ProcessorTopology* pOutTopology)
+{
+	if (!pOutTopology)
+	{
+		return false;
+	}
+
+	RawProcessorTopology raw = {};
+	const bool bResult = QueryPlatformTopology(&raw);
+	if (!bResult)
+	{
+		BuildFallbackTopology(&raw);
+	}
+
+	BuildTopology(raw, pOutTopology);
 	return bResult;
 }
 
-// Helper function to count set bits in the processor mask.
-DWORD CountSetBits(ULONG_PTR bitMask)
+const ProcessorTopology& GetProcessorTopology()
 {
-	DWORD LSHIFT = sizeof(ULONG_PTR) * 8 - 1;
-	DWORD bitSetCount = 0;
-	ULONG_PTR bitTest = (ULONG_PTR)1 << LSHIFT;
-	DWORD i;
+	static const ProcessorTopology s_topology = []()
+		{
+			ProcessorTopology topology = {};
+			QueryProcessorTopology(&topology);
+			return topology;
+		}();
+	return s_topology;
+}
 
-	for (i = 0; i <= LSHIFT; ++i)
+void GetWorkerAffinityList(const ProcessorTopology& topology, uint32_t reservedCoreCount, std::vector<uint32_t>* pOutLogicalProcessorList)
+{
+	pOutLogicalProcessorList->clear();
+
+	// 성능 코어 먼저. 같은 등급 안에서는 원래 순서 유지
+	std::vector<const ProcessorCoreInfo*> coreOrder;
+	coreOrder.reserve(topology.CoreList.size());
+	for (const ProcessorCoreInfo& core : topology.CoreList)
 	{
-		bitSetCount += ((bitMask & bitTest) ? 1 : 0);
-		bitTest /= 2;
+		coreOrder.push_back(&core);
 	}
+	std::stable_sort(coreOrder.begin(), coreOrder.end(),
+		[](const ProcessorCoreInfo* a, const ProcessorCoreInfo* b) { return a->EfficiencyClass > b->EfficiencyClass; });
+
+	const size_t reservedCount = (std::min)(static_cast<size_t>(reservedCoreCount), coreOrder.size());
+
+	// 같은 등급의 코어를 NUMA 노드별로 나눠 번갈아 꺼낸다. 워커 수가 코어 수보다 적어도 노드에 고르게 퍼진다
+	const size_t nodeCount = (topology.NumaNodeCount > 0) ? topology.NumaNodeCount : 1;
+	std::vector<std::vector<const ProcessorCoreInfo*>> nodeCoreList(nodeCount);
+	for (size_t tierBegin = reservedCount; tierBegin < coreOrder.size();)
+	{
+		size_t tierEnd = tierBegin;
+		while (tierEnd < coreOrder.size() && coreOrder[tierEnd]->EfficiencyClass == coreOrder[tierBegin]->EfficiencyClass)
+		{
+			const uint32_t nodeIndex = (std::min)(coreOrder[tierEnd]->NumaNodeIndex, static_cast<uint32_t>(nodeCount - 1));
+			nodeCoreList[nodeIndex].push_back(coreOrder[tierEnd]);
+			tierEnd++;
+		}
 
-	return bitSetCount;
+		for (size_t round = 0; round < tierEnd - tierBegin; round++)
+		{
+			for (const std::vector<const ProcessorCoreInfo*>& coreList : nodeCoreList)
+			{
+				if (round < coreList.size())
+				{
+					pOutLogicalProcessorList->push_back(coreList[round]->LogicalProcessorList[0]);
+				}
+			}
+		}
+
+		for (std::vector<const ProcessorCoreInfo*>& coreList : nodeCoreList)
+		{
+			coreList.clear();
+		}
+		tierBegin = tierEnd;
+	}
+
+	for (size_t i = 0; i < reservedCount; i++)
+	{
+		pOutLogicalProcessorList->push_back(coreOrder[i]->LogicalProcessorList[0]);
+	}
+}
+
+bool SetCurrentThreadAffinity(uint32_t logicalProcessorIndex)
+{
+#ifdef _WIN32
+	GROUP_AFFINITY groupAffinity = {};
+	groupAffinity.Group = static_cast<WORD>(logicalProcessorIndex / 64);
+	groupAffinity.Mask = static_cast<KAFFINITY>(1) << (logicalProcessorIndex % 64);
+	return SetThreadGroupAffinity(GetCurrentThread(), &groupAffinity, nullptr) != FALSE;
+#else
+	if (logicalProcessorIndex >= CPU_SETSIZE)
+	{
+		return false;
+	}
+
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	CPU_SET(logicalProcessorIndex, &cpuSet);
+	return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#endif
+}
+
+#ifdef _WIN32
+BOOL GetPhysicalCoreCount(DWORD* pdwOutPhysicalCoreCount, DWORD* pdwOutLogicalCoreCount)
+{
+	ProcessorTopology topology = {};
+	const bool bResult = QueryProcessorTopology(&topology);
+	*pdwOutPhysicalCoreCount = topology.GetPhysicalCoreCount();
+	*pdwOutLogicalCoreCount = topology.LogicalProcessorCount;
+	return bResult ? TRUE : FALSE;
 }
+#endif
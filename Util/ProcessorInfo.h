@@ -1,4 +1,61 @@
 #pragma once
 
-BOOL GetPhysicalCoreCount(DWORD* pdwOutPhysicalCoreCount,DWORD* pdwOutLogicalCoreCount);
+#include <cstdint>
+#include <vector>
 
+/**
+ * CPU topology: physical cores with their SMT siblings, the caches shared between
+ * them, packages and NUMA nodes.
+ *
+ * Logical processors are numbered globally: processor group * 64 + index on Windows,
+ * the kernel cpu number on Linux. QueryProcessorTopology() reads
+ * GetLogicalProcessorInformationEx on Windows and /sys/devices/system/cpu on Linux;
+ * when neither is available every logical processor is reported as its own core.
+ * GetProcessorTopology() queries once and caches the result.
+ */
+
+struct ProcessorCoreInfo
+{
+	std::vector<uint32_t> LogicalProcessorList;		// SMT siblings, 오름차순
+	uint32_t PackageIndex = 0;
+	uint32_t NumaNodeIndex = 0;
+	uint32_t EfficiencyClass = 0;					// 하이브리드 CPU에서 클수록 성능 코어 (Windows만)
+	uint32_t L2CacheIndex = UINT32_MAX;				// ProcessorTopology::CacheList 인덱스, 없으면 UINT32_MAX
+	uint32_t L3CacheIndex = UINT32_MAX;
+};
+
+struct ProcessorCacheInfo
+{
+	uint32_t Level = 0;
+	uint64_t SizeInBytes = 0;
+	uint32_t LineSize = 0;
+	std::vector<uint32_t> LogicalProcessorList;		// 이 캐시를 공유하는 logical processor
+};
+
+struct ProcessorTopology
+{
+	std::vector<ProcessorCoreInfo> CoreList;		// 패키지, 첫 logical processor 순
+	std::vector<ProcessorCacheInfo> CacheList;		// data / unified 캐시만
+	uint32_t LogicalProcessorCount = 0;
+	uint32_t PackageCount = 0;
+	uint32_t NumaNodeCount = 0;
+
+	uint32_t GetPhysicalCoreCount() const
+	{
+		return static_cast<uint32_t>(CoreList.size());
+	}
+};
+
+bool QueryProcessorTopology(ProcessorTopology* pOutTopology);
+const ProcessorTopology& GetProcessorTopology();
+
+// 물리 코어마다 logical processor 하나씩, 성능 코어를 먼저, NUMA 노드를 번갈아 고른다.
+// 앞의 reservedCoreCount개 코어(메인 스레드 몫)는 목록 끝으로 보낸다
+void GetWorkerAffinityList(const ProcessorTopology& topology, uint32_t reservedCoreCount, std::vector<uint32_t>* pOutLogicalProcessorList);
+
+// 호출한 스레드를 logical processor 하나에 고정
+bool SetCurrentThreadAffinity(uint32_t logicalProcessorIndex);
+
+#ifdef _WIN32
+BOOL GetPhysicalCoreCount(DWORD* pdwOutPhysicalCoreCount, DWORD* pdwOutLogicalCoreCount);
+#endif